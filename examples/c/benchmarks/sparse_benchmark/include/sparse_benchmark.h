@@ -0,0 +1,16 @@
+#ifndef SPARSE_BENCHMARK_H
+#define SPARSE_BENCHMARK_H
+
+/* This generated file contains includes for project dependencies */
+#include "sparse_benchmark/bake_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,109 @@
+#include <sparse_benchmark.h>
+#include <stdio.h>
+
+// This example measures the performance of the sparse set, which is used by
+// several internal data structures (tables, type info, allocators). It
+// compares operations on single elements with their bulk equivalents.
+
+typedef struct {
+    double x, y, z;
+    int64_t value;
+} Data;
+
+#define ELEMENT_COUNT (1000 * 1000)
+#define ITERATIONS (10)
+
+static double now_diff(ecs_time_t *t) {
+    return ecs_time_measure(t) * 1000.0;
+}
+
+int main(int argc, char *argv[]) {
+    (void)argc; (void)argv;
+    ecs_os_set_api_defaults();
+
+    uint64_t *ids = ecs_os_malloc_n(uint64_t, ELEMENT_COUNT);
+    double t_add = 0, t_new_ids = 0, t_get_dense = 0, t_iter = 0;
+    double t_remove = 0, t_remove_n = 0;
+    int64_t sum = 0;
+    ecs_time_t t = {0};
+
+    for (int it = 0; it < ITERATIONS; it ++) {
+        ecs_sparse_t s1, s2;
+        ecs_sparse_init_t(&s1, Data);
+        ecs_sparse_init_t(&s2, Data);
+
+        // Create elements one by one
+        ecs_time_measure(&t);
+        for (int i = 0; i < ELEMENT_COUNT; i ++) {
+            ecs_sparse_add_t(&s1, Data)->value = i;
+        }
+        t_add += now_diff(&t);
+
+        // Create elements in bulk
+        ecs_time_measure(&t);
+        const uint64_t *new_ids = ecs_sparse_new_ids(&s2, ELEMENT_COUNT);
+        t_new_ids += now_diff(&t);
+        ecs_os_memcpy_n(ids, new_ids, uint64_t, ELEMENT_COUNT);
+
+        // Remove every third element and recycle the ids, so that the dense
+        // order no longer matches the order in which elements are stored.
+        for (int i = 0; i < ELEMENT_COUNT; i += 3) {
+            ecs_sparse_remove_t(&s2, Data, ids[i]);
+        }
+        ecs_sparse_new_ids(&s2, ELEMENT_COUNT / 3);
+
+        // Iterate by dense index
+        ecs_time_measure(&t);
+        int32_t count = ecs_sparse_count(&s2);
+        for (int i = 0; i < count; i ++) {
+            sum += ecs_sparse_get_dense_t(&s2, Data, i)->value ++;
+        }
+        t_get_dense += now_diff(&t);
+
+        // Iterate with the sparse iterator
+        ecs_time_measure(&t);
+        ecs_sparse_iter_t sit = ecs_sparse_iter(&s2);
+        Data *ptr;
+        while ((ptr = ecs_sparse_next_t(&sit, Data, NULL))) {
+            sum += ptr->value ++;
+        }
+        t_iter += now_diff(&t);
+
+        // Remove elements one by one
+        ecs_os_memcpy_n(ids, ecs_sparse_ids(&s1), uint64_t, ELEMENT_COUNT);
+        ecs_time_measure(&t);
+        for (int i = 0; i < ELEMENT_COUNT; i ++) {
+            ecs_sparse_remove_t(&s1, Data, ids[i]);
+        }
+        t_remove += now_diff(&t);
+
+        // Remove the same number of elements in bulk
+        ecs_sparse_fini(&s2);
+        ecs_sparse_init_t(&s2, Data);
+        ecs_os_memcpy_n(ids, ecs_sparse_new_ids(&s2, ELEMENT_COUNT),
+            uint64_t, ELEMENT_COUNT);
+        ecs_time_measure(&t);
+        ecs_sparse_remove_n_t(&s2, Data, ids, ELEMENT_COUNT);
+        t_remove_n += now_diff(&t);
+
+        ecs_sparse_fini(&s1);
+        ecs_sparse_fini(&s2);
+    }
+
+    printf("add:       %8.2fms\n", t_add / ITERATIONS);
+    printf("new_ids:   %8.2fms\n", t_new_ids / ITERATIONS);
+    printf("get_dense: %8.2fms\n", t_get_dense / ITERATIONS);
+    printf("iter:      %8.2fms\n", t_iter / ITERATIONS);
+    printf("remove:    %8.2fms\n", t_remove / ITERATIONS);
+    printf("remove_n:  %8.2fms\n", t_remove_n / ITERATIONS);
+    printf("(checksum %lld)\n", (long long)sum);
+
+    // Output (times depend on the machine):
+    //   add:       ...ms
+    //   new_ids:   ...ms
+    //   ...
+
+    ecs_os_free(ids);
+
+    return 0;
+}
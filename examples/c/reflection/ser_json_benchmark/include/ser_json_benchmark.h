@@ -0,0 +1,16 @@
+#ifndef SER_JSON_BENCHMARK_H
+#define SER_JSON_BENCHMARK_H
+
+/* This generated file contains includes for project dependencies */
+#include "ser_json_benchmark/bake_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,98 @@
+#include <ser_json_benchmark.h>
+#include <stdio.h>
+
+// This example measures how fast entities with integer, floating point and
+// string members are serialized to JSON. It can be used to compare the
+// performance of the JSON serializer between versions.
+
+typedef struct {
+    double x, y;
+} Position;
+
+typedef struct {
+    int32_t value;
+    int64_t max;
+} Health;
+
+typedef struct {
+    char *value;
+} Description;
+
+#define ENTITY_COUNT (100 * 1000)
+#define ITERATIONS (10)
+
+int main(int argc, char *argv[]) {
+    ecs_world_t *world = ecs_init();
+    (void)argc; (void)argv;
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Health);
+    ECS_COMPONENT(world, Description);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { .name = "x", .type = ecs_id(ecs_f64_t) },
+            { .name = "y", .type = ecs_id(ecs_f64_t) },
+        }
+    });
+
+    ecs_struct(world, {
+        .entity = ecs_id(Health),
+        .members = {
+            { .name = "value", .type = ecs_id(ecs_i32_t) },
+            { .name = "max", .type = ecs_id(ecs_i64_t) },
+        }
+    });
+
+    ecs_struct(world, {
+        .entity = ecs_id(Description),
+        .members = {
+            { .name = "value", .type = ecs_id(ecs_string_t) }
+        }
+    });
+
+    for (int i = 0; i < ENTITY_COUNT; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        ecs_set(world, e, Position, {i * 0.5, i * 2});
+        ecs_set(world, e, Health, {i % 100, 100});
+        ecs_set(world, e, Description, {
+            (i % 10) ? "A long description without special characters"
+                     : "A description with a \"quote\"\nand a new line"
+        });
+    }
+
+    ecs_query_t *q = ecs_query(world, {
+        .filter.terms = {
+            { ecs_id(Position) }, { ecs_id(Health) }, { ecs_id(Description) }
+        }
+    });
+
+    ecs_iter_to_json_desc_t desc = ECS_ITER_TO_JSON_INIT;
+    desc.serialize_entity_ids = true;
+    desc.serialize_ids = false;
+    desc.serialize_is_set = false;
+
+    ecs_time_t t = {0};
+    ecs_size_t size = 0;
+
+    ecs_time_measure(&t);
+    for (int i = 0; i < ITERATIONS; i ++) {
+        ecs_iter_t it = ecs_query_iter(world, q);
+        char *json = ecs_iter_to_json(world, &it, &desc);
+        size += ecs_os_strlen(json);
+        ecs_os_free(json);
+    }
+    double elapsed = ecs_time_measure(&t);
+
+    printf("serialized %d bytes in %.4fs (%.1f MB/s)\n", size, elapsed, 
+        (double)size / elapsed / (1024 * 1024));
+
+    // Output (times depend on the machine):
+    //   serialized ... bytes in ...s (... MB/s)
+
+    ecs_query_fini(q);
+    ecs_fini(world);
+
+    return 0;
+}
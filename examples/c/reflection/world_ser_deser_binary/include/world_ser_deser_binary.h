@@ -0,0 +1,16 @@
+#ifndef WORLD_SER_DESER_BINARY_H
+#define WORLD_SER_DESER_BINARY_H
+
+/* This generated file contains includes for project dependencies */
+#include "world_ser_deser_binary/bake_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,96 @@
+#include <world_ser_deser_binary.h>
+#include <stdio.h>
+
+// This example serializes a world to both JSON and the binary format, and
+// compares how long it takes to save and load the data.
+
+typedef struct {
+    double x, y;
+} Position, Velocity;
+
+ECS_COMPONENT_DECLARE(Position);
+ECS_COMPONENT_DECLARE(Velocity);
+
+#define ENTITY_COUNT (100 * 1000)
+
+void MoveModuleImport(ecs_world_t *world) {
+    ECS_MODULE(world, MoveModule);
+
+    ECS_COMPONENT_DEFINE(world, Position);
+    ECS_COMPONENT_DEFINE(world, Velocity);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { .name = "x", .type = ecs_id(ecs_f64_t) },
+            { .name = "y", .type = ecs_id(ecs_f64_t) },
+        }
+    });
+
+    ecs_struct(world, {
+        .entity = ecs_id(Velocity),
+        .members = {
+            { .name = "x", .type = ecs_id(ecs_f64_t) },
+            { .name = "y", .type = ecs_id(ecs_f64_t) },
+        }
+    });
+}
+
+ecs_world_t* create_world(void) {
+    ecs_world_t *world = ecs_init(); {
+        ECS_IMPORT(world, MoveModule);
+    }
+    return world;
+}
+
+int main(int argc, char *argv[]) {
+    ecs_world_t *world = create_world();
+    (void)argc; (void)argv;
+
+    for (int i = 0; i < ENTITY_COUNT; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        ecs_set(world, e, Position, {i, i * 2});
+        ecs_set(world, e, Velocity, {1, 1});
+    }
+
+    ecs_time_t t = {0};
+
+    // Serialize to JSON
+    ecs_time_measure(&t);
+    char *json = ecs_world_to_json(world, NULL);
+    double json_save = ecs_time_measure(&t);
+
+    ecs_world_t *world_json = create_world();
+    ecs_time_measure(&t);
+    ecs_world_from_json(world_json, json, NULL);
+    double json_load = ecs_time_measure(&t);
+
+    // Serialize to binary
+    ecs_size_t size = 0;
+    ecs_time_measure(&t);
+    void *data = ecs_world_to_binary(world, NULL, &size);
+    double bin_save = ecs_time_measure(&t);
+
+    ecs_world_t *world_bin = create_world();
+    ecs_time_measure(&t);
+    ecs_world_from_binary(world_bin, data, size, NULL);
+    double bin_load = ecs_time_measure(&t);
+
+    printf("json:   %8d bytes, save %.4fs, load %.4fs\n",
+        ecs_os_strlen(json), json_save, json_load);
+    printf("binary: %8d bytes, save %.4fs, load %.4fs\n",
+        size, bin_save, bin_load);
+
+    // Output (times depend on the machine):
+    //   json:    ... bytes, save ...s, load ...s
+    //   binary:  ... bytes, save ...s, load ...s
+
+    ecs_os_free(json);
+    ecs_os_free(data);
+
+    ecs_fini(world);
+    ecs_fini(world_json);
+    ecs_fini(world_bin);
+
+    return 0;
+}
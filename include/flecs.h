@@ -70,7 +70,8 @@
 /** @def FLECS_ACCURATE_COUNTERS
  * Define to ensure that global counters used for statistics (such as the
  * allocation counters in the OS API) are accurate in multithreaded
- * applications, at the cost of increased overhead.
+ * applications, at the cost of increased overhead. Counters of a world are
+ * kept per stage, and are accurate without this define.
  */
 // #define FLECS_ACCURATE_COUNTERS
 
@@ -179,6 +180,7 @@
 #define FLECS_SNAPSHOT      /**< Snapshot & restore ECS data */
 #define FLECS_STATS         /**< Access runtime statistics */
 #define FLECS_MONITOR       /**< Track runtime statistics periodically */
+#define FLECS_TRACE         /**< Record timeline of frames and systems */
 #define FLECS_METRICS       /**< Expose component data as statistics */
 #define FLECS_ALERTS        /**< Monitor conditions for errors */
 #define FLECS_SYSTEM        /**< System support */
@@ -189,6 +191,7 @@
 #define FLECS_UNITS         /**< Builtin standard units */
 #define FLECS_EXPR          /**< Parsing strings to/from component values */
 #define FLECS_JSON          /**< Parsing JSON to/from component values */
+#define FLECS_BINARY        /**< Binary world serialization */
 #define FLECS_DOC           /**< Document entities & components */
 #define FLECS_LOG           /**< When enabled ECS provides more detailed logs */
 #define FLECS_APP           /**< Application addon */
@@ -255,6 +258,30 @@
  * as memory will be freed more often, at the cost of decreased performance. */
 // #define FLECS_USE_OS_ALLOC
 
+/** @def FLECS_PAGE_ALLOC_SIZE
+ * Blocks of the block allocator that are at least this size, such as the
+ * storage of large table columns, are allocated with ecs_os_page_alloc()
+ * instead of ecs_os_malloc(). This allocates them as separate, page aligned
+ * memory regions. */
+#ifndef FLECS_PAGE_ALLOC_SIZE
+#define FLECS_PAGE_ALLOC_SIZE (64 * 1024)
+#endif
+
+/** @def FLECS_HUGE_PAGE_ALLOC_SIZE
+ * Blocks that are at least this size request huge pages (EcsOsPageHuge), which
+ * reduces TLB misses when iterating large columns. */
+#ifndef FLECS_HUGE_PAGE_ALLOC_SIZE
+#define FLECS_HUGE_PAGE_ALLOC_SIZE (2 * 1024 * 1024)
+#endif
+
+/** @def FLECS_VM_ALLOC_SIZE
+ * When reserved storage is enabled (see ecs_set_reserved_storage()), blocks that
+ * are at least this size are stored in reserved virtual memory, so that they
+ * can grow without being copied. */
+#ifndef FLECS_VM_ALLOC_SIZE
+#define FLECS_VM_ALLOC_SIZE (1024 * 1024)
+#endif
+
 /** @def FLECS_ID_DESC_MAX
  * Maximum number of ids to add ecs_entity_desc_t / ecs_bulk_desc_t */
 #ifndef FLECS_ID_DESC_MAX
@@ -1287,6 +1314,31 @@ typedef struct ecs_world_info_t {
                                        * registering them as names. */
 } ecs_world_info_t;
 
+/** Parameters for memory compaction (see ecs_set_compaction()). */
+typedef struct ecs_compaction_desc_t {
+    /** Time in seconds compaction may spend at the end of each frame. Zero
+     * disables automatic compaction. */
+    double time_budget_seconds;
+
+    /** Free storage of a table after it was found empty by this many passes
+     * (0 = only when table is deleted). */
+    uint16_t clear_generation;
+
+    /** Delete a table after it was found empty by this many passes
+     * (0 = never). */
+    uint16_t delete_generation;
+} ecs_compaction_desc_t;
+
+/** Memory reclaimed by compaction (see ecs_get_compaction_stats()). */
+typedef struct ecs_compaction_stats_t {
+    int64_t column_bytes;   /**< Bytes released by shrinking table storage */
+    int64_t block_bytes;    /**< Bytes of allocator blocks returned to the OS */
+    int64_t stack_bytes;    /**< Bytes of stack allocator pages returned to the OS */
+    int32_t shrink_count;   /**< Number of times table storage was shrunk */
+    int32_t delete_count;   /**< Number of deleted empty tables */
+    int32_t pass_count;     /**< Number of completed compaction passes */
+} ecs_compaction_stats_t;
+
 /** Type that contains information about a query group. */
 typedef struct ecs_query_group_info_t {
     int32_t match_count;  /**< How often tables have been matched/unmatched */
@@ -1689,6 +1741,29 @@ ecs_world_t* ecs_init(void);
 FLECS_API
 ecs_world_t* ecs_mini(void);
 
+/** Create a new world that allocates from an arena.
+ * Same as ecs_init(), but the blocks of the world's internal allocators (used
+ * for tables, id records, hashmaps, component storage, ...) are taken from a
+ * single growable arena. Blocks are not freed individually when the world is
+ * deleted, the arena releases all of them at once.
+ *
+ * This reduces the cost of creating and deleting worlds, which is useful for
+ * applications that create many short-lived worlds. Memory freed to the arena
+ * is reused by the world, but is not returned to the OS before ecs_fini().
+ *
+ * @return A new world
+ */
+FLECS_API
+ecs_world_t* ecs_init_w_arena(void);
+
+/** Create a new world with just the core module that allocates from an arena.
+ * Same as ecs_init_w_arena(), but doesn't import modules from addons.
+ *
+ * @return A new tiny world
+ */
+FLECS_API
+ecs_world_t* ecs_mini_w_arena(void);
+
 /** Create a new world with arguments.
  * Same as ecs_init(), but allows passing in command line arguments. Command line
  * arguments are used to:
@@ -1835,6 +1910,24 @@ FLECS_API void ecs_measure_system_time(
     ecs_world_t *world,
     bool enable);
 
+/** Measure stage time.
+ * Stage time measurements measure for each stage (thread) the time spent in
+ * each system, the time spent waiting for other threads at sync points, and
+ * the time spent merging the commands of the stage.
+ * This makes it possible to find systems that take longer on some threads
+ * than on others, and threads that are stalled.
+ *
+ * Stage time measurements add more overhead than system time measurements, 
+ * and are intended for profiling. The measurements are available in the 
+ * pipeline statistics.
+ *
+ * @param world The world.
+ * @param enable Whether to enable or disable stage time measuring.
+ */
+FLECS_API void ecs_measure_stage_time(
+    ecs_world_t *world,
+    bool enable);
+
 /** Set target frames per second (FPS) for application.
  * Setting the target FPS ensures that ecs_progress() is not invoked faster than
  * the specified FPS. When enabled, ecs_progress() tracks the time passed since
@@ -2236,6 +2329,11 @@ void* ecs_get_binding_ctx(
 const ecs_build_info_t* ecs_get_build_info(void);
 
 /** Get world info.
+ * Counters that are updated by multiple threads, such as the number of systems
+ * ran and the number of commands processed, are kept per stage. These counters
+ * are added up when stages are merged and at the end of a frame. This operation
+ * does not modify the world, and returns the values of the last time the
+ * counters were added up.
  *
  * @param world The world.
  * @return Pointer to the world info. Valid for as long as the world exists.
@@ -2293,6 +2391,24 @@ bool ecs_enable_range_check(
     ecs_world_t *world,
     bool enable);
 
+/** Enable/disable interning of entity names, symbols and aliases.
+ * When enabled, identifiers with the same value share a single string that is
+ * owned by the world, which reduces memory usage for applications that create
+ * many entities with the same name in different scopes. Strings are reference
+ * counted, and are freed when no longer used by any identifier.
+ *
+ * Disabling interning does not affect identifiers that were already interned.
+ * The string of an interned identifier must not be modified in place.
+ *
+ * @param world The world.
+ * @param enable True if interning should be enabled, false to disable.
+ * @return The previous value.
+ */
+FLECS_API
+bool ecs_enable_name_interning(
+    ecs_world_t *world,
+    bool enable);
+
 /** Get the largest issued entity id (not counting generation).
  *
  * @param world The world.
@@ -2361,6 +2477,70 @@ int32_t ecs_delete_empty_tables(
     int32_t min_id_count,
     double time_budget_seconds);
 
+/** Enable automatic memory compaction.
+ * When enabled, the world runs an incremental compaction step at the end of
+ * each frame for at most the configured time budget. A compaction pass:
+ *  - shrinks table storage that uses less than half of its capacity
+ *  - frees storage of, or deletes, tables that stayed empty for a number of
+ *    passes (see ecs_delete_empty_tables())
+ *  - returns allocator blocks with only free chunks to the OS
+ *  - returns unused stack allocator pages to the OS
+ *
+ * A pass can span multiple frames. The next frame continues where the last
+ * step left off, so that eventually all tables and allocators are visited.
+ *
+ * @param world The world.
+ * @param desc Compaction parameters (NULL disables compaction).
+ */
+FLECS_API
+void ecs_set_compaction(
+    ecs_world_t *world,
+    const ecs_compaction_desc_t *desc);
+
+/** Run a compaction step.
+ * This runs a compaction step with the parameters set by ecs_set_compaction()
+ * and the provided time budget. If the time budget is zero, the operation
+ * completes the current pass. This operation may not be called while the world
+ * is in readonly mode.
+ *
+ * @param world The world.
+ * @param time_budget_seconds Amount of time operation is allowed to spend.
+ * @return True if the step completed a pass, false if not.
+ */
+FLECS_API
+bool ecs_compact(
+    ecs_world_t *world,
+    double time_budget_seconds);
+
+/** Get statistics on memory reclaimed by compaction.
+ *
+ * @param world The world.
+ * @return The compaction statistics.
+ */
+FLECS_API
+const ecs_compaction_stats_t* ecs_get_compaction_stats(
+    const ecs_world_t *world);
+
+/** Store large allocations in reserved virtual memory.
+ * When enabled, allocations of the world allocator that are at least
+ * FLECS_VM_ALLOC_SIZE, such as large table columns, reserve the provided
+ * amount of address space and only commit the memory that is used. Growing
+ * such an allocation commits more of its reservation, which does not copy the
+ * data and does not change its address.
+ *
+ * Allocations that do not fit in the reservation, and allocations that are
+ * shrunk (for example by ecs_compact()) are moved as usual. Changing the size
+ * only applies to new allocations.
+ *
+ * @param world The world.
+ * @param reserve_size Address space reserved per allocation (0 disables).
+ * @return False if the OS API doesn't support virtual memory, true otherwise.
+ */
+FLECS_API
+bool ecs_set_reserved_storage(
+    ecs_world_t *world,
+    ecs_size_t reserve_size);
+
 /** Get world from poly.
  *
  * @param poly A pointer to a poly object.
@@ -3625,6 +3805,36 @@ ecs_entity_t ecs_lookup_path_w_sep(
     const char *prefix,
     bool recursive);
 
+/** Lookup entities for multiple paths.
+ * Same as calling ecs_lookup_path_w_sep() for each path, but faster when paths
+ * share a parent. Scopes that are resolved for a path are cached for the 
+ * duration of the call, so that for paths like "level.room.chair" and 
+ * "level.room.table" the "level.room" scope is only looked up once.
+ *
+ * The result array must be large enough to store count entities. Paths that
+ * are not found, or that are NULL, are set to 0.
+ *
+ * @param world The world.
+ * @param parent The entity from which to resolve the paths.
+ * @param paths The paths to resolve.
+ * @param count The number of paths.
+ * @param sep The path separator.
+ * @param prefix The path prefix.
+ * @param recursive Recursively traverse up the tree until entity is found.
+ * @param entities Array that receives the entities.
+ * @return The number of paths that were found.
+ */
+FLECS_API
+int32_t ecs_bulk_lookup_path(
+    const ecs_world_t *world,
+    ecs_entity_t parent,
+    const char *const *paths,
+    int32_t count,
+    const char *sep,
+    const char *prefix,
+    bool recursive,
+    ecs_entity_t *entities);
+
 /** Lookup an entity by its symbol name.
  * This looks up an entity by symbol stored in (EcsIdentifier, EcsSymbol). The
  * operation does not take into account hierarchies.
@@ -0,0 +1,177 @@
+/**
+ * @file addons/binary.h
+ * @brief Binary world serializer addon.
+ *
+ * Serialize the contents of a world to a compact binary format, and load it
+ * back into a world. The format is generated from the reflection data of
+ * components (EcsMetaTypeSerialized), and stores data a table at a time.
+ * Components that don't contain strings, vectors or entity handles are
+ * written as a single block of memory per table.
+ *
+ * The format is intended for saving and loading worlds of the same
+ * application. Data is stored in the byte order and layout of the machine that
+ * wrote it, and component layouts are checked when loading. Components that
+ * have no reflection data or that contain opaque types are not serialized.
+ */
+
+#ifdef FLECS_BINARY
+
+#ifndef FLECS_META
+#define FLECS_META
+#endif
+
+#ifndef FLECS_BINARY_H
+#define FLECS_BINARY_H
+
+/**
+ * @defgroup c_addons_binary Binary
+ * @ingroup c_addons
+ * Functions for serializing worlds to/from a binary format.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Callback used to write serialized data to a stream.
+ *
+ * @param data The data to write.
+ * @param size The number of bytes to write.
+ * @param ctx User context.
+ * @return Zero if success, non-zero if failed.
+ */
+typedef int (*ecs_binary_write_action_t)(
+    const void *data,
+    ecs_size_t size,
+    void *ctx);
+
+/** Callback used to read serialized data from a stream.
+ *
+ * @param data The buffer to read into.
+ * @param size The maximum number of bytes to read.
+ * @param ctx User context.
+ * @return The number of bytes read, zero at the end of the stream, or -1 if
+ *         failed.
+ */
+typedef ecs_size_t (*ecs_binary_read_action_t)(
+    void *data,
+    ecs_size_t size,
+    void *ctx);
+
+/** Used with ecs_world_to_binary(). */
+typedef struct ecs_world_to_binary_desc_t {
+    bool serialize_builtin;    /**< Serialize builtin data */
+    bool serialize_modules;    /**< Serialize modules */
+} ecs_world_to_binary_desc_t;
+
+/** Used with ecs_world_from_binary(). */
+typedef struct ecs_from_binary_desc_t {
+    /** Fail when a component stored in the data does not exist in the world,
+     * or has a different layout. When not in strict mode, values for such
+     * components are ignored. */
+    bool strict;
+} ecs_from_binary_desc_t;
+
+/** Serialize world into binary buffer.
+ * This operation serializes the same entities as ecs_world_to_json().
+ *
+ * @param world The world to serialize.
+ * @param desc Serializer parameters (optional).
+ * @param size_out Out parameter for the size of the returned buffer.
+ * @return Buffer with serialized data (must be freed with ecs_os_free()), or
+ *         NULL if failed.
+ */
+FLECS_API
+void* ecs_world_to_binary(
+    ecs_world_t *world,
+    const ecs_world_to_binary_desc_t *desc,
+    ecs_size_t *size_out);
+
+/** Serialize world into stream.
+ * Same as ecs_world_to_binary(), but writes data to a stream. Data is written
+ * in chunks as the world is serialized.
+ *
+ * @param world The world to serialize.
+ * @param desc Serializer parameters (optional).
+ * @param write Callback that writes data to the stream.
+ * @param ctx User context passed to callback.
+ * @return Zero if success, non-zero if failed.
+ */
+FLECS_API
+int ecs_world_to_binary_stream(
+    ecs_world_t *world,
+    const ecs_world_to_binary_desc_t *desc,
+    ecs_binary_write_action_t write,
+    void *ctx);
+
+/** Serialize world into file descriptor.
+ *
+ * @param world The world to serialize.
+ * @param desc Serializer parameters (optional).
+ * @param fd File descriptor opened for writing.
+ * @return Zero if success, non-zero if failed.
+ */
+FLECS_API
+int ecs_world_to_binary_fd(
+    ecs_world_t *world,
+    const ecs_world_to_binary_desc_t *desc,
+    int fd);
+
+/** Deserialize binary data into world.
+ * Entities are resolved the same way as ecs_world_from_json(): named entities
+ * are looked up by path and created if they don't exist, anonymous entities
+ * are mapped to new or existing ids.
+ *
+ * @param world The world.
+ * @param data Buffer created by ecs_world_to_binary().
+ * @param size Size of the buffer.
+ * @param desc Deserializer parameters (optional).
+ * @return Zero if success, non-zero if failed.
+ */
+FLECS_API
+int ecs_world_from_binary(
+    ecs_world_t *world,
+    const void *data,
+    ecs_size_t size,
+    const ecs_from_binary_desc_t *desc);
+
+/** Deserialize binary data from stream into world.
+ * Same as ecs_world_from_binary(), but reads data from a stream.
+ *
+ * @param world The world.
+ * @param read Callback that reads data from the stream.
+ * @param ctx User context passed to callback.
+ * @param desc Deserializer parameters (optional).
+ * @return Zero if success, non-zero if failed.
+ */
+FLECS_API
+int ecs_world_from_binary_stream(
+    ecs_world_t *world,
+    ecs_binary_read_action_t read,
+    void *ctx,
+    const ecs_from_binary_desc_t *desc);
+
+/** Deserialize binary data from file descriptor into world.
+ *
+ * @param world The world.
+ * @param fd File descriptor opened for reading.
+ * @param desc Deserializer parameters (optional).
+ * @return Zero if success, non-zero if failed.
+ */
+FLECS_API
+int ecs_world_from_binary_fd(
+    ecs_world_t *world,
+    int fd,
+    const ecs_from_binary_desc_t *desc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+/** @} */
+
+#endif
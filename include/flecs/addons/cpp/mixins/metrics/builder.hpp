@@ -84,6 +84,26 @@ struct metric_builder {
         return kind(_::cpp_type<Kind>::id(m_world));
     }
 
+    /** Use buckets of equal width for histogram metric */
+    metric_builder& buckets(double min, double max, int32_t count = 0) {
+        m_desc.histogram.min = min;
+        m_desc.histogram.max = max;
+        m_desc.histogram.bucket_count = count;
+        m_desc.histogram.log = false;
+        return *this;
+    }
+
+    /** Use log buckets for histogram metric */
+    metric_builder& log_buckets(
+        double min, int32_t count = 0, int32_t sub_bucket_count = 0) 
+    {
+        m_desc.histogram.min = min;
+        m_desc.histogram.bucket_count = count;
+        m_desc.histogram.sub_bucket_count = sub_bucket_count;
+        m_desc.histogram.log = true;
+        return *this;
+    }
+
     metric_builder& brief(const char *b) {
         m_desc.brief = b;
         return *this;
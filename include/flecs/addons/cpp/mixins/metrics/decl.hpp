@@ -21,6 +21,7 @@ namespace flecs {
 struct metrics {
     using Value = EcsMetricValue;
     using Source = EcsMetricSource;
+    using HistogramValue = EcsMetricHistogram;
 
     struct Instance { };
     struct Metric { };
@@ -28,6 +29,7 @@ struct metrics {
     struct CounterIncrement { };
     struct CounterId { };
     struct Gauge { };
+    struct Histogram { };
 
     metrics(flecs::world& world);
 };
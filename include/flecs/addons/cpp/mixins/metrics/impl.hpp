@@ -15,6 +15,7 @@ inline metrics::metrics(flecs::world& world) {
 
     world.component<Value>();
     world.component<Source>();
+    world.component<HistogramValue>();
 
     world.entity<metrics::Instance>("::flecs::metrics::Instance");
     world.entity<metrics::Metric>("::flecs::metrics::Metric");
@@ -22,6 +23,7 @@ inline metrics::metrics(flecs::world& world) {
     world.entity<metrics::CounterId>("::flecs::metrics::Metric::CounterId");
     world.entity<metrics::CounterIncrement>("::flecs::metrics::Metric::CounterIncrement");
     world.entity<metrics::Gauge>("::flecs::metrics::Metric::Gauge");
+    world.entity<metrics::Histogram>("::flecs::metrics::Metric::Histogram");
 }
 
 inline metric_builder::~metric_builder() {
@@ -89,4 +89,14 @@ inline bool world::using_task_threads() const {
     return ecs_using_task_threads(m_world);
 }
 
+inline void world::set_worker_affinity(
+    const ecs_worker_affinity_t *affinity, int32_t count) const 
+{
+    ecs_set_worker_affinity(m_world, affinity, count);
+}
+
+inline void world::set_worker_table_affinity(bool enabled) const {
+    ecs_set_worker_table_affinity(m_world, enabled);
+}
+
 }
@@ -92,4 +92,14 @@ void set_task_threads(int32_t task_threads) const;
  */
 bool using_task_threads() const;
 
+/** Set placement of worker threads.
+ * @see ecs_set_worker_affinity
+ */
+void set_worker_affinity(const ecs_worker_affinity_t *affinity, int32_t count) const;
+
+/** Process each table on a single worker.
+ * @see ecs_set_worker_table_affinity
+ */
+void set_worker_table_affinity(bool enabled = true) const;
+
 /** @} */
@@ -94,10 +94,11 @@ typedef struct {
     const char* status;         /**< default = OK */
     const char* content_type;   /**< default = application/json */
     ecs_strbuf_t headers;       /**< default = "" */
+    bool chunked;               /**< set by ecs_http_reply_flush() */
 } ecs_http_reply_t;
 
 #define ECS_HTTP_REPLY_INIT \
-    (ecs_http_reply_t){200, ECS_STRBUF_INIT, "OK", "application/json", ECS_STRBUF_INIT}
+    (ecs_http_reply_t){200, ECS_STRBUF_INIT, "OK", "application/json", ECS_STRBUF_INIT, false}
 
 /* Global statistics. */
 extern int64_t ecs_http_request_received_count;
@@ -125,7 +126,7 @@ typedef struct {
     void *ctx;                        /**< Passed to callback (optional) */
     uint16_t port;                    /**< HTTP port */
     const char *ipaddr;               /**< Interface to listen on (optional) */
-    int32_t send_queue_wait_ms;       /**< Send queue wait time when empty */
+    int32_t send_queue_wait_ms;       /**< Max time I/O thread waits before sending queued replies (Windows only) */
     double cache_timeout;             /**< Cache invalidation timeout (0 disables caching) */
     double cache_purge_timeout;       /**< Cache purge timeout (for purging cache entries) */
 } ecs_http_server_desc_t;
@@ -160,8 +161,9 @@ int ecs_http_server_start(
     ecs_http_server_t* server);
 
 /** Process server requests.
- * This operation invokes the reply callback for each received request. No new
- * requests will be enqueued while processing requests.
+ * This operation invokes the reply callback for each request that was received
+ * before the operation was called. Requests that are received while replies
+ * are flushed (see ecs_http_reply_flush()) are processed by the next call.
  *
  * @param server The server for which to process requests.
  */
@@ -170,6 +172,23 @@ void ecs_http_server_dequeue(
     ecs_http_server_t* server,
     ecs_ftime_t delta_time);
 
+/** Process server requests that use the specified method.
+ * Same as ecs_http_server_dequeue(), except that no requests are processed
+ * if one of the queued requests uses a different method. This allows an
+ * application to process requests that only read data on another thread, and
+ * leave the other requests to the thread that owns the data.
+ *
+ * @param server The server for which to process requests.
+ * @param delta_time Time passed since the last call.
+ * @param method The method of requests to process.
+ * @return True if requests with a different method are queued.
+ */
+FLECS_API
+bool ecs_http_server_dequeue_method(
+    ecs_http_server_t* server,
+    ecs_ftime_t delta_time,
+    ecs_http_method_t method);
+
 /** Stop server.
  * After this operation no new requests can be received.
  *
@@ -204,6 +223,107 @@ int ecs_http_server_request(
     const char *req,
     ecs_http_reply_t *reply_out);
 
+/** Send the contents of the reply body to the client.
+ * This function can be called by a request handler to send a large reply
+ * while it is being created. The first call sends the reply headers with 
+ * chunked transfer encoding, after which each call sends the current contents
+ * of the reply body as a chunk and clears the body. The code, status, content
+ * type and headers of the reply can no longer be changed after the first call.
+ *
+ * When the handler returns, what is left in the body is sent as the last 
+ * chunk. If the handler sets an error code (>= 400) after the first call, the
+ * reply is not terminated so that the client can detect it is incomplete.
+ *
+ * For requests that are not received on a connection, such as requests made
+ * with ecs_http_server_request(), this function does nothing and the body is
+ * returned in its entirety.
+ *
+ * Chunked replies are not cached.
+ *
+ * @param req The request.
+ * @param reply The reply.
+ * @return Zero if success, non-zero if sending failed.
+ */
+FLECS_API
+int ecs_http_reply_flush(
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply);
+
+/** Keep reply open to push data to the client.
+ * This function can be called by a request handler to turn the reply into a
+ * stream of server-sent events (content type text/event-stream). The current
+ * contents of the reply body are sent, after which the reply stays open when
+ * the handler returns. Data is pushed to the client with
+ * ecs_http_stream_send(), until the stream is closed with
+ * ecs_http_stream_close(). No more requests are read from the connection.
+ *
+ * Streams must be closed by the application, also when the client went away,
+ * which is reported by ecs_http_stream_send().
+ *
+ * For requests that are not received on a connection, such as requests made
+ * with ecs_http_server_request(), this function returns 0 and the body is
+ * returned as a regular reply.
+ *
+ * @param req The request.
+ * @param reply The reply.
+ * @return Handle to the stream, or 0 if the reply could not be streamed.
+ */
+FLECS_API
+uint64_t ecs_http_reply_stream(
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply);
+
+/** Push data to the client of a stream.
+ * Data is queued as a chunk of the reply, and sent by the server thread. This
+ * function must not be called from a request handler, as the server is locked
+ * while handlers run.
+ *
+ * If the client doesn't keep up with the data, it is not queued and the
+ * function returns 1, so that the application can send it again later.
+ *
+ * @param srv The server.
+ * @param stream The stream returned by ecs_http_reply_stream().
+ * @param data The data to send.
+ * @param length The number of bytes to send.
+ * @return Zero if success, 1 if the data was not sent because the client is
+ *         busy, -1 if the client is no longer connected.
+ */
+FLECS_API
+int ecs_http_stream_send(
+    ecs_http_server_t *srv,
+    uint64_t stream,
+    const char *data,
+    ecs_size_t length);
+
+/** Close stream.
+ * This terminates the reply and closes the connection after the remaining
+ * data has been sent.
+ *
+ * @param srv The server.
+ * @param stream The stream returned by ecs_http_reply_stream().
+ */
+FLECS_API
+void ecs_http_stream_close(
+    ecs_http_server_t *srv,
+    uint64_t stream);
+
+/** Invalidate cached replies for path.
+ * This removes the cached replies to GET requests for the specified path, so
+ * that the next request for the path is handled again. Cached replies for all
+ * parameters of the path are removed. The path has the same format as the
+ * path member of ecs_http_request_t, and does not start with a '/'.
+ *
+ * This function must be called from a request handler, as the server is locked
+ * while handlers run, or while the server is not running.
+ *
+ * @param srv The server.
+ * @param path The path of the replies to invalidate.
+ */
+FLECS_API
+void ecs_http_server_invalidate(
+    ecs_http_server_t *srv,
+    const char *path);
+
 /** Get context provided in ecs_http_server_desc_t */
 FLECS_API
 void* ecs_http_server_ctx(
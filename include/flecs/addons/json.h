@@ -348,6 +348,47 @@ int ecs_iter_to_json_buf(
     ecs_strbuf_t *buf_out,
     const ecs_iter_to_json_desc_t *desc);
 
+/** Minimum number of bytes passed to the callback of ecs_iter_to_json_stream().
+ * Only the last chunk of a stream can be smaller. */
+#define ECS_JSON_STREAM_CHUNK_SIZE (64 * 1024)
+
+/** Callback used to write JSON to a stream.
+ *
+ * @param data The JSON data to write (not zero terminated).
+ * @param size The number of bytes to write.
+ * @param ctx User context.
+ * @return Zero if success, non-zero if failed.
+ */
+typedef int (*ecs_json_write_action_t)(
+    const char *data,
+    ecs_size_t size,
+    void *ctx);
+
+/** Serialize iterator into JSON stream.
+ * Same as ecs_iter_to_json(), but writes the JSON to a callback while the
+ * iterator is serialized, instead of building the entire string in memory. 
+ * Data is buffered until it exceeds ECS_JSON_STREAM_CHUNK_SIZE, after which
+ * it is passed to the callback and the buffer is reused. Buffered data is
+ * flushed between results and between the component columns of a result.
+ *
+ * If the callback returns an error, serialization stops and the iterator is
+ * cleaned up.
+ *
+ * @param world The world.
+ * @param iter The iterator to serialize.
+ * @param desc Serializer parameters (optional).
+ * @param write Callback that receives the JSON data.
+ * @param ctx User context passed to callback.
+ * @return Zero if success, non-zero if failed.
+ */
+FLECS_API
+int ecs_iter_to_json_stream(
+    const ecs_world_t *world,
+    ecs_iter_t *iter,
+    const ecs_iter_to_json_desc_t *desc,
+    ecs_json_write_action_t write,
+    void *ctx);
+
 /** Used with ecs_iter_to_json(). */
 typedef struct ecs_world_to_json_desc_t {
     bool serialize_builtin;    /**< Exclude flecs modules & contents */
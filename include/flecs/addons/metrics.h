@@ -52,6 +52,9 @@ FLECS_API extern ECS_TAG_DECLARE(EcsCounterId);
 /** Metric that represents current value */
 FLECS_API extern ECS_TAG_DECLARE(EcsGauge);
 
+/** Metric that represents the distribution of a member across entities */
+FLECS_API extern ECS_TAG_DECLARE(EcsHistogram);
+
 /** Tag added to metric instances */
 FLECS_API extern ECS_TAG_DECLARE(EcsMetricInstance);
 
@@ -61,6 +64,18 @@ FLECS_API extern ECS_COMPONENT_DECLARE(EcsMetricValue);
 /** Component with entity source of metric instance */
 FLECS_API extern ECS_COMPONENT_DECLARE(EcsMetricSource);
 
+/** Component with buckets and percentiles of histogram metric */
+FLECS_API extern ECS_COMPONENT_DECLARE(EcsMetricHistogram);
+
+/** Maximum number of buckets of a histogram metric */
+#define ECS_METRIC_HISTOGRAM_BUCKET_COUNT_MAX (64)
+
+/** Default number of buckets of a histogram metric */
+#define ECS_METRIC_HISTOGRAM_BUCKET_COUNT_DEFAULT (16)
+
+/** Default number of buckets per power of 2 of a log histogram metric */
+#define ECS_METRIC_HISTOGRAM_SUB_BUCKET_COUNT_DEFAULT (4)
+
 typedef struct EcsMetricValue {
     double value;
 } EcsMetricValue;
@@ -69,6 +84,50 @@ typedef struct EcsMetricSource {
     ecs_entity_t entity;
 } EcsMetricSource;
 
+/** Histogram of member values, recomputed each frame. Counts are stored as
+ * doubles so that all values can be read in the same way as EcsMetricValue. */
+typedef struct EcsMetricHistogram {
+    double count;           /**< Number of samples */
+    double sum;             /**< Sum of samples */
+    double min;             /**< Smallest sample */
+    double max;             /**< Largest sample */
+    double p50;             /**< 50th percentile (median) */
+    double p90;             /**< 90th percentile */
+    double p99;             /**< 99th percentile */
+    int32_t bucket_count;   /**< Number of buckets */
+
+    /** Upper bound of each bucket. Samples that are outside of the range of
+     * the buckets are counted in the first or last bucket. */
+    double bounds[ECS_METRIC_HISTOGRAM_BUCKET_COUNT_MAX];
+
+    /** Number of samples in each bucket */
+    double buckets[ECS_METRIC_HISTOGRAM_BUCKET_COUNT_MAX];
+} EcsMetricHistogram;
+
+/** Bucket layout of histogram metric, used with ecs_metric_desc_t. */
+typedef struct ecs_metric_histogram_desc_t {
+    /** Lower bound of first bucket */
+    double min;
+
+    /** Upper bound of last bucket. Only used for linear buckets. */
+    double max;
+
+    /** Number of buckets (default = ECS_METRIC_HISTOGRAM_BUCKET_COUNT_DEFAULT,
+     * max = ECS_METRIC_HISTOGRAM_BUCKET_COUNT_MAX) */
+    int32_t bucket_count;
+
+    /** Use log buckets instead of buckets of equal width. Log buckets are laid
+     * out like an HDR histogram: each power of 2 starting from min (rounded
+     * down to a power of 2) is divided in sub_bucket_count buckets of equal
+     * width, which keeps the relative error of percentiles constant. Min must
+     * be larger than 0. */
+    bool log;
+
+    /** Number of buckets per power of 2 for log buckets. Must be a power of 2
+     * (default = ECS_METRIC_HISTOGRAM_SUB_BUCKET_COUNT_DEFAULT) */
+    int32_t sub_bucket_count;
+} ecs_metric_histogram_desc_t;
+
 typedef struct ecs_metric_desc_t {
     int32_t _canary;
 
@@ -94,9 +153,13 @@ typedef struct ecs_metric_desc_t {
      * will create a metric per target. */
     bool targets;
 
-    /** Must be EcsGauge, EcsCounter, EcsCounterIncrement or EcsCounterId */
+    /** Must be EcsGauge, EcsCounter, EcsCounterIncrement, EcsCounterId or
+     * EcsHistogram */
     ecs_entity_t kind;
 
+    /** Buckets of histogram. Only used for EcsHistogram */
+    ecs_metric_histogram_desc_t histogram;
+
     /** Description of metric. Will only be set if FLECS_DOC addon is enabled */
     const char *brief;
 } ecs_metric_desc_t;
@@ -136,6 +199,14 @@ typedef struct ecs_metric_desc_t {
  *   (component) id. This kind creates a single metric instance for regular ids,
  *   and a metric instance per target for wildcard ids when targets is set.
  *
+ * A histogram metric (EcsHistogram) tracks the distribution of a member across
+ * all entities with the member, for example the path cost of each entity. It
+ * does not create metric instances. Instead the metric entity gets an
+ * EcsMetricHistogram component with the bucket counts and the p50, p90 and p99
+ * percentiles, which are recomputed each frame. The buckets are filled for
+ * each table at once. Percentiles are interpolated within a bucket, so their
+ * precision depends on the bucket layout.
+ *
  * @param world The world.
  * @param desc Metric description.
  * @return The metric entity.
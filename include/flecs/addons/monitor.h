@@ -45,6 +45,7 @@ FLECS_API extern ecs_entity_t EcsPeriod1w;
 typedef struct {
     ecs_ftime_t elapsed;
     int32_t reduce_count;
+    int64_t sample_count;       /**< Total number of samples added */
 } EcsStatsHeader;
 
 typedef struct {
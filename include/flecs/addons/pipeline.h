@@ -209,6 +209,50 @@ FLECS_API
 bool ecs_using_task_threads(
     ecs_world_t *world);
 
+/** Placement of a worker thread, used with ecs_set_worker_affinity(). */
+typedef struct ecs_worker_affinity_t {
+    int32_t cpu;       /**< CPU to run worker on (-1 = any) */
+    int32_t numa_node; /**< NUMA node to run worker on if cpu is -1 (-1 = any) */
+} ecs_worker_affinity_t;
+
+/** Set placement of worker threads.
+ * Pins worker threads to CPUs or NUMA nodes, which prevents the OS from 
+ * migrating workers away from the caches and memory of the data they process.
+ * The worker of stage N uses element (N - 1) % count of the affinity array.
+ * The main thread (stage 0) is not pinned.
+ *
+ * Workers are pinned when their thread starts, so threads that are running are
+ * restarted. Threads created with ecs_set_task_threads() are not pinned, as
+ * they are owned by the task system.
+ *
+ * Pinning requires the thread_set_affinity_ function of the OS API. Combine 
+ * with ecs_set_worker_table_affinity() to keep each table on the same worker.
+ *
+ * @param world The world.
+ * @param affinity Array with placement of workers.
+ * @param count Number of elements in the array (0 = don't pin new threads).
+ */
+FLECS_API
+void ecs_set_worker_affinity(
+    ecs_world_t *world,
+    const ecs_worker_affinity_t *affinity,
+    int32_t count);
+
+/** Process each table on a single worker.
+ * By default the rows of each table are split across workers. When table
+ * affinity is enabled, worker iterators assign each table to one worker based 
+ * on the table id, so that a table is processed by the same worker each frame.
+ * This improves cache and NUMA locality for worlds with many tables, at the 
+ * cost of an uneven distribution when a few tables contain most entities.
+ *
+ * @param world The world.
+ * @param enabled Whether to enable table affinity.
+ */
+FLECS_API
+void ecs_set_worker_table_affinity(
+    ecs_world_t *world,
+    bool enabled);
+
 ////////////////////////////////////////////////////////////////////////////////
 //// Module
 ////////////////////////////////////////////////////////////////////////////////
@@ -50,9 +50,28 @@ extern "C" {
 /** Component that instantiates the REST API */
 FLECS_API extern const ecs_entity_t ecs_id(EcsRest);
 
+/** Determines which thread handles REST requests. */
+typedef enum ecs_rest_thread_mode_t {
+    /** Requests are handled on the main thread by the DequeueRest system. Time
+     * spent on handling requests is added to the frame time. */
+    EcsRestMainThread,
+
+    /** GET requests are handled on a REST thread while the world is idle
+     * between frames. Requests see the world as it was at the end of a frame.
+     * A new frame waits for a request that is still being handled. Requests
+     * that modify the world (PUT, DELETE) are handled on the main thread in
+     * the next frame. 
+     * The application must not modify the world outside of ecs_progress() in
+     * this mode. If the REST thread has not been able to handle requests for
+     * more than a second because there is no time between frames, requests are
+     * handled on the main thread. */
+    EcsRestBetweenFrames
+} ecs_rest_thread_mode_t;
+
 typedef struct {
     uint16_t port;      /**< Port of server (optional, default = 27750) */
     char *ipaddr;       /**< Interface address (optional, default = 0.0.0.0) */
+    ecs_rest_thread_mode_t thread_mode; /**< Thread that handles requests (optional, default = EcsRestMainThread) */
     void *impl;
 } EcsRest;
 
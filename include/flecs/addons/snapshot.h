@@ -40,6 +40,30 @@ FLECS_API
 ecs_snapshot_t* ecs_snapshot_take(
     ecs_world_t *world);
 
+/** Create a delta snapshot.
+ * A delta snapshot only stores the table data that changed since the base
+ * snapshot was taken, and uses the base snapshot for everything else. This
+ * makes taking a delta snapshot cheap for worlds in which only a small part of
+ * the data changes between snapshots.
+ *
+ * Changes are detected with table change detection, which means that writes
+ * to components must be signalled with ecs_modified() (or happen through 
+ * ecs_set(), or through [out] fields of queries). Writes to pointers returned 
+ * by ecs_get_mut() that are not followed by ecs_modified() are not detected.
+ *
+ * The base snapshot must be a snapshot created by ecs_snapshot_take(). It must
+ * not be restored or freed before the delta snapshot is freed. A delta snapshot
+ * can be restored with ecs_snapshot_restore() or ecs_snapshot_rollback().
+ *
+ * @param world The world to snapshot.
+ * @param base The base snapshot.
+ * @return The delta snapshot.
+ */
+FLECS_API
+ecs_snapshot_t* ecs_snapshot_take_delta(
+    ecs_world_t *world,
+    const ecs_snapshot_t *base);
+
 /** Create a filtered snapshot.
  * This operation is the same as ecs_snapshot_take(), but accepts an iterator so
  * an application can control what is stored by the snapshot.
@@ -70,6 +94,25 @@ void ecs_snapshot_restore(
     ecs_world_t *world,
     ecs_snapshot_t *snapshot);
 
+/** Roll back the world to a snapshot.
+ * Same as ecs_snapshot_restore(), but does not consume the snapshot. The
+ * world receives a copy of the snapshot data, which means that the same
+ * snapshot can be used to roll back the world multiple times. This is useful
+ * for speculative simulation, where many branches are simulated from the same
+ * starting state. Snapshot data is copied into the existing storage of the
+ * world tables, so a rollback does not allocate new storage for tables that
+ * still exist.
+ *
+ * The snapshot must still be freed with ecs_snapshot_free().
+ *
+ * @param world The world to roll back.
+ * @param snapshot The snapshot to roll back to.
+ */
+FLECS_API
+void ecs_snapshot_rollback(
+    ecs_world_t *world,
+    ecs_snapshot_t *snapshot);
+
 /** Obtain iterator to snapshot data.
  *
  * @param snapshot The snapshot to iterate over.
@@ -174,6 +174,11 @@ typedef struct ecs_system_stats_t {
     bool task;                     /**< Is system a task */
 
     ecs_query_stats_t query;
+
+    /** Time spent processing a system for each stage (element type is 
+     * ecs_metric_t). Only populated by ecs_pipeline_stats_get() when stage 
+     * time is measured (see ecs_measure_stage_time()). */
+    ecs_vec_t stage_time_spent;
 } ecs_system_stats_t;
 
 /** Statistics for sync point */
@@ -188,6 +193,15 @@ typedef struct ecs_sync_stats_t {
     bool no_readonly;
 } ecs_sync_stats_t;
 
+/** Statistics for stage (thread) that runs systems */
+typedef struct ecs_stage_stats_t {
+    int64_t first_;
+    ecs_metric_t time_spent;       /**< Time spent processing systems */
+    ecs_metric_t wait_time;        /**< Time spent waiting for other threads at sync points */
+    ecs_metric_t merge_time;       /**< Time spent merging commands of stage */
+    int64_t last_;
+} ecs_stage_stats_t;
+
 /** Statistics for all systems in a pipeline. */
 typedef struct ecs_pipeline_stats_t {
     /* Allow for initializing struct with {0} */
@@ -210,8 +224,57 @@ typedef struct ecs_pipeline_stats_t {
     int32_t system_count;        /**< Number of systems in pipeline */
     int32_t active_system_count; /**< Number of active systems in pipeline */
     int32_t rebuild_count;       /**< Number of times pipeline has rebuilt */
+
+    /** Vector with stage stats, one for each stage. Only populated when stage
+     * time is measured (see ecs_measure_stage_time()). */
+    ecs_vec_t stages;
 } ecs_pipeline_stats_t;
 
+/** Number of bytes used and allocated by a part of a world. Memory that is
+ * allocated but not used is reserved for future use (e.g. vector capacity). */
+typedef struct ecs_memory_t {
+    int64_t used;                  /**< Bytes that store live data */
+    int64_t allocated;             /**< Bytes allocated, including used bytes */
+} ecs_memory_t;
+
+/** Memory used by the subsystems of a world (use ecs_world_memory_get()) */
+typedef struct ecs_world_memory_t {
+    ecs_memory_t entity_index;     /**< Entity records and alive list */
+    ecs_memory_t id_index;         /**< Id records and their table caches */
+    ecs_memory_t tables;           /**< Table metadata (type, records, edges) */
+    ecs_memory_t table_data;       /**< Entity ids and component columns */
+    ecs_memory_t queries;          /**< Cached queries */
+    ecs_memory_t observers;        /**< Observers */
+    ecs_memory_t name_index;       /**< Name, symbol and alias lookup indices */
+    ecs_memory_t stages;           /**< Command queues and temporary storage */
+
+    /** Memory of the world allocator. This is not a separate subsystem, but a
+     * different view on memory that is also attributed to the above fields. */
+    ecs_memory_t allocator;
+} ecs_world_memory_t;
+
+/** Memory used by a table (use ecs_table_memory_get()) */
+typedef struct ecs_table_memory_t {
+    ecs_memory_t metadata;         /**< Type, records, column map and edges */
+    ecs_memory_t entities;         /**< Entity id array */
+    ecs_memory_t columns;          /**< Component, toggle and union columns */
+} ecs_table_memory_t;
+
+/** Memory attributed to a component or pair (use ecs_id_memory_get()) */
+typedef struct ecs_id_memory_t {
+    ecs_memory_t columns;          /**< Columns that store the component */
+    ecs_memory_t index;            /**< Id record and table cache */
+    int32_t table_count;           /**< Number of tables with the id */
+} ecs_id_memory_t;
+
+/** Memory of a single size class of an allocator. */
+typedef struct ecs_size_class_memory_t {
+    ecs_size_t size;               /**< Size of the chunks in the size class */
+    int32_t chunk_count;           /**< Number of chunks in use */
+    int32_t block_count;           /**< Number of blocks allocated */
+    ecs_memory_t memory;           /**< Bytes in used chunks, bytes in blocks */
+} ecs_size_class_memory_t;
+
 /** Get world statistics.
  *
  * @param world The world.
@@ -383,6 +446,84 @@ void ecs_pipeline_stats_copy_last(
 
 #endif
 
+/** Get memory used by a world.
+ * The operation walks the storage of the world, and attributes the memory of
+ * each data structure to one of the fields in ecs_world_memory_t. Its cost is
+ * linear in the number of entities, tables, ids and queries, and it is meant
+ * for diagnostics, not for calling every frame.
+ *
+ * Sizes are computed from the data structures that store the data, and do not
+ * include padding added by allocators.
+ *
+ * @param world The world.
+ * @param memory Out parameter for memory.
+ */
+FLECS_API
+void ecs_world_memory_get(
+    const ecs_world_t *world,
+    ecs_world_memory_t *memory);
+
+/** Get memory used by a table.
+ *
+ * @param world The world.
+ * @param table The table.
+ * @param memory Out parameter for memory.
+ */
+FLECS_API
+void ecs_table_memory_get(
+    const ecs_world_t *world,
+    const ecs_table_t *table,
+    ecs_table_memory_t *memory);
+
+/** Get memory attributed to a component, tag or pair.
+ * The columns field contains the memory of the columns that store the id across
+ * all tables, including empty tables that still have allocated storage. For
+ * wildcard ids the memory of all matching ids is returned.
+ *
+ * @param world The world.
+ * @param id The id.
+ * @param memory Out parameter for memory.
+ */
+FLECS_API
+void ecs_id_memory_get(
+    const ecs_world_t *world,
+    ecs_id_t id,
+    ecs_id_memory_t *memory);
+
+/** Get memory used by the cache of a query.
+ *
+ * @param query The query.
+ * @return The memory used by the query.
+ */
+FLECS_API
+ecs_memory_t ecs_query_memory_get(
+    const ecs_query_t *query);
+
+/** Get memory used by an observer.
+ *
+ * @param observer The observer.
+ * @return The memory used by the observer.
+ */
+FLECS_API
+ecs_memory_t ecs_observer_memory_get(
+    const ecs_observer_t *observer);
+
+/** Get memory of the size classes of the world allocator.
+ * The world allocator provides the storage for component columns, vectors and
+ * maps. The operation writes up to count size classes to the classes array,
+ * ordered by chunk size, and returns the total number of size classes.
+ *
+ * @param world The world.
+ * @param classes Array to write size classes to (may be NULL if count is 0).
+ * @param count Number of elements in the classes array.
+ * @return Number of size classes of the world allocator.
+ */
+FLECS_API
+int32_t ecs_allocator_memory_get(
+    const ecs_world_t *world,
+    ecs_size_class_memory_t *classes,
+    int32_t count);
+
 /** Reduce all measurements from a window into a single measurement. */
 FLECS_API
 void ecs_metric_reduce(
@@ -0,0 +1,98 @@
+/**
+ * @file addons/trace.h
+ * @brief Trace addon.
+ *
+ * The trace addon records a timeline of frames, systems, merges, observers and
+ * table creation. Each stage (thread) records events in its own ring buffer,
+ * which keeps the most recent events. The timeline can be exported in the
+ * Chrome Trace Event format, which can be opened with chrome://tracing or
+ * https://ui.perfetto.dev.
+ *
+ * When tracing is not started the addon only adds a check on a world flag to
+ * the code that it traces.
+ */
+
+#ifdef FLECS_TRACE
+
+/**
+ * @defgroup c_addons_trace Trace
+ * @ingroup c_addons
+ * Record a timeline of frames, systems, merges and observers.
+ *
+ * @{
+ */
+
+#ifndef FLECS_TRACE_H
+#define FLECS_TRACE_H
+
+/** Default number of events kept for each stage */
+#define ECS_TRACE_DEFAULT_CAPACITY (64 * 1024)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Start recording trace events.
+ * This discards events from a previous trace. Each stage keeps the last
+ * capacity events, which is rounded up to a power of 2. Events of stages that
+ * are deleted (for example by ecs_set_threads()) are discarded.
+ *
+ * This operation must be called while the world is not in readonly mode.
+ *
+ * @param world The world.
+ * @param capacity The number of events kept per stage (0 = default).
+ */
+FLECS_API
+void ecs_trace_start(
+    ecs_world_t *world,
+    int32_t capacity);
+
+/** Stop recording trace events.
+ * Events that were recorded are kept until the next call to ecs_trace_start(),
+ * so that they can still be exported.
+ *
+ * @param world The world.
+ */
+FLECS_API
+void ecs_trace_stop(
+    ecs_world_t *world);
+
+/** Test if trace events are recorded.
+ *
+ * @param world The world.
+ * @return True if recording, false if not.
+ */
+FLECS_API
+bool ecs_trace_is_recording(
+    const ecs_world_t *world);
+
+/** Serialize recorded events to Chrome Trace Event JSON.
+ * This operation must be called while the world is not in readonly mode.
+ *
+ * @param world The world.
+ * @return JSON string with the trace events, or NULL if failed.
+ */
+FLECS_API
+char* ecs_trace_to_json(
+    const ecs_world_t *world);
+
+/** Same as ecs_trace_to_json(), but serializes to an ecs_strbuf_t instance.
+ *
+ * @param world The world.
+ * @param buf_out The strbuf to append the string to.
+ * @return Zero if success, non-zero if failed.
+ */
+FLECS_API
+int ecs_trace_to_json_buf(
+    const ecs_world_t *world,
+    ecs_strbuf_t *buf_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FLECS_TRACE_H
+
+/** @} */
+
+#endif // FLECS_TRACE
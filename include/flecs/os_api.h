@@ -87,6 +87,42 @@ typedef
 void* (*ecs_os_api_calloc_t)(
     ecs_size_t size);
 
+typedef
+void* (*ecs_os_api_aligned_alloc_t)(
+    ecs_size_t size,
+    ecs_size_t alignment);
+
+typedef
+void (*ecs_os_api_aligned_free_t)(
+    void *ptr);
+
+/* Memory pages */
+typedef
+void* (*ecs_os_api_page_alloc_t)(
+    ecs_size_t size,
+    int32_t numa_node,
+    ecs_flags32_t flags);
+
+typedef
+void (*ecs_os_api_page_free_t)(
+    void *ptr,
+    ecs_size_t size);
+
+/* Virtual memory */
+typedef
+void* (*ecs_os_api_vm_reserve_t)(
+    ecs_size_t size);
+
+typedef
+int (*ecs_os_api_vm_commit_t)(
+    void *ptr,
+    ecs_size_t size);
+
+typedef
+void (*ecs_os_api_vm_release_t)(
+    void *ptr,
+    ecs_size_t size);
+
 typedef
 char* (*ecs_os_api_strdup_t)(
     const char *str);
@@ -108,6 +144,11 @@ void* (*ecs_os_api_thread_join_t)(
 typedef
 ecs_os_thread_id_t (*ecs_os_api_thread_self_t)(void);
 
+typedef
+int (*ecs_os_api_thread_set_affinity_t)(
+    int32_t cpu,
+    int32_t numa_node);
+
 /* Tasks */
 typedef
 ecs_os_thread_t (*ecs_os_api_task_new_t)(
@@ -226,6 +267,20 @@ typedef struct ecs_os_api_t {
     ecs_os_api_realloc_t realloc_;
     ecs_os_api_calloc_t calloc_;
     ecs_os_api_free_t free_;
+    ecs_os_api_aligned_alloc_t aligned_alloc_;
+    ecs_os_api_aligned_free_t aligned_free_;
+
+    /* Memory pages. Used for large allocations, which can request huge pages
+     * (EcsOsPageHuge) or memory on a NUMA node (-1 for no preference). */
+    ecs_os_api_page_alloc_t page_alloc_;
+    ecs_os_api_page_free_t page_free_;
+
+    /* Virtual memory. Reserves address space without backing memory, which is
+     * made accessible with commit. Commit is called with the size of the
+     * accessible range starting at the reserved address. Returns 0 if ok. */
+    ecs_os_api_vm_reserve_t vm_reserve_;
+    ecs_os_api_vm_commit_t vm_commit_;
+    ecs_os_api_vm_release_t vm_release_;
 
     /* Strings */
     ecs_os_api_strdup_t strdup_;
@@ -235,6 +290,10 @@ typedef struct ecs_os_api_t {
     ecs_os_api_thread_join_t thread_join_;
     ecs_os_api_thread_self_t thread_self_;
 
+    /* Pin the calling thread to a CPU, or to the CPUs of a NUMA node if cpu is
+     * -1. Returns zero if successful. */
+    ecs_os_api_thread_set_affinity_t thread_set_affinity_;
+
     /* Tasks */
     ecs_os_api_thread_new_t task_new_;
     ecs_os_api_thread_join_t task_join_;
@@ -338,6 +397,27 @@ void ecs_os_set_api_defaults(void);
 #ifndef ecs_os_calloc
 #define ecs_os_calloc(size) ecs_os_api.calloc_(size)
 #endif
+#ifndef ecs_os_aligned_alloc
+#define ecs_os_aligned_alloc(size, alignment) ecs_os_api.aligned_alloc_(size, alignment)
+#endif
+#ifndef ecs_os_aligned_free
+#define ecs_os_aligned_free(ptr) ecs_os_api.aligned_free_(ptr)
+#endif
+#ifndef ecs_os_page_alloc
+#define ecs_os_page_alloc(size, numa_node, flags) ecs_os_api.page_alloc_(size, numa_node, flags)
+#endif
+#ifndef ecs_os_page_free
+#define ecs_os_page_free(ptr, size) ecs_os_api.page_free_(ptr, size)
+#endif
+#ifndef ecs_os_vm_reserve
+#define ecs_os_vm_reserve(size) ecs_os_api.vm_reserve_(size)
+#endif
+#ifndef ecs_os_vm_commit
+#define ecs_os_vm_commit(ptr, size) ecs_os_api.vm_commit_(ptr, size)
+#endif
+#ifndef ecs_os_vm_release
+#define ecs_os_vm_release(ptr, size) ecs_os_api.vm_release_(ptr, size)
+#endif
 #if defined(ECS_TARGET_WINDOWS)
 #define ecs_os_alloca(size) _alloca((size_t)(size))
 #else
@@ -429,6 +509,7 @@ void ecs_os_set_api_defaults(void);
 #define ecs_os_thread_new(callback, param) ecs_os_api.thread_new_(callback, param)
 #define ecs_os_thread_join(thread) ecs_os_api.thread_join_(thread)
 #define ecs_os_thread_self() ecs_os_api.thread_self_()
+#define ecs_os_thread_set_affinity(cpu, numa_node) ecs_os_api.thread_set_affinity_(cpu, numa_node)
 
 /* Tasks */
 #define ecs_os_task_new(callback, param) ecs_os_api.task_new_(callback, param)
@@ -544,6 +625,10 @@ void* ecs_os_memdup(
 FLECS_API
 bool ecs_os_has_heap(void);
 
+/** Are virtual memory functions available? */
+FLECS_API
+bool ecs_os_has_vm(void);
+
 /** Are threading functions available? */
 FLECS_API
 bool ecs_os_has_threading(void);
@@ -33,6 +33,9 @@
 #ifdef FLECS_NO_STATS
 #undef FLECS_STATS
 #endif
+#ifdef FLECS_NO_TRACE
+#undef FLECS_TRACE
+#endif
 #ifdef FLECS_NO_SYSTEM
 #undef FLECS_SYSTEM
 #endif
@@ -57,6 +60,9 @@
 #ifdef FLECS_NO_JSON
 #undef FLECS_JSON
 #endif
+#ifdef FLECS_NO_BINARY
+#undef FLECS_BINARY
+#endif
 #ifdef FLECS_NO_DOC
 #undef FLECS_DOC
 #endif
@@ -157,6 +163,13 @@
 #include "../addons/stats.h"
 #endif
 
+#ifdef FLECS_TRACE
+#ifdef FLECS_NO_TRACE
+#error "FLECS_NO_TRACE failed: TRACE is required by other addons"
+#endif
+#include "../addons/trace.h"
+#endif
+
 #ifdef FLECS_METRICS
 #ifdef FLECS_NO_METRICS
 #error "FLECS_NO_METRICS failed: METRICS is required by other addons"
@@ -192,7 +205,14 @@
 #include "../addons/json.h"
 #endif
 
-#if defined(FLECS_EXPR) || defined(FLECS_META_C)
+#ifdef FLECS_BINARY
+#ifdef FLECS_NO_BINARY
+#error "FLECS_NO_BINARY failed: BINARY is required by other addons"
+#endif
+#include "../addons/binary.h"
+#endif
+
+#if defined(FLECS_EXPR) || defined(FLECS_META_C) || defined(FLECS_BINARY)
 #ifndef FLECS_META
 #define FLECS_META
 #endif
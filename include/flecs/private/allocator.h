@@ -13,19 +13,49 @@ FLECS_DBG_API extern int64_t ecs_block_allocator_free_count;
 FLECS_DBG_API extern int64_t ecs_stack_allocator_alloc_count;
 FLECS_DBG_API extern int64_t ecs_stack_allocator_free_count;
 
+/** Chunks of size classes that are at least FLECS_VM_ALLOC_SIZE can be stored
+ * in reserved virtual memory regions. When such a chunk is reallocated to a
+ * larger size class, more of its region is committed instead of copying it. */
+typedef struct ecs_allocator_vm_t {
+    ecs_map_t regions;         /* map<ptr, reserved size> */
+    ecs_size_t reserve;        /* Size of new regions, 0 if disabled */
+    int64_t committed;         /* Committed memory in regions */
+} ecs_allocator_vm_t;
+
 struct ecs_allocator_t {
     ecs_block_allocator_t chunks;
     struct ecs_sparse_t sizes; /* <size, block_allocator_t> */
+    ecs_block_allocator_arena_t *arena;
+    ecs_block_allocator_depot_t *depot;
+    ecs_allocator_vm_t vm;
 };
 
 FLECS_API
 void flecs_allocator_init(
     ecs_allocator_t *a);
 
+FLECS_API
+void flecs_allocator_init_w_arena(
+    ecs_allocator_t *a,
+    ecs_block_allocator_arena_t *arena);
+
+FLECS_API
+void flecs_allocator_init_w_depot(
+    ecs_allocator_t *a,
+    ecs_block_allocator_depot_t *depot);
+
 FLECS_API
 void flecs_allocator_fini(
     ecs_allocator_t *a);
 
+/** Store chunks of large size classes in reserved virtual memory regions of
+ * the specified size. A size of 0 disables reserving new regions. Returns false
+ * if the OS API has no virtual memory support. */
+FLECS_API
+bool flecs_allocator_set_vm_reserve(
+    ecs_allocator_t *a,
+    ecs_size_t size);
+
 FLECS_API
 ecs_block_allocator_t* flecs_allocator_get(
     ecs_allocator_t *a, 
@@ -23,6 +23,10 @@ extern "C" {
 #define EcsWorldMeasureFrameTime      (1u << 5)
 #define EcsWorldMeasureSystemTime     (1u << 6)
 #define EcsWorldMultiThreaded         (1u << 7)
+#define EcsWorldMeasureStageTime      (1u << 8)
+#define EcsWorldTrace                 (1u << 9)
+#define EcsWorldWorkerTableAffinity   (1u << 10)
+#define EcsWorldInternIdentifiers     (1u << 11)
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -34,6 +38,9 @@ extern "C" {
 #define EcsOsApiLogWithTimeStamp      (1u << 2)
 #define EcsOsApiLogWithTimeDelta      (1u << 3)
 
+/* Flags for ecs_os_page_alloc() */
+#define EcsOsPageHuge                 (1u << 0)  /* Use huge pages if possible */
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Entity flags (set in upper bits of ecs_record_t::row)
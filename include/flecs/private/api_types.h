@@ -178,6 +178,7 @@ typedef struct ecs_query_iter_t {
 typedef struct ecs_snapshot_iter_t {
     ecs_filter_t filter;
     ecs_vec_t tables; /* ecs_table_leaf_t */
+    const struct ecs_snapshot_t *base; /* Base of delta snapshot */
     int32_t index;
 } ecs_snapshot_iter_t;
 
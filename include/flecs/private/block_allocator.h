@@ -17,6 +17,31 @@ typedef struct ecs_block_allocator_chunk_header_t {
     struct ecs_block_allocator_chunk_header_t *next;
 } ecs_block_allocator_chunk_header_t;
 
+typedef struct ecs_block_allocator_arena_page_t {
+    struct ecs_block_allocator_arena_page_t *next;
+    ecs_size_t size;
+    ecs_size_t sp;
+} ecs_block_allocator_arena_page_t;
+
+/** Arena that block allocators can take their blocks from. Blocks taken from
+ * an arena are not freed individually, but are released all at once when the
+ * arena is deinitialized. */
+typedef struct ecs_block_allocator_arena_t {
+    ecs_block_allocator_arena_page_t *page; /* Current page, head of list */
+    ecs_size_t page_size;                   /* Size of next page */
+    int32_t page_count;
+} ecs_block_allocator_arena_t;
+
+/** Depot that block allocators of different threads exchange free chunks with.
+ * The free list of a block allocator that uses a depot acts as a magazine: when
+ * it runs empty a magazine of free chunks is taken from the depot, and when it
+ * has too many free chunks a magazine is returned to the depot. Only taking and
+ * returning magazines takes a lock, and memory freed by one thread can be
+ * reused by another thread. Chunks may be freed with a different block
+ * allocator than the one that allocated them, as long as both use the same
+ * depot and chunk size. */
+typedef struct ecs_block_allocator_depot_t ecs_block_allocator_depot_t;
+
 typedef struct ecs_block_allocator_t {
     ecs_block_allocator_chunk_header_t *head;
     ecs_block_allocator_block_t *block_head;
@@ -26,8 +51,32 @@ typedef struct ecs_block_allocator_t {
     int32_t chunks_per_block;
     int32_t block_size;
     int32_t alloc_count;
+    ecs_block_allocator_arena_t *arena;
+    struct ecs_block_allocator_depot_bin_t *depot; /* Depot chunks of same size */
+    int32_t free_count; /* Number of chunks in free list (with depot) */
+    struct ecs_allocator_vm_t *vm; /* Reserved memory for large chunks */
 } ecs_block_allocator_t;
 
+FLECS_API
+void flecs_ballocator_arena_init(
+    ecs_block_allocator_arena_t *arena);
+
+FLECS_API
+void flecs_ballocator_arena_fini(
+    ecs_block_allocator_arena_t *arena);
+
+FLECS_API
+void* flecs_ballocator_arena_alloc(
+    ecs_block_allocator_arena_t *arena,
+    ecs_size_t size);
+
+FLECS_API
+ecs_block_allocator_depot_t* flecs_ballocator_depot_new(void);
+
+FLECS_API
+void flecs_ballocator_depot_free(
+    ecs_block_allocator_depot_t *depot);
+
 FLECS_API
 void flecs_ballocator_init(
     ecs_block_allocator_t *ba,
@@ -38,6 +87,18 @@ void flecs_ballocator_init(
 #define flecs_ballocator_init_n(ba, T, count)\
     flecs_ballocator_init(ba, ECS_SIZEOF(T) * count)
 
+FLECS_API
+void flecs_ballocator_init_w_arena(
+    ecs_block_allocator_t *ba,
+    ecs_size_t size,
+    ecs_block_allocator_arena_t *arena);
+
+FLECS_API
+void flecs_ballocator_init_w_depot(
+    ecs_block_allocator_t *ba,
+    ecs_size_t size,
+    ecs_block_allocator_depot_t *depot);
+
 FLECS_API
 ecs_block_allocator_t* flecs_ballocator_new(
     ecs_size_t size);
@@ -79,4 +140,10 @@ void* flecs_bdup(
     ecs_block_allocator_t *ba, 
     void *memory);
 
+/** Free blocks of which all chunks are free. Returns the number of bytes freed.
+ * Blocks taken from an arena and chunks owned by a depot are not freed. */
+FLECS_API
+int64_t flecs_ballocator_trim(
+    ecs_block_allocator_t *ba);
+
 #endif
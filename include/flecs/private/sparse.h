@@ -29,6 +29,15 @@ typedef struct ecs_sparse_t {
     struct ecs_block_allocator_t *page_allocator;
 } ecs_sparse_t;
 
+/** Iterator over the alive elements of a sparse set */
+typedef struct ecs_sparse_iter_t {
+    const void *pages;       /* Pages of the sparse set */
+    const uint64_t *ids;     /* Alive ids, in dense order */
+    int32_t index;           /* Index of next element */
+    int32_t count;           /* Number of alive elements */
+    ecs_size_t size;         /* Element size */
+} ecs_sparse_iter_t;
+
 /** Initialize sparse set */
 FLECS_DBG_API
 void flecs_sparse_init(
@@ -68,6 +77,13 @@ FLECS_DBG_API
 uint64_t flecs_sparse_new_id(
     ecs_sparse_t *sparse);
 
+/** Generate or recycle new ids in bulk. Returns a pointer to the new ids,
+ * which is valid until the next operation on the sparse set. */
+FLECS_DBG_API
+const uint64_t* flecs_sparse_new_ids(
+    ecs_sparse_t *sparse,
+    int32_t count);
+
 /** Remove an element */
 FLECS_DBG_API
 void flecs_sparse_remove(
@@ -78,12 +94,30 @@ void flecs_sparse_remove(
 #define flecs_sparse_remove_t(sparse, T, id)\
     flecs_sparse_remove(sparse, ECS_SIZEOF(T), id)
 
+/** Remove elements in bulk. Ids that are not alive are ignored. */
+FLECS_DBG_API
+void flecs_sparse_remove_n(
+    ecs_sparse_t *sparse,
+    ecs_size_t elem_size,
+    const uint64_t *ids,
+    int32_t count);
+
+#define flecs_sparse_remove_n_t(sparse, T, ids, count)\
+    flecs_sparse_remove_n(sparse, ECS_SIZEOF(T), ids, count)
+
 /** Test if id is alive, which requires the generation count to match. */
 FLECS_DBG_API
 bool flecs_sparse_is_alive(
     const ecs_sparse_t *sparse,
     uint64_t id);
 
+/** Test if all ids are alive. */
+FLECS_DBG_API
+bool flecs_sparse_is_alive_n(
+    const ecs_sparse_t *sparse,
+    const uint64_t *ids,
+    int32_t count);
+
 /** Get value from sparse set by dense id. This function is useful in 
  * combination with flecs_sparse_count for iterating all values in the set. */
 FLECS_DBG_API
@@ -156,6 +190,23 @@ FLECS_DBG_API
 const uint64_t* flecs_sparse_ids(
     const ecs_sparse_t *sparse);
 
+/** Iterate alive elements in dense order. The iterator is invalidated when
+ * elements are added to or removed from the sparse set. */
+FLECS_DBG_API
+ecs_sparse_iter_t flecs_sparse_iter(
+    const ecs_sparse_t *sparse);
+
+/** Return next element, or NULL if there are no more elements. If id_out is
+ * not NULL, it is set to the id of the returned element. */
+FLECS_DBG_API
+void* flecs_sparse_next(
+    ecs_sparse_iter_t *it,
+    ecs_size_t elem_size,
+    uint64_t *id_out);
+
+#define flecs_sparse_next_t(it, T, id_out)\
+    ECS_CAST(T*, flecs_sparse_next(it, ECS_SIZEOF(T), id_out))
+
 /* Publicly exposed APIs 
  * The flecs_ functions aren't exposed directly as this can cause some
  * optimizers to not consider them for link time optimization. */
@@ -202,6 +253,57 @@ void* ecs_sparse_get(
 #define ecs_sparse_get_t(sparse, T, index)\
     ECS_CAST(T*, ecs_sparse_get(sparse, ECS_SIZEOF(T), index))
 
+FLECS_API
+void ecs_sparse_fini(
+    ecs_sparse_t *sparse);
+
+FLECS_API
+const uint64_t* ecs_sparse_ids(
+    const ecs_sparse_t *sparse);
+
+FLECS_API
+const uint64_t* ecs_sparse_new_ids(
+    ecs_sparse_t *sparse,
+    int32_t count);
+
+FLECS_API
+void ecs_sparse_remove(
+    ecs_sparse_t *sparse,
+    ecs_size_t elem_size,
+    uint64_t id);
+
+#define ecs_sparse_remove_t(sparse, T, id)\
+    ecs_sparse_remove(sparse, ECS_SIZEOF(T), id)
+
+FLECS_API
+void ecs_sparse_remove_n(
+    ecs_sparse_t *sparse,
+    ecs_size_t elem_size,
+    const uint64_t *ids,
+    int32_t count);
+
+#define ecs_sparse_remove_n_t(sparse, T, ids, count)\
+    ecs_sparse_remove_n(sparse, ECS_SIZEOF(T), ids, count)
+
+FLECS_API
+bool ecs_sparse_is_alive_n(
+    const ecs_sparse_t *sparse,
+    const uint64_t *ids,
+    int32_t count);
+
+FLECS_API
+ecs_sparse_iter_t ecs_sparse_iter(
+    const ecs_sparse_t *sparse);
+
+FLECS_API
+void* ecs_sparse_next(
+    ecs_sparse_iter_t *it,
+    ecs_size_t elem_size,
+    uint64_t *id_out);
+
+#define ecs_sparse_next_t(it, T, id_out)\
+    ECS_CAST(T*, ecs_sparse_next(it, ECS_SIZEOF(T), id_out))
+
 #ifdef __cplusplus
 }
 #endif
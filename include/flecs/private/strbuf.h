@@ -105,6 +105,28 @@ void ecs_strbuf_appendstrn(
     const char *str,
     int32_t n);
 
+/* Append string to buffer, escape special characters and delimiter.
+ * Characters are escaped the same way as ecs_stresc(). */
+FLECS_API
+void ecs_strbuf_appendesc(
+    ecs_strbuf_t *buffer,
+    const char *str,
+    char delimiter);
+
+/* Reserve space for n characters and return pointer to write position.
+ * Characters written to the returned pointer are added to the buffer with
+ * ecs_strbuf_commit(). The pointer is invalidated by the next append. */
+FLECS_API
+char* ecs_strbuf_reserve(
+    ecs_strbuf_t *buffer,
+    int32_t n);
+
+/* Add n characters written to pointer returned by ecs_strbuf_reserve() */
+FLECS_API
+void ecs_strbuf_commit(
+    ecs_strbuf_t *buffer,
+    int32_t n);
+
 /* Return result string */
 FLECS_API
 char* ecs_strbuf_get(
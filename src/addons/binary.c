@@ -0,0 +1,1513 @@
+/**
+ * @file addons/binary.c
+ * @brief Binary world serializer addon.
+ *
+ * The format consists of a header followed by a list of tables. Each table
+ * stores its type, its entities and a column for each component. Entity
+ * handles are written as their serialized id. The first time an entity is
+ * written its path is written as well, so that it can be resolved when
+ * loading. Component values are either written as a single block of memory
+ * (for components that only contain primitive values), or are written value
+ * by value using the operations of EcsMetaTypeSerialized.
+ */
+
+#include "../private_api.h"
+
+#ifdef FLECS_BINARY
+
+#if defined(ECS_TARGET_WINDOWS)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define FLECS_BINARY_MAGIC "FLBN"
+#define FLECS_BINARY_VERSION (1)
+#define FLECS_BINARY_BYTE_ORDER (0x01020304)
+#define FLECS_BINARY_CHUNK_SIZE (64 * 1024)
+#define FLECS_BINARY_NULL_STRING (UINT32_MAX)
+
+/* Record kinds */
+#define FLECS_BINARY_END (0)
+#define FLECS_BINARY_TABLE (1)
+
+/* Column kinds */
+#define FLECS_BINARY_COLUMN_NONE (0)
+#define FLECS_BINARY_COLUMN_POD (1)
+#define FLECS_BINARY_COLUMN_OPS (2)
+
+/* Cached information about how to serialize a type */
+typedef struct ecs_binary_type_t {
+    const ecs_type_info_t *ti;
+    ecs_meta_type_op_t *ops;
+    int32_t op_count;
+    uint64_t hash;              /* Hash of type layout */
+    bool is_pod;                /* Can be serialized with memcpy */
+    bool is_valid;              /* Type can be serialized */
+} ecs_binary_type_t;
+
+typedef struct ecs_binary_writer_t {
+    ecs_binary_write_action_t write;
+    void *ctx;
+    ecs_vec_t buf;
+    int err;
+} ecs_binary_writer_t;
+
+typedef struct ecs_binary_reader_t {
+    ecs_binary_read_action_t read;
+    void *ctx;
+    const char *ptr;
+    const char *end;
+    char *buf;
+    int err;
+} ecs_binary_reader_t;
+
+typedef struct ecs_binary_ser_t {
+    ecs_world_t *world;
+    ecs_allocator_t *a;
+    ecs_binary_writer_t w;
+    ecs_map_t written;          /* Entities for which path has been written */
+    ecs_map_t types;            /* type entity -> ecs_binary_type_t* */
+} ecs_binary_ser_t;
+
+typedef struct ecs_binary_de_t {
+    ecs_world_t *world;
+    ecs_allocator_t *a;
+    ecs_binary_reader_t r;
+    const ecs_from_binary_desc_t *desc;
+    ecs_map_t entities;         /* serialized id -> entity */
+    ecs_map_t issued;           /* Entities issued by deserializer */
+    ecs_map_t types;            /* type entity -> ecs_binary_type_t* */
+    ecs_vec_t ids;              /* Ids of current table in serialized order */
+    ecs_vec_t records;
+    ecs_vec_t columns_set;
+    ecs_vec_t added;
+    ecs_vec_t removed;
+} ecs_binary_de_t;
+
+/* -- Type information -- */
+
+static
+uint64_t flecs_binary_hash_combine(
+    uint64_t h,
+    uint64_t v)
+{
+    return h ^ (v + 0x9e3779b97f4a7c15 + (h << 6) + (h >> 2));
+}
+
+static
+const ecs_binary_type_t* flecs_binary_get_type(
+    ecs_world_t *world,
+    ecs_allocator_t *a,
+    ecs_map_t *types,
+    ecs_entity_t type)
+{
+    ecs_binary_type_t *result = ecs_map_get_deref(
+        types, ecs_binary_type_t, type);
+    if (result) {
+        return result;
+    }
+
+    result = flecs_calloc_t(a, ecs_binary_type_t);
+    ecs_map_insert_ptr(types, type, result);
+
+    const ecs_type_info_t *ti = ecs_get_type_info(world, type);
+    const EcsMetaTypeSerialized *ser = ecs_get(
+        world, type, EcsMetaTypeSerialized);
+    if (!ti || !ser) {
+        return result;
+    }
+
+    result->ti = ti;
+    result->ops = ecs_vec_first_t(&ser->ops, ecs_meta_type_op_t);
+    result->op_count = ecs_vec_count(&ser->ops);
+
+    /* Types with hooks can own data that isn't described by reflection, so
+     * only copy them by value. This is part of the layout hash, so that the
+     * serializer and deserializer agree on how a type is stored. */
+    bool is_pod = !ti->hooks.copy && !ti->hooks.move && !ti->hooks.dtor;
+    uint64_t hash = flecs_binary_hash_combine(
+        (uint64_t)ti->size, (uint64_t)is_pod);
+
+    int32_t i;
+    for (i = 0; i < result->op_count; i ++) {
+        ecs_meta_type_op_t *op = &result->ops[i];
+        int32_t op_hash[] = {
+            (int32_t)op->kind, op->count, op->size, op->offset, op->op_count };
+        hash = flecs_binary_hash_combine(hash,
+            flecs_hash(op_hash, ECS_SIZEOF(op_hash)));
+
+        ecs_entity_t elem_type = 0;
+        switch(op->kind) {
+        case EcsOpOpaque:
+            return result; /* Not supported */
+        case EcsOpString:
+        case EcsOpEntity:
+        case EcsOpId:
+            is_pod = false;
+            break;
+        case EcsOpVector:
+            is_pod = false;
+            elem_type = ecs_get(world, op->type, EcsVector)->type;
+            break;
+        case EcsOpArray:
+            elem_type = ecs_get(world, op->type, EcsArray)->type;
+            break;
+        default:
+            break;
+        }
+
+        if (elem_type) {
+            const ecs_binary_type_t *elem = flecs_binary_get_type(
+                world, a, types, elem_type);
+            if (!elem->is_valid) {
+                return result;
+            }
+            is_pod &= elem->is_pod;
+            hash = flecs_binary_hash_combine(hash, elem->hash);
+        }
+    }
+
+    result->hash = hash;
+    result->is_pod = is_pod;
+    result->is_valid = true;
+    return result;
+}
+
+static
+void flecs_binary_types_fini(
+    ecs_allocator_t *a,
+    ecs_map_t *types)
+{
+    ecs_map_iter_t it = ecs_map_iter(types);
+    while (ecs_map_next(&it)) {
+        flecs_free_t(a, ecs_binary_type_t, ecs_map_ptr(&it));
+    }
+    ecs_map_fini(types);
+}
+
+/* -- Writer -- */
+
+static
+void flecs_binary_flush(
+    ecs_binary_writer_t *w)
+{
+    int32_t count = ecs_vec_count(&w->buf);
+    if (w->write && count && !w->err) {
+        if (w->write(ecs_vec_first(&w->buf), count, w->ctx)) {
+            ecs_err("binary: failed to write to stream");
+            w->err = -1;
+        }
+    }
+
+    if (w->write) {
+        ecs_vec_clear(&w->buf);
+    }
+}
+
+static
+void flecs_binary_write(
+    ecs_binary_writer_t *w,
+    const void *data,
+    ecs_size_t size)
+{
+    if (size) {
+        void *dst = ecs_vec_grow(NULL, &w->buf, 1, size);
+        ecs_os_memcpy(dst, data, size);
+    }
+}
+
+/* Write large block of data. When writing to a stream, the data is passed
+ * directly to the stream, so it doesn't have to be copied to the buffer. */
+static
+void flecs_binary_write_blob(
+    ecs_binary_writer_t *w,
+    const void *data,
+    ecs_size_t size)
+{
+    if (w->write && size >= FLECS_BINARY_CHUNK_SIZE) {
+        flecs_binary_flush(w);
+        if (!w->err && w->write(data, size, w->ctx)) {
+            ecs_err("binary: failed to write to stream");
+            w->err = -1;
+        }
+    } else {
+        flecs_binary_write(w, data, size);
+    }
+}
+
+static
+void flecs_binary_write_u8(
+    ecs_binary_writer_t *w,
+    uint8_t value)
+{
+    flecs_binary_write(w, &value, ECS_SIZEOF(uint8_t));
+}
+
+static
+void flecs_binary_write_u32(
+    ecs_binary_writer_t *w,
+    uint32_t value)
+{
+    flecs_binary_write(w, &value, ECS_SIZEOF(uint32_t));
+}
+
+static
+void flecs_binary_write_u64(
+    ecs_binary_writer_t *w,
+    uint64_t value)
+{
+    flecs_binary_write(w, &value, ECS_SIZEOF(uint64_t));
+}
+
+/* -- Serializer -- */
+
+static
+void flecs_binary_ser_type_ops(
+    ecs_binary_ser_t *ser,
+    ecs_meta_type_op_t *ops,
+    int32_t op_count,
+    const void *base,
+    int32_t in_array);
+
+static
+void flecs_binary_ser_entity(
+    ecs_binary_ser_t *ser,
+    ecs_entity_t e)
+{
+    ecs_binary_writer_t *w = &ser->w;
+    flecs_binary_write_u64(w, e);
+    if (!e) {
+        return;
+    }
+
+    ecs_map_val_t *written = ecs_map_ensure(&ser->written, e);
+    if (written[0]) {
+        return;
+    }
+
+    written[0] = 1;
+
+    ecs_world_t *world = ser->world;
+    if (ecs_is_alive(world, e) && ecs_get_name(world, e)) {
+        char *path = ecs_get_path_w_sep(world, 0, e, ".", NULL);
+        ecs_size_t len = ecs_os_strlen(path);
+        flecs_binary_write_u32(w, flecs_ito(uint32_t, len));
+        flecs_binary_write(w, path, len);
+        ecs_os_free(path);
+    } else {
+        flecs_binary_write_u32(w, 0);
+    }
+}
+
+static
+void flecs_binary_ser_id(
+    ecs_binary_ser_t *ser,
+    ecs_id_t id)
+{
+    flecs_binary_write_u64(&ser->w, id & ECS_ID_FLAGS_MASK);
+    if (ECS_IS_PAIR(id)) {
+        ecs_world_t *world = ser->world;
+        ecs_entity_t first = ECS_PAIR_FIRST(id);
+        ecs_entity_t second = ECS_PAIR_SECOND(id);
+        ecs_entity_t alive_first = ecs_get_alive(world, first);
+        ecs_entity_t alive_second = ecs_get_alive(world, second);
+        flecs_binary_ser_entity(ser, alive_first ? alive_first : first);
+        flecs_binary_ser_entity(ser, alive_second ? alive_second : second);
+    } else {
+        flecs_binary_ser_entity(ser, id & ECS_COMPONENT_MASK);
+    }
+}
+
+static
+void flecs_binary_ser_elements(
+    ecs_binary_ser_t *ser,
+    ecs_entity_t type,
+    const void *base,
+    int32_t count)
+{
+    const ecs_binary_type_t *bt = flecs_binary_get_type(
+        ser->world, ser->a, &ser->types, type);
+    ecs_assert(bt->is_valid, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_size_t size = bt->ti->size;
+    if (bt->is_pod) {
+        flecs_binary_write(&ser->w, base, size * count);
+        return;
+    }
+
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        flecs_binary_ser_type_ops(ser, bt->ops, bt->op_count,
+            ECS_ELEM(base, size, i), 0);
+    }
+}
+
+static
+void flecs_binary_ser_type_op(
+    ecs_binary_ser_t *ser,
+    ecs_meta_type_op_t *op,
+    const void *base)
+{
+    ecs_binary_writer_t *w = &ser->w;
+    const void *ptr = ECS_OFFSET(base, op->offset);
+
+    switch(op->kind) {
+    case EcsOpString: {
+        const char *str = *(const char**)ptr;
+        if (!str) {
+            flecs_binary_write_u32(w, FLECS_BINARY_NULL_STRING);
+        } else {
+            ecs_size_t len = ecs_os_strlen(str);
+            flecs_binary_write_u32(w, flecs_ito(uint32_t, len));
+            flecs_binary_write(w, str, len);
+        }
+        break;
+    }
+    case EcsOpEntity:
+        flecs_binary_ser_entity(ser, *(const ecs_entity_t*)ptr);
+        break;
+    case EcsOpId:
+        flecs_binary_ser_id(ser, *(const ecs_id_t*)ptr);
+        break;
+    case EcsOpArray: {
+        const EcsArray *a = ecs_get(ser->world, op->type, EcsArray);
+        ecs_assert(a != NULL, ECS_INTERNAL_ERROR, NULL);
+        flecs_binary_ser_elements(ser, a->type, ptr, a->count);
+        break;
+    }
+    case EcsOpVector: {
+        const EcsVector *v = ecs_get(ser->world, op->type, EcsVector);
+        ecs_assert(v != NULL, ECS_INTERNAL_ERROR, NULL);
+        const ecs_vec_t *vec = ptr;
+        int32_t count = ecs_vec_count(vec);
+        flecs_binary_write_u32(w, flecs_ito(uint32_t, count));
+        if (count) {
+            flecs_binary_ser_elements(ser, v->type, ecs_vec_first(vec), count);
+        }
+        break;
+    }
+    case EcsOpEnum:
+    case EcsOpBitmask:
+    case EcsOpBool:
+    case EcsOpChar:
+    case EcsOpByte:
+    case EcsOpU8:
+    case EcsOpU16:
+    case EcsOpU32:
+    case EcsOpU64:
+    case EcsOpI8:
+    case EcsOpI16:
+    case EcsOpI32:
+    case EcsOpI64:
+    case EcsOpF32:
+    case EcsOpF64:
+    case EcsOpUPtr:
+    case EcsOpIPtr:
+        flecs_binary_write(w, ptr, op->size);
+        break;
+    case EcsOpOpaque:
+    case EcsOpPush:
+    case EcsOpPop:
+    case EcsOpScope:
+    case EcsOpPrimitive:
+    default:
+        ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    }
+}
+
+/* Iterate over a slice of the type ops array */
+static
+void flecs_binary_ser_type_ops(
+    ecs_binary_ser_t *ser,
+    ecs_meta_type_op_t *ops,
+    int32_t op_count,
+    const void *base,
+    int32_t in_array)
+{
+    int32_t i, j;
+    for (i = 0; i < op_count; i ++) {
+        ecs_meta_type_op_t *op = &ops[i];
+
+        if (in_array <= 0) {
+            int32_t elem_count = op->count;
+            if (elem_count > 1) {
+                /* Serialize inline array */
+                for (j = 0; j < elem_count; j ++) {
+                    flecs_binary_ser_type_ops(ser, op, op->op_count,
+                        ECS_OFFSET(base, j * op->size), 1);
+                }
+                i += op->op_count - 1;
+                continue;
+            }
+        }
+
+        if (op->kind == EcsOpPush) {
+            in_array --;
+        } else if (op->kind == EcsOpPop) {
+            in_array ++;
+        } else {
+            flecs_binary_ser_type_op(ser, op, base);
+        }
+    }
+}
+
+static
+void flecs_binary_ser_table(
+    ecs_binary_ser_t *ser,
+    ecs_table_t *table,
+    const ecs_entity_t *entities,
+    int32_t offset,
+    int32_t count)
+{
+    ecs_binary_writer_t *w = &ser->w;
+    int32_t i, type_count = table->type.count;
+    ecs_id_t *ids = table->type.array;
+
+    flecs_binary_write_u8(w, FLECS_BINARY_TABLE);
+    flecs_binary_write_u32(w, flecs_ito(uint32_t, type_count));
+    for (i = 0; i < type_count; i ++) {
+        flecs_binary_ser_id(ser, ids[i]);
+    }
+
+    flecs_binary_write_u32(w, flecs_ito(uint32_t, count));
+    for (i = 0; i < count; i ++) {
+        flecs_binary_ser_entity(ser, entities[i]);
+    }
+
+    for (i = 0; i < type_count; i ++) {
+        int32_t column_index = ecs_table_type_to_column_index(table, i);
+        if (column_index == -1) {
+            flecs_binary_write_u8(w, FLECS_BINARY_COLUMN_NONE);
+            continue;
+        }
+
+        ecs_column_t *column = &table->data.columns[column_index];
+        const ecs_binary_type_t *bt = flecs_binary_get_type(
+            ser->world, ser->a, &ser->types, column->ti->component);
+        if (!bt->is_valid) {
+            flecs_binary_write_u8(w, FLECS_BINARY_COLUMN_NONE);
+            continue;
+        }
+
+        ecs_size_t size = bt->ti->size;
+        const void *ptr = ecs_vec_get(&column->data, size, offset);
+
+        if (bt->is_pod) {
+            flecs_binary_write_u8(w, FLECS_BINARY_COLUMN_POD);
+            flecs_binary_write_u64(w, bt->hash);
+            flecs_binary_write_u64(w, flecs_ito(uint64_t, size * count));
+            flecs_binary_write_blob(w, ptr, size * count);
+        } else {
+            flecs_binary_write_u8(w, FLECS_BINARY_COLUMN_OPS);
+            flecs_binary_write_u64(w, bt->hash);
+
+            /* Size of column isn't known in advance, patch it afterwards */
+            int32_t size_offset = ecs_vec_count(&w->buf);
+            flecs_binary_write_u64(w, 0);
+
+            int32_t row;
+            for (row = 0; row < count; row ++) {
+                flecs_binary_ser_type_ops(ser, bt->ops, bt->op_count,
+                    ECS_ELEM(ptr, size, row), 0);
+            }
+
+            uint64_t column_size = flecs_ito(uint64_t,
+                ecs_vec_count(&w->buf) - size_offset - ECS_SIZEOF(uint64_t));
+            ecs_os_memcpy(ecs_vec_get(&w->buf, 1, size_offset),
+                &column_size, ECS_SIZEOF(uint64_t));
+        }
+
+        if (ecs_vec_count(&w->buf) >= FLECS_BINARY_CHUNK_SIZE) {
+            flecs_binary_flush(w);
+        }
+    }
+}
+
+static
+int flecs_world_to_binary(
+    ecs_world_t *world,
+    const ecs_world_to_binary_desc_t *desc,
+    ecs_binary_writer_t *w)
+{
+    ecs_filter_t f = ECS_FILTER_INIT;
+    ecs_filter_desc_t filter_desc = {0};
+    filter_desc.storage = &f;
+
+    if (desc && desc->serialize_builtin && desc->serialize_modules) {
+        filter_desc.terms[0].id = EcsAny;
+    } else {
+        bool serialize_builtin = desc && desc->serialize_builtin;
+        bool serialize_modules = desc && desc->serialize_modules;
+        int32_t term_id = 0;
+
+        if (!serialize_builtin) {
+            filter_desc.terms[term_id].id = ecs_pair(EcsChildOf, EcsFlecs);
+            filter_desc.terms[term_id].oper = EcsNot;
+            filter_desc.terms[term_id].src.flags = EcsSelf | EcsParent;
+            term_id ++;
+        }
+        if (!serialize_modules) {
+            filter_desc.terms[term_id].id = EcsModule;
+            filter_desc.terms[term_id].oper = EcsNot;
+            filter_desc.terms[term_id].src.flags = EcsSelf | EcsParent;
+        }
+    }
+
+    filter_desc.flags = EcsFilterMatchDisabled|EcsFilterMatchPrefab;
+
+    if (ecs_filter_init(world, &filter_desc) == NULL) {
+        return -1;
+    }
+
+    ecs_binary_ser_t ser = {
+        .world = world,
+        .a = &world->allocator,
+        .w = *w
+    };
+
+    ecs_map_init(&ser.written, ser.a);
+    ecs_map_init(&ser.types, ser.a);
+
+    flecs_binary_write(&ser.w, FLECS_BINARY_MAGIC, 4);
+    flecs_binary_write_u32(&ser.w, FLECS_BINARY_VERSION);
+    flecs_binary_write_u32(&ser.w, FLECS_BINARY_BYTE_ORDER);
+    flecs_binary_write_u32(&ser.w, (uint32_t)ECS_SIZEOF(void*));
+
+    ecs_iter_t it = ecs_filter_iter(world, &f);
+    while (ecs_filter_next(&it)) {
+        if (!it.count) {
+            continue;
+        }
+        flecs_binary_ser_table(&ser, it.table, it.entities, it.offset,
+            it.count);
+        if (ser.w.err) {
+            ecs_iter_fini(&it);
+            break;
+        }
+    }
+
+    flecs_binary_write_u8(&ser.w, FLECS_BINARY_END);
+    flecs_binary_flush(&ser.w);
+
+    ecs_map_fini(&ser.written);
+    flecs_binary_types_fini(ser.a, &ser.types);
+    ecs_filter_fini(&f);
+
+    *w = ser.w;
+    return w->err;
+}
+
+void* ecs_world_to_binary(
+    ecs_world_t *world,
+    const ecs_world_to_binary_desc_t *desc,
+    ecs_size_t *size_out)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(size_out != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_binary_writer_t w = {0};
+    ecs_vec_init(NULL, &w.buf, 1, FLECS_BINARY_CHUNK_SIZE);
+
+    if (flecs_world_to_binary(world, desc, &w)) {
+        ecs_vec_fini(NULL, &w.buf, 1);
+        return NULL;
+    }
+
+    *size_out = ecs_vec_count(&w.buf);
+    return ecs_vec_first(&w.buf);
+error:
+    return NULL;
+}
+
+int ecs_world_to_binary_stream(
+    ecs_world_t *world,
+    const ecs_world_to_binary_desc_t *desc,
+    ecs_binary_write_action_t write,
+    void *ctx)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(write != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_binary_writer_t w = { .write = write, .ctx = ctx };
+    ecs_vec_init(NULL, &w.buf, 1, FLECS_BINARY_CHUNK_SIZE);
+    int result = flecs_world_to_binary(world, desc, &w);
+    ecs_vec_fini(NULL, &w.buf, 1);
+    return result;
+error:
+    return -1;
+}
+
+static
+int flecs_binary_fd_write(
+    const void *data,
+    ecs_size_t size,
+    void *ctx)
+{
+    int fd = *(int*)ctx;
+    const char *ptr = data;
+    while (size) {
+#if defined(ECS_TARGET_WINDOWS)
+        int written = _write(fd, ptr, (unsigned int)size);
+#else
+        ecs_size_t written = (ecs_size_t)write(fd, ptr, (size_t)size);
+#endif
+        if (written <= 0) {
+            return -1;
+        }
+        ptr += written;
+        size -= written;
+    }
+    return 0;
+}
+
+int ecs_world_to_binary_fd(
+    ecs_world_t *world,
+    const ecs_world_to_binary_desc_t *desc,
+    int fd)
+{
+    return ecs_world_to_binary_stream(world, desc, flecs_binary_fd_write, &fd);
+}
+
+/* -- Reader -- */
+
+static
+int flecs_binary_read(
+    ecs_binary_reader_t *r,
+    void *data,
+    ecs_size_t size)
+{
+    char *dst = data;
+    while (size) {
+        ecs_size_t avail = (ecs_size_t)(r->end - r->ptr);
+        if (avail) {
+            ecs_size_t n = size < avail ? size : avail;
+            if (dst) {
+                ecs_os_memcpy(dst, r->ptr, n);
+                dst += n;
+            }
+            r->ptr += n;
+            size -= n;
+            continue;
+        }
+
+        if (!r->read) {
+            goto error;
+        }
+
+        ecs_size_t n;
+        if (dst && size >= FLECS_BINARY_CHUNK_SIZE) {
+            /* Read large blocks directly into destination */
+            n = r->read(dst, size, r->ctx);
+            if (n <= 0) {
+                goto error;
+            }
+            dst += n;
+            size -= n;
+        } else {
+            n = r->read(r->buf, FLECS_BINARY_CHUNK_SIZE, r->ctx);
+            if (n <= 0) {
+                goto error;
+            }
+            r->ptr = r->buf;
+            r->end = r->buf + n;
+        }
+    }
+
+    return 0;
+error:
+    if (!r->err) {
+        ecs_err("binary: unexpected end of data");
+        r->err = -1;
+    }
+    return -1;
+}
+
+/* Skip data (for values that can't be deserialized) */
+static
+int flecs_binary_skip(
+    ecs_binary_reader_t *r,
+    uint64_t size)
+{
+    while (size) {
+        ecs_size_t n = size > INT32_MAX ? INT32_MAX : (ecs_size_t)size;
+        if (flecs_binary_read(r, NULL, n)) {
+            return -1;
+        }
+        size -= (uint64_t)n;
+    }
+    return 0;
+}
+
+static
+int flecs_binary_read_u8(
+    ecs_binary_reader_t *r,
+    uint8_t *value)
+{
+    return flecs_binary_read(r, value, ECS_SIZEOF(uint8_t));
+}
+
+static
+int flecs_binary_read_u32(
+    ecs_binary_reader_t *r,
+    uint32_t *value)
+{
+    return flecs_binary_read(r, value, ECS_SIZEOF(uint32_t));
+}
+
+static
+int flecs_binary_read_u64(
+    ecs_binary_reader_t *r,
+    uint64_t *value)
+{
+    return flecs_binary_read(r, value, ECS_SIZEOF(uint64_t));
+}
+
+/* Check a length read from the input before it's used to allocate memory.
+ * Every element takes at least min_size bytes, so for in-memory input the
+ * length can't exceed the remaining data. The size of streamed input isn't
+ * known, so only check that the allocation fits in an ecs_size_t. */
+static
+int flecs_binary_check_length(
+    ecs_binary_reader_t *r,
+    uint32_t length,
+    ecs_size_t elem_size,
+    ecs_size_t min_size)
+{
+    uint64_t size = (uint64_t)length * flecs_ito(uint64_t, elem_size);
+    if (size >= INT32_MAX) {
+        goto error;
+    }
+
+    if (!r->read) {
+        uint64_t avail = flecs_ito(uint64_t, r->end - r->ptr);
+        if (((uint64_t)length * flecs_ito(uint64_t, min_size)) > avail) {
+            goto error;
+        }
+    }
+
+    return 0;
+error:
+    if (!r->err) {
+        ecs_err("binary: invalid length (%u)", length);
+        r->err = -1;
+    }
+    return -1;
+}
+
+/* -- Deserializer -- */
+
+static
+int flecs_binary_de_type_ops(
+    ecs_binary_de_t *de,
+    ecs_meta_type_op_t *ops,
+    int32_t op_count,
+    void *base,
+    int32_t in_array);
+
+static
+ecs_entity_t flecs_binary_new_id(
+    ecs_binary_de_t *de,
+    ecs_entity_t ser_id)
+{
+    ecs_world_t *world = de->world;
+    ecs_entity_t result;
+
+    /* Bind to the serialized id if it is not in use, or used by an anonymous
+     * entity, and wasn't already issued for another entity. */
+    if (!ecs_map_get(&de->issued, ser_id) && (!ecs_exists(world, ser_id) ||
+       (ecs_is_alive(world, ser_id) && !ecs_get_name(world, ser_id))))
+    {
+        ecs_make_alive(world, ser_id);
+        result = ser_id;
+    } else if (ser_id < FLECS_HI_COMPONENT_ID) {
+        result = ecs_new_low_id(world);
+    } else {
+        result = ecs_new_id(world);
+    }
+
+    ecs_map_ensure(&de->issued, result);
+    return result;
+}
+
+static
+int flecs_binary_de_entity(
+    ecs_binary_de_t *de,
+    ecs_entity_t *out)
+{
+    ecs_world_t *world = de->world;
+    uint64_t ser_id;
+    if (flecs_binary_read_u64(&de->r, &ser_id)) {
+        return -1;
+    }
+
+    if (!ser_id) {
+        *out = 0;
+        return 0;
+    }
+
+    ecs_map_val_t *e = ecs_map_get(&de->entities, ser_id);
+    if (e) {
+        *out = e[0];
+        return 0;
+    }
+
+    uint32_t len;
+    if (flecs_binary_read_u32(&de->r, &len)) {
+        return -1;
+    }
+
+    if (flecs_binary_check_length(&de->r, len, 1, 1)) {
+        return -1;
+    }
+
+    ecs_entity_t result;
+    if (len) {
+        char *path = ecs_os_malloc(flecs_uto(ecs_size_t, len + 1));
+        if (flecs_binary_read(&de->r, path, (ecs_size_t)len)) {
+            ecs_os_free(path);
+            return -1;
+        }
+        path[len] = '\0';
+
+        /* Paths of builtin entities omit the flecs.core scope, so do a
+         * recursive lookup that also searches the lookup path. */
+        result = ecs_lookup_path_w_sep(world, 0, path, ".", NULL, true);
+        if (!result) {
+            result = ecs_entity(world, { .name = path, .sep = "." });
+            ecs_map_ensure(&de->issued, result);
+        }
+        ecs_os_free(path);
+    } else {
+        result = flecs_binary_new_id(de, ser_id);
+    }
+
+    ecs_map_insert(&de->entities, ser_id, result);
+    *out = result;
+    return 0;
+}
+
+static
+int flecs_binary_de_id(
+    ecs_binary_de_t *de,
+    ecs_id_t *out)
+{
+    uint64_t flags;
+    if (flecs_binary_read_u64(&de->r, &flags)) {
+        return -1;
+    }
+
+    ecs_entity_t first, second;
+    if (flecs_binary_de_entity(de, &first)) {
+        return -1;
+    }
+
+    if (flags & ECS_PAIR) {
+        if (flecs_binary_de_entity(de, &second)) {
+            return -1;
+        }
+        *out = ecs_pair(first, second) | flags;
+    } else {
+        *out = first | flags;
+    }
+
+    return 0;
+}
+
+static
+int flecs_binary_de_elements(
+    ecs_binary_de_t *de,
+    ecs_entity_t type,
+    void *base,
+    int32_t count)
+{
+    const ecs_binary_type_t *bt = flecs_binary_get_type(
+        de->world, de->a, &de->types, type);
+    ecs_assert(bt->is_valid, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_size_t size = bt->ti->size;
+    if (bt->is_pod) {
+        return flecs_binary_read(&de->r, base, size * count);
+    }
+
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        if (flecs_binary_de_type_ops(de, bt->ops, bt->op_count,
+            ECS_ELEM(base, size, i), 0))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static
+int flecs_binary_de_vector(
+    ecs_binary_de_t *de,
+    ecs_meta_type_op_t *op,
+    ecs_vec_t *vec)
+{
+    const EcsVector *v = ecs_get(de->world, op->type, EcsVector);
+    ecs_assert(v != NULL, ECS_INTERNAL_ERROR, NULL);
+    const ecs_binary_type_t *bt = flecs_binary_get_type(
+        de->world, de->a, &de->types, v->type);
+    ecs_assert(bt->is_valid, ECS_INTERNAL_ERROR, NULL);
+
+    uint32_t count;
+    if (flecs_binary_read_u32(&de->r, &count)) {
+        return -1;
+    }
+
+    /* Values of non-POD elements take at least one byte */
+    const ecs_type_info_t *ti = bt->ti;
+    ecs_size_t size = ti->size;
+    if (flecs_binary_check_length(&de->r, count, size, 
+        bt->is_pod ? size : 1)) 
+    {
+        return -1;
+    }
+    int32_t new_count = flecs_uto(int32_t, count);
+    int32_t old_count = ecs_vec_count(vec);
+
+    if (new_count < old_count && ti->hooks.dtor) {
+        ti->hooks.dtor(ECS_ELEM(vec->array, size, new_count),
+            old_count - new_count, ti);
+    }
+
+    /* Vectors in component values use the OS allocator */
+    ecs_vec_init_if(vec, size);
+    ecs_vec_set_count(NULL, vec, size, new_count);
+
+    if (new_count > old_count) {
+        void *ptr = ECS_ELEM(vec->array, size, old_count);
+        if (ti->hooks.ctor) {
+            ti->hooks.ctor(ptr, new_count - old_count, ti);
+        } else {
+            ecs_os_memset(ptr, 0, size * (new_count - old_count));
+        }
+    }
+
+    if (!new_count) {
+        return 0;
+    }
+
+    return flecs_binary_de_elements(de, v->type, vec->array, new_count);
+}
+
+static
+int flecs_binary_de_type_op(
+    ecs_binary_de_t *de,
+    ecs_meta_type_op_t *op,
+    void *base)
+{
+    void *ptr = ECS_OFFSET(base, op->offset);
+
+    switch(op->kind) {
+    case EcsOpString: {
+        uint32_t len;
+        if (flecs_binary_read_u32(&de->r, &len)) {
+            return -1;
+        }
+
+        char *str = NULL;
+        if (len != FLECS_BINARY_NULL_STRING) {
+            if (flecs_binary_check_length(&de->r, len, 1, 1)) {
+                return -1;
+            }
+            str = ecs_os_malloc(flecs_uto(ecs_size_t, len + 1));
+            if (flecs_binary_read(&de->r, str, (ecs_size_t)len)) {
+                ecs_os_free(str);
+                return -1;
+            }
+            str[len] = '\0';
+        }
+
+        ecs_os_free(*(char**)ptr);
+        *(char**)ptr = str;
+        break;
+    }
+    case EcsOpEntity:
+        return flecs_binary_de_entity(de, ptr);
+    case EcsOpId:
+        return flecs_binary_de_id(de, ptr);
+    case EcsOpArray: {
+        const EcsArray *a = ecs_get(de->world, op->type, EcsArray);
+        ecs_assert(a != NULL, ECS_INTERNAL_ERROR, NULL);
+        return flecs_binary_de_elements(de, a->type, ptr, a->count);
+    }
+    case EcsOpVector:
+        return flecs_binary_de_vector(de, op, ptr);
+    case EcsOpEnum:
+    case EcsOpBitmask:
+    case EcsOpBool:
+    case EcsOpChar:
+    case EcsOpByte:
+    case EcsOpU8:
+    case EcsOpU16:
+    case EcsOpU32:
+    case EcsOpU64:
+    case EcsOpI8:
+    case EcsOpI16:
+    case EcsOpI32:
+    case EcsOpI64:
+    case EcsOpF32:
+    case EcsOpF64:
+    case EcsOpUPtr:
+    case EcsOpIPtr:
+        return flecs_binary_read(&de->r, ptr, op->size);
+    case EcsOpOpaque:
+    case EcsOpPush:
+    case EcsOpPop:
+    case EcsOpScope:
+    case EcsOpPrimitive:
+    default:
+        ecs_abort(ECS_INTERNAL_ERROR, NULL);
+    }
+
+    return 0;
+}
+
+/* Iterate over a slice of the type ops array */
+static
+int flecs_binary_de_type_ops(
+    ecs_binary_de_t *de,
+    ecs_meta_type_op_t *ops,
+    int32_t op_count,
+    void *base,
+    int32_t in_array)
+{
+    int32_t i, j;
+    for (i = 0; i < op_count; i ++) {
+        ecs_meta_type_op_t *op = &ops[i];
+
+        if (in_array <= 0) {
+            int32_t elem_count = op->count;
+            if (elem_count > 1) {
+                /* Deserialize inline array */
+                for (j = 0; j < elem_count; j ++) {
+                    if (flecs_binary_de_type_ops(de, op, op->op_count,
+                        ECS_OFFSET(base, j * op->size), 1))
+                    {
+                        return -1;
+                    }
+                }
+                i += op->op_count - 1;
+                continue;
+            }
+        }
+
+        if (op->kind == EcsOpPush) {
+            in_array --;
+        } else if (op->kind == EcsOpPop) {
+            in_array ++;
+        } else if (flecs_binary_de_type_op(de, op, base)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Compute ids that are added and removed when moving between tables */
+static
+void flecs_binary_type_diff(
+    ecs_binary_de_t *de,
+    const ecs_type_t *src,
+    const ecs_type_t *dst)
+{
+    ecs_vec_clear(&de->added);
+    ecs_vec_clear(&de->removed);
+
+    int32_t i_src = 0, i_dst = 0;
+    int32_t src_count = src ? src->count : 0, dst_count = dst->count;
+    while (i_src < src_count || i_dst < dst_count) {
+        if (i_dst == dst_count ||
+            (i_src < src_count && src->array[i_src] < dst->array[i_dst]))
+        {
+            ecs_vec_append_t(de->a, &de->removed, ecs_id_t)[0] =
+                src->array[i_src ++];
+        } else if (i_src == src_count ||
+            src->array[i_src] > dst->array[i_dst])
+        {
+            ecs_vec_append_t(de->a, &de->added, ecs_id_t)[0] =
+                dst->array[i_dst ++];
+        } else {
+            i_src ++;
+            i_dst ++;
+        }
+    }
+}
+
+static
+int flecs_binary_de_entities(
+    ecs_binary_de_t *de,
+    ecs_table_t *table)
+{
+    ecs_world_t *world = de->world;
+    uint32_t i, count;
+    if (flecs_binary_read_u32(&de->r, &count)) {
+        return -1;
+    }
+
+    ecs_vec_clear(&de->records);
+
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e;
+        if (flecs_binary_de_entity(de, &e)) {
+            return -1;
+        }
+
+        ecs_record_t *r = flecs_entities_try(world, e);
+        ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+
+        if (r->table != table) {
+            ecs_table_t *src = r->table;
+            flecs_binary_type_diff(de, src ? &src->type : NULL, &table->type);
+            ecs_type_t added = {
+                .array = ecs_vec_first(&de->added),
+                .count = ecs_vec_count(&de->added)
+            };
+            ecs_type_t removed = {
+                .array = ecs_vec_first(&de->removed),
+                .count = ecs_vec_count(&de->removed)
+            };
+            ecs_commit(world, e, r, table, &added, &removed);
+        }
+
+        if (r->table != table) {
+            ecs_err("binary: failed to add entity to table");
+            return -1;
+        }
+
+        ecs_vec_append_t(de->a, &de->records, ecs_record_t*)[0] = r;
+    }
+
+    return 0;
+}
+
+static
+int flecs_binary_de_column(
+    ecs_binary_de_t *de,
+    ecs_table_t *table,
+    ecs_id_t id)
+{
+    ecs_world_t *world = de->world;
+    uint8_t kind;
+    if (flecs_binary_read_u8(&de->r, &kind)) {
+        return -1;
+    }
+
+    if (kind == FLECS_BINARY_COLUMN_NONE) {
+        return 0;
+    }
+
+    uint64_t hash, size;
+    if (flecs_binary_read_u64(&de->r, &hash) ||
+        flecs_binary_read_u64(&de->r, &size))
+    {
+        return -1;
+    }
+
+    const ecs_binary_type_t *bt = NULL;
+    ecs_column_t *column = NULL;
+    ecs_table_record_t *tr = flecs_table_record_get(world, table, id);
+    ecs_assert(tr != NULL, ECS_INTERNAL_ERROR, NULL);
+    if (tr->column != -1) {
+        column = &table->data.columns[tr->column];
+        bt = flecs_binary_get_type(world, de->a, &de->types,
+            column->ti->component);
+    }
+
+    int32_t i, count = ecs_vec_count(&de->records);
+    ecs_record_t **records = ecs_vec_first(&de->records);
+
+    if (!bt || !bt->is_valid || bt->hash != hash ||
+        (bt->is_pod != (kind == FLECS_BINARY_COLUMN_POD)))
+    {
+        char *id_str = ecs_id_str(world, id);
+        if (de->desc->strict) {
+            ecs_err("binary: layout of '%s' does not match stored data",
+                id_str);
+            ecs_os_free(id_str);
+            return -1;
+        }
+        ecs_dbg("binary: skipping values for '%s'", id_str);
+        ecs_os_free(id_str);
+        return flecs_binary_skip(&de->r, size);
+    }
+
+    ecs_size_t elem_size = bt->ti->size;
+
+    if (bt->is_pod) {
+        if (size != flecs_ito(uint64_t, elem_size * count)) {
+            ecs_err("binary: invalid column size");
+            return -1;
+        }
+
+        /* If entities are stored in consecutive rows, read all values at once.
+         * This is the common case when loading into an empty world. */
+        int32_t first_row = count ? ECS_RECORD_TO_ROW(records[0]->row) : 0;
+        for (i = 1; i < count; i ++) {
+            if (ECS_RECORD_TO_ROW(records[i]->row) != (first_row + i)) {
+                break;
+            }
+        }
+
+        if (i == count) {
+            void *ptr = ecs_vec_get(&column->data, elem_size, first_row);
+            if (flecs_binary_read(&de->r, ptr, elem_size * count)) {
+                return -1;
+            }
+        } else {
+            for (i = 0; i < count; i ++) {
+                int32_t row = ECS_RECORD_TO_ROW(records[i]->row);
+                void *ptr = ecs_vec_get(&column->data, elem_size, row);
+                if (flecs_binary_read(&de->r, ptr, elem_size)) {
+                    return -1;
+                }
+            }
+        }
+    } else {
+        for (i = 0; i < count; i ++) {
+            int32_t row = ECS_RECORD_TO_ROW(records[i]->row);
+            void *ptr = ecs_vec_get(&column->data, elem_size, row);
+            if (flecs_binary_de_type_ops(de, bt->ops, bt->op_count, ptr, 0)) {
+                return -1;
+            }
+        }
+    }
+
+    ecs_vec_append_t(de->a, &de->columns_set, ecs_id_t)[0] = id;
+
+    return 0;
+}
+
+static
+int flecs_binary_de_table(
+    ecs_binary_de_t *de)
+{
+    ecs_world_t *world = de->world;
+    uint32_t i, id_count;
+    if (flecs_binary_read_u32(&de->r, &id_count)) {
+        return -1;
+    }
+
+    ecs_vec_clear(&de->ids);
+    for (i = 0; i < id_count; i ++) {
+        ecs_id_t id;
+        if (flecs_binary_de_id(de, &id)) {
+            return -1;
+        }
+        ecs_vec_append_t(de->a, &de->ids, ecs_id_t)[0] = id;
+    }
+
+    /* Ids are sorted in the world that wrote the data, but may not be sorted
+     * after being mapped to entities in this world. Keep the original order,
+     * since columns are stored in that order. */
+    ecs_vec_t id_copy = ecs_vec_copy_t(de->a, &de->ids, ecs_id_t);
+    ecs_type_t type = {
+        .array = ecs_vec_first(&id_copy),
+        .count = ecs_vec_count(&id_copy)
+    };
+
+    qsort(type.array, flecs_itosize(type.count), sizeof(ecs_id_t),
+        flecs_id_qsort_cmp);
+
+    ecs_table_t *table = flecs_table_find_or_create(world, &type);
+    ecs_vec_fini_t(de->a, &id_copy, ecs_id_t);
+    if (!table) {
+        return -1;
+    }
+
+    if (flecs_binary_de_entities(de, table)) {
+        return -1;
+    }
+
+    ecs_vec_clear(&de->columns_set);
+    ecs_id_t *ids = ecs_vec_first(&de->ids);
+    for (i = 0; i < id_count; i ++) {
+        if (flecs_binary_de_column(de, table, ids[i])) {
+            return -1;
+        }
+    }
+
+    /* Send OnSet notifications */
+    ecs_defer_begin(world);
+    ecs_type_t set_type = {
+        .array = ecs_vec_first(&de->columns_set),
+        .count = ecs_vec_count(&de->columns_set) };
+
+    int32_t record_count = ecs_vec_count(&de->records);
+    if (ecs_table_count(table) == record_count) {
+        flecs_notify_on_set(world, table, 0, record_count, &set_type, true);
+    } else {
+        ecs_record_t **records = ecs_vec_first(&de->records);
+        int32_t r;
+        for (r = 0; r < record_count; r ++) {
+            int32_t row = ECS_RECORD_TO_ROW(records[r]->row);
+            flecs_notify_on_set(world, table, row, 1, &set_type, true);
+        }
+    }
+    ecs_defer_end(world);
+
+    return 0;
+}
+
+static
+int flecs_world_from_binary(
+    ecs_world_t *world,
+    ecs_binary_reader_t *r,
+    const ecs_from_binary_desc_t *desc_arg)
+{
+    ecs_from_binary_desc_t desc = {0};
+    if (desc_arg) {
+        desc = *desc_arg;
+    }
+
+    ecs_binary_de_t de = {
+        .world = world,
+        .a = &world->allocator,
+        .r = *r,
+        .desc = &desc
+    };
+
+    ecs_map_init(&de.entities, de.a);
+    ecs_map_init(&de.issued, de.a);
+    ecs_map_init(&de.types, de.a);
+    ecs_vec_init_t(de.a, &de.ids, ecs_id_t, 0);
+    ecs_vec_init_t(de.a, &de.records, ecs_record_t*, 0);
+    ecs_vec_init_t(de.a, &de.columns_set, ecs_id_t, 0);
+    ecs_vec_init_t(de.a, &de.added, ecs_id_t, 0);
+    ecs_vec_init_t(de.a, &de.removed, ecs_id_t, 0);
+
+    /* Paths are resolved from the root */
+    ecs_entity_t old_scope = ecs_set_scope(world, 0);
+    ecs_id_t old_with = ecs_set_with(world, 0);
+
+    int result = -1;
+    char magic[4];
+    uint32_t version, byte_order, ptr_size;
+    if (flecs_binary_read(&de.r, magic, 4) ||
+        flecs_binary_read_u32(&de.r, &version) ||
+        flecs_binary_read_u32(&de.r, &byte_order) ||
+        flecs_binary_read_u32(&de.r, &ptr_size))
+    {
+        goto done;
+    }
+
+    if (ecs_os_memcmp(magic, FLECS_BINARY_MAGIC, 4)) {
+        ecs_err("binary: invalid data");
+        goto done;
+    }
+
+    if (version != FLECS_BINARY_VERSION) {
+        ecs_err("binary: unsupported version %u", version);
+        goto done;
+    }
+
+    if (byte_order != FLECS_BINARY_BYTE_ORDER ||
+        ptr_size != (uint32_t)ECS_SIZEOF(void*))
+    {
+        ecs_err("binary: data was written by incompatible platform");
+        goto done;
+    }
+
+    do {
+        uint8_t kind;
+        if (flecs_binary_read_u8(&de.r, &kind)) {
+            goto done;
+        }
+
+        if (kind == FLECS_BINARY_END) {
+            break;
+        } else if (kind == FLECS_BINARY_TABLE) {
+            if (flecs_binary_de_table(&de)) {
+                goto done;
+            }
+        } else {
+            ecs_err("binary: invalid data");
+            goto done;
+        }
+    } while (true);
+
+    result = 0;
+done:
+    ecs_set_with(world, old_with);
+    ecs_set_scope(world, old_scope);
+
+    ecs_map_fini(&de.entities);
+    ecs_map_fini(&de.issued);
+    flecs_binary_types_fini(de.a, &de.types);
+    ecs_vec_fini_t(de.a, &de.ids, ecs_id_t);
+    ecs_vec_fini_t(de.a, &de.records, ecs_record_t*);
+    ecs_vec_fini_t(de.a, &de.columns_set, ecs_id_t);
+    ecs_vec_fini_t(de.a, &de.added, ecs_id_t);
+    ecs_vec_fini_t(de.a, &de.removed, ecs_id_t);
+    return result;
+}
+
+int ecs_world_from_binary(
+    ecs_world_t *world,
+    const void *data,
+    ecs_size_t size,
+    const ecs_from_binary_desc_t *desc)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(data != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_binary_reader_t r = {
+        .ptr = data,
+        .end = ECS_OFFSET(data, size)
+    };
+
+    return flecs_world_from_binary(world, &r, desc);
+error:
+    return -1;
+}
+
+int ecs_world_from_binary_stream(
+    ecs_world_t *world,
+    ecs_binary_read_action_t read,
+    void *ctx,
+    const ecs_from_binary_desc_t *desc)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(read != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_binary_reader_t r = {
+        .read = read,
+        .ctx = ctx,
+        .buf = ecs_os_malloc(FLECS_BINARY_CHUNK_SIZE)
+    };
+
+    int result = flecs_world_from_binary(world, &r, desc);
+    ecs_os_free(r.buf);
+    return result;
+error:
+    return -1;
+}
+
+static
+ecs_size_t flecs_binary_fd_read(
+    void *data,
+    ecs_size_t size,
+    void *ctx)
+{
+    int fd = *(int*)ctx;
+#if defined(ECS_TARGET_WINDOWS)
+    return _read(fd, data, (unsigned int)size);
+#else
+    return (ecs_size_t)read(fd, data, (size_t)size);
+#endif
+}
+
+int ecs_world_from_binary_fd(
+    ecs_world_t *world,
+    int fd,
+    const ecs_from_binary_desc_t *desc)
+{
+    return ecs_world_from_binary_stream(world, flecs_binary_fd_read, &fd, desc);
+}
+
+#endif
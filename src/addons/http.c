@@ -35,6 +35,7 @@
  */
 
 #include "../private_api.h"
+#include <ctype.h>
 
 #ifdef FLECS_HTTP
 
@@ -59,6 +60,7 @@ typedef SOCKET ecs_http_socket_t;
 #include <strings.h>
 #include <signal.h>
 #include <fcntl.h>
+#include <poll.h>
 #ifdef __FreeBSD__
 #include <netinet/in.h>
 #endif
@@ -73,14 +75,11 @@ typedef int ecs_http_socket_t;
 /* Max length of request method */
 #define ECS_HTTP_METHOD_LEN_MAX (8) 
 
-/* Timeout (s) before connection purge */
-#define ECS_HTTP_CONNECTION_PURGE_TIMEOUT (1.0)
+/* Timeout (s) before an idle keep-alive connection is closed */
+#define ECS_HTTP_CONNECTION_IDLE_TIMEOUT (30.0)
 
-/* Number of dequeues before purging */
-#define ECS_HTTP_CONNECTION_PURGE_RETRY_COUNT (5)
-
-/* Number of retries receiving request */
-#define ECS_HTTP_REQUEST_RECV_RETRY (10)
+/* Max time (ms) the I/O thread waits for socket events */
+#define ECS_HTTP_POLL_TIMEOUT (100)
 
 /* Minimum interval between dequeueing requests (ms) */
 #define ECS_HTTP_MIN_DEQUEUE_INTERVAL (50)
@@ -97,6 +96,26 @@ typedef int ecs_http_socket_t;
 /* Total number of outstanding send requests */
 #define ECS_HTTP_SEND_QUEUE_MAX (256)
 
+/* Number of bytes queued on a connection before a chunked reply waits for the
+ * data to be sent */
+#define ECS_HTTP_SEND_QUEUE_BYTES_MAX (1024 * 1024)
+
+/* Max time (s) a chunked reply waits for a client to receive data before the
+ * reply is aborted. Replies are flushed on the main thread, so this limits how
+ * long a client that stops reading can stall a frame. */
+#define ECS_HTTP_FLUSH_TIMEOUT (0.5)
+
+/* Minimum size of a reply body before it's compressed */
+#define ECS_HTTP_COMPRESS_MIN (1024)
+
+/* Parameters of the deflate compressor. Longer hash chains find better matches
+ * at the cost of speed. */
+#define ECS_HTTP_DEFLATE_WINDOW (32 * 1024)
+#define ECS_HTTP_DEFLATE_HASH_BITS (15)
+#define ECS_HTTP_DEFLATE_CHAIN_MAX (16)
+#define ECS_HTTP_DEFLATE_MATCH_MIN (3)
+#define ECS_HTTP_DEFLATE_MATCH_MAX (258)
+
 /* Global statistics */
 int64_t ecs_http_request_received_count = 0;
 int64_t ecs_http_request_invalid_count = 0;
@@ -108,22 +127,33 @@ int64_t ecs_http_send_ok_count = 0;
 int64_t ecs_http_send_error_count = 0;
 int64_t ecs_http_busy_count = 0;
 
-/* Send request queue */
+/* Reply data waiting to be sent on a connection */
 typedef struct ecs_http_send_request_t {
-    ecs_http_socket_t sock;
     char *headers;
     int32_t header_length;
     char *content;
     int32_t content_length;
+    int32_t sent;   /* Number of bytes of headers + content already sent */
+    uint64_t seq;   /* Sequence number of request on connection */
+    bool last;      /* Last part of reply (chunked replies have many parts) */
+    bool close;     /* Close connection after reply is sent */
 } ecs_http_send_request_t;
 
-typedef struct ecs_http_send_queue_t {
-    ecs_http_send_request_t requests[ECS_HTTP_SEND_QUEUE_MAX];
-    int32_t head;
-    int32_t tail;
-    ecs_os_thread_t thread;
-    int32_t wait_ms;
-} ecs_http_send_queue_t;
+/* State of gzip encoded reply. Chunked replies are compressed one chunk at a
+ * time, the checksum and size of the uncompressed data are sent at the end.
+ * The hash chains and the last window of data are kept between chunks, so that
+ * a chunk can refer to strings in earlier chunks. */
+typedef struct ecs_http_gzip_t {
+    uint32_t crc;   /* CRC32 of uncompressed data */
+    uint32_t size;  /* Size of uncompressed data (modulo 2^32) */
+    bool started;   /* Whether gzip header was written */
+    int32_t *head;  /* Last position + 1 for each hash */
+    int32_t *prev;  /* Previous position + 1 with same hash, per position */
+    uint8_t *window; /* Last ECS_HTTP_DEFLATE_WINDOW bytes of data */
+    int32_t window_length;
+    int32_t offset; /* Position of the first byte in window */
+    int32_t hashed; /* Positions before this are in the hash chains */
+} ecs_http_gzip_t;
 
 typedef struct ecs_http_request_key_t {
     const char *array;
@@ -168,7 +198,12 @@ struct ecs_http_server_t {
     int32_t requests_processed; /* requests processed in last stats interval */
     int32_t requests_processed_total; /* total requests processed */
     int32_t dequeue_count; /* number of dequeues in last stats interval */ 
-    ecs_http_send_queue_t send_queue;
+
+    int32_t send_count; /* send requests queued on all connections */
+    int32_t poll_timeout; /* max time (ms) I/O thread waits for events */
+#ifndef ECS_TARGET_WINDOWS
+    int wakeup[2]; /* pipe used to wake up I/O thread when data is queued */
+#endif
 
     ecs_hashmap_t request_cache;
 };
@@ -208,18 +243,29 @@ typedef struct {
     char header_buf[32];
     bool parse_content_length;
     bool invalid;
+    char version_minor; /* last character of HTTP version */
 } ecs_http_fragment_t;
 
-/** Extend public connection type with fragment data */
+/** Extend public connection type with fragment data.
+ * Connections are kept open after a reply is sent, so that clients can send
+ * more requests without reconnecting. Requests can be pipelined: each request
+ * gets a sequence number, which makes sure replies are sent in the order
+ * requests were received, even if they're handled in a different order. */
 typedef struct {
     ecs_http_connection_t pub;
     ecs_http_socket_t sock;
 
-    /* Connection is purged after both timeout expires and connection has
-     * exceeded retry count. This ensures that a connection does not immediately
-     * timeout when a frame takes longer than usual */
-    double dequeue_timeout;
-    int32_t dequeue_retries;    
+    ecs_http_fragment_t frag;   /* Request that's being received */
+    ecs_vec_t send_queue;       /* vec<ecs_http_send_request_t> */
+    int32_t send_bytes;         /* Bytes in send queue */
+    uint64_t recv_seq;          /* Sequence number of next received request */
+    uint64_t send_seq;          /* Sequence number of next reply to send */
+    int32_t request_count;      /* Requests waiting to be handled */
+    uint64_t stream_seq;        /* Sequence number of open stream */
+    double last_active;         /* Time of last send or receive */
+    bool closing;               /* Close after outstanding replies are sent */
+    bool want_write;            /* Socket buffer was full during last send */
+    bool stream;                /* Reply is kept open to push data */
 } ecs_http_connection_impl_t;
 
 typedef struct {
@@ -227,8 +273,23 @@ typedef struct {
     uint64_t conn_id; /* for sanity check */
     char *res;
     int32_t req_len;
+    uint64_t seq; /* sequence number of request on connection */
+    bool close; /* close connection after reply */
+    bool gzip; /* client accepts gzip encoded reply */
+    bool stream; /* reply was turned into a stream by handler */
+    double flush_wait; /* time (s) spent waiting for client to receive data */
+    ecs_http_gzip_t gzip_state; /* compressor state of chunked reply */
 } ecs_http_request_impl_t;
 
+static
+bool http_would_block(void) {
+#if defined(ECS_TARGET_WINDOWS)
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+
 static
 ecs_size_t http_send(
     ecs_http_socket_t sock, 
@@ -263,7 +324,10 @@ ecs_size_t http_recv(
     ret = flecs_itoi32(recv_bytes);
 #endif
     if (ret == -1) {
-        ecs_dbg("recv failed: %s (sock = %d)", ecs_os_strerror(errno), sock);
+        if (!http_would_block()) {
+            ecs_dbg("recv failed: %s (sock = %d)", 
+                ecs_os_strerror(errno), sock);
+        }
     } else if (ret == 0) {
         ecs_dbg("recv: received 0 bytes (sock = %d)", sock);
     }
@@ -271,27 +335,6 @@ ecs_size_t http_recv(
     return ret;
 }
 
-static
-void http_sock_set_timeout(
-    ecs_http_socket_t sock,
-    int32_t timeout_ms)
-{
-    int r;
-#ifdef ECS_TARGET_POSIX
-    struct timeval tv;
-    tv.tv_sec = timeout_ms * 1000;
-    tv.tv_usec = 0;
-    r = setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&tv, sizeof tv);
-#else
-    DWORD t = (DWORD)timeout_ms;
-    r = setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&t, sizeof t);
-#endif
-    if (r) {
-        ecs_warn("http: failed to set socket timeout: %s", 
-            ecs_os_strerror(errno));
-    }
-}
-
 static
 void http_sock_keep_alive(
     ecs_http_socket_t sock)
@@ -325,6 +368,25 @@ void http_sock_nonblock(ecs_http_socket_t sock, bool enable) {
             ecs_os_strerror(errno));
         return;
     }
+#else
+    u_long mode = enable;
+    if (ioctlsocket(sock, FIONBIO, &mode)) {
+        ecs_warn("http: failed to set socket NONBLOCK: %d",
+            WSAGetLastError());
+    }
+#endif
+}
+
+static
+int http_poll(
+    struct pollfd *fds,
+    int32_t count,
+    int32_t timeout_ms)
+{
+#if defined(ECS_TARGET_WINDOWS)
+    return WSAPoll(fds, (ULONG)count, timeout_ms);
+#else
+    return poll(fds, (nfds_t)count, timeout_ms);
 #endif
 }
 
@@ -383,6 +445,17 @@ bool http_socket_is_valid(
 #define HTTP_SOCKET_INVALID (-1)
 #endif
 
+static
+void http_shutdown(
+    ecs_http_socket_t sock)
+{
+#if defined(ECS_TARGET_WINDOWS)
+    shutdown(sock, SD_BOTH);
+#else
+    shutdown(sock, SHUT_RDWR);
+#endif
+}
+
 static
 void http_close(
     ecs_http_socket_t *sock)
@@ -414,18 +487,71 @@ ecs_http_socket_t http_accept(
 static
 void http_reply_fini(ecs_http_reply_t* reply) {
     ecs_assert(reply != NULL, ECS_INTERNAL_ERROR, NULL);
-    ecs_os_free(reply->body.content);
+    ecs_strbuf_reset(&reply->body);
+}
+
+static
+void http_gzip_fini(
+    ecs_http_gzip_t *gz)
+{
+    ecs_os_free(gz->head);
+    ecs_os_free(gz->prev);
+    ecs_os_free(gz->window);
+    gz->head = NULL;
+    gz->prev = NULL;
+    gz->window = NULL;
 }
 
+/* Release resources of request. Doesn't remove the request from the server, so
+ * that requests can be removed in bulk (see http_requests_free). */
 static
 void http_request_fini(ecs_http_request_impl_t *req) {
     ecs_assert(req != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(req->pub.conn != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(req->pub.conn->server != NULL, ECS_INTERNAL_ERROR, NULL);
     ecs_assert(req->pub.conn->id == req->conn_id, ECS_INTERNAL_ERROR, NULL);
+    http_gzip_fini(&req->gzip_state);
     ecs_os_free(req->res);
-    flecs_sparse_remove_t(&req->pub.conn->server->requests, 
-        ecs_http_request_impl_t, req->pub.id);
+    ((ecs_http_connection_impl_t*)req->pub.conn)->request_count --;
+}
+
+/* Remove the first count requests from server. Ids are copied as removing
+ * requests moves elements of the dense array. */
+static
+void http_requests_free(
+    ecs_http_server_t *srv,
+    int32_t count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    /* Skip element with id 0, which is reserved */
+    const uint64_t *ids = &flecs_sparse_ids(&srv->requests)[1];
+    uint64_t *ids_copy = ecs_os_memdup_n(ids, uint64_t, count);
+    flecs_sparse_remove_n_t(&srv->requests, ecs_http_request_impl_t, 
+        ids_copy, count);
+    ecs_os_free(ids_copy);
+}
+
+static
+void http_send_request_fini(
+    ecs_http_connection_impl_t *conn,
+    int32_t index)
+{
+    ecs_http_send_request_t *requests = ecs_vec_first(&conn->send_queue);
+    ecs_http_send_request_t *r = &requests[index];
+    conn->send_bytes -= r->header_length + r->content_length;
+    conn->pub.server->send_count --;
+    ecs_os_free(r->headers);
+    ecs_os_free(r->content);
+
+    /* Keep remaining requests in order, as parts of a reply are sent in the
+     * order in which they were queued */
+    int32_t count = ecs_vec_count(&conn->send_queue);
+    ecs_os_memmove(r, &r[1],
+        (count - index - 1) * ECS_SIZEOF(ecs_http_send_request_t));
+    ecs_vec_remove_last(&conn->send_queue);
 }
 
 static
@@ -438,6 +564,13 @@ void http_connection_free(ecs_http_connection_impl_t *conn) {
         http_close(&conn->sock);
     }
 
+    int32_t i;
+    for (i = ecs_vec_count(&conn->send_queue) - 1; i >= 0; i --) {
+        http_send_request_fini(conn, i);
+    }
+    ecs_vec_fini_t(NULL, &conn->send_queue, ecs_http_send_request_t);
+    ecs_strbuf_reset(&conn->frag.buf);
+
     flecs_sparse_remove_t(&conn->pub.server->connections, 
         ecs_http_connection_impl_t, conn_id);
 }
@@ -568,7 +701,7 @@ void http_insert_request_entry(
     ecs_http_reply_t *reply)
 {
     int32_t content_length = ecs_strbuf_written(&reply->body);
-    if (!content_length) {
+    if (!content_length || reply->chunked) {
         return;
     }
 
@@ -641,47 +774,108 @@ char* http_decode_request(
 }
 
 static
-ecs_http_request_entry_t* http_enqueue_request(
-    ecs_http_connection_impl_t *conn,
-    uint64_t conn_id,
-    ecs_http_fragment_t *frag)
+bool http_header_equals(
+    const char *str,
+    const char *lit)
 {
-    ecs_http_server_t *srv = conn->pub.server;
+    for (; *str && *lit; str ++, lit ++) {
+        if (tolower(*str) != tolower(*lit)) {
+            return false;
+        }
+    }
+    return !*str && !*lit;
+}
 
-    ecs_os_mutex_lock(srv->lock);
-    bool is_alive = conn->pub.id == conn_id;
+static
+const char* http_request_header(
+    ecs_http_fragment_t *frag,
+    const char *name)
+{
+    const char *buf = frag->buf.content;
+    int32_t i, count = frag->header_count;
+    for (i = 0; i < count; i ++) {
+        if (http_header_equals(&buf[frag->header_offsets[i]], name)) {
+            return &buf[frag->header_value_offsets[i]];
+        }
+    }
+    return NULL;
+}
 
-    if (!is_alive || frag->invalid) { 
-        /* Don't enqueue invalid requests or requests for purged connections */
-        ecs_strbuf_reset(&frag->buf);
-    } else {
-        ecs_http_request_impl_t req;
-        char *res = http_decode_request(&req, frag);
-        if (res) {
-            req.pub.conn = (ecs_http_connection_t*)conn;
-
-            /* Check cache for GET requests */
-            if (frag->method == EcsHttpGet) {
-                ecs_http_request_entry_t *entry = 
-                    http_find_request_entry(srv, res, frag->header_offsets[0]);
-                if (entry) {
-                    /* If an entry is found, don't enqueue a request. Instead
-                     * return the cached response immediately. */
-                    ecs_os_free(res);
-                    return entry;
-                }
+static
+bool http_request_gzip(
+    ecs_http_fragment_t *frag)
+{
+    const char *encoding = http_request_header(frag, "Accept-Encoding");
+    return encoding && strstr(encoding, "gzip");
+}
+
+static
+bool http_request_close(
+    ecs_http_fragment_t *frag)
+{
+    /* HTTP/1.1 connections are persistent by default, HTTP/1.0 connections
+     * are closed after the reply unless the client asks for keep-alive */
+    bool close = frag->version_minor == '0';
+    const char *buf = frag->buf.content;
+    int32_t i, count = frag->header_count;
+    for (i = 0; i < count; i ++) {
+        const char *key = &buf[frag->header_offsets[i]];
+        if (http_header_equals(key, "Connection")) {
+            const char *value = &buf[frag->header_value_offsets[i]];
+            if (http_header_equals(value, "close")) {
+                close = true;
+            } else if (http_header_equals(value, "keep-alive")) {
+                close = false;
             }
+        }
+    }
+    return close;
+}
 
-            ecs_http_request_impl_t *req_ptr = flecs_sparse_add_t(
-                &srv->requests, ecs_http_request_impl_t);
-            *req_ptr = req;
-            req_ptr->pub.id = flecs_sparse_last_id(&srv->requests);
-            req_ptr->conn_id = conn->pub.id;
-            ecs_os_linc(&ecs_http_request_received_count);
+static
+ecs_http_request_entry_t* http_enqueue_request(
+    ecs_http_connection_impl_t *conn,
+    ecs_http_fragment_t *frag,
+    uint64_t seq,
+    bool close)
+{
+    /* Must be called while server is locked */
+    ecs_http_server_t *srv = conn->pub.server;
+    bool gzip = http_request_gzip(frag);
+
+    /* Cached replies don't have the headers the client needs to validate its
+     * own copy, so let the handler reply to conditional requests */
+    bool conditional = http_request_header(frag, "If-None-Match") != NULL;
+
+    ecs_http_request_impl_t req;
+    char *res = http_decode_request(&req, frag);
+    if (res) {
+        req.pub.conn = (ecs_http_connection_t*)conn;
+
+        /* Check cache for GET requests */
+        if (frag->method == EcsHttpGet && !conditional) {
+            ecs_http_request_entry_t *entry = 
+                http_find_request_entry(srv, res, frag->header_offsets[0]);
+            if (entry) {
+                /* If an entry is found, don't enqueue a request. Instead
+                 * return the cached response immediately. */
+                ecs_os_free(res);
+                return entry;
+            }
         }
+
+        ecs_http_request_impl_t *req_ptr = flecs_sparse_add_t(
+            &srv->requests, ecs_http_request_impl_t);
+        *req_ptr = req;
+        req_ptr->pub.id = flecs_sparse_last_id(&srv->requests);
+        req_ptr->conn_id = conn->pub.id;
+        req_ptr->seq = seq;
+        req_ptr->close = close;
+        req_ptr->gzip = gzip;
+        conn->request_count ++;
+        ecs_os_linc(&ecs_http_request_received_count);
     }
 
-    ecs_os_mutex_unlock(srv->lock);
     return NULL;
 }
 
@@ -689,7 +883,8 @@ static
 bool http_parse_request(
     ecs_http_fragment_t *frag,
     const char* req_frag, 
-    ecs_size_t req_frag_len) 
+    ecs_size_t req_frag_len,
+    ecs_size_t *consumed) 
 {
     int32_t i;
     for (i = 0; i < req_frag_len; i++) {
@@ -707,6 +902,17 @@ bool http_parse_request(
                 ecs_strbuf_reset(&frag->buf);
                 frag->state = HttpFragStatePath;
                 frag->buf.content = NULL;
+            } else if ((c == '\r' || c == '\n') && 
+                !ecs_strbuf_written(&frag->buf)) 
+            {
+                /* Ignore empty lines before request line */
+            } else if (c == '\r' || 
+                ecs_strbuf_written(&frag->buf) >= ECS_HTTP_METHOD_LEN_MAX) 
+            {
+                /* Not a valid request line, don't wait for more data */
+                ecs_strbuf_reset(&frag->buf);
+                frag->invalid = true;
+                frag->state = HttpFragStateDone;
             } else {
                 ecs_strbuf_appendch(&frag->buf, c);
             }
@@ -733,7 +939,10 @@ bool http_parse_request(
         case HttpFragStateVersion:
             if (c == '\r') {
                 frag->state = HttpFragStateCR;
-            } /* version is not stored */
+            } else {
+                /* Only the minor version is stored, to detect HTTP/1.0 */
+                frag->version_minor = c;
+            }
             break;
         case HttpFragStateHeaderStart:
             if (http_header_writable(frag)) {
@@ -843,6 +1052,17 @@ bool http_parse_request(
         case HttpFragStateDone:
             break;
         }
+
+        if (frag->state == HttpFragStateDone) {
+            /* Don't parse past the end of the request, the remaining data 
+             * belongs to the next (pipelined) request */
+            i ++;
+            break;
+        }
+    }
+
+    if (consumed) {
+        *consumed = i;
     }
 
     if (frag->state == HttpFragStateDone) {
@@ -852,289 +1072,817 @@ bool http_parse_request(
     }
 }
 
-static
-ecs_http_send_request_t* http_send_queue_post(
-    ecs_http_server_t *srv)
-{
-    /* This function should only be called while the server is locked. Before 
-     * the lock is released, the returned element should be populated. */
-    ecs_http_send_queue_t *sq = &srv->send_queue;
-    int32_t next = (sq->head + 1) % ECS_HTTP_SEND_QUEUE_MAX;
-    if (next == sq->tail) {
-        return NULL;
-    }
+/* Compression. Replies are gzip encoded with a deflate compressor that finds
+ * repeated strings with a hash chain, and encodes them with the fixed Huffman
+ * codes from the deflate spec (RFC 1951). Fixed codes don't compress as well as
+ * dynamic codes, but JSON replies are repetitive enough that most of the gain
+ * comes from matching strings. */
 
-    /* Don't enqueue new requests if server is shutting down */
-    if (!srv->should_run) {
-        return NULL;
-    }
+static uint32_t http_crc_table[256];
 
-    /* Return element at end of the queue */
-    ecs_http_send_request_t *result = &sq->requests[sq->head];
-    sq->head = next;
-    return result;
-}
+/* Fixed Huffman codes, bit reversed so they can be written directly */
+static uint16_t http_symbol_code[288];
+static uint8_t http_symbol_bits[288];
+static uint8_t http_dist_code[30];
+
+static const uint16_t http_length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
+    67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint8_t http_length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4,
+    5, 5, 5, 5, 0
+};
+
+static const uint16_t http_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513,
+    769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+static const uint8_t http_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10,
+    11, 11, 12, 12, 13, 13
+};
+
+typedef struct {
+    uint8_t *out;
+    ecs_size_t length;
+    uint32_t bits;
+    int32_t bit_count;
+} ecs_http_bit_writer_t;
 
 static
-ecs_http_send_request_t* http_send_queue_get(
-    ecs_http_server_t *srv)
+uint32_t http_reverse_bits(
+    uint32_t code,
+    int32_t count)
 {
-    ecs_os_mutex_lock(srv->lock);
-    ecs_http_send_queue_t *sq = &srv->send_queue;
-    if (sq->tail == sq->head) {
-        return NULL;
+    uint32_t result = 0;
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        result = (result << 1) | (code & 1);
+        code >>= 1;
     }
-
-    int32_t next = (sq->tail + 1) % ECS_HTTP_SEND_QUEUE_MAX;
-    ecs_http_send_request_t *result = &sq->requests[sq->tail];
-    sq->tail = next;
     return result;
 }
 
 static
-void* http_server_send_queue(void* arg) {
-    ecs_http_server_t *srv = arg;
-    int32_t wait_ms = srv->send_queue.wait_ms;
-
-    /* Run for as long as the server is running or there are messages. When the
-     * server is stopping, no new messages will be enqueued */
-    while (srv->should_run || (srv->send_queue.head != srv->send_queue.tail)) {
-        ecs_http_send_request_t* r = http_send_queue_get(srv);
-        if (!r) {
-            ecs_os_mutex_unlock(srv->lock);
-            /* If the queue is empty, wait so we don't run too fast */
-            if (srv->should_run) {
-                ecs_os_sleep(0, wait_ms * 1000 * 1000);
-            }
-        } else {
-            ecs_http_socket_t sock = r->sock;
-            char *headers = r->headers;
-            int32_t headers_length = r->header_length;
-            char *content = r->content;
-            int32_t content_length = r->content_length;
-            ecs_os_mutex_unlock(srv->lock);
-
-            if (http_socket_is_valid(sock)) {
-                bool error = false;
-
-                http_sock_nonblock(sock, false);
-
-                /* Write headers */
-                ecs_size_t written = http_send(sock, headers, headers_length, 0);
-                if (written != headers_length) {
-                    ecs_err("http: failed to write HTTP response headers: %s",
-                        ecs_os_strerror(errno));
-                    ecs_os_linc(&ecs_http_send_error_count);
-                    error = true;
-                } else if (content_length >= 0) {
-                    /* Write content */
-                    written = http_send(sock, content, content_length, 0);
-                    if (written != content_length) {
-                        ecs_err("http: failed to write HTTP response body: %s",
-                            ecs_os_strerror(errno));
-                        ecs_os_linc(&ecs_http_send_error_count);
-                        error = true;
-                    }
-                }
-                if (!error) {
-                    ecs_os_linc(&ecs_http_send_ok_count);
-                }
+void http_gzip_init(void) {
+    /* Called when a server is created, before any threads use the tables */
+    if (http_crc_table[1]) {
+        return;
+    }
 
-                http_close(&sock);
-            } else {
-                ecs_err("http: invalid socket\n");
-            }
+    uint32_t i;
+    for (i = 0; i < 256; i ++) {
+        uint32_t c = i;
+        int32_t k;
+        for (k = 0; k < 8; k ++) {
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        }
+        http_crc_table[i] = c;
+    }
 
-            ecs_os_free(content);
-            ecs_os_free(headers);
+    for (i = 0; i < 288; i ++) {
+        uint32_t code;
+        int32_t bits;
+        if (i < 144) {
+            code = 0x30 + i;
+            bits = 8;
+        } else if (i < 256) {
+            code = 0x190 + (i - 144);
+            bits = 9;
+        } else if (i < 280) {
+            code = i - 256;
+            bits = 7;
+        } else {
+            code = 0xC0 + (i - 280);
+            bits = 8;
         }
+        http_symbol_code[i] = (uint16_t)http_reverse_bits(code, bits);
+        http_symbol_bits[i] = (uint8_t)bits;
+    }
+
+    for (i = 0; i < 30; i ++) {
+        http_dist_code[i] = (uint8_t)http_reverse_bits(i, 5);
     }
-    return NULL;
 }
 
 static
-void http_append_send_headers(
-    ecs_strbuf_t *hdrs,
-    int code, 
-    const char* status, 
-    const char* content_type,  
-    ecs_strbuf_t *extra_headers,
-    ecs_size_t content_len,
-    bool preflight)
+uint32_t http_crc32(
+    uint32_t crc,
+    const uint8_t *data,
+    ecs_size_t length)
 {
-    ecs_strbuf_appendlit(hdrs, "HTTP/1.1 ");
-    ecs_strbuf_appendint(hdrs, code);
-    ecs_strbuf_appendch(hdrs, ' ');
-    ecs_strbuf_appendstr(hdrs, status);
-    ecs_strbuf_appendlit(hdrs, "\r\n");
-
-    if (content_type) {
-        ecs_strbuf_appendlit(hdrs, "Content-Type: ");
-        ecs_strbuf_appendstr(hdrs, content_type);
-        ecs_strbuf_appendlit(hdrs, "\r\n");
+    crc = ~crc;
+    ecs_size_t i;
+    for (i = 0; i < length; i ++) {
+        crc = http_crc_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
     }
+    return ~crc;
+}
 
-    if (content_len >= 0) {
-        ecs_strbuf_appendlit(hdrs, "Content-Length: ");
-        ecs_strbuf_append(hdrs, "%d", content_len);
-        ecs_strbuf_appendlit(hdrs, "\r\n");
+static
+void http_put_bits(
+    ecs_http_bit_writer_t *w,
+    uint32_t value,
+    int32_t count)
+{
+    /* Deflate packs values starting at the least significant bit */
+    w->bits |= value << w->bit_count;
+    w->bit_count += count;
+    while (w->bit_count >= 8) {
+        w->out[w->length ++] = (uint8_t)w->bits;
+        w->bits >>= 8;
+        w->bit_count -= 8;
     }
+}
 
-    ecs_strbuf_appendlit(hdrs, "Access-Control-Allow-Origin: *\r\n");
-    if (preflight) {
-        ecs_strbuf_appendlit(hdrs, "Access-Control-Allow-Private-Network: true\r\n");
-        ecs_strbuf_appendlit(hdrs, "Access-Control-Allow-Methods: GET, PUT, OPTIONS\r\n");
-        ecs_strbuf_appendlit(hdrs, "Access-Control-Max-Age: 600\r\n");
+static
+void http_put_align(
+    ecs_http_bit_writer_t *w)
+{
+    if (w->bit_count) {
+        http_put_bits(w, 0, 8 - w->bit_count);
     }
+}
 
-    ecs_strbuf_mergebuff(hdrs, extra_headers);
-
-    ecs_strbuf_appendlit(hdrs, "\r\n");
+static
+void http_put_u32(
+    ecs_http_bit_writer_t *w,
+    uint32_t value)
+{
+    http_put_bits(w, value & 0xFFFF, 16);
+    http_put_bits(w, value >> 16, 16);
 }
 
 static
-void http_send_reply(
-    ecs_http_connection_impl_t* conn, 
-    ecs_http_reply_t* reply,
-    bool preflight) 
+void http_put_symbol(
+    ecs_http_bit_writer_t *w,
+    int32_t sym)
 {
-    ecs_strbuf_t hdrs = ECS_STRBUF_INIT;
-    int32_t content_length = reply->body.length;
-    char *content = ecs_strbuf_get(&reply->body);
+    http_put_bits(w, http_symbol_code[sym], http_symbol_bits[sym]);
+}
 
-    /* Use asynchronous send queue for outgoing data so send operations won't
-     * hold up main thread */
-    ecs_http_send_request_t *req = NULL;
+static
+void http_put_match(
+    ecs_http_bit_writer_t *w,
+    int32_t length,
+    int32_t dist)
+{
+    int32_t i = 28;
+    while (http_length_base[i] > length) {
+        i --;
+    }
+    http_put_symbol(w, 257 + i);
+    http_put_bits(w, (uint32_t)(length - http_length_base[i]), 
+        http_length_extra[i]);
 
-    if (!preflight) {
-        req = http_send_queue_post(conn->pub.server);
-        if (!req) {
-            reply->code = 503; /* queue full, server is busy */
-            ecs_os_linc(&ecs_http_busy_count);
-        }
+    int32_t d = 29;
+    while (http_dist_base[d] > dist) {
+        d --;
     }
+    http_put_bits(w, http_dist_code[d], 5);
+    http_put_bits(w, (uint32_t)(dist - http_dist_base[d]), http_dist_extra[d]);
+}
 
-    http_append_send_headers(&hdrs, reply->code, reply->status, 
-        reply->content_type, &reply->headers, content_length, preflight);
-    ecs_size_t headers_length = ecs_strbuf_written(&hdrs);
-    char *headers = ecs_strbuf_get(&hdrs);
+static
+uint32_t http_deflate_hash(
+    const uint8_t *ptr)
+{
+    uint32_t v = (uint32_t)ptr[0] | ((uint32_t)ptr[1] << 8) | 
+        ((uint32_t)ptr[2] << 16);
+    return (v * 2654435761u) >> (32 - ECS_HTTP_DEFLATE_HASH_BITS);
+}
 
-    if (!req) {
-        ecs_size_t written = http_send(conn->sock, headers, headers_length, 0);
-        if (written != headers_length) {
-            ecs_err("http: failed to send reply to '%s:%s': %s",
-                conn->pub.host, conn->pub.port, ecs_os_strerror(errno));
-            ecs_os_linc(&ecs_http_send_error_count);
-        }
-        ecs_os_free(content);
-        ecs_os_free(headers);
-        http_close(&conn->sock);
+/* Positions are stored as int32_t. Subtract from positions before they can
+ * overflow, which only happens for replies of more than a gigabyte. */
+static
+void http_deflate_rebase(
+    ecs_http_gzip_t *gz)
+{
+    if (gz->offset < (1 << 30)) {
         return;
     }
 
-    /* Second, enqueue send request for response body */
-    req->sock = conn->sock;
-    req->headers = headers;
-    req->header_length = headers_length;
-    req->content = content;
-    req->content_length = content_length;
-
-    /* Take ownership of values */
-    reply->body.content = NULL;
-    conn->sock = HTTP_SOCKET_INVALID;
+    int32_t shift = gz->offset, i;
+    for (i = 0; i < (1 << ECS_HTTP_DEFLATE_HASH_BITS); i ++) {
+        gz->head[i] = gz->head[i] > shift ? gz->head[i] - shift : 0;
+    }
+    for (i = 0; i < ECS_HTTP_DEFLATE_WINDOW; i ++) {
+        gz->prev[i] = gz->prev[i] > shift ? gz->prev[i] - shift : 0;
+    }
+    gz->hashed -= shift;
+    gz->offset = 0;
 }
 
+/* Encode data as a single block with fixed Huffman codes. Matches can refer to
+ * the window of data from previous calls. */
 static
-void http_recv_connection(
-    ecs_http_server_t *srv,
-    ecs_http_connection_impl_t *conn, 
-    uint64_t conn_id,
-    ecs_http_socket_t sock)
+void http_deflate(
+    ecs_http_bit_writer_t *w,
+    ecs_http_gzip_t *gz,
+    const uint8_t *input,
+    ecs_size_t input_length,
+    bool last)
 {
-    ecs_size_t bytes_read;
-    char recv_buf[ECS_HTTP_SEND_RECV_BUFFER_SIZE];
-    ecs_http_fragment_t frag = {0};
-    int32_t retries = 0;
-
-    do {
-        if ((bytes_read = http_recv(
-            sock, recv_buf, ECS_SIZEOF(recv_buf), 0)) > 0) 
-        {
-            bool is_alive = conn->pub.id == conn_id;
-            if (!is_alive) {
-                /* Connection has been purged by main thread */
-                goto done;
-            }
+    http_put_bits(w, last, 1);
+    http_put_bits(w, 1, 2);
+
+    /* Data is the window followed by the input. Positions in the hash chains
+     * are relative to the start of the window from the first call, and are 
+     * stored + 1, so that 0 means no position. */
+    const uint8_t *data = input;
+    int32_t start = gz->window_length;
+    int32_t length = start + input_length;
+    if (start) {
+        uint8_t *buf = ecs_os_malloc(length);
+        ecs_os_memcpy(buf, gz->window, start);
+        ecs_os_memcpy(&buf[start], input, input_length);
+        data = buf;
+    }
 
-            if (http_parse_request(&frag, recv_buf, bytes_read)) {
-                if (frag.method == EcsHttpOptions) {
-                    ecs_http_reply_t reply;
-                    reply.body = ECS_STRBUF_INIT;
-                    reply.code = 200;
-                    reply.content_type = NULL;
-                    reply.headers = ECS_STRBUF_INIT;
-                    reply.status = "OK";
-                    http_send_reply(conn, &reply, true);
-                    ecs_os_linc(&ecs_http_request_preflight_count);
-                } else {
-                    ecs_http_request_entry_t *entry =
-                        http_enqueue_request(conn, conn_id, &frag);
-                    if (entry) {
-                        ecs_http_reply_t reply;
-                        reply.body = ECS_STRBUF_INIT;
-                        reply.code = entry->code;
-                        reply.content_type = "application/json";
-                        reply.headers = ECS_STRBUF_INIT;
-                        reply.status = "OK";
-                        ecs_strbuf_appendstrn(&reply.body, 
-                            entry->content, entry->content_length);
-                        http_send_reply(conn, &reply, false);
-                        http_connection_free(conn);
-
-                        /* Lock was transferred from enqueue_request */
-                        ecs_os_mutex_unlock(srv->lock);
+    if (!gz->head && length >= ECS_HTTP_DEFLATE_MATCH_MIN) {
+        gz->head = ecs_os_calloc_n(int32_t, 1 << ECS_HTTP_DEFLATE_HASH_BITS);
+        gz->prev = ecs_os_calloc_n(int32_t, ECS_HTTP_DEFLATE_WINDOW);
+    }
+
+    const int32_t window_mask = ECS_HTTP_DEFLATE_WINDOW - 1;
+    int32_t *head = gz->head, *prev = gz->prev;
+    int32_t offset = gz->offset;
+    int32_t i = start, hashed = gz->hashed - offset;
+    while (i < length) {
+        int32_t best_length = 0, best_dist = 0;
+        int32_t max_length = length - i;
+        if (max_length > ECS_HTTP_DEFLATE_MATCH_MAX) {
+            max_length = ECS_HTTP_DEFLATE_MATCH_MAX;
+        }
+
+        if (max_length >= ECS_HTTP_DEFLATE_MATCH_MIN) {
+            uint32_t h = http_deflate_hash(&data[i]);
+            int32_t cand = head[h] - 1 - offset;
+            int32_t depth = ECS_HTTP_DEFLATE_CHAIN_MAX;
+            while (cand >= 0 && depth -- && 
+                (i - cand) <= ECS_HTTP_DEFLATE_WINDOW) 
+            {
+                if (data[cand + best_length] == data[i + best_length]) {
+                    int32_t l = 0;
+                    while (l < max_length && data[cand + l] == data[i + l]) {
+                        l ++;
+                    }
+                    if (l > best_length) {
+                        best_length = l;
+                        best_dist = i - cand;
+                        if (l == max_length) {
+                            break;
+                        }
                     }
                 }
-            } else {
-                ecs_os_linc(&ecs_http_request_invalid_count);
+
+                /* Slots are reused when the window wraps around, so only
+                 * follow links to earlier positions */
+                int32_t next = prev[(cand + offset) & window_mask] - 1 - offset;
+                if (next >= cand) {
+                    break;
+                }
+                cand = next;
             }
         }
 
-        ecs_os_sleep(0, 10 * 1000 * 1000);
-    } while ((bytes_read == -1) && (++retries < ECS_HTTP_REQUEST_RECV_RETRY));
+        int32_t advance = 1;
+        if (best_length >= ECS_HTTP_DEFLATE_MATCH_MIN) {
+            http_put_match(w, best_length, best_dist);
+            advance = best_length;
+        } else {
+            http_put_symbol(w, data[i]);
+        }
 
-    if (retries == ECS_HTTP_REQUEST_RECV_RETRY) {
-        http_close(&sock);
+        /* Add positions that were consumed to the hash chains. The last 
+         * positions of the data are added by the next call. */
+        i += advance;
+        int32_t end = i;
+        if (end > length - ECS_HTTP_DEFLATE_MATCH_MIN + 1) {
+            end = length - ECS_HTTP_DEFLATE_MATCH_MIN + 1;
+        }
+        for (; hashed < end; hashed ++) {
+            uint32_t h = http_deflate_hash(&data[hashed]);
+            prev[(hashed + offset) & window_mask] = head[h];
+            head[h] = hashed + offset + 1;
+        }
     }
 
-done:
-    ecs_strbuf_reset(&frag.buf);
+    http_put_symbol(w, 256); /* End of block */
+
+    if (!last) {
+        /* Keep the last window of data for the next call */
+        int32_t keep = length;
+        if (keep > ECS_HTTP_DEFLATE_WINDOW) {
+            keep = ECS_HTTP_DEFLATE_WINDOW;
+        }
+        if (!gz->window) {
+            gz->window = ecs_os_malloc(ECS_HTTP_DEFLATE_WINDOW);
+        }
+        ecs_os_memmove(gz->window, &data[length - keep], keep);
+        gz->window_length = keep;
+        gz->offset = offset + length - keep;
+        gz->hashed = hashed + offset;
+        if (gz->head) {
+            http_deflate_rebase(gz);
+        }
+    }
+
+    if (data != input) {
+        ecs_os_free(ECS_CONST_CAST(uint8_t*, data));
+    }
 }
 
-typedef struct {
-    ecs_http_connection_impl_t *conn;
-    uint64_t id;
-} http_conn_res_t;
+/* Compress (part of) a reply. Returns the gzip encoded data, which must be
+ * freed by the caller. For a reply that's sent in parts, every part except the
+ * last ends on a byte boundary so it can be sent as a separate chunk. */
+static
+char* http_gzip(
+    ecs_http_gzip_t *gz,
+    const char *data,
+    ecs_size_t length,
+    bool last,
+    ecs_size_t *length_out)
+{
+    /* Fixed codes take at most 9 bits per byte of input */
+    ecs_http_bit_writer_t w = {0};
+    w.out = ecs_os_malloc(length + length / 8 + 64);
+
+    if (!gz->started) {
+        /* Magic, deflate method, no flags, no time, no extra flags, unknown
+         * operating system */
+        static const uint8_t header[10] = {
+            0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 255 };
+        ecs_os_memcpy(w.out, header, 10);
+        w.length = 10;
+        gz->started = true;
+    }
+
+    const uint8_t *bytes = (const uint8_t*)data;
+    http_deflate(&w, gz, bytes, length, last);
+    gz->crc = http_crc32(gz->crc, bytes, length);
+    gz->size += (uint32_t)length;
+
+    if (!last) {
+        /* Empty stored block, which aligns the stream to a byte boundary */
+        http_put_bits(&w, 0, 3);
+        http_put_align(&w);
+        http_put_u32(&w, 0xFFFF0000);
+    } else {
+        http_put_align(&w);
+        http_put_u32(&w, gz->crc);
+        http_put_u32(&w, gz->size);
+        http_gzip_fini(gz);
+    }
+
+    *length_out = w.length;
+    return (char*)w.out;
+}
+
+static
+void http_wakeup(
+    ecs_http_server_t *srv)
+{
+#ifndef ECS_TARGET_WINDOWS
+    /* Wake up I/O thread so it sends queued data without waiting for the poll
+     * timeout. If the pipe is full the thread is already going to wake up. */
+    char ch = 0;
+    if (write(srv->wakeup[1], &ch, 1) != 1) {
+        /* Ignore */
+    }
+#else
+    /* WSAPoll can't wait on a pipe, so the I/O thread polls with a timeout
+     * that's short enough to pick up queued data */
+    (void)srv;
+#endif
+}
+
+static
+void http_send_queue_push(
+    ecs_http_connection_impl_t *conn,
+    char *headers,
+    int32_t header_length,
+    char *content,
+    int32_t content_length,
+    uint64_t seq,
+    bool last,
+    bool close)
+{
+    /* Must be called while server is locked. Takes ownership of headers and
+     * content. */
+    ecs_http_send_request_t *r = ecs_vec_append_t(
+        NULL, &conn->send_queue, ecs_http_send_request_t);
+    r->headers = headers;
+    r->header_length = header_length;
+    r->content = content;
+    r->content_length = content_length;
+    r->sent = 0;
+    r->seq = seq;
+    r->last = last;
+    r->close = close;
+    conn->send_bytes += header_length + content_length;
+    conn->pub.server->send_count ++;
+}
+
+/* Send (part of) request. Returns 1 if request was sent, 0 if the socket can't
+ * accept more data, -1 if sending failed. */
+static
+int http_send_request(
+    ecs_http_connection_impl_t *conn,
+    ecs_http_send_request_t *r)
+{
+    int32_t total = r->header_length + r->content_length;
+    while (r->sent < total) {
+        const char *data;
+        ecs_size_t length;
+        if (r->sent < r->header_length) {
+            data = &r->headers[r->sent];
+            length = r->header_length - r->sent;
+        } else {
+            int32_t offset = r->sent - r->header_length;
+            data = &r->content[offset];
+            length = r->content_length - offset;
+        }
+
+        ecs_size_t written = http_send(conn->sock, data, length, 0);
+        if (written < 0) {
+            if (http_would_block()) {
+                return 0;
+            }
+            return -1;
+        }
+
+        r->sent += written;
+    }
+
+    return 1;
+}
+
+static
+void http_send_connection(
+    ecs_http_connection_impl_t *conn,
+    double now)
+{
+    /* Send replies in the order of the requests. Requests can be handled out of
+     * order, and a reply may not have been queued yet while replies to later
+     * requests are already waiting. */
+    int32_t i = 0;
+    while (i < ecs_vec_count(&conn->send_queue)) {
+        ecs_http_send_request_t *r = ecs_vec_get_t(
+            &conn->send_queue, ecs_http_send_request_t, i);
+        if (r->seq != conn->send_seq) {
+            i ++;
+            continue;
+        }
+
+        if (!http_socket_is_valid(conn->sock)) {
+            http_send_request_fini(conn, i);
+            continue;
+        }
+
+        int32_t sent = r->sent;
+        int result = http_send_request(conn, r);
+        if (r->sent != sent) {
+            conn->last_active = now;
+        }
+
+        if (!result) {
+            conn->want_write = true;
+            return;
+        }
+
+        if (result == -1) {
+            ecs_err("http: failed to send reply to '%s:%s': %s",
+                conn->pub.host, conn->pub.port, ecs_os_strerror(errno));
+            ecs_os_linc(&ecs_http_send_error_count);
+            http_close(&conn->sock);
+        } else if (r->last) {
+            /* A last part without data is only queued to close connections
+             * of replies that failed halfway */
+            if (r->header_length || r->content_length) {
+                ecs_os_linc(&ecs_http_send_ok_count);
+            }
+            if (r->close) {
+                http_close(&conn->sock);
+            }
+            conn->send_seq ++;
+        }
+
+        http_send_request_fini(conn, i);
+
+        /* Start from the beginning, parts of the next reply may have been
+         * queued before the parts of this reply */
+        i = 0;
+    }
+}
 
 static
-http_conn_res_t http_init_connection(
+void http_append_send_headers(
+    ecs_strbuf_t *hdrs,
+    int code, 
+    const char* status, 
+    const char* content_type,  
+    ecs_strbuf_t *extra_headers,
+    ecs_size_t content_len,
+    bool preflight)
+{
+    ecs_strbuf_appendlit(hdrs, "HTTP/1.1 ");
+    ecs_strbuf_appendint(hdrs, code);
+    ecs_strbuf_appendch(hdrs, ' ');
+    ecs_strbuf_appendstr(hdrs, status);
+    ecs_strbuf_appendlit(hdrs, "\r\n");
+
+    if (content_type) {
+        ecs_strbuf_appendlit(hdrs, "Content-Type: ");
+        ecs_strbuf_appendstr(hdrs, content_type);
+        ecs_strbuf_appendlit(hdrs, "\r\n");
+    }
+
+    if (content_len >= 0) {
+        ecs_strbuf_appendlit(hdrs, "Content-Length: ");
+        ecs_strbuf_append(hdrs, "%d", content_len);
+        ecs_strbuf_appendlit(hdrs, "\r\n");
+    }
+
+    ecs_strbuf_appendlit(hdrs, "Access-Control-Allow-Origin: *\r\n");
+    if (preflight) {
+        ecs_strbuf_appendlit(hdrs, "Access-Control-Allow-Private-Network: true\r\n");
+        ecs_strbuf_appendlit(hdrs, "Access-Control-Allow-Methods: GET, PUT, DELETE, OPTIONS\r\n");
+        ecs_strbuf_appendlit(hdrs, "Access-Control-Max-Age: 600\r\n");
+    }
+
+    ecs_strbuf_mergebuff(hdrs, extra_headers);
+
+    ecs_strbuf_appendlit(hdrs, "\r\n");
+}
+
+static
+void http_send_chunk(
+    ecs_http_connection_impl_t* conn,
+    const char *data,
+    ecs_size_t length,
+    uint64_t seq,
+    bool last,
+    bool close)
+{
+    /* Encode chunk as "<length in hex>\r\n<data>\r\n", terminate reply with an
+     * empty chunk */
+    char hdr[16];
+    ecs_size_t hdr_length = 0;
+    if (length) {
+        hdr_length = ecs_os_snprintf(
+            hdr, ECS_SIZEOF(hdr), "%x\r\n", (unsigned)length);
+    }
+
+    const char *terminator = last ? "\r\n0\r\n\r\n" : "\r\n";
+    if (!length) {
+        terminator = "0\r\n\r\n";
+    }
+
+    ecs_size_t terminator_length = ecs_os_strlen(terminator);
+    ecs_size_t chunk_length = hdr_length + length + terminator_length;
+    char *chunk = ecs_os_malloc(chunk_length);
+    if (length) {
+        ecs_os_memcpy(chunk, hdr, hdr_length);
+        ecs_os_memcpy(&chunk[hdr_length], data, length);
+    }
+    ecs_os_memcpy(&chunk[hdr_length + length], terminator, terminator_length);
+
+    http_send_queue_push(conn, NULL, 0, chunk, chunk_length, seq, last, close);
+}
+
+static
+void http_send_last_chunk(
+    ecs_http_connection_impl_t* conn, 
+    ecs_http_reply_t* reply,
+    ecs_http_gzip_t *gzip,
+    uint64_t seq,
+    bool close)
+{
+    /* Don't terminate the reply if the handler failed after the headers were
+     * sent, so the client can tell the reply is incomplete. */
+    if (reply->code >= 400) {
+        ecs_os_linc(&ecs_http_send_error_count);
+        http_send_queue_push(conn, NULL, 0, NULL, 0, seq, true, true);
+        return;
+    }
+
+    int32_t length = ecs_strbuf_written(&reply->body);
+    if (gzip) {
+        ecs_size_t gzip_length;
+        char *data = http_gzip(
+            gzip, reply->body.content, length, true, &gzip_length);
+        http_send_chunk(conn, data, gzip_length, seq, true, close);
+        ecs_os_free(data);
+    } else {
+        http_send_chunk(conn, reply->body.content, length, seq, true, close);
+    }
+}
+
+static
+void http_send_reply(
+    ecs_http_connection_impl_t* conn, 
+    ecs_http_reply_t* reply,
+    ecs_http_gzip_t *gzip,
+    bool preflight,
+    uint64_t seq,
+    bool close) 
+{
+    if (reply->chunked) {
+        /* Headers and part of the body were already queued by the handler */
+        http_send_last_chunk(conn, reply, gzip, seq, close);
+        return;
+    }
+
+    if (!preflight && 
+        conn->pub.server->send_count >= ECS_HTTP_SEND_QUEUE_MAX) 
+    {
+        /* Too much data is waiting to be sent, server is busy */
+        reply->code = 503;
+        reply->status = "Service Unavailable";
+        ecs_strbuf_reset(&reply->body);
+        ecs_os_linc(&ecs_http_busy_count);
+        close = true;
+    }
+
+    if (close) {
+        ecs_strbuf_appendlit(&reply->headers, "Connection: close\r\n");
+    }
+
+    ecs_strbuf_t hdrs = ECS_STRBUF_INIT;
+    int32_t content_length = reply->body.length;
+    char *content = ecs_strbuf_get(&reply->body);
+
+    if (gzip && !preflight && content_length >= ECS_HTTP_COMPRESS_MIN) {
+        ecs_size_t gzip_length;
+        char *gzip_content = http_gzip(
+            gzip, content, content_length, true, &gzip_length);
+        if (gzip_length < content_length) {
+            ecs_os_free(content);
+            content = gzip_content;
+            content_length = gzip_length;
+            ecs_strbuf_appendlit(&reply->headers, 
+                "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n");
+        } else {
+            ecs_os_free(gzip_content);
+        }
+    }
+
+    http_append_send_headers(&hdrs, reply->code, reply->status, 
+        reply->content_type, &reply->headers, content_length, preflight);
+    ecs_size_t headers_length = ecs_strbuf_written(&hdrs);
+    char *headers = ecs_strbuf_get(&hdrs);
+
+    /* Reply is sent by I/O thread so send operations won't hold up the main
+     * thread. The queue takes ownership of the values. */
+    http_send_queue_push(conn, headers, headers_length, 
+        content, content_length, seq, true, close);
+    reply->body.content = NULL;
+}
+
+static
+void http_recv_request(
+    ecs_http_connection_impl_t *conn)
+{
+    /* Must be called while server is locked */
+    ecs_http_fragment_t *frag = &conn->frag;
+    uint64_t seq = conn->recv_seq ++;
+    bool close = frag->invalid || http_request_close(frag);
+    ecs_http_gzip_t gzip = {0};
+    bool accept_gzip = !frag->invalid && http_request_gzip(frag);
+    if (close) {
+        /* Don't read requests after the one that closes the connection */
+        conn->closing = true;
+    }
+
+    if (frag->invalid) {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        reply.code = 400;
+        reply.status = "Bad Request";
+        http_send_reply(conn, &reply, NULL, false, seq, close);
+        http_reply_fini(&reply);
+        ecs_strbuf_reset(&frag->buf);
+        ecs_os_linc(&ecs_http_request_invalid_count);
+    } else if (frag->method == EcsHttpOptions) {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        reply.content_type = NULL;
+        http_send_reply(conn, &reply, NULL, true, seq, close);
+        http_reply_fini(&reply);
+        ecs_strbuf_reset(&frag->buf);
+        ecs_os_linc(&ecs_http_request_preflight_count);
+    } else {
+        ecs_http_request_entry_t *entry =
+            http_enqueue_request(conn, frag, seq, close);
+        if (entry) {
+            ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+            reply.code = entry->code;
+            ecs_strbuf_appendstrn(&reply.body, 
+                entry->content, entry->content_length);
+            http_send_reply(conn, &reply, accept_gzip ? &gzip : NULL, 
+                false, seq, close);
+            http_reply_fini(&reply);
+        }
+    }
+
+    /* Parse next request from the start */
+    frag->state = HttpFragStateBegin;
+}
+
+static
+void http_recv_connection(
+    ecs_http_connection_impl_t *conn,
+    double now)
+{
+    /* Must be called while server is locked */
+    ecs_size_t bytes_read;
+    char recv_buf[ECS_HTTP_SEND_RECV_BUFFER_SIZE];
+
+    while (!conn->closing) {
+        bytes_read = http_recv(conn->sock, recv_buf, ECS_SIZEOF(recv_buf), 0);
+        if (bytes_read == 0) {
+            /* Client closed the connection. Replies to outstanding requests
+             * are still sent, in case the client only closed its end. */
+            conn->closing = true;
+            break;
+        }
+
+        if (bytes_read < 0) {
+            if (!http_would_block()) {
+                http_close(&conn->sock);
+                conn->closing = true;
+            }
+            break;
+        }
+
+        conn->last_active = now;
+
+        /* Data can contain the end of one request and the start of the next */
+        ecs_size_t offset = 0;
+        while (offset < bytes_read && !conn->closing) {
+            ecs_size_t consumed = 0;
+            ecs_http_fragment_t *frag = &conn->frag;
+            if (http_parse_request(frag, &recv_buf[offset], 
+                bytes_read - offset, &consumed)) 
+            {
+                http_recv_request(conn);
+            } else if (ecs_strbuf_written(&frag->buf) > 
+                ECS_HTTP_REQUEST_LEN_MAX) 
+            {
+                ecs_err("http: request from '%s:%s' exceeds max length",
+                    conn->pub.host, conn->pub.port);
+                frag->invalid = true;
+                http_recv_request(conn);
+            }
+            offset += consumed;
+        }
+    }
+}
+
+static
+void http_recv_stream(
+    ecs_http_connection_impl_t *conn)
+{
+    /* Must be called while server is locked. Clients don't send requests on a
+     * connection with an open stream, only check if the client went away so
+     * the stream can be closed. */
+    char recv_buf[256];
+    for (;;) {
+        ecs_size_t bytes_read = http_recv(
+            conn->sock, recv_buf, ECS_SIZEOF(recv_buf), 0);
+        if (!bytes_read || (bytes_read < 0 && !http_would_block())) {
+            http_close(&conn->sock);
+            break;
+        }
+        if (bytes_read < 0) {
+            break;
+        }
+    }
+}
+
+static
+void http_init_connection(
     ecs_http_server_t *srv, 
     ecs_http_socket_t sock_conn,
     struct sockaddr_storage *remote_addr, 
-    ecs_size_t remote_addr_len) 
+    ecs_size_t remote_addr_len,
+    double now) 
 {
-    http_sock_set_timeout(sock_conn, 100);
+    /* Must be called while server is locked */
     http_sock_keep_alive(sock_conn);
     http_sock_nonblock(sock_conn, true);
 
     /* Create new connection */
-    ecs_os_mutex_lock(srv->lock);
     ecs_http_connection_impl_t *conn = flecs_sparse_add_t(
         &srv->connections, ecs_http_connection_impl_t);
-    uint64_t conn_id = conn->pub.id = flecs_sparse_last_id(&srv->connections);
+    ecs_os_zeromem(conn);
+    conn->pub.id = flecs_sparse_last_id(&srv->connections);
     conn->pub.server = srv;
     conn->sock = sock_conn;
-    ecs_os_mutex_unlock(srv->lock);
+    conn->last_active = now;
+    ecs_vec_init_t(NULL, &conn->send_queue, ecs_http_send_request_t, 0);
 
     char *remote_host = conn->pub.host;
     char *remote_port = conn->pub.port;
@@ -1151,8 +1899,177 @@ http_conn_res_t http_init_connection(
 
     ecs_dbg_2("http: connection established from '%s:%s' (socket %u)", 
         remote_host, remote_port, sock_conn);
-    
-    return (http_conn_res_t){ .conn = conn, .id = conn_id };
+}
+
+static
+void http_accept_pending(
+    ecs_http_server_t *srv,
+    double now)
+{
+    /* Must be called while server is locked */
+    struct sockaddr_storage remote_addr;
+    ecs_size_t remote_addr_len;
+
+    for (;;) {
+        remote_addr_len = ECS_SIZEOF(remote_addr);
+        ecs_http_socket_t sock_conn = http_accept(srv->sock, 
+            (struct sockaddr*) &remote_addr, &remote_addr_len);
+
+        if (!http_socket_is_valid(sock_conn)) {
+            if (!http_would_block()) {
+                ecs_dbg("http: connection attempt failed: %s", 
+                    ecs_os_strerror(errno));
+            }
+            break;
+        }
+
+        http_init_connection(srv, sock_conn, &remote_addr, remote_addr_len,
+            now);
+    }
+}
+
+static
+bool http_connection_done(
+    ecs_http_connection_impl_t *conn,
+    double now)
+{
+    if (conn->request_count) {
+        /* Main thread still has to reply to requests on this connection */
+        return false;
+    }
+
+    if (!http_socket_is_valid(conn->sock)) {
+        return true;
+    }
+
+    if (ecs_vec_count(&conn->send_queue)) {
+        /* Close connections of clients that stopped receiving data, as the
+         * send queue would otherwise never drain. */
+        return (now - conn->last_active) > ECS_HTTP_CONNECTION_IDLE_TIMEOUT;
+    }
+
+    return conn->closing || 
+        ((now - conn->last_active) > ECS_HTTP_CONNECTION_IDLE_TIMEOUT);
+}
+
+static
+void http_server_poll(
+    ecs_http_server_t *srv)
+{
+    /* The I/O thread waits for events on the listening socket, the wakeup pipe
+     * and all connections. It holds the server lock while it's not waiting. */
+    ecs_vec_t fds, conns;
+    ecs_vec_init_t(NULL, &fds, struct pollfd, 0);
+    ecs_vec_init_t(NULL, &conns, ecs_http_connection_impl_t*, 0);
+
+    ecs_os_mutex_lock(srv->lock);
+    while (srv->should_run) {
+        ecs_vec_clear(&fds);
+        ecs_vec_clear(&conns);
+
+        struct pollfd *fd = ecs_vec_append_t(NULL, &fds, struct pollfd);
+        fd->fd = srv->sock;
+        fd->events = POLLIN;
+#ifndef ECS_TARGET_WINDOWS
+        fd = ecs_vec_append_t(NULL, &fds, struct pollfd);
+        fd->fd = srv->wakeup[0];
+        fd->events = POLLIN;
+#endif
+        int32_t conn_start = ecs_vec_count(&fds);
+
+        int32_t i, count = flecs_sparse_count(&srv->connections);
+        for (i = 1; i < count; i ++) {
+            ecs_http_connection_impl_t *conn = flecs_sparse_get_dense_t(
+                &srv->connections, ecs_http_connection_impl_t, i);
+            if (!http_socket_is_valid(conn->sock)) {
+                continue;
+            }
+
+            short events = 0;
+            if (!conn->closing || conn->stream) {
+                events |= POLLIN;
+            }
+            if (conn->want_write) {
+                events |= POLLOUT;
+            }
+            if (!events) {
+                continue;
+            }
+
+            fd = ecs_vec_append_t(NULL, &fds, struct pollfd);
+            fd->fd = conn->sock;
+            fd->events = events;
+            ecs_vec_append_t(NULL, &conns, ecs_http_connection_impl_t*)[0] = 
+                conn;
+        }
+
+        ecs_os_mutex_unlock(srv->lock);
+        int result = http_poll(ecs_vec_first(&fds), ecs_vec_count(&fds), 
+            srv->poll_timeout);
+        ecs_os_mutex_lock(srv->lock);
+
+        ecs_time_t t = {0, 0};
+        double now = ecs_time_measure(&t);
+
+        if (result < 0 && !http_would_block()) {
+            ecs_err("http: poll failed: %s", ecs_os_strerror(errno));
+            break;
+        }
+
+        struct pollfd *pfds = ecs_vec_first(&fds);
+        if (result > 0) {
+            if (pfds[0].revents & POLLIN) {
+                http_accept_pending(srv, now);
+            }
+
+#ifndef ECS_TARGET_WINDOWS
+            if (pfds[1].revents & POLLIN) {
+                char buf[64];
+                while (read(srv->wakeup[0], buf, ECS_SIZEOF(buf)) > 0) { }
+            }
+#endif
+
+            /* Connections created by accept aren't in the list of fds. 
+             * Connections are only freed by this thread, so the pointers in
+             * the list are still valid. */
+            ecs_http_connection_impl_t **conn_ptrs = ecs_vec_first(&conns);
+            count = ecs_vec_count(&conns);
+            for (i = 0; i < count; i ++) {
+                ecs_http_connection_impl_t *conn = conn_ptrs[i];
+                short revents = pfds[conn_start + i].revents;
+                if (revents & POLLOUT) {
+                    conn->want_write = false;
+                }
+                if (revents & (POLLIN | POLLHUP | POLLERR)) {
+                    if (conn->stream) {
+                        http_recv_stream(conn);
+                    } else {
+                        http_recv_connection(conn, now);
+                    }
+                }
+            }
+        }
+
+        /* Send queued replies, free closed and idle connections */
+        count = flecs_sparse_count(&srv->connections);
+        for (i = count - 1; i >= 1; i --) {
+            ecs_http_connection_impl_t *conn = flecs_sparse_get_dense_t(
+                &srv->connections, ecs_http_connection_impl_t, i);
+            if (!conn->want_write && ecs_vec_count(&conn->send_queue)) {
+                http_send_connection(conn, now);
+            }
+
+            if (http_connection_done(conn, now)) {
+                ecs_dbg_2("http: closing connection '%s:%s' (sock = %d)", 
+                    conn->pub.host, conn->pub.port, conn->sock);
+                http_connection_free(conn);
+            }
+        }
+    }
+    ecs_os_mutex_unlock(srv->lock);
+
+    ecs_vec_fini_t(NULL, &fds, struct pollfd);
+    ecs_vec_fini_t(NULL, &conns, ecs_http_connection_impl_t*);
 }
 
 static
@@ -1229,7 +2146,7 @@ void http_accept_connections(
             goto done;
         }
 
-        http_sock_set_timeout(sock, 1000);
+        http_sock_nonblock(sock, true);
 
         srv->sock = sock;
 
@@ -1246,32 +2163,16 @@ void http_accept_connections(
     }
     ecs_os_mutex_unlock(srv->lock);
 
-    struct sockaddr_storage remote_addr;
-    ecs_size_t remote_addr_len = 0;
-
-    while (srv->should_run) {
-        remote_addr_len = ECS_SIZEOF(remote_addr);
-        ecs_http_socket_t sock_conn = http_accept(srv->sock, (struct sockaddr*) &remote_addr, 
-            &remote_addr_len);
-
-        if (!http_socket_is_valid(sock_conn)) {
-            if (srv->should_run) {
-                ecs_dbg("http: connection attempt failed: %s", 
-                    ecs_os_strerror(errno));
-            }
-            continue;
-        }
-
-        http_conn_res_t conn = http_init_connection(srv, sock_conn, &remote_addr, remote_addr_len);
-        http_recv_connection(srv, conn.conn, conn.id, sock_conn);
+    if (http_socket_is_valid(srv->sock)) {
+        http_server_poll(srv);
     }
 
 done:
     ecs_os_mutex_lock(srv->lock);
-    if (http_socket_is_valid(sock) && errno != EBADF) {
+    if (http_socket_is_valid(sock)) {
         http_close(&sock);
-        srv->sock = sock;
     }
+    srv->sock = HTTP_SOCKET_INVALID;
     ecs_os_mutex_unlock(srv->lock);
 
     ecs_trace("http: no longer accepting connections on '%s:%s'",
@@ -1345,19 +2246,44 @@ void http_handle_request(
             }
         }
 
-        if (req->pub.method == EcsHttpGet) {
-            http_insert_request_entry(srv, req, &reply);
-        }
+        if (req->stream) {
+            /* Reply stays open, send what the handler added after opening
+             * the stream */
+            ecs_http_reply_flush((ecs_http_request_t*)req, &reply);
+        } else {
+            if (req->pub.method == EcsHttpGet) {
+                http_insert_request_entry(srv, req, &reply);
+            }
 
-        http_send_reply(conn, &reply, false);
-        ecs_dbg_2("http: reply sent to '%s:%s'", conn->pub.host, conn->pub.port);
+            http_send_reply(conn, &reply, 
+                req->gzip ? &req->gzip_state : NULL, 
+                false, req->seq, req->close);
+            ecs_dbg_2("http: reply queued for '%s:%s'", 
+                conn->pub.host, conn->pub.port);
+        }
     } else {
         /* Already taken care of */
     }
 
     http_reply_fini(&reply);
     http_request_fini(req);
-    http_connection_free(conn);
+}
+
+static
+void http_remove_request_entry(
+    ecs_http_server_t *srv,
+    ecs_hm_bucket_t *bucket,
+    uint64_t hash,
+    int32_t index)
+{
+    ecs_http_request_key_t *key = ecs_vec_get_t(
+        &bucket->keys, ecs_http_request_key_t, index);
+    ecs_http_request_entry_t *entry = ecs_vec_get_t(
+        &bucket->values, ecs_http_request_entry_t, index);
+    /* Safe, code owns the value */
+    ecs_os_free(ECS_CONST_CAST(char*, key->array));
+    ecs_os_free(entry->content);
+    flecs_hm_bucket_remove(&srv->request_cache, bucket, hash, index);
 }
 
 static
@@ -1371,17 +2297,11 @@ void http_purge_request_cache(
     while (ecs_map_next(&it)) {
         ecs_hm_bucket_t *bucket = ecs_map_ptr(&it);
         int32_t i, count = ecs_vec_count(&bucket->values);
-        ecs_http_request_key_t *keys = ecs_vec_first(&bucket->keys);
         ecs_http_request_entry_t *entries = ecs_vec_first(&bucket->values);
         for (i = count - 1; i >= 0; i --) {
             ecs_http_request_entry_t *entry = &entries[i];
             if (fini || ((time - entry->time) > srv->cache_purge_timeout)) {
-                ecs_http_request_key_t *key = &keys[i];
-                /* Safe, code owns the value */
-                ecs_os_free(ECS_CONST_CAST(char*, key->array));
-                ecs_os_free(entry->content);
-                flecs_hm_bucket_remove(&srv->request_cache, bucket, 
-                    ecs_map_key(&it), i);
+                http_remove_request_entry(srv, bucket, ecs_map_key(&it), i);
             }
         }
     }
@@ -1391,13 +2311,40 @@ void http_purge_request_cache(
     }
 }
 
+/* Returns whether a queued request uses a method other than the specified
+ * method. Options requests are already handled by the server thread. */
+static
+bool http_requests_other_method(
+    ecs_http_server_t *srv,
+    ecs_http_method_t method)
+{
+    int32_t i, request_count = flecs_sparse_count(&srv->requests);
+    for (i = 1; i < request_count; i ++) {
+        ecs_http_request_impl_t *req = flecs_sparse_get_dense_t(
+            &srv->requests, ecs_http_request_impl_t, i);
+        if (req->pub.method != method && req->pub.method != EcsHttpOptions) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Returns -1 if requests aren't handled because one of them uses a method other
+ * than the specified method. EcsHttpMethodUnsupported handles all requests. */
 static
 int32_t http_dequeue_requests(
     ecs_http_server_t *srv,
-    double delta_time)
+    ecs_http_method_t method)
 {
     ecs_os_mutex_lock(srv->lock);
 
+    if (method != EcsHttpMethodUnsupported && 
+        http_requests_other_method(srv, method)) 
+    {
+        ecs_os_mutex_unlock(srv->lock);
+        return -1;
+    }
+
     int32_t i, request_count = flecs_sparse_count(&srv->requests);
     for (i = request_count - 1; i >= 1; i --) {
         ecs_http_request_impl_t *req = flecs_sparse_get_dense_t(
@@ -1405,23 +2352,13 @@ int32_t http_dequeue_requests(
         http_handle_request(srv, req);
     }
 
-    int32_t connections_count = flecs_sparse_count(&srv->connections);
-    for (i = connections_count - 1; i >= 1; i --) {
-        ecs_http_connection_impl_t *conn = flecs_sparse_get_dense_t(
-            &srv->connections, ecs_http_connection_impl_t, i);
-
-        conn->dequeue_timeout += delta_time;
-        conn->dequeue_retries ++;
-        
-        if ((conn->dequeue_timeout > 
-            (double)ECS_HTTP_CONNECTION_PURGE_TIMEOUT) &&
-             (conn->dequeue_retries > ECS_HTTP_CONNECTION_PURGE_RETRY_COUNT)) 
-        {
-            ecs_dbg("http: purging connection '%s:%s' (sock = %d)", 
-                conn->pub.host, conn->pub.port, conn->sock);
-            http_connection_free(conn);
-        }
-    }
+    /* Flushing a reply temporarily releases the lock, so requests may have
+     * been added while handling requests. Only remove the handled requests,
+     * which are the first request_count - 1 elements of the dense array. */
+    http_requests_free(srv, request_count - 1);
+
+    /* Send replies without waiting for poll timeout */
+    http_wakeup(srv);
 
     http_purge_request_cache(srv, false);
     ecs_os_mutex_unlock(srv->lock);
@@ -1466,6 +2403,8 @@ ecs_http_server_t* ecs_http_server_init(
     srv->should_run = false;
     srv->initialized = true;
 
+    http_gzip_init();
+
     srv->cache_timeout = desc->cache_timeout;
     srv->cache_purge_timeout = desc->cache_purge_timeout;
 
@@ -1479,10 +2418,24 @@ ecs_http_server_t* ecs_http_server_init(
     srv->ctx = desc->ctx;
     srv->port = desc->port;
     srv->ipaddr = desc->ipaddr;
-    srv->send_queue.wait_ms = desc->send_queue_wait_ms;
-    if (!srv->send_queue.wait_ms) {
-        srv->send_queue.wait_ms = 1;
+#ifndef ECS_TARGET_WINDOWS
+    srv->poll_timeout = ECS_HTTP_POLL_TIMEOUT;
+    if (pipe(srv->wakeup)) {
+        ecs_err("http: failed to create wakeup pipe: %s", 
+            ecs_os_strerror(errno));
+        ecs_os_mutex_free(srv->lock);
+        ecs_os_free(srv);
+        return NULL;
+    }
+    http_sock_nonblock(srv->wakeup[0], true);
+    http_sock_nonblock(srv->wakeup[1], true);
+#else
+    /* Replies are picked up by the I/O thread when the poll times out */
+    srv->poll_timeout = desc->send_queue_wait_ms;
+    if (!srv->poll_timeout) {
+        srv->poll_timeout = 1;
     }
+#endif
 
     flecs_sparse_init_t(&srv->connections, NULL, NULL, ecs_http_connection_impl_t);
     flecs_sparse_init_t(&srv->requests, NULL, NULL, ecs_http_request_impl_t);
@@ -1515,6 +2468,10 @@ void ecs_http_server_fini(
     }
     ecs_os_mutex_free(srv->lock);
     http_purge_request_cache(srv, true);
+#ifndef ECS_TARGET_WINDOWS
+    close(srv->wakeup[0]);
+    close(srv->wakeup[1]);
+#endif
     flecs_sparse_fini(&srv->requests);
     flecs_sparse_fini(&srv->connections);
     ecs_os_free(srv);
@@ -1537,11 +2494,6 @@ int ecs_http_server_start(
         goto error;
     }
 
-    srv->send_queue.thread = ecs_os_thread_new(http_server_send_queue, srv);
-    if (!srv->send_queue.thread) {
-        goto error;
-    }
-
     return 0;
 error:
     return -1;
@@ -1559,14 +2511,11 @@ void ecs_http_server_stop(
 
     ecs_os_mutex_lock(srv->lock);
     srv->should_run = false;
-    if (http_socket_is_valid(srv->sock)) {
-        http_close(&srv->sock);
-    }
+    http_wakeup(srv);
     ecs_os_mutex_unlock(srv->lock);
 
     ecs_os_thread_join(srv->thread);
-    ecs_os_thread_join(srv->send_queue.thread);
-    ecs_trace("http: server threads shut down");
+    ecs_trace("http: server thread shut down");
 
     /* Cleanup all outstanding requests */
     int i, count = flecs_sparse_count(&srv->requests);
@@ -1574,6 +2523,7 @@ void ecs_http_server_stop(
         http_request_fini(flecs_sparse_get_dense_t(
             &srv->requests, ecs_http_request_impl_t, i));
     }
+    http_requests_free(srv, count - 1);
 
     /* Close all connections */
     count = flecs_sparse_count(&srv->connections);
@@ -1592,29 +2542,37 @@ error:
     return;
 }
 
-void ecs_http_server_dequeue(
+static
+bool http_server_dequeue(
     ecs_http_server_t* srv,
-    ecs_ftime_t delta_time)
+    ecs_ftime_t delta_time,
+    ecs_http_method_t method)
 {
     ecs_check(srv != NULL, ECS_INVALID_PARAMETER, NULL);
     ecs_check(srv->initialized, ECS_INVALID_PARAMETER, NULL);
     ecs_check(srv->should_run, ECS_INVALID_PARAMETER, NULL);
     
+    bool result = false;
     srv->dequeue_timeout += (double)delta_time;
     srv->stats_timeout += (double)delta_time;
 
     if ((1000 * srv->dequeue_timeout) > (double)ECS_HTTP_MIN_DEQUEUE_INTERVAL) {
-        srv->dequeue_timeout = 0;
-
         ecs_time_t t = {0};
         ecs_time_measure(&t);
-        int32_t request_count = http_dequeue_requests(srv, srv->dequeue_timeout);
-        srv->requests_processed += request_count;
-        srv->requests_processed_total += request_count;
-        double time_spent = ecs_time_measure(&t);
-        srv->request_time += time_spent;
-        srv->request_time_total += time_spent;
-        srv->dequeue_count ++;
+        int32_t request_count = http_dequeue_requests(srv, method);
+        if (request_count == -1) {
+            /* Don't reset timeout, so the next call handles the requests 
+             * without waiting for the dequeue interval */
+            result = true;
+        } else {
+            srv->dequeue_timeout = 0;
+            srv->requests_processed += request_count;
+            srv->requests_processed_total += request_count;
+            double time_spent = ecs_time_measure(&t);
+            srv->request_time += time_spent;
+            srv->request_time_total += time_spent;
+            srv->dequeue_count ++;
+        }
     }
 
     if ((1000 * srv->stats_timeout) > (double)ECS_HTTP_MIN_STATS_INTERVAL) {
@@ -1627,8 +2585,28 @@ void ecs_http_server_dequeue(
         srv->dequeue_count = 0;
     }
 
+    return result;
 error:
-    return;
+    return false;
+}
+
+void ecs_http_server_dequeue(
+    ecs_http_server_t* srv,
+    ecs_ftime_t delta_time)
+{
+    http_server_dequeue(srv, delta_time, EcsHttpMethodUnsupported);
+}
+
+bool ecs_http_server_dequeue_method(
+    ecs_http_server_t* srv,
+    ecs_ftime_t delta_time,
+    ecs_http_method_t method)
+{
+    ecs_check(method != EcsHttpMethodUnsupported, 
+        ECS_INVALID_PARAMETER, NULL);
+    return http_server_dequeue(srv, delta_time, method);
+error:
+    return false;
 }
 
 int ecs_http_server_http_request(
@@ -1642,7 +2620,7 @@ int ecs_http_server_http_request(
     }
 
     ecs_http_fragment_t frag = {0};
-    if (!http_parse_request(&frag, req, len)) {
+    if (!http_parse_request(&frag, req, len, NULL)) {
         ecs_strbuf_reset(&frag.buf);
         reply_out->code = 400;
         return -1;
@@ -1655,14 +2633,19 @@ int ecs_http_server_http_request(
         return -1;
     }
 
-    ecs_http_request_entry_t *entry = 
-        http_find_request_entry(srv, request.res, request.req_len);
+    ecs_http_request_entry_t *entry = NULL;
+    if (request.pub.method == EcsHttpGet &&
+        !ecs_http_get_header(&request.pub, "If-None-Match"))
+    {
+        entry = http_find_request_entry(srv, request.res, request.req_len);
+    }
     if (entry) {
         reply_out->body = ECS_STRBUF_INIT;
         reply_out->code = entry->code;
         reply_out->content_type = "application/json";
         reply_out->headers = ECS_STRBUF_INIT;
         reply_out->status = "OK";
+        reply_out->chunked = false;
         ecs_strbuf_appendstrn(&reply_out->body, 
             entry->content, entry->content_length);
     } else {
@@ -1708,6 +2691,230 @@ int ecs_http_server_request(
     return ecs_http_server_http_request(srv, reqstr, len, reply_out);
 }
 
+void ecs_http_server_invalidate(
+    ecs_http_server_t *srv,
+    const char *path)
+{
+    ecs_check(srv != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(path != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    /* Cache keys start with the decoded path, which is terminated with a 0 */
+    ecs_map_iter_t it = ecs_map_iter(&srv->request_cache.impl);
+    while (ecs_map_next(&it)) {
+        ecs_hm_bucket_t *bucket = ecs_map_ptr(&it);
+        int32_t i, count = ecs_vec_count(&bucket->keys);
+        ecs_http_request_key_t *keys = ecs_vec_first(&bucket->keys);
+        for (i = count - 1; i >= 0; i --) {
+            if (!ecs_os_strcmp(&keys[i].array[1], path)) {
+                http_remove_request_entry(srv, bucket, ecs_map_key(&it), i);
+            }
+        }
+    }
+error:
+    return;
+}
+
+int ecs_http_reply_flush(
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply)
+{
+    ecs_check(req != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(reply != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_http_connection_impl_t *conn = 
+        (ecs_http_connection_impl_t*)req->conn;
+    if (!conn) {
+        /* Request was not received on a connection, keep entire body */
+        return 0;
+    }
+
+    /* Handlers run on the main thread while the server is locked. Safe, the
+     * request is owned by the server while the handler runs. */
+    ecs_http_server_t *srv = conn->pub.server;
+    ecs_http_request_impl_t *req_impl = ECS_CONST_CAST(
+        ecs_http_request_impl_t*, req);
+
+    if (!http_socket_is_valid(conn->sock) || 
+        req_impl->flush_wait > ECS_HTTP_FLUSH_TIMEOUT) 
+    {
+        return -1;
+    }
+
+    if (!reply->chunked) {
+        ecs_strbuf_t hdrs = ECS_STRBUF_INIT;
+        ecs_strbuf_appendlit(&reply->headers, "Transfer-Encoding: chunked\r\n");
+        if (req_impl->gzip) {
+            ecs_strbuf_appendlit(&reply->headers, 
+                "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n");
+        }
+        if (req_impl->close) {
+            ecs_strbuf_appendlit(&reply->headers, "Connection: close\r\n");
+        }
+        http_append_send_headers(&hdrs, reply->code, reply->status,
+            reply->content_type, &reply->headers, -1, false);
+        ecs_size_t headers_length = ecs_strbuf_written(&hdrs);
+        char *headers = ecs_strbuf_get(&hdrs);
+        http_send_queue_push(conn, headers, headers_length, NULL, 0, 
+            req_impl->seq, false, false);
+        reply->chunked = true;
+    }
+
+    int32_t length = ecs_strbuf_written(&reply->body);
+    if (!length) {
+        return 0;
+    }
+
+    if (req_impl->gzip) {
+        /* Safe, compressor state is not visible to the handler */
+        ecs_http_gzip_t *gzip = ECS_CONST_CAST(
+            ecs_http_gzip_t*, &req_impl->gzip_state);
+        ecs_size_t gzip_length;
+        char *data = http_gzip(
+            gzip, reply->body.content, length, false, &gzip_length);
+        http_send_chunk(conn, data, gzip_length, req_impl->seq, false, false);
+        ecs_os_free(data);
+    } else {
+        http_send_chunk(conn, reply->body.content, length, req_impl->seq, 
+            false, false);
+    }
+
+    /* Keep the buffer so it can be reused for the next chunk */
+    reply->body.length = 0;
+
+    /* Wait for the I/O thread if the client doesn't keep up, so a large reply
+     * isn't buffered in its entirety. Only wait when this is the reply that's
+     * being sent, as replies to earlier requests may not have been queued. */
+    http_wakeup(srv);
+    ecs_time_t t = {0, 0};
+    ecs_time_measure(&t);
+    while ((conn->send_bytes > ECS_HTTP_SEND_QUEUE_BYTES_MAX) &&
+        (conn->send_seq == req_impl->seq) &&
+        http_socket_is_valid(conn->sock) && srv->should_run)
+    {
+        ecs_os_mutex_unlock(srv->lock);
+        ecs_os_sleep(0, 1000 * 1000);
+        ecs_os_mutex_lock(srv->lock);
+
+        req_impl->flush_wait += ecs_time_measure(&t);
+        if (req_impl->flush_wait > ECS_HTTP_FLUSH_TIMEOUT) {
+            /* Don't stall the frame on a client that stopped receiving data.
+             * The socket is shut down instead of closed, as the I/O thread may
+             * be polling it. Sending the queued data then fails, after which
+             * the I/O thread closes the connection. */
+            ecs_warn("http: client '%s:%s' doesn't receive reply, aborting",
+                conn->pub.host, conn->pub.port);
+            ecs_os_linc(&ecs_http_send_error_count);
+            http_shutdown(conn->sock);
+            conn->closing = true;
+            http_wakeup(srv);
+            return -1;
+        }
+    }
+
+    if (!http_socket_is_valid(conn->sock)) {
+        return -1;
+    }
+
+    return 0;
+error:
+    return -1;
+}
+
+uint64_t ecs_http_reply_stream(
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply)
+{
+    ecs_check(req != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(reply != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!reply->chunked, ECS_INVALID_OPERATION, 
+        "cannot stream reply that was already flushed");
+
+    reply->content_type = "text/event-stream";
+    ecs_strbuf_appendlit(&reply->headers, "Cache-Control: no-cache\r\n");
+
+    ecs_http_connection_impl_t *conn = 
+        (ecs_http_connection_impl_t*)req->conn;
+    if (!conn || conn->stream) {
+        return 0;
+    }
+
+    /* Safe, request is owned by the server while the handler runs. Data is
+     * pushed as it's created, so don't wait for more data to compress. */
+    ecs_http_request_impl_t *req_impl = ECS_CONST_CAST(
+        ecs_http_request_impl_t*, req);
+    req_impl->gzip = false;
+
+    if (ecs_http_reply_flush(req, reply)) {
+        return 0;
+    }
+
+    /* The stream counts as an outstanding request, which keeps the connection
+     * alive until the stream is closed. Requests pipelined after the stream
+     * can't be replied to, so stop reading requests. */
+    req_impl->stream = true;
+    conn->stream = true;
+    conn->stream_seq = req_impl->seq;
+    conn->request_count ++;
+    conn->closing = true;
+
+    return conn->pub.id;
+error:
+    return 0;
+}
+
+int ecs_http_stream_send(
+    ecs_http_server_t *srv,
+    uint64_t stream,
+    const char *data,
+    ecs_size_t length)
+{
+    ecs_check(srv != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(stream != 0, ECS_INVALID_PARAMETER, NULL);
+
+    int result = 0;
+    ecs_os_mutex_lock(srv->lock);
+    ecs_http_connection_impl_t *conn = flecs_sparse_try_t(
+        &srv->connections, ecs_http_connection_impl_t, stream);
+    if (!conn || !conn->stream || !http_socket_is_valid(conn->sock)) {
+        result = -1;
+    } else if (conn->send_bytes > ECS_HTTP_SEND_QUEUE_BYTES_MAX) {
+        /* Client doesn't keep up, don't buffer more data */
+        ecs_os_linc(&ecs_http_busy_count);
+        result = 1;
+    } else if (length) {
+        http_send_chunk(conn, data, length, conn->stream_seq, false, false);
+        http_wakeup(srv);
+    }
+    ecs_os_mutex_unlock(srv->lock);
+
+    return result;
+error:
+    return -1;
+}
+
+void ecs_http_stream_close(
+    ecs_http_server_t *srv,
+    uint64_t stream)
+{
+    ecs_check(srv != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_os_mutex_lock(srv->lock);
+    ecs_http_connection_impl_t *conn = flecs_sparse_try_t(
+        &srv->connections, ecs_http_connection_impl_t, stream);
+    if (conn && conn->stream) {
+        conn->stream = false;
+        conn->request_count --;
+        if (http_socket_is_valid(conn->sock)) {
+            /* Terminate reply and close connection once it's sent */
+            http_send_chunk(conn, NULL, 0, conn->stream_seq, true, true);
+            http_wakeup(srv);
+        }
+    }
+    ecs_os_mutex_unlock(srv->lock);
+error:
+    return;
+}
+
 void* ecs_http_server_ctx(
     ecs_http_server_t* srv)
 {
@@ -433,20 +433,9 @@ void flecs_json_string_escape(
     ecs_strbuf_t *buf,
     const char *value)
 {
-    ecs_size_t length = ecs_stresc(NULL, 0, '"', value);
-    if (length == ecs_os_strlen(value)) {
-        ecs_strbuf_appendch(buf, '"');
-        ecs_strbuf_appendstrn(buf, value, length);
-        ecs_strbuf_appendch(buf, '"');
-    } else {
-        char *out = ecs_os_malloc(length + 3);
-        ecs_stresc(out + 1, length, '"', value);
-        out[0] = '"';
-        out[length + 1] = '"';
-        out[length + 2] = '\0';
-        ecs_strbuf_appendstr(buf, out);
-        ecs_os_free(out);
-    }
+    ecs_strbuf_appendch(buf, '"');
+    ecs_strbuf_appendesc(buf, value, '"');
+    ecs_strbuf_appendch(buf, '"');
 }
 
 void flecs_json_member(
@@ -36,11 +36,23 @@ typedef struct ecs_json_value_ser_ctx_t {
     bool initialized;
 } ecs_json_value_ser_ctx_t;
 
+/* Type data for a field, reused by results that match the same id. This
+ * avoids looking up the component and reflection data of each field for every
+ * serialized result. */
+typedef struct ecs_json_field_plan_t {
+    ecs_id_t id;
+    const EcsComponent *comp;
+    const EcsMetaTypeSerialized *ser;
+} ecs_json_field_plan_t;
+
 /* Cached data for serializer */
 typedef struct ecs_json_ser_ctx_t {
     ecs_id_record_t *idr_doc_name;
     ecs_id_record_t *idr_doc_color;
     ecs_json_value_ser_ctx_t value_ctx[64];
+    ecs_json_field_plan_t field_plan[64];
+    ecs_json_write_action_t write; /* Set when streaming to a sink */
+    void *write_ctx;
 } ecs_json_ser_ctx_t;
 
 const char* flecs_json_parse(
@@ -2070,11 +2070,37 @@ void flecs_json_serialize_iter_result_colors(
 #endif
 }
 
+/* When streaming, pass buffered data to the sink once it exceeds the chunk
+ * size. Only the length of the buffer is reset, which keeps its allocation and
+ * the list state used for separators intact. */
+static
+int flecs_json_serialize_flush(
+    ecs_strbuf_t *buf,
+    ecs_json_ser_ctx_t *ser_ctx,
+    bool last)
+{
+    if (!ser_ctx->write) {
+        return 0;
+    }
+
+    if (!buf->length || (!last && buf->length < ECS_JSON_STREAM_CHUNK_SIZE)) {
+        return 0;
+    }
+
+    if (ser_ctx->write(buf->content, buf->length, ser_ctx->write_ctx)) {
+        return -1;
+    }
+
+    buf->length = 0;
+    return 0;
+}
+
 static
 int flecs_json_serialize_iter_result_values(
     const ecs_world_t *world,
     const ecs_iter_t *it,
-    ecs_strbuf_t *buf) 
+    ecs_strbuf_t *buf,
+    ecs_json_ser_ctx_t *ser_ctx) 
 {
     if (!it->ptrs || (it->flags & EcsIterNoData)) {
         return 0;
@@ -2105,26 +2131,26 @@ int flecs_json_serialize_iter_result_values(
             continue;
         }
 
-        /* Get component id (can be different in case of pairs) */
-        ecs_entity_t type = ecs_get_typeid(world, it->ids[i]);
-        if (!type) {
-            /* Odd, we have a ptr but no Component? Not the place of the
-             * serializer to complain about that. */
-            ecs_strbuf_appendch(buf, '0');
-            continue;
-        }
+        /* Get component id (can be different in case of pairs). Fields are
+         * usually matched with the same id for all results. */
+        ecs_json_field_plan_t *plan = &ser_ctx->field_plan[i];
+        if (plan->id != it->ids[i]) {
+            plan->id = it->ids[i];
+            plan->comp = NULL;
+            plan->ser = NULL;
 
-        const EcsComponent *comp = ecs_get(world, type, EcsComponent);
-        if (!comp) {
-            /* Also odd, typeid but not a component? */
-            ecs_strbuf_appendch(buf, '0');
-            continue;
+            ecs_entity_t type = ecs_get_typeid(world, plan->id);
+            if (type) {
+                plan->comp = ecs_get(world, type, EcsComponent);
+                plan->ser = ecs_get(world, type, EcsMetaTypeSerialized);
+            }
         }
 
-        const EcsMetaTypeSerialized *ser = ecs_get(
-            world, type, EcsMetaTypeSerialized);
-        if (!ser) {
-            /* Not odd, component just has no reflection data */
+        /* No type info means that the id is not a component or that the
+         * component has no reflection data */
+        const EcsComponent *comp = plan->comp;
+        const EcsMetaTypeSerialized *ser = plan->ser;
+        if (!comp || !ser) {
             ecs_strbuf_appendch(buf, '0');
             continue;
         }
@@ -2147,6 +2173,10 @@ int flecs_json_serialize_iter_result_values(
                 return -1;
             }
         }
+
+        if (flecs_json_serialize_flush(buf, ser_ctx, false)) {
+            return -1;
+        }
     }
 
     flecs_json_array_pop(buf);
@@ -2159,7 +2189,8 @@ int flecs_json_serialize_iter_result_columns(
     const ecs_world_t *world,
     const ecs_iter_t *it,
     ecs_strbuf_t *buf,
-    const ecs_iter_to_json_desc_t *desc)
+    const ecs_iter_to_json_desc_t *desc,
+    ecs_json_ser_ctx_t *ser_ctx)
 {
     ecs_table_t *table = it->table;
     if (!table || !table->column_count) {
@@ -2220,6 +2251,10 @@ int flecs_json_serialize_iter_result_columns(
         if (array_to_json_buf_w_type_data(world, ptr, it->count, buf, comp, ser)) {
             return -1;
         }
+
+        if (flecs_json_serialize_flush(buf, ser_ctx, false)) {
+            return -1;
+        }
     }
 
     flecs_json_array_pop(buf);
@@ -2301,14 +2336,22 @@ int flecs_json_serialize_iter_result(
             flecs_json_serialize_iter_result_colors(it, buf, ser_ctx);
         }
 
+        if (flecs_json_serialize_flush(buf, ser_ctx, false)) {
+            return -1;
+        }
+
         /* Serialize component values */
         if (desc && desc->serialize_table) {
-            if (flecs_json_serialize_iter_result_columns(world, it, buf, desc)) {
+            if (flecs_json_serialize_iter_result_columns(
+                world, it, buf, desc, ser_ctx)) 
+            {
                 return -1;
             }
         } else {
             if (!desc || desc->serialize_values) {
-                if (flecs_json_serialize_iter_result_values(world, it, buf)) {
+                if (flecs_json_serialize_iter_result_values(
+                    world, it, buf, ser_ctx)) 
+                {
                     return -1;
                 }
             }
@@ -2331,11 +2374,14 @@ int flecs_json_serialize_iter_result(
     return 0;
 }
 
-int ecs_iter_to_json_buf(
+static
+int flecs_iter_to_json_buf(
     const ecs_world_t *world,
     ecs_iter_t *it,
     ecs_strbuf_t *buf,
-    const ecs_iter_to_json_desc_t *desc)
+    const ecs_iter_to_json_desc_t *desc,
+    ecs_json_write_action_t write,
+    void *write_ctx)
 {
     ecs_time_t duration = {0};
     if (desc && desc->measure_eval_duration) {
@@ -2345,6 +2391,8 @@ int ecs_iter_to_json_buf(
     /* Cache id record for flecs.doc ids */
     ecs_json_ser_ctx_t ser_ctx;
     ecs_os_zeromem(&ser_ctx);
+    ser_ctx.write = write;
+    ser_ctx.write_ctx = write_ctx;
 #ifdef FLECS_DOC
     ser_ctx.idr_doc_name = flecs_id_record_get(world, 
         ecs_pair_t(EcsDocDescription, EcsName));
@@ -2409,7 +2457,9 @@ int ecs_iter_to_json_buf(
 
         ecs_iter_next_action_t next = it->next;
         while (next(it)) {
-            if (flecs_json_serialize_iter_result(world, it, buf, desc, &ser_ctx)) {
+            if (flecs_json_serialize_iter_result(world, it, buf, desc, &ser_ctx) ||
+                flecs_json_serialize_flush(buf, &ser_ctx, false)) 
+            {
                 ecs_strbuf_reset(buf);
                 ecs_iter_fini(it);
                 return -1;
@@ -2436,7 +2486,33 @@ int ecs_iter_to_json_buf(
 
     flecs_json_object_pop(buf);
 
-    return 0;
+    return flecs_json_serialize_flush(buf, &ser_ctx, true);
+}
+
+int ecs_iter_to_json_buf(
+    const ecs_world_t *world,
+    ecs_iter_t *it,
+    ecs_strbuf_t *buf,
+    const ecs_iter_to_json_desc_t *desc)
+{
+    return flecs_iter_to_json_buf(world, it, buf, desc, NULL, NULL);
+}
+
+int ecs_iter_to_json_stream(
+    const ecs_world_t *world,
+    ecs_iter_t *it,
+    const ecs_iter_to_json_desc_t *desc,
+    ecs_json_write_action_t write,
+    void *ctx)
+{
+    ecs_check(write != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    ecs_strbuf_t buf = ECS_STRBUF_INIT;
+    int result = flecs_iter_to_json_buf(world, it, &buf, desc, write, ctx);
+    ecs_strbuf_reset(&buf);
+    return result;
+error:
+    return -1;
 }
 
 char* ecs_iter_to_json(
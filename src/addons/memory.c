@@ -0,0 +1,591 @@
+/**
+ * @file addons/memory.c
+ * @brief Memory accounting for the stats addon.
+ *
+ * Memory is computed by walking the data structures of a world, which means
+ * that the regular (de)allocation paths don't pay for the bookkeeping. For
+ * each data structure "used" is the memory that stores live data, whereas
+ * "allocated" also includes reserved capacity, such as the unused elements of
+ * a vector or the buckets of a map.
+ */
+
+#include "../private_api.h"
+
+#ifdef FLECS_STATS
+
+static
+void flecs_memory_add(
+    ecs_memory_t *dst,
+    const ecs_memory_t *src)
+{
+    dst->used += src->used;
+    dst->allocated += src->allocated;
+}
+
+static
+void flecs_memory_add_size(
+    ecs_memory_t *dst,
+    ecs_size_t size)
+{
+    dst->used += size;
+    dst->allocated += size;
+}
+
+static
+void flecs_memory_vec(
+    ecs_memory_t *dst,
+    const ecs_vec_t *v,
+    ecs_size_t elem_size)
+{
+    dst->used += (int64_t)v->count * elem_size;
+    dst->allocated += (int64_t)v->size * elem_size;
+}
+
+static
+void flecs_memory_map(
+    ecs_memory_t *dst,
+    const ecs_map_t *map)
+{
+    int64_t entries = (int64_t)map->count * ECS_SIZEOF(ecs_bucket_entry_t);
+    dst->used += entries;
+    dst->allocated += entries +
+        (int64_t)map->bucket_count * ECS_SIZEOF(ecs_bucket_t);
+}
+
+static
+void flecs_memory_hashmap(
+    ecs_memory_t *dst,
+    const ecs_hashmap_t *hm)
+{
+    flecs_memory_map(dst, &hm->impl);
+
+    ecs_map_iter_t it = ecs_map_iter(&hm->impl);
+    while (ecs_map_next(&it)) {
+        ecs_hm_bucket_t *bucket = ecs_map_ptr(&it);
+        flecs_memory_add_size(dst, ECS_SIZEOF(ecs_hm_bucket_t));
+        flecs_memory_vec(dst, &bucket->keys, hm->key_size);
+        flecs_memory_vec(dst, &bucket->values, hm->value_size);
+    }
+}
+
+static
+void flecs_memory_string_pool(
+    ecs_memory_t *dst,
+    const ecs_hashmap_t *pool)
+{
+    flecs_memory_hashmap(dst, pool);
+
+    flecs_hashmap_iter_t it = flecs_hashmap_iter(
+        ECS_CONST_CAST(ecs_hashmap_t*, pool));
+    ecs_hashed_string_t *key;
+    while (flecs_hashmap_next_w_key(&it, ecs_hashed_string_t, &key, uint64_t)) {
+        flecs_memory_add_size(dst, key->length + 1);
+    }
+}
+
+static
+void flecs_memory_stack(
+    ecs_memory_t *dst,
+    const ecs_stack_t *stack)
+{
+    const ecs_stack_page_t *page;
+    bool in_use = true;
+    for (page = &stack->first; page; page = page->next) {
+        if (!page->data) {
+            continue;
+        }
+
+        dst->allocated += ECS_STACK_PAGE_SIZE;
+        if (in_use) {
+            dst->used += page->sp;
+        }
+
+        /* Pages after the tail page are kept for reuse */
+        if (page == stack->tail_page) {
+            in_use = false;
+        }
+    }
+}
+
+static
+void flecs_memory_filter(
+    ecs_memory_t *dst,
+    const ecs_filter_t *filter)
+{
+    /* Terms array is allocated together with the field sizes and ids */
+    flecs_memory_add_size(dst, filter->term_count * (ECS_SIZEOF(ecs_term_t) +
+        ECS_SIZEOF(ecs_id_t) + ECS_SIZEOF(ecs_size_t)));
+}
+
+static
+void flecs_memory_graph_edges(
+    ecs_memory_t *dst,
+    const ecs_graph_edges_t *edges)
+{
+    if (edges->lo) {
+        int32_t i, used = 0;
+        for (i = 0; i < FLECS_HI_COMPONENT_ID; i ++) {
+            const ecs_graph_edge_t *edge = &edges->lo[i];
+            if (edge->to) {
+                used ++;
+            }
+            if (edge->diff) {
+                flecs_memory_add_size(dst, ECS_SIZEOF(ecs_table_diff_t) +
+                    (edge->diff->added.count + edge->diff->removed.count) *
+                        ECS_SIZEOF(ecs_id_t));
+            }
+        }
+        dst->used += used * ECS_SIZEOF(ecs_graph_edge_t);
+        dst->allocated += FLECS_HI_COMPONENT_ID * ECS_SIZEOF(ecs_graph_edge_t);
+    }
+
+    if (edges->hi) {
+        flecs_memory_add_size(dst, ECS_SIZEOF(ecs_map_t));
+        flecs_memory_map(dst, edges->hi);
+
+        ecs_map_iter_t it = ecs_map_iter(edges->hi);
+        while (ecs_map_next(&it)) {
+            const ecs_graph_edge_t *edge = ecs_map_ptr(&it);
+            flecs_memory_add_size(dst, ECS_SIZEOF(ecs_graph_edge_t));
+            if (edge->diff) {
+                flecs_memory_add_size(dst, ECS_SIZEOF(ecs_table_diff_t) +
+                    (edge->diff->added.count + edge->diff->removed.count) *
+                        ECS_SIZEOF(ecs_id_t));
+            }
+        }
+    }
+}
+
+static
+void flecs_memory_column(
+    ecs_memory_t *dst,
+    const ecs_column_t *column)
+{
+    flecs_memory_vec(dst, &column->data, column->size);
+}
+
+static
+void flecs_memory_id_record_index(
+    ecs_memory_t *dst,
+    const ecs_id_record_t *idr)
+{
+    flecs_memory_map(dst, &idr->cache.index);
+    flecs_memory_vec(dst, &idr->reachable.ids,
+        ECS_SIZEOF(ecs_reachable_elem_t));
+}
+
+static
+void flecs_memory_id_record(
+    ecs_world_memory_t *dst,
+    const ecs_id_record_t *idr)
+{
+    flecs_memory_id_record_index(&dst->id_index, idr);
+    if (idr->name_index) {
+        flecs_memory_add_size(&dst->name_index, ECS_SIZEOF(ecs_hashmap_t));
+        flecs_memory_hashmap(&dst->name_index, idr->name_index);
+    }
+}
+
+static
+void flecs_memory_query_match(
+    ecs_memory_t *dst,
+    const ecs_query_t *query,
+    const ecs_query_table_match_t *qm)
+{
+    ecs_size_t field_count = query->filter.field_count;
+    flecs_memory_add_size(dst, ECS_SIZEOF(ecs_query_table_match_t));
+    if (qm->columns) {
+        flecs_memory_add_size(dst, field_count * ECS_SIZEOF(int32_t));
+    }
+    if (qm->storage_columns) {
+        flecs_memory_add_size(dst, field_count * ECS_SIZEOF(int32_t));
+    }
+    if (qm->ids) {
+        flecs_memory_add_size(dst, field_count * ECS_SIZEOF(ecs_id_t));
+    }
+    if (qm->sources) {
+        flecs_memory_add_size(dst, field_count * ECS_SIZEOF(ecs_entity_t));
+    }
+    if (qm->monitor) {
+        flecs_memory_add_size(dst, (1 + field_count) * ECS_SIZEOF(int32_t));
+    }
+    flecs_memory_vec(dst, &qm->refs, ECS_SIZEOF(ecs_ref_t));
+}
+
+static
+void flecs_memory_polys(
+    const ecs_world_t *world,
+    ecs_entity_t kind,
+    ecs_memory_t *dst)
+{
+    ecs_id_record_t *idr = flecs_id_record_get(world,
+        ecs_pair(ecs_id(EcsPoly), kind));
+    if (!idr) {
+        return;
+    }
+
+    ecs_table_cache_iter_t it;
+    const ecs_table_record_t *tr;
+    if (flecs_table_cache_all_iter(&idr->cache, &it)) {
+        while ((tr = flecs_table_cache_next(&it, ecs_table_record_t))) {
+            ecs_table_t *table = tr->hdr.table;
+            EcsPoly *polys = ecs_table_get_column(table, tr->column, 0);
+            int32_t i, count = ecs_table_count(table);
+            for (i = 0; i < count; i ++) {
+                ecs_memory_t m;
+                if (kind == EcsQuery) {
+                    m = ecs_query_memory_get(polys[i].poly);
+                } else {
+                    m = ecs_observer_memory_get(polys[i].poly);
+                }
+                flecs_memory_add(dst, &m);
+            }
+        }
+    }
+}
+
+static
+void flecs_memory_entity_index(
+    ecs_memory_t *dst,
+    const ecs_entity_index_t *index)
+{
+    dst->used += (int64_t)index->alive_count *
+        (ECS_SIZEOF(uint64_t) + ECS_SIZEOF(ecs_record_t));
+    dst->allocated += (int64_t)index->dense.size * ECS_SIZEOF(uint64_t);
+    dst->allocated += (int64_t)index->pages.size *
+        ECS_SIZEOF(ecs_entity_index_page_t*);
+
+    int32_t i, count = ecs_vec_count(&index->pages);
+    ecs_entity_index_page_t **pages = ecs_vec_first(&index->pages);
+    for (i = 0; i < count; i ++) {
+        if (pages[i]) {
+            dst->allocated += ECS_SIZEOF(ecs_entity_index_page_t);
+        }
+    }
+}
+
+static
+void flecs_memory_stage(
+    ecs_memory_t *dst,
+    const ecs_stage_t *stage)
+{
+    int32_t i;
+    for (i = 0; i < ECS_MAX_DEFER_STACK; i ++) {
+        const ecs_commands_t *cmd = &stage->cmd_stack[i];
+        flecs_memory_vec(dst, &cmd->queue, ECS_SIZEOF(ecs_cmd_t));
+        flecs_memory_stack(dst, &cmd->stack);
+        flecs_memory_vec(dst, &cmd->entries.dense, ECS_SIZEOF(uint64_t));
+    }
+
+    flecs_memory_vec(dst, &stage->post_frame_actions,
+        ECS_SIZEOF(ecs_action_elem_t));
+}
+
+static
+void flecs_memory_ballocator(
+    const ecs_block_allocator_t *ba,
+    ecs_size_class_memory_t *dst)
+{
+    ecs_os_zeromem(dst);
+    dst->size = ba->data_size;
+
+    const ecs_block_allocator_block_t *block;
+    for (block = ba->block_head; block; block = block->next) {
+        dst->block_count ++;
+    }
+
+    int32_t free_count = 0;
+    const ecs_block_allocator_chunk_header_t *chunk;
+    for (chunk = ba->head; chunk; chunk = chunk->next) {
+        free_count ++;
+    }
+
+    dst->chunk_count = dst->block_count * ba->chunks_per_block - free_count;
+    dst->memory.used = (int64_t)dst->chunk_count * ba->chunk_size;
+    dst->memory.allocated = (int64_t)dst->block_count * ba->block_size;
+}
+
+static
+int flecs_memory_size_class_compare(
+    const void *ptr_a,
+    const void *ptr_b)
+{
+    const ecs_size_class_memory_t *a = ptr_a;
+    const ecs_size_class_memory_t *b = ptr_b;
+    return (a->size > b->size) - (a->size < b->size);
+}
+
+void ecs_table_memory_get(
+    const ecs_world_t *world,
+    const ecs_table_t *table,
+    ecs_table_memory_t *memory)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    ecs_check(table != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(memory != NULL, ECS_INVALID_PARAMETER, NULL);
+    (void)world;
+
+    ecs_os_zeromem(memory);
+
+    ecs_memory_t *meta = &memory->metadata;
+    int32_t type_count = table->type.count;
+    int32_t column_count = table->column_count;
+    flecs_memory_add_size(meta, ECS_SIZEOF(ecs_table_t));
+    flecs_memory_add_size(meta, type_count * ECS_SIZEOF(ecs_id_t));
+    flecs_memory_add_size(meta, column_count * ECS_SIZEOF(ecs_column_t));
+    if (table->column_map) {
+        flecs_memory_add_size(meta,
+            (type_count + column_count) * ECS_SIZEOF(int32_t));
+    }
+    if (table->dirty_state) {
+        flecs_memory_add_size(meta, (column_count + 1) * ECS_SIZEOF(int32_t));
+    }
+    if (table->_) {
+        flecs_memory_add_size(meta, ECS_SIZEOF(ecs_table__t));
+        flecs_memory_add_size(meta,
+            table->_->record_count * ECS_SIZEOF(ecs_table_record_t));
+    }
+    flecs_memory_graph_edges(meta, &table->node.add);
+    flecs_memory_graph_edges(meta, &table->node.remove);
+
+    flecs_memory_vec(&memory->entities, &table->data.entities,
+        ECS_SIZEOF(ecs_entity_t));
+
+    int32_t i;
+    for (i = 0; i < column_count; i ++) {
+        flecs_memory_column(&memory->columns, &table->data.columns[i]);
+    }
+
+    if (table->_) {
+        for (i = 0; i < table->_->bs_count; i ++) {
+            const ecs_bitset_t *bs = &table->_->bs_columns[i];
+            flecs_memory_add_size(&memory->columns, ECS_SIZEOF(ecs_bitset_t));
+            memory->columns.used +=
+                ((bs->count + 63) / 64) * ECS_SIZEOF(uint64_t);
+            memory->columns.allocated +=
+                ((bs->size + 63) / 64) * ECS_SIZEOF(uint64_t);
+        }
+
+        for (i = 0; i < table->_->sw_count; i ++) {
+            const ecs_switch_t *sw = &table->_->sw_columns[i];
+            flecs_memory_add_size(&memory->columns, ECS_SIZEOF(ecs_switch_t));
+            flecs_memory_map(&memory->columns, &sw->hdrs);
+            flecs_memory_vec(&memory->columns, &sw->nodes,
+                ECS_SIZEOF(ecs_switch_node_t));
+            flecs_memory_vec(&memory->columns, &sw->values,
+                ECS_SIZEOF(uint64_t));
+        }
+    }
+error:
+    return;
+}
+
+void ecs_id_memory_get(
+    const ecs_world_t *world,
+    ecs_id_t id,
+    ecs_id_memory_t *memory)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(memory != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    ecs_os_zeromem(memory);
+
+    ecs_id_record_t *idr = flecs_id_record_get(world, id);
+    if (!idr) {
+        return;
+    }
+
+    flecs_memory_add_size(&memory->index, ECS_SIZEOF(ecs_id_record_t));
+    flecs_memory_id_record_index(&memory->index, idr);
+
+    ecs_table_cache_iter_t it;
+    const ecs_table_record_t *tr;
+    if (flecs_table_cache_all_iter(&idr->cache, &it)) {
+        while ((tr = flecs_table_cache_next(&it, ecs_table_record_t))) {
+            ecs_table_t *table = tr->hdr.table;
+            memory->table_count ++;
+
+            if (tr->column == -1) {
+                continue;
+            }
+
+            /* Wildcard records can match multiple columns */
+            int32_t i, end = tr->index + tr->count;
+            for (i = tr->index; i < end; i ++) {
+                int32_t column = ecs_table_type_to_column_index(table, i);
+                if (column != -1) {
+                    flecs_memory_column(&memory->columns,
+                        &table->data.columns[column]);
+                }
+            }
+        }
+    }
+error:
+    return;
+}
+
+ecs_memory_t ecs_query_memory_get(
+    const ecs_query_t *query)
+{
+    ecs_memory_t result = {0};
+    ecs_poly_assert(query, ecs_query_t);
+
+    flecs_memory_add_size(&result, ECS_SIZEOF(ecs_query_t));
+    flecs_memory_filter(&result, &query->filter);
+    flecs_memory_map(&result, &query->cache.index);
+    flecs_memory_map(&result, &query->groups);
+    result.used += (int64_t)ecs_map_count(&query->groups) *
+        ECS_SIZEOF(ecs_query_table_list_t);
+    result.allocated += (int64_t)ecs_map_count(&query->groups) *
+        ECS_SIZEOF(ecs_query_table_list_t);
+    flecs_memory_vec(&result, &query->table_slices,
+        ECS_SIZEOF(ecs_query_table_match_t));
+    flecs_memory_vec(&result, &query->subqueries, ECS_SIZEOF(ecs_query_t*));
+
+    ecs_table_cache_iter_t it;
+    const ecs_query_table_t *qt;
+    ecs_table_cache_t *cache = ECS_CONST_CAST(ecs_table_cache_t*,
+        &query->cache);
+    if (flecs_table_cache_all_iter(cache, &it)) {
+        while ((qt = flecs_table_cache_next(&it, ecs_query_table_t))) {
+            flecs_memory_add_size(&result, ECS_SIZEOF(ecs_query_table_t));
+
+            const ecs_query_table_match_t *qm;
+            for (qm = qt->first; qm; qm = qm->next_match) {
+                flecs_memory_query_match(&result, query, qm);
+            }
+        }
+    }
+
+    return result;
+}
+
+ecs_memory_t ecs_observer_memory_get(
+    const ecs_observer_t *observer)
+{
+    ecs_memory_t result = {0};
+    ecs_poly_assert(observer, ecs_observer_t);
+
+    flecs_memory_add_size(&result, ECS_SIZEOF(ecs_observer_t));
+    flecs_memory_filter(&result, &observer->filter);
+
+    return result;
+}
+
+void ecs_world_memory_get(
+    const ecs_world_t *world,
+    ecs_world_memory_t *memory)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(memory != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    ecs_os_zeromem(memory);
+
+    /* Entity index */
+    flecs_memory_entity_index(&memory->entity_index,
+        &world->store.entity_index);
+
+    /* Id index. Low id records are stored in an array that is allocated
+     * when the world is created. */
+    memory->id_index.allocated +=
+        FLECS_HI_ID_RECORD_ID * ECS_SIZEOF(ecs_id_record_t);
+    flecs_memory_map(&memory->id_index, &world->id_index_hi);
+
+    int32_t i;
+    for (i = 0; i < FLECS_HI_ID_RECORD_ID; i ++) {
+        const ecs_id_record_t *idr = &world->id_index_lo[i];
+        if (idr->id) {
+            memory->id_index.used += ECS_SIZEOF(ecs_id_record_t);
+            flecs_memory_id_record(memory, idr);
+        }
+    }
+
+    ecs_map_iter_t it = ecs_map_iter(&world->id_index_hi);
+    while (ecs_map_next(&it)) {
+        flecs_memory_add_size(&memory->id_index, ECS_SIZEOF(ecs_id_record_t));
+        flecs_memory_id_record(memory, ecs_map_ptr(&it));
+    }
+
+    /* Tables */
+    flecs_memory_hashmap(&memory->tables, &world->store.table_map);
+    ecs_sparse_iter_t table_it = flecs_sparse_iter(&world->store.tables);
+    const ecs_table_t *table = &world->store.root;
+    do {
+        ecs_table_memory_t tm;
+        ecs_table_memory_get(world, table, &tm);
+        flecs_memory_add(&memory->tables, &tm.metadata);
+        flecs_memory_add(&memory->table_data, &tm.entities);
+        flecs_memory_add(&memory->table_data, &tm.columns);
+    } while ((table = flecs_sparse_next_t(&table_it, ecs_table_t, NULL)));
+
+    /* Queries & observers */
+    flecs_memory_polys(world, EcsQuery, &memory->queries);
+    flecs_memory_polys(world, EcsObserver, &memory->observers);
+
+    /* Name index */
+    flecs_memory_hashmap(&memory->name_index, &world->symbols);
+    flecs_memory_hashmap(&memory->name_index, &world->aliases);
+
+    flecs_memory_string_pool(&memory->name_index, &world->identifiers);
+
+    /* Stages */
+    for (i = 0; i < world->stage_count; i ++) {
+        flecs_memory_stage(&memory->stages, &world->stages[i]);
+    }
+
+    /* World allocator */
+    ecs_sparse_iter_t size_it = flecs_sparse_iter(&world->allocator.sizes);
+    const ecs_block_allocator_t *ba;
+    while ((ba = flecs_sparse_next_t(&size_it, ecs_block_allocator_t, NULL))) {
+        ecs_size_class_memory_t sc;
+        flecs_memory_ballocator(ba, &sc);
+        flecs_memory_add(&memory->allocator, &sc.memory);
+    }
+
+    /* Committed memory of reserved regions (see ecs_set_reserved_storage) */
+    memory->allocator.used += world->allocator.vm.committed;
+    memory->allocator.allocated += world->allocator.vm.committed;
+error:
+    return;
+}
+
+int32_t ecs_allocator_memory_get(
+    const ecs_world_t *world,
+    ecs_size_class_memory_t *classes,
+    int32_t count)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!count || classes != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    world = ecs_get_world(world);
+
+    const ecs_sparse_t *sizes = &world->allocator.sizes;
+    int32_t i, size_count = flecs_sparse_count(sizes);
+    if (!count || !size_count) {
+        return size_count;
+    }
+
+    ecs_size_class_memory_t *all = ecs_os_malloc_n(
+        ecs_size_class_memory_t, size_count);
+    for (i = 0; i < size_count; i ++) {
+        flecs_memory_ballocator(
+            flecs_sparse_get_dense_t(sizes, ecs_block_allocator_t, i), &all[i]);
+    }
+
+    qsort(all, flecs_itosize(size_count), ECS_SIZEOF(ecs_size_class_memory_t),
+        flecs_memory_size_class_compare);
+
+    ecs_os_memcpy_n(classes, all, ecs_size_class_memory_t,
+        ECS_MIN(count, size_count));
+    ecs_os_free(all);
+
+    return size_count;
+error:
+    return 0;
+}
+
+#endif
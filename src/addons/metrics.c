@@ -17,6 +17,8 @@ ECS_TAG_DECLARE(EcsCounter);
 ECS_TAG_DECLARE(EcsCounterIncrement);
 ECS_TAG_DECLARE(EcsCounterId);
 ECS_TAG_DECLARE(EcsGauge);
+ECS_TAG_DECLARE(EcsHistogram);
+ECS_COMPONENT_DECLARE(EcsMetricHistogram);
 
 /* Internal components */
 static ECS_COMPONENT_DECLARE(EcsMetricMember);
@@ -24,6 +26,7 @@ static ECS_COMPONENT_DECLARE(EcsMetricId);
 static ECS_COMPONENT_DECLARE(EcsMetricOneOf);
 static ECS_COMPONENT_DECLARE(EcsMetricCountIds);
 static ECS_COMPONENT_DECLARE(EcsMetricCountTargets);
+static ECS_COMPONENT_DECLARE(EcsMetricMemberHistogram);
 static ECS_COMPONENT_DECLARE(EcsMetricMemberInstance);
 static ECS_COMPONENT_DECLARE(EcsMetricIdInstance);
 static ECS_COMPONENT_DECLARE(EcsMetricOneOfInstance);
@@ -62,6 +65,20 @@ typedef struct {
     ecs_map_t targets;               /**< Map of counters for each target */
 } ecs_count_targets_metric_ctx_t;
 
+/** Context for metric that tracks distribution of member */
+typedef struct {
+    ecs_metric_ctx_t metric;
+    ecs_primitive_kind_t type_kind;  /**< Primitive type kind of member */
+    uint16_t offset;                 /**< Offset of member in component */
+    ecs_filter_t filter;             /**< Matches component with member */
+    int32_t bucket_count;            /**< Number of buckets */
+    double min;                      /**< Lower bound of first bucket */
+    double scale;                    /**< Buckets per unit (linear buckets) */
+    bool log;                        /**< Log buckets */
+    int64_t first;                   /**< Upper bits of first bucket (log) */
+    int32_t shift;                   /**< Shift of bits to bucket (log) */
+} ecs_histogram_metric_ctx_t;
+
 /** Stores context shared for all instances of member metric */
 typedef struct {
     ecs_member_metric_ctx_t *ctx;
@@ -87,6 +104,11 @@ typedef struct {
     ecs_count_targets_metric_ctx_t *ctx;
 } EcsMetricCountTargets;
 
+/** Stores context of histogram metric */
+typedef struct {
+    ecs_histogram_metric_ctx_t *ctx;
+} EcsMetricMemberHistogram;
+
 /** Instance of member metric */
 typedef struct {
     ecs_ref_t ref;
@@ -149,6 +171,18 @@ static ECS_MOVE(EcsMetricCountTargets, dst, src, {
     src->ctx = NULL;
 })
 
+static ECS_DTOR(EcsMetricMemberHistogram, ptr, {
+    if (ptr->ctx) {
+        ecs_filter_fini(&ptr->ctx->filter);
+        ecs_os_free(ptr->ctx);
+    }
+})
+
+static ECS_MOVE(EcsMetricMemberHistogram, dst, src, {
+    *dst = *src;
+    src->ctx = NULL;
+})
+
 /** Observer used for creating new instances of member metric */
 static void flecs_metrics_on_member_metric(ecs_iter_t *it) {
     ecs_world_t *world = it->world;
@@ -437,6 +471,280 @@ static void UpdateCountIds(ecs_iter_t *it) {
     }
 }
 
+/* Number of samples that are assigned to buckets at a time */
+#define FLECS_METRIC_HISTOGRAM_CHUNK (256)
+
+#define FLECS_METRIC_HISTOGRAM_LOAD(T)\
+    for (i = 0; i < count; i ++) {\
+        out[i] = (double)*(const T*)ECS_OFFSET(ptr, i * size);\
+    }
+
+/* Convert member values of a table to doubles. The switch is outside of the
+ * loop so that the common types are converted with a plain strided load. */
+static
+void flecs_metric_histogram_load(
+    ecs_primitive_kind_t kind,
+    const void *ptr,
+    ecs_size_t size,
+    int32_t count,
+    double *out)
+{
+    int32_t i;
+    switch(kind) {
+    case EcsF32: FLECS_METRIC_HISTOGRAM_LOAD(ecs_f32_t); break;
+    case EcsF64: FLECS_METRIC_HISTOGRAM_LOAD(ecs_f64_t); break;
+    case EcsI32: FLECS_METRIC_HISTOGRAM_LOAD(ecs_i32_t); break;
+    case EcsU32: FLECS_METRIC_HISTOGRAM_LOAD(ecs_u32_t); break;
+    case EcsI64: FLECS_METRIC_HISTOGRAM_LOAD(ecs_i64_t); break;
+    case EcsU64: FLECS_METRIC_HISTOGRAM_LOAD(ecs_u64_t); break;
+    default:
+        for (i = 0; i < count; i ++) {
+            out[i] = ecs_meta_ptr_to_float(kind, ECS_OFFSET(ptr, i * size));
+        }
+        break;
+    }
+}
+
+/* Compute bucket for each value. The loops don't branch, which lets the
+ * compiler vectorize them. */
+static
+void flecs_metric_histogram_assign(
+    const ecs_histogram_metric_ctx_t *ctx,
+    const double *values,
+    int32_t count,
+    int32_t *out)
+{
+    int32_t i, last = ctx->bucket_count - 1;
+    if (!ctx->log) {
+        double min = ctx->min, scale = ctx->scale, max = (double)last;
+        for (i = 0; i < count; i ++) {
+            double f = (values[i] - min) * scale;
+            f = f >= 0 ? f : 0; /* Also catches NaN */
+            f = f < max ? f : max;
+            out[i] = (int32_t)f;
+        }
+    } else {
+        /* The exponent and upper bits of the mantissa of a positive double
+         * increase monotonically with its value, and together are the index
+         * of the bucket. */
+        int64_t first = ctx->first;
+        int32_t shift = ctx->shift;
+        for (i = 0; i < count; i ++) {
+            double v = values[i];
+            uint64_t bits;
+            ecs_os_memcpy_t(&bits, &v, uint64_t);
+            int64_t b = (int64_t)(bits >> shift) - first;
+            b = v > 0 ? b : 0;
+            b = b > 0 ? b : 0;
+            b = b < last ? b : last;
+            out[i] = (int32_t)b;
+        }
+    }
+}
+
+/* Interpolate percentile within the bucket that contains it */
+static
+double flecs_metric_histogram_percentile(
+    const EcsMetricHistogram *h,
+    double p)
+{
+    double rank = h->count * p, cur = 0;
+    int32_t b, last = h->bucket_count - 1;
+    for (b = 0; b <= last; b ++) {
+        double n = h->buckets[b];
+        if (n == 0 || (cur + n) < rank) {
+            cur += n;
+            continue;
+        }
+
+        /* First and last buckets also count samples outside of the range */
+        double lo = b ? h->bounds[b - 1] : h->min;
+        double hi = b != last ? h->bounds[b] : h->max;
+        lo = lo > h->min ? lo : h->min;
+        hi = hi < h->max ? hi : h->max;
+        return lo + (hi - lo) * ((rank - cur) / n);
+    }
+
+    return h->max;
+}
+
+/** Update histogram metric */
+static void UpdateHistogram(ecs_iter_t *it) {
+    ecs_world_t *world = it->real_world;
+    EcsMetricMemberHistogram *m = ecs_field(it, EcsMetricMemberHistogram, 1);
+    EcsMetricHistogram *h = ecs_field(it, EcsMetricHistogram, 2);
+    double values[FLECS_METRIC_HISTOGRAM_CHUNK];
+    int32_t buckets[FLECS_METRIC_HISTOGRAM_CHUNK];
+
+    int32_t i, count = it->count;
+    for (i = 0; i < count; i ++) {
+        ecs_histogram_metric_ctx_t *ctx = m[i].ctx;
+        EcsMetricHistogram *hist = &h[i];
+        double *hbuckets = hist->buckets;
+        double sum = 0, min = 0, max = 0;
+        int64_t total = 0;
+
+        ecs_os_memset_n(hbuckets, 0, double, ctx->bucket_count);
+
+        ecs_iter_t fit = ecs_filter_iter(world, &ctx->filter);
+        while (ecs_filter_next(&fit)) {
+            ecs_size_t size = fit.sizes[0];
+            const void *ptr = ECS_OFFSET(
+                ecs_field_w_size(&fit, flecs_itosize(size), 1), ctx->offset);
+
+            int32_t offset, table_count = fit.count;
+            for (offset = 0; offset < table_count; 
+                offset += FLECS_METRIC_HISTOGRAM_CHUNK) 
+            {
+                int32_t j, n = table_count - offset;
+                if (n > FLECS_METRIC_HISTOGRAM_CHUNK) {
+                    n = FLECS_METRIC_HISTOGRAM_CHUNK;
+                }
+
+                flecs_metric_histogram_load(ctx->type_kind, 
+                    ECS_OFFSET(ptr, offset * size), size, n, values);
+                flecs_metric_histogram_assign(ctx, values, n, buckets);
+
+                if (!total) {
+                    min = max = values[0];
+                }
+
+                for (j = 0; j < n; j ++) {
+                    double v = values[j];
+                    hbuckets[buckets[j]] += 1;
+                    sum += v;
+                    min = v < min ? v : min;
+                    max = v > max ? v : max;
+                }
+
+                total += n;
+            }
+        }
+
+        hist->count = (double)total;
+        hist->sum = sum;
+        hist->min = min;
+        hist->max = max;
+        if (total) {
+            hist->p50 = flecs_metric_histogram_percentile(hist, 0.5);
+            hist->p90 = flecs_metric_histogram_percentile(hist, 0.9);
+            hist->p99 = flecs_metric_histogram_percentile(hist, 0.99);
+        } else {
+            hist->p50 = hist->p90 = hist->p99 = 0;
+        }
+    }
+}
+
+/** Initialize histogram metric */
+static
+int flecs_histogram_metric_init(
+    ecs_world_t *world,
+    ecs_entity_t metric,
+    ecs_id_t id,
+    ecs_primitive_kind_t type_kind,
+    uintptr_t offset,
+    const ecs_metric_desc_t *desc)
+{
+    const ecs_metric_histogram_desc_t *hd = &desc->histogram;
+    ecs_histogram_metric_ctx_t *ctx = NULL;
+
+    int32_t bucket_count = hd->bucket_count;
+    if (!bucket_count) {
+        bucket_count = ECS_METRIC_HISTOGRAM_BUCKET_COUNT_DEFAULT;
+    }
+
+    if (bucket_count < 0 || bucket_count > ECS_METRIC_HISTOGRAM_BUCKET_COUNT_MAX) {
+        char *metric_name = ecs_get_fullpath(world, metric);
+        ecs_err("invalid bucket count %d for histogram metric '%s'",
+            bucket_count, metric_name);
+        ecs_os_free(metric_name);
+        goto error;
+    }
+
+    int32_t sub_bucket_count = hd->sub_bucket_count;
+    if (hd->log) {
+        if (!sub_bucket_count) {
+            sub_bucket_count = ECS_METRIC_HISTOGRAM_SUB_BUCKET_COUNT_DEFAULT;
+        }
+        if (sub_bucket_count < 0 || sub_bucket_count > (1 << 20) ||
+            (sub_bucket_count & (sub_bucket_count - 1))) 
+        {
+            char *metric_name = ecs_get_fullpath(world, metric);
+            ecs_err("sub bucket count for histogram metric '%s' must be a "
+                "power of 2", metric_name);
+            ecs_os_free(metric_name);
+            goto error;
+        }
+        if (!(hd->min > 0)) {
+            char *metric_name = ecs_get_fullpath(world, metric);
+            ecs_err("min of histogram metric '%s' with log buckets must be "
+                "larger than 0", metric_name);
+            ecs_os_free(metric_name);
+            goto error;
+        }
+    } else if (!(hd->max > hd->min)) {
+        char *metric_name = ecs_get_fullpath(world, metric);
+        ecs_err("max of histogram metric '%s' must be larger than min", 
+            metric_name);
+        ecs_os_free(metric_name);
+        goto error;
+    }
+
+    ctx = ecs_os_calloc_t(ecs_histogram_metric_ctx_t);
+    ctx->metric.metric = metric;
+    ctx->metric.kind = desc->kind;
+    ctx->type_kind = type_kind;
+    ctx->offset = flecs_uto(uint16_t, offset);
+    ctx->bucket_count = bucket_count;
+    ctx->min = hd->min;
+    ctx->log = hd->log;
+
+    ctx->filter = ECS_FILTER_INIT;
+    if (!ecs_filter(world, {
+        .storage = &ctx->filter,
+        .terms = {{ .id = id, .src.flags = EcsSelf, .inout = EcsIn }}
+    })) {
+        goto error;
+    }
+
+    EcsMetricHistogram *h = ecs_ensure(world, metric, EcsMetricHistogram);
+    ecs_os_zeromem(h);
+    h->bucket_count = bucket_count;
+
+    int32_t b;
+    if (hd->log) {
+        /* Bucket bounds are the doubles of which the mantissa bits that aren't
+         * used for the bucket index are zero. */
+        uint64_t bits;
+        ecs_os_memcpy_t(&bits, &hd->min, uint64_t);
+        ctx->shift = 52;
+        while ((1 << (52 - ctx->shift)) < sub_bucket_count) {
+            ctx->shift --;
+        }
+        ctx->first = (int64_t)(bits >> ctx->shift);
+        for (b = 0; b < bucket_count; b ++) {
+            bits = (uint64_t)(ctx->first + b + 1) << ctx->shift;
+            ecs_os_memcpy_t(&h->bounds[b], &bits, double);
+        }
+    } else {
+        double width = (hd->max - hd->min) / bucket_count;
+        ctx->scale = 1.0 / width;
+        for (b = 0; b < bucket_count; b ++) {
+            h->bounds[b] = hd->min + width * (b + 1);
+        }
+    }
+
+    ecs_modified(world, metric, EcsMetricHistogram);
+    ecs_set(world, metric, EcsMetricMemberHistogram, { .ctx = ctx });
+    ecs_add_pair(world, metric, EcsMetric, desc->kind);
+    ecs_add_id(world, metric, EcsMetric);
+
+    return 0;
+error:
+    ecs_os_free(ctx);
+    return -1;
+}
+
 /** Initialize member metric */
 static
 int flecs_member_metric_init(
@@ -561,6 +869,11 @@ int flecs_member_metric_init(
         goto error;
     }
 
+    if (desc->kind == EcsHistogram) {
+        return flecs_histogram_metric_init(
+            world, metric, id, p->kind, offset, desc);
+    }
+
     ecs_member_metric_ctx_t *ctx = ecs_os_calloc_t(ecs_member_metric_ctx_t);
     ctx->metric.metric = metric;
     ctx->metric.kind = desc->kind;
@@ -729,6 +1042,8 @@ int flecs_count_ids_metric_init(
 {
     ecs_set(world, metric, EcsMetricCountIds, { .id = desc->id });
     ecs_set(world, metric, EcsMetricValue, { .value = 0 });
+    ecs_add_pair(world, metric, EcsMetric, desc->kind);
+    ecs_add_id(world, metric, EcsMetric);
     return 0;
 }
 
@@ -754,7 +1069,8 @@ ecs_entity_t ecs_metric_init(
     if (kind != EcsGauge && 
         kind != EcsCounter && 
         kind != EcsCounterId &&
-        kind != EcsCounterIncrement) 
+        kind != EcsCounterIncrement &&
+        kind != EcsHistogram) 
     {
         ecs_err("invalid metric kind %s", ecs_get_fullpath(world, kind));
         goto error;
@@ -765,6 +1081,11 @@ ecs_entity_t ecs_metric_init(
         goto error;
     }
 
+    if (kind == EcsHistogram && !desc->member && !desc->dotmember) {
+        ecs_err("Histogram can only be used in combination with member");
+        goto error;
+    }
+
     if (kind == EcsCounterId && (desc->member || desc->dotmember)) {
         ecs_err("CounterId cannot be used in combination with member");
         goto error;
@@ -854,12 +1175,14 @@ void FlecsMetricsImport(ecs_world_t *world) {
     ECS_TAG_DEFINE(world, EcsCounterIncrement);
     ECS_TAG_DEFINE(world, EcsCounterId);
     ECS_TAG_DEFINE(world, EcsGauge);
+    ECS_TAG_DEFINE(world, EcsHistogram);
     ecs_set_scope(world, old_scope);
 
     ecs_set_name_prefix(world, "EcsMetric");
     ECS_TAG_DEFINE(world, EcsMetricInstance);
     ECS_COMPONENT_DEFINE(world, EcsMetricValue);
     ECS_COMPONENT_DEFINE(world, EcsMetricSource);
+    ECS_COMPONENT_DEFINE(world, EcsMetricHistogram);
     ECS_COMPONENT_DEFINE(world, EcsMetricMemberInstance);
     ECS_COMPONENT_DEFINE(world, EcsMetricIdInstance);
     ECS_COMPONENT_DEFINE(world, EcsMetricOneOfInstance);
@@ -868,6 +1191,7 @@ void FlecsMetricsImport(ecs_world_t *world) {
     ECS_COMPONENT_DEFINE(world, EcsMetricOneOf);
     ECS_COMPONENT_DEFINE(world, EcsMetricCountIds);
     ECS_COMPONENT_DEFINE(world, EcsMetricCountTargets);
+    ECS_COMPONENT_DEFINE(world, EcsMetricMemberHistogram);
 
     ecs_add_id(world, ecs_id(EcsMetricMemberInstance), EcsPrivate);
     ecs_add_id(world, ecs_id(EcsMetricIdInstance), EcsPrivate);
@@ -887,6 +1211,24 @@ void FlecsMetricsImport(ecs_world_t *world) {
         }
     });
 
+    ecs_struct(world, {
+        .entity = ecs_id(EcsMetricHistogram),
+        .members = {
+            { .name = "count", .type = ecs_id(ecs_f64_t) },
+            { .name = "sum", .type = ecs_id(ecs_f64_t) },
+            { .name = "min", .type = ecs_id(ecs_f64_t) },
+            { .name = "max", .type = ecs_id(ecs_f64_t) },
+            { .name = "p50", .type = ecs_id(ecs_f64_t) },
+            { .name = "p90", .type = ecs_id(ecs_f64_t) },
+            { .name = "p99", .type = ecs_id(ecs_f64_t) },
+            { .name = "bucket_count", .type = ecs_id(ecs_i32_t) },
+            { .name = "bounds", .type = ecs_id(ecs_f64_t), 
+                .count = ECS_METRIC_HISTOGRAM_BUCKET_COUNT_MAX },
+            { .name = "buckets", .type = ecs_id(ecs_f64_t), 
+                .count = ECS_METRIC_HISTOGRAM_BUCKET_COUNT_MAX }
+        }
+    });
+
     ecs_set_hooks(world, EcsMetricMember, {
         .ctor = ecs_default_ctor,
         .dtor = ecs_dtor(EcsMetricMember),
@@ -911,6 +1253,12 @@ void FlecsMetricsImport(ecs_world_t *world) {
         .move = ecs_move(EcsMetricCountTargets)
     });
 
+    ecs_set_hooks(world, EcsMetricMemberHistogram, {
+        .ctor = ecs_default_ctor,
+        .dtor = ecs_dtor(EcsMetricMemberHistogram),
+        .move = ecs_move(EcsMetricMemberHistogram)
+    });
+
     ecs_add_id(world, EcsMetric, EcsOneOf);
 
 #ifdef FLECS_DOC
@@ -960,6 +1308,10 @@ void FlecsMetricsImport(ecs_world_t *world) {
 
     ECS_SYSTEM(world, UpdateCountTargets, EcsPreStore, 
         [inout] CountTargets);
+
+    ECS_SYSTEM(world, UpdateHistogram, EcsPreStore, 
+        [in]  MemberHistogram,
+        [out] Histogram);
 }
 
 #endif
@@ -127,10 +127,15 @@ void MonitorStats(ecs_iter_t *it) {
             } else if (kind == ecs_id(EcsPipelineStats)) {
                 ecs_world_stats_repeat_last(stats);
             }
+            hdr->sample_count ++;
         }
         hdr->reduce_count = 0;
     }
 
+    if (dif) {
+        hdr->sample_count ++;
+    }
+
     if (last && kind == ecs_id(EcsPipelineStats)) {
         ecs_pipeline_stats_fini(last);
     }
@@ -138,13 +143,14 @@ void MonitorStats(ecs_iter_t *it) {
 
 static
 void ReduceStats(ecs_iter_t *it) {
-    void *dst = ecs_field_w_size(it, 0, 1);
+    EcsStatsHeader *dst_hdr = ecs_field_w_size(it, 0, 1);
     void *src = ecs_field_w_size(it, 0, 2);
 
     ecs_id_t kind = ecs_pair_first(it->world, ecs_field_id(it, 1));
 
-    dst = ECS_OFFSET_T(dst, EcsStatsHeader);
+    void *dst = ECS_OFFSET_T(dst_hdr, EcsStatsHeader);
     src = ECS_OFFSET_T(src, EcsStatsHeader);
+    dst_hdr->sample_count ++;
 
     if (kind == ecs_id(EcsWorldStats)) {
         ecs_world_stats_reduce(dst, src);
@@ -197,6 +203,11 @@ void AggregateStats(ecs_iter_t *it) {
         }
     }
 
+    /* Only the first reduce of an interval adds a sample */
+    if (!dst_hdr->reduce_count) {
+        dst_hdr->sample_count ++;
+    }
+
     /* A day has 60 24 minute intervals */
     dst_hdr->reduce_count ++;
     if (dst_hdr->reduce_count >= interval) {
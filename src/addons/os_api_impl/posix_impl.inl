@@ -4,6 +4,16 @@
  */
 
 #include "pthread.h"
+#include <sys/mman.h>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
 
 #if defined(__APPLE__) && defined(__MACH__)
 #include <mach/mach_time.h>
@@ -51,6 +61,70 @@ ecs_os_thread_id_t posix_thread_self(void)
     return (ecs_os_thread_id_t)pthread_self();
 }
 
+#if defined(__linux__) && defined(CPU_SET)
+/* Add CPUs of NUMA node to set. The CPUs are read from sysfs, which has the
+ * format "0-3,8-11", so that libnuma is not required. */
+static
+int posix_numa_node_cpus(
+    int32_t numa_node,
+    cpu_set_t *set)
+{
+    char path[64], buf[1024];
+    ecs_os_snprintf(path, 64, "/sys/devices/system/node/node%d/cpulist", 
+        numa_node);
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return -1;
+    }
+
+    char *ptr = fgets(buf, ECS_SIZEOF(buf), f);
+    fclose(f);
+    if (!ptr) {
+        return -1;
+    }
+
+    int32_t count = 0;
+    while (*ptr >= '0' && *ptr <= '9') {
+        long cpu = strtol(ptr, &ptr, 10), last = cpu;
+        if (*ptr == '-') {
+            last = strtol(ptr + 1, &ptr, 10);
+        }
+        for (; cpu <= last && cpu < CPU_SETSIZE; cpu ++) {
+            CPU_SET((size_t)cpu, set);
+            count ++;
+        }
+        if (*ptr == ',') {
+            ptr ++;
+        }
+    }
+
+    return count ? 0 : -1;
+}
+
+static
+int posix_thread_set_affinity(
+    int32_t cpu,
+    int32_t numa_node)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (cpu >= 0) {
+        if (cpu >= CPU_SETSIZE) {
+            return -1;
+        }
+        CPU_SET((size_t)cpu, &set);
+    } else if (numa_node >= 0) {
+        if (posix_numa_node_cpus(numa_node, &set)) {
+            return -1;
+        }
+    } else {
+        return 0;
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+#endif
+
 static
 int32_t posix_ainc(
     int32_t *count)
@@ -298,6 +372,110 @@ uint64_t posix_time_now(void) {
     return now;
 }
 
+#ifdef MAP_ANONYMOUS
+
+/* Transparent huge pages can only back memory that is aligned to the huge page
+ * size, which mmap doesn't guarantee. */
+#define POSIX_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+static
+void* posix_page_alloc(
+    ecs_size_t size,
+    int32_t numa_node,
+    ecs_flags32_t flags)
+{
+    ecs_assert(size > 0, ECS_INVALID_PARAMETER, NULL);
+    size_t len = (size_t)size;
+    size_t map_len = len;
+    bool huge = (flags & EcsOsPageHuge) && (len >= POSIX_HUGE_PAGE_SIZE);
+    if (huge) {
+        map_len += POSIX_HUGE_PAGE_SIZE;
+    }
+
+    char *ptr = mmap(NULL, map_len, PROT_READ | PROT_WRITE, 
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+
+    if (huge) {
+        /* Unmap the parts before and after the aligned range */
+        uintptr_t mask = POSIX_HUGE_PAGE_SIZE - 1;
+        char *aligned = (char*)(((uintptr_t)ptr + mask) & ~mask);
+        size_t page_mask = (size_t)sysconf(_SC_PAGESIZE) - 1;
+        size_t used = (len + page_mask) & ~page_mask;
+        size_t head = (size_t)(aligned - ptr);
+        size_t tail = map_len - head - used;
+        if (head) {
+            munmap(ptr, head);
+        }
+        if (tail) {
+            munmap(aligned + used, tail);
+        }
+        ptr = aligned;
+#ifdef MADV_HUGEPAGE
+        madvise(ptr, len, MADV_HUGEPAGE);
+#endif
+    }
+
+#if defined(__linux__) && defined(SYS_mbind)
+    /* Prefer the node, but fall back to other nodes if it is out of memory.
+     * Calls mbind directly so that libnuma is not required. */
+    if (numa_node >= 0 && numa_node < 64) {
+        unsigned long nodemask = 1ul << numa_node;
+        if (syscall(SYS_mbind, ptr, len, 1 /* MPOL_PREFERRED */, &nodemask, 
+            (unsigned long)(sizeof(nodemask) * 8), 0)) 
+        {
+            ecs_dbg("mbind failed for NUMA node %d", numa_node);
+        }
+    }
+#else
+    (void)numa_node;
+#endif
+
+    return ptr;
+}
+
+static
+void posix_page_free(
+    void *ptr,
+    ecs_size_t size)
+{
+    if (ptr) {
+        if (munmap(ptr, (size_t)size)) {
+            ecs_err("munmap failed");
+        }
+    }
+}
+
+static
+void* posix_vm_reserve(
+    ecs_size_t size)
+{
+    ecs_assert(size > 0, ECS_INVALID_PARAMETER, NULL);
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void *ptr = mmap(NULL, (size_t)size, PROT_NONE, flags, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+    return ptr;
+}
+
+static
+int posix_vm_commit(
+    void *ptr,
+    ecs_size_t size)
+{
+    size_t page_mask = (size_t)sysconf(_SC_PAGESIZE) - 1;
+    size_t len = ((size_t)size + page_mask) & ~page_mask;
+    return mprotect(ptr, len, PROT_READ | PROT_WRITE);
+}
+
+#endif
+
 void ecs_set_os_api_impl(void) {
     ecs_os_set_api_defaults();
 
@@ -306,6 +484,9 @@ void ecs_set_os_api_impl(void) {
     api.thread_new_ = posix_thread_new;
     api.thread_join_ = posix_thread_join;
     api.thread_self_ = posix_thread_self;
+#if defined(__linux__) && defined(CPU_SET)
+    api.thread_set_affinity_ = posix_thread_set_affinity;
+#endif
     api.task_new_ = posix_thread_new;
     api.task_join_ = posix_thread_join;
     api.ainc_ = posix_ainc;
@@ -323,6 +504,13 @@ void ecs_set_os_api_impl(void) {
     api.cond_wait_ = posix_cond_wait;
     api.sleep_ = posix_sleep;
     api.now_ = posix_time_now;
+#ifdef MAP_ANONYMOUS
+    api.page_alloc_ = posix_page_alloc;
+    api.page_free_ = posix_page_free;
+    api.vm_reserve_ = posix_vm_reserve;
+    api.vm_commit_ = posix_vm_commit;
+    api.vm_release_ = posix_page_free;
+#endif
 
     posix_time_setup();
 
@@ -54,6 +54,32 @@ ecs_os_thread_id_t win_thread_self(void)
     return (ecs_os_thread_id_t)GetCurrentThreadId();
 }
 
+static
+int win_thread_set_affinity(
+    int32_t cpu,
+    int32_t numa_node)
+{
+    DWORD_PTR mask;
+    if (cpu >= 0) {
+        if (cpu >= (int32_t)(sizeof(DWORD_PTR) * 8)) {
+            return -1;
+        }
+        mask = (DWORD_PTR)1 << cpu;
+    } else if (numa_node >= 0) {
+        ULONGLONG node_mask;
+        if (!GetNumaNodeProcessorMask((UCHAR)numa_node, &node_mask) || 
+            !node_mask) 
+        {
+            return -1;
+        }
+        mask = (DWORD_PTR)node_mask;
+    } else {
+        return 0;
+    }
+
+    return SetThreadAffinityMask(GetCurrentThread(), mask) ? 0 : -1;
+}
+
 static
 int32_t win_ainc(
     int32_t *count) 
@@ -246,6 +272,56 @@ uint64_t win_time_now(void) {
     return now;
 }
 
+/* Large pages are not requested, as they require the SeLockMemoryPrivilege
+ * privilege, which applications usually don't have. */
+static
+void* win_page_alloc(
+    ecs_size_t size,
+    int32_t numa_node,
+    ecs_flags32_t flags)
+{
+    (void)flags;
+    ecs_assert(size > 0, ECS_INVALID_PARAMETER, NULL);
+    DWORD type = MEM_RESERVE | MEM_COMMIT;
+    if (numa_node >= 0) {
+        return VirtualAllocExNuma(GetCurrentProcess(), NULL, (SIZE_T)size, 
+            type, PAGE_READWRITE, (DWORD)numa_node);
+    }
+    return VirtualAlloc(NULL, (SIZE_T)size, type, PAGE_READWRITE);
+}
+
+static
+void win_page_free(
+    void *ptr,
+    ecs_size_t size)
+{
+    (void)size;
+    if (ptr) {
+        if (!VirtualFree(ptr, 0, MEM_RELEASE)) {
+            ecs_err("win_page_free: VirtualFree failed");
+        }
+    }
+}
+
+static
+void* win_vm_reserve(
+    ecs_size_t size)
+{
+    ecs_assert(size > 0, ECS_INVALID_PARAMETER, NULL);
+    return VirtualAlloc(NULL, (SIZE_T)size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+static
+int win_vm_commit(
+    void *ptr,
+    ecs_size_t size)
+{
+    if (!VirtualAlloc(ptr, (SIZE_T)size, MEM_COMMIT, PAGE_READWRITE)) {
+        return -1;
+    }
+    return 0;
+}
+
 static
 void win_fini(void) {
     if (ecs_os_api.flags_ & EcsOsApiHighResolutionTimer) {
@@ -261,6 +337,7 @@ void ecs_set_os_api_impl(void) {
     api.thread_new_ = win_thread_new;
     api.thread_join_ = win_thread_join;
     api.thread_self_ = win_thread_self;
+    api.thread_set_affinity_ = win_thread_set_affinity;
     api.task_new_ = win_thread_new;
     api.task_join_ = win_thread_join;
     api.ainc_ = win_ainc;
@@ -278,6 +355,11 @@ void ecs_set_os_api_impl(void) {
     api.cond_wait_ = win_cond_wait;
     api.sleep_ = win_sleep;
     api.now_ = win_time_now;
+    api.page_alloc_ = win_page_alloc;
+    api.page_free_ = win_page_free;
+    api.vm_reserve_ = win_vm_reserve;
+    api.vm_commit_ = win_vm_commit;
+    api.vm_release_ = win_page_free;
     api.fini_ = win_fini;
 
     win_time_setup();
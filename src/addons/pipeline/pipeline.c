@@ -570,7 +570,7 @@ int32_t flecs_run_pipeline_ops(
         ecs_run_intern(world, s, system, sys, stage_index,
             stage_count, delta_time, 0, 0, NULL);
 
-        world->info.systems_ran_frame++;
+        stage->counters.systems_ran ++;
         ran_since_merge++;
 
         if (ran_since_merge == op->count) {
@@ -630,7 +630,8 @@ void flecs_run_pipeline(
         }
 
         ecs_time_t st = { 0 };
-        bool measure_time = world->flags & EcsWorldMeasureSystemTime;
+        bool measure_time = world->flags & 
+            (EcsWorldMeasureSystemTime | EcsWorldMeasureStageTime);
         if (measure_time) {
             ecs_time_measure(&st);
         }
@@ -759,6 +760,11 @@ bool ecs_progress(
         flecs_join_worker_threads(world);
     }
 
+    /* World may be used by another thread until the next frame begins */
+    if (world->on_frame_end) {
+        world->on_frame_end(world, world->on_frame_end_ctx);
+    }
+
     return !ECS_BIT_IS_SET(world->flags, EcsWorldQuit);
 error:
     return false;
@@ -853,6 +859,9 @@ void FlecsPipelineFini(
         ecs_set_threads(world, 0);
     }
 
+    ecs_vec_fini_t(&world->allocator, &world->worker_affinity, 
+        ecs_worker_affinity_t);
+
     ecs_assert(world->workers_running == 0, ECS_INTERNAL_ERROR, NULL);
 }
 
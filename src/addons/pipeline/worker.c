@@ -12,13 +12,19 @@
 /* Synchronize workers */
 static
 void flecs_sync_worker(
-    ecs_world_t* world)
+    ecs_world_t* world,
+    ecs_stage_t *stage)
 {
     int32_t stage_count = ecs_get_stage_count(world);
     if (stage_count <= 1) {
         return;
     }
 
+    /* Main thread computes how long worker waited once all threads synced */
+    if (world->flags & EcsWorldMeasureStageTime) {
+        ecs_os_get_time(&stage->sync_time);
+    }
+
     /* Signal that thread is waiting */
     ecs_os_mutex_lock(world->sync_mutex);
     if (++world->workers_waiting == (stage_count - 1)) {
@@ -31,6 +37,34 @@ void flecs_sync_worker(
     ecs_os_mutex_unlock(world->sync_mutex);
 }
 
+/* Pin worker thread to CPU or NUMA node */
+static
+void flecs_worker_set_affinity(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    int32_t count = ecs_vec_count(&world->worker_affinity);
+    if (!count || !ecs_os_api.thread_set_affinity_ || 
+        ecs_using_task_threads(world)) 
+    {
+        return;
+    }
+
+    ecs_worker_affinity_t *a = ecs_vec_get_t(&world->worker_affinity, 
+        ecs_worker_affinity_t, (stage->id - 1) % count);
+    if (a->cpu < 0 && a->numa_node < 0) {
+        return;
+    }
+
+    if (ecs_os_thread_set_affinity(a->cpu, a->numa_node)) {
+        ecs_warn("worker %d: failed to set affinity (cpu = %d, numa node = %d)",
+            stage->id, a->cpu, a->numa_node);
+    } else {
+        ecs_dbg_2("worker %d: affinity set (cpu = %d, numa node = %d)",
+            stage->id, a->cpu, a->numa_node);
+    }
+}
+
 /* Worker thread */
 static
 void* flecs_worker(void *arg) {
@@ -42,6 +76,8 @@ void* flecs_worker(void *arg) {
 
     ecs_dbg_2("worker %d: start", stage->id);
 
+    flecs_worker_set_affinity(world, stage);
+
     /* Start worker, increase counter so main thread knows how many
      * workers are ready */
     ecs_os_mutex_lock(world->sync_mutex);
@@ -62,7 +98,7 @@ void* flecs_worker(void *arg) {
 
         ecs_set_scope((ecs_world_t*)stage, old_scope);
 
-        flecs_sync_worker(world);
+        flecs_sync_worker(world, stage);
     }
 
     ecs_dbg_2("worker %d: finalizing", stage->id);
@@ -148,6 +184,12 @@ void flecs_wait_for_sync(
 
     ecs_dbg_3("#[bold]pipeline: waiting for worker sync");
 
+    bool measure_time = world->flags & EcsWorldMeasureStageTime;
+    ecs_time_t t_start = {0};
+    if (measure_time) {
+        ecs_os_get_time(&t_start);
+    }
+
     ecs_os_mutex_lock(world->sync_mutex);
     if (world->workers_waiting != (stage_count - 1)) {
         ecs_os_cond_wait(world->sync_cond, world->sync_mutex);
@@ -157,6 +199,24 @@ void flecs_wait_for_sync(
     ecs_assert(world->workers_waiting == (stage_count - 1), 
         ECS_INTERNAL_ERROR, NULL);
 
+    if (measure_time) {
+        /* Workers are blocked, so it's safe to update their counters */
+        ecs_time_t t_sync = {0};
+        ecs_os_get_time(&t_sync);
+        world->stages[0].counters.wait_time += 
+            ecs_time_to_double(ecs_time_sub(t_sync, t_start));
+
+        int32_t i;
+        for (i = 1; i < stage_count; i ++) {
+            ecs_stage_t *stage = &world->stages[i];
+            double wait_time = ecs_time_to_double(
+                ecs_time_sub(t_sync, stage->sync_time));
+            if (wait_time > 0) {
+                stage->counters.wait_time += wait_time;
+            }
+        }
+    }
+
     world->workers_waiting = 0;
     ecs_os_mutex_unlock(world->sync_mutex);
 
@@ -306,4 +366,44 @@ bool ecs_using_task_threads(
     return world->workers_use_task_api;
 }
 
+void ecs_set_worker_affinity(
+    ecs_world_t *world,
+    const ecs_worker_affinity_t *affinity,
+    int32_t count)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    ecs_check(count >= 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!count || affinity != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!(world->flags & EcsWorldReadonly), 
+        ECS_INVALID_OPERATION, NULL);
+
+    if (count && !ecs_os_api.thread_set_affinity_) {
+        ecs_warn("cannot pin workers: OS API has no thread_set_affinity_");
+    }
+
+    ecs_vec_t *v = &world->worker_affinity;
+    ecs_vec_init_if_t(v, ecs_worker_affinity_t);
+    ecs_vec_set_count_t(&world->allocator, v, ecs_worker_affinity_t, count);
+    if (count) {
+        ecs_os_memcpy_n(ecs_vec_first(v), affinity, 
+            ecs_worker_affinity_t, count);
+    }
+
+    /* Workers pin themselves when their thread starts */
+    if (ecs_get_stage_count(world) > 1 && !ecs_using_task_threads(world)) {
+        flecs_join_worker_threads(world);
+        flecs_create_worker_threads(world);
+    }
+error:
+    return;
+}
+
+void ecs_set_worker_table_affinity(
+    ecs_world_t *world,
+    bool enabled)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    ECS_BIT_COND(world->flags, EcsWorldWorkerTableAffinity, enabled);
+}
+
 #endif
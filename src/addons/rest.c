@@ -4,20 +4,56 @@
  */
 
 #include "../private_api.h"
+#include "../addons/system/system.h"
+#include <ctype.h>
 
 #ifdef FLECS_REST
 
 /* Retain captured commands for one minute at 60 FPS */
 #define FLECS_REST_COMMAND_RETAIN_COUNT (60 * 60)
 
+/* Handle requests on main thread if REST thread didn't get to handle requests
+ * for this long (s) */
+#define FLECS_REST_THREAD_TIMEOUT (1.0)
+
 static ECS_TAG_DECLARE(EcsRestPlecs);
 
-typedef struct {
+typedef struct ecs_rest_ctx_t ecs_rest_ctx_t;
+
+struct ecs_rest_ctx_t {
     ecs_world_t *world;
     ecs_http_server_t *srv;
     int32_t rc;
     ecs_map_t cmd_captures;
-} ecs_rest_ctx_t;
+
+    /* Queries registered with PUT /query/<name> */
+    ecs_vec_t prepared_queries; /* vec<ecs_rest_prepared_query_t> */
+
+    /* Change tracking for query results */
+    ecs_map_t table_versions; /* map<table id, ecs_rest_table_version_t> */
+    uint64_t changes_version; /* Incremented when query results changed */
+    int64_t table_delete_total; /* Table deletions when versions were pruned */
+
+    /* Streams opened with GET /stream/... */
+    ecs_vec_t streams;        /* vec<ecs_rest_stream_t> */
+    int64_t stream_frame;     /* Last frame for which streams were updated */
+
+    /* Layout of OpenMetrics endpoint */
+    ecs_vec_t om_families;    /* vec<ecs_rest_om_family_t> */
+    uint64_t om_layout_hash;  /* Hash of entities used to create layout */
+
+    /* REST thread, used when requests are handled between frames */
+    ecs_os_thread_t thread;
+    ecs_os_mutex_t lock;
+    ecs_os_cond_t cond;
+    bool should_run;
+    bool world_idle;     /* Main thread isn't using world */
+    bool busy;           /* REST thread is handling requests */
+    bool hand_off;       /* Hand world to REST thread when frame has ended */
+    bool main_thread;    /* Queued requests must be handled on main thread */
+    double last_dequeue; /* Last time REST thread handled requests */
+    ecs_rest_ctx_t *next; /* Next server with REST thread for same world */
+};
 
 typedef struct {
     char *cmds;
@@ -29,6 +65,68 @@ typedef struct {
     ecs_vec_t syncs;
 } ecs_rest_cmd_capture_t;
 
+typedef struct {
+    uint64_t dirty;   /* Sum of table dirty counters */
+    uint64_t version; /* Value of changes_version when last changed */
+} ecs_rest_table_version_t;
+
+/* Query that's compiled once, and evaluated by each request for it */
+typedef struct {
+    char *name;
+    ecs_rule_t *rule;
+    ecs_iter_to_json_desc_t desc; /* Serializer parameters of registration */
+} ecs_rest_prepared_query_t;
+
+/* Context of iterator that skips tables that didn't change */
+typedef struct {
+    ecs_rest_ctx_t *impl;
+    uint64_t since;
+} ecs_rest_changes_iter_t;
+
+/* Value of a sample in the OpenMetrics reply */
+typedef enum {
+    EcsRestOmSystemTime,      /* Time spent in system */
+    EcsRestOmMetricValue,     /* Value of metric instance */
+    EcsRestOmAlertCount       /* Number of active alert instances */
+} ecs_rest_om_kind_t;
+
+/* Sample in the OpenMetrics reply */
+typedef struct {
+    char *prefix;             /* Sample name and labels, ends with space */
+    ecs_entity_t entity;      /* Entity that stores value */
+    ecs_id_t id;              /* Component with value (metrics) */
+    int32_t offset;           /* Offset of double in component (metrics) */
+} ecs_rest_om_sample_t;
+
+/* Metric family in the OpenMetrics reply. Everything that doesn't change
+ * between scrapes is formatted when the layout is created. */
+typedef struct {
+    char *header;             /* TYPE and HELP lines */
+    ecs_rest_om_kind_t kind;
+    ecs_vec_t samples;        /* vec<ecs_rest_om_sample_t> */
+} ecs_rest_om_family_t;
+
+/* Stream that pushes query results or statistics to a client */
+typedef struct {
+    uint64_t id;              /* HTTP stream */
+    bool pushed;              /* First event was pushed */
+
+    /* Query streams */
+    ecs_rule_t *rule;
+    ecs_iter_to_json_desc_t desc;
+    bool changes;             /* Only push tables that changed */
+    uint64_t hash;            /* Hash of last pushed result */
+    uint64_t tables;          /* Matched tables of last pushed result */
+    uint64_t version;         /* Value of changes_version at last push */
+
+    /* Stats streams */
+    ecs_entity_t kind;        /* EcsWorldStats or EcsPipelineStats */
+    ecs_entity_t period;
+    bool stages;              /* Push stage stats of pipeline */
+    int64_t sample_count;     /* Sample count of last pushed sample */
+    int32_t reduce_count;     /* Reduce count of last pushed sample */
+} ecs_rest_stream_t;
+
 static ECS_COPY(EcsRest, dst, src, {
     ecs_rest_ctx_t *impl = src->impl;
     if (impl) {
@@ -37,6 +135,7 @@ static ECS_COPY(EcsRest, dst, src, {
 
     ecs_os_strset(&dst->ipaddr, src->ipaddr);
     dst->port = src->port;
+    dst->thread_mode = src->thread_mode;
     dst->impl = impl;
 })
 
@@ -332,6 +431,56 @@ bool flecs_rest_enable(
     return true;
 }
 
+static
+bool flecs_rest_trace(
+    ecs_world_t *world,
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply)
+{
+#ifdef FLECS_TRACE
+    bool enabled = ecs_trace_is_recording(world);
+    int32_t capacity = 0;
+    flecs_rest_bool_param(req, "enabled", &enabled);
+    flecs_rest_int_param(req, "capacity", &capacity);
+    if (capacity < 0) {
+        flecs_reply_error(reply, "bad request (invalid capacity)");
+        reply->code = 400;
+        return true;
+    }
+
+    if (enabled) {
+        ecs_trace_start(world, capacity);
+    } else {
+        ecs_trace_stop(world);
+    }
+
+    return true;
+#else
+    (void)world;
+    (void)req;
+    (void)reply;
+    return false;
+#endif
+}
+
+static
+bool flecs_rest_reply_trace(
+    ecs_world_t *world,
+    ecs_http_reply_t *reply)
+{
+#ifdef FLECS_TRACE
+    if (ecs_trace_to_json_buf(world, &reply->body)) {
+        flecs_reply_error(reply, "failed to serialize trace");
+        reply->code = 500;
+    }
+    return true;
+#else
+    (void)world;
+    (void)reply;
+    return false;
+#endif
+}
+
 static
 bool flecs_rest_script(
     ecs_world_t *world,
@@ -390,42 +539,359 @@ void flecs_rest_reply_set_captured_log(
     reply->code = 400;
 }
 
+typedef struct {
+    const ecs_http_request_t *req;
+    ecs_http_reply_t *reply;
+    int64_t version; /* Version to add to reply, -1 if not requested */
+} flecs_rest_stream_ctx_t;
+
+/* Large query results are sent to the client while they're serialized, which
+ * bounds the memory used by a request to a few chunks. */
+static
+int flecs_rest_reply_stream(
+    const char *data,
+    ecs_size_t size,
+    void *ctx)
+{
+    flecs_rest_stream_ctx_t *stream = ctx;
+    ecs_http_reply_t *reply = stream->reply;
+    if (stream->version >= 0 && size && data[0] == '{') {
+        /* Add version as first member of the reply object */
+        ecs_strbuf_appendlit(&reply->body, "{\"version\":");
+        ecs_strbuf_appendint(&reply->body, stream->version);
+        data ++;
+        size --;
+        if (size && data[0] != '}') {
+            ecs_strbuf_appendch(&reply->body, ',');
+        }
+        stream->version = -1;
+    }
+
+    ecs_strbuf_appendstrn(&reply->body, data, size);
+    if (ecs_strbuf_written(&reply->body) < ECS_JSON_STREAM_CHUNK_SIZE) {
+        /* Small replies are sent in one piece, so they can be cached */
+        return 0;
+    }
+
+    return ecs_http_reply_flush(stream->req, reply);
+}
+
+static
+uint64_t flecs_rest_hash_combine(
+    uint64_t hash,
+    uint64_t value)
+{
+    return hash ^ (value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2));
+}
+
+static
+uint64_t flecs_rest_table_dirty(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    /* Enables change tracking for the table. Dirty counters are only ever
+     * incremented, so the sum changes when any of them changes. */
+    int32_t *dirty_state = flecs_table_get_dirty_state(world, table);
+    uint64_t result = 0;
+    int32_t i, count = table->column_count + 1;
+    for (i = 0; i < count; i ++) {
+        result += (uint32_t)dirty_state[i];
+    }
+    return result;
+}
+
+static
+uint64_t flecs_rest_request_hash(
+    const ecs_http_request_t* req)
+{
+    uint64_t hash = flecs_hash(req->path, ecs_os_strlen(req->path));
+    int32_t i;
+    for (i = 0; i < req->param_count; i ++) {
+        const char *key = req->params[i].key;
+        const char *value = req->params[i].value;
+        hash = flecs_rest_hash_combine(hash, flecs_hash(key, 
+            ecs_os_strlen(key)));
+        hash = flecs_rest_hash_combine(hash, flecs_hash(value, 
+            ecs_os_strlen(value)));
+    }
+    return hash;
+}
+
+/* Remove versions of deleted tables. Table ids are recycled with a new
+ * generation, so versions of deleted tables are never used again. */
+static
+void flecs_rest_table_versions_prune(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl)
+{
+    int64_t delete_total = world->info.table_delete_total;
+    if (delete_total == impl->table_delete_total) {
+        return;
+    }
+
+    impl->table_delete_total = delete_total;
+
+    ecs_vec_t deleted;
+    ecs_vec_init_t(NULL, &deleted, uint64_t, 0);
+    ecs_map_iter_t it = ecs_map_iter(&impl->table_versions);
+    while (ecs_map_next(&it)) {
+        uint64_t table_id = ecs_map_key(&it);
+        if (!flecs_sparse_is_alive(&world->store.tables, table_id)) {
+            ecs_vec_append_t(NULL, &deleted, uint64_t)[0] = table_id;
+        }
+    }
+
+    int32_t i, count = ecs_vec_count(&deleted);
+    uint64_t *ids = ecs_vec_first(&deleted);
+    for (i = 0; i < count; i ++) {
+        ecs_map_remove_free(&impl->table_versions, ids[i]);
+    }
+    ecs_vec_fini_t(NULL, &deleted, uint64_t);
+}
+
+/* Evaluate query and compute ETag from the tables it matches. This also
+ * records which tables changed since the last time they were observed, which
+ * lets clients request only the tables that changed since a version. Changes
+ * are detected with the same counters as query change detection, so they
+ * include set operations, ecs_modified() and queries with [out] fields.
+ *
+ * The recorded version of a table only depends on the table, so that queries
+ * that match the same table don't overwrite each other's versions. Changes to
+ * components matched on other entities only change the ETag.
+ *
+ * The optional tables_out parameter is set to a hash of the matched tables,
+ * their entity counts and the components matched on other entities, which
+ * changes when entities are added or removed from the result, or when the
+ * result can't be described by the tables that changed. */
+static
+uint64_t flecs_rest_query_changes(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
+    uint64_t hash,
+    ecs_poly_t *query,
+    uint64_t *tables_out)
+{
+    uint64_t tables = 0;
+    ecs_map_init_if(&impl->table_versions, NULL);
+    flecs_rest_table_versions_prune(world, impl);
+    uint64_t version = impl->changes_version + 1;
+    bool changed = false;
+
+    ecs_iter_t it;
+    ecs_iter_poly(world, query, &it, NULL);
+    ECS_BIT_SET(it.flags, EcsIterIsInstanced);
+    ECS_BIT_SET(it.flags, EcsIterNoData);
+
+    while (ecs_iter_next(&it)) {
+        ecs_table_t *table = it.table;
+        uint64_t dirty = 0;
+        if (table) {
+            dirty = flecs_rest_table_dirty(world, table);
+            tables = flecs_rest_hash_combine(tables, table->id);
+        } else {
+            int32_t e;
+            for (e = 0; e < it.count; e ++) {
+                tables = flecs_rest_hash_combine(tables, it.entities[e]);
+            }
+        }
+
+        /* Include tables of components matched on other entities */
+        int32_t f;
+        for (f = 0; f < it.field_count; f ++) {
+            ecs_entity_t src = it.sources[f];
+            if (!src) {
+                continue;
+            }
+            ecs_record_t *r = flecs_entities_get(world, src);
+            if (r && r->table) {
+                uint64_t src_dirty = flecs_rest_table_dirty(world, r->table);
+                hash = flecs_rest_hash_combine(hash, r->table->id);
+                hash = flecs_rest_hash_combine(hash, src_dirty);
+                tables = flecs_rest_hash_combine(tables, src_dirty);
+            }
+        }
+
+        tables = flecs_rest_hash_combine(tables, (uint64_t)it.count);
+        hash = flecs_rest_hash_combine(hash, dirty);
+
+        if (table) {
+            ecs_rest_table_version_t *tv = ecs_map_get_deref(
+                &impl->table_versions, ecs_rest_table_version_t, table->id);
+            if (!tv) {
+                tv = ecs_map_insert_alloc_t(&impl->table_versions, 
+                    ecs_rest_table_version_t, table->id);
+            } else if (tv->dirty == dirty) {
+                continue;
+            }
+            tv->dirty = dirty;
+            tv->version = version;
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        impl->changes_version = version;
+    }
+
+    if (tables_out) {
+        *tables_out = tables;
+    }
+
+    return flecs_rest_hash_combine(hash, tables);
+}
+
+/* Add ETag header to reply. Returns true if the client already has the reply,
+ * in which case the reply has no body. */
+static
+bool flecs_rest_reply_etag(
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply,
+    uint64_t hash)
+{
+    char etag[32];
+    ecs_os_snprintf(etag, ECS_SIZEOF(etag), "\"%08x%08x\"", 
+        (uint32_t)(hash >> 32), (uint32_t)hash);
+    ecs_strbuf_appendlit(&reply->headers, "ETag: ");
+    ecs_strbuf_appendstr(&reply->headers, etag);
+    ecs_strbuf_appendlit(&reply->headers, "\r\n");
+
+    const char *match = ecs_http_get_header(req, "If-None-Match");
+    if (match && strstr(match, etag)) {
+        reply->code = 304;
+        reply->status = "Not Modified";
+        reply->content_type = NULL;
+        return true;
+    }
+
+    return false;
+}
+
+static
+bool flecs_rest_changes_next(
+    ecs_iter_t *it)
+{
+    ecs_iter_t *chain_it = it->chain_it;
+    ecs_rest_changes_iter_t *changes = it->ctx;
+    ECS_BIT_COND(chain_it->flags, EcsIterIsInstanced, 
+        ECS_BIT_IS_SET(it->flags, EcsIterIsInstanced));
+
+    while (ecs_iter_next(chain_it)) {
+        ecs_table_t *table = chain_it->table;
+        if (table) {
+            ecs_rest_table_version_t *tv = ecs_map_get_deref(
+                &changes->impl->table_versions, ecs_rest_table_version_t, 
+                table->id);
+            if (tv && tv->version <= changes->since) {
+                continue;
+            }
+        }
+
+        /* Copy everything up to the private iterator data */
+        ecs_os_memcpy(it, chain_it, offsetof(ecs_iter_t, priv));
+        it->ctx = changes;
+        return true;
+    }
+
+    return false;
+}
+
+static
+void flecs_rest_changes_fini(
+    ecs_iter_t *it)
+{
+    ecs_iter_fini(it->chain_it);
+    it->chain_it = NULL;
+}
+
+/* Iterator that only returns tables that changed since a version */
+static
+ecs_iter_t flecs_rest_changes_iter(
+    ecs_iter_t *it,
+    ecs_rest_changes_iter_t *changes)
+{
+    ecs_iter_t result = *it;
+    result.priv.cache.stack_cursor = NULL; /* Don't copy allocator cursor */
+    result.ctx = changes;
+    result.next = flecs_rest_changes_next;
+    result.fini = flecs_rest_changes_fini;
+    result.chain_it = it;
+    return result;
+}
+
 static
 void flecs_rest_iter_to_reply(
     ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
     const ecs_http_request_t* req,
     ecs_http_reply_t *reply,
     ecs_poly_t *query,
-    ecs_iter_t *it)
+    ecs_iter_t *it,
+    const ecs_iter_to_json_desc_t *defaults)
 {
     ecs_iter_to_json_desc_t desc = {0};
-    desc.serialize_entities = true;
-    desc.serialize_variables = true;
+    if (defaults) {
+        desc = *defaults;
+    } else {
+        desc.serialize_entities = true;
+        desc.serialize_variables = true;
+    }
     flecs_rest_parse_json_ser_iter_params(&desc, req);
     desc.query = query;
 
     int32_t offset = 0;
     int32_t limit = 1000;
+    int32_t since = -1;
 
     flecs_rest_int_param(req, "offset", &offset);
     flecs_rest_int_param(req, "limit", &limit);
+    flecs_rest_int_param(req, "since", &since);
 
     if (offset < 0 || limit < 0) {
         flecs_reply_error(reply, "invalid offset/limit parameter");
+        ecs_iter_fini(it);
         return;
     }
 
+    /* Result for a query only changes if the tables it matches change. The
+     * ETag lets clients skip downloading results that they already have.
+     * Computing it evaluates the query and enables change detection for the
+     * matched tables, so only do it when the client asks for it. */
+    bool etag = false;
+    flecs_rest_bool_param(req, "etag", &etag);
+    if (etag || since >= 0 || ecs_http_get_header(req, "If-None-Match")) {
+        uint64_t hash = flecs_rest_query_changes(
+            world, impl, flecs_rest_request_hash(req), query, NULL);
+        if (flecs_rest_reply_etag(req, reply, hash)) {
+            ecs_iter_fini(it);
+            return;
+        }
+    }
+
+    ecs_rest_changes_iter_t changes = { impl, (uint64_t)since };
+    ecs_iter_t cit;
+    if (since >= 0) {
+        cit = flecs_rest_changes_iter(it, &changes);
+        it = &cit;
+    }
+
     ecs_iter_t pit = ecs_page_iter(it, offset, limit);
-    if (ecs_iter_to_json_buf(world, &pit, &reply->body, &desc)) {
-        flecs_rest_reply_set_captured_log(reply);
+    flecs_rest_stream_ctx_t stream = { req, reply, -1 };
+    if (since >= 0) {
+        stream.version = (int64_t)impl->changes_version;
     }
 
-    flecs_rest_int_param(req, "offset", &offset);
+    if (ecs_iter_to_json_stream(
+        world, &pit, &desc, flecs_rest_reply_stream, &stream)) 
+    {
+        ecs_strbuf_reset(&reply->body);
+        flecs_rest_reply_set_captured_log(reply);
+    }
 }
 
 static
 bool flecs_rest_reply_existing_query(
     ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
     const ecs_http_request_t* req,
     ecs_http_reply_t *reply,
     const char *name)
@@ -481,7 +947,7 @@ bool flecs_rest_reply_existing_query(
         }
     }
 
-    flecs_rest_iter_to_reply(world, req, reply, poly, &it);
+    flecs_rest_iter_to_reply(world, impl, req, reply, poly, &it, NULL);
 
     ecs_os_api.log_ = rest_prev_log;
     ecs_log_enable_colors(prev_color);    
@@ -492,12 +958,14 @@ bool flecs_rest_reply_existing_query(
 static
 bool flecs_rest_reply_query(
     ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
     const ecs_http_request_t* req,
     ecs_http_reply_t *reply)
 {
     const char *q_name = ecs_http_get_param(req, "name");
     if (q_name) {
-        return flecs_rest_reply_existing_query(world, req, reply, q_name);
+        return flecs_rest_reply_existing_query(
+            world, impl, req, reply, q_name);
     }
 
     const char *q = ecs_http_get_param(req, "q");
@@ -526,7 +994,7 @@ bool flecs_rest_reply_query(
         }
     } else {
         ecs_iter_t it = ecs_rule_iter(world, r);
-        flecs_rest_iter_to_reply(world, req, reply, r, &it);
+        flecs_rest_iter_to_reply(world, impl, req, reply, r, &it, NULL);
         ecs_rule_fini(r);
     }
 
@@ -536,162 +1004,329 @@ bool flecs_rest_reply_query(
     return true;
 }
 
-#ifdef FLECS_MONITOR
-
 static
-void flecs_rest_array_append_(
-    ecs_strbuf_t *reply,
-    const char *field,
-    int32_t field_len,
-    const ecs_float_t *values,
-    int32_t t)
+ecs_rest_prepared_query_t* flecs_rest_get_prepared_query(
+    ecs_rest_ctx_t *impl,
+    const char *name,
+    int32_t *index_out)
 {
-    ecs_strbuf_list_appendch(reply, '"');
-    ecs_strbuf_appendstrn(reply, field, field_len);
-    ecs_strbuf_appendlit(reply, "\":");
-    ecs_strbuf_list_push(reply, "[", ",");
-
-    int32_t i;
-    for (i = t + 1; i <= (t + ECS_STAT_WINDOW); i ++) {
-        int32_t index = i % ECS_STAT_WINDOW;
-        ecs_strbuf_list_next(reply);
-        ecs_strbuf_appendflt(reply, (double)values[index], '"');
+    ecs_rest_prepared_query_t *queries = ecs_vec_first(&impl->prepared_queries);
+    int32_t i, count = ecs_vec_count(&impl->prepared_queries);
+    for (i = 0; i < count; i ++) {
+        if (!ecs_os_strcmp(queries[i].name, name)) {
+            if (index_out) {
+                *index_out = i;
+            }
+            return &queries[i];
+        }
     }
-
-    ecs_strbuf_list_pop(reply, "]");
+    return NULL;
 }
 
-#define flecs_rest_array_append(reply, field, values, t)\
-    flecs_rest_array_append_(reply, field, sizeof(field) - 1, values, t)
-
 static
-void flecs_rest_gauge_append(
-    ecs_strbuf_t *reply,
-    const ecs_metric_t *m,
-    const char *field,
-    int32_t field_len,
-    int32_t t,
-    const char *brief,
-    int32_t brief_len)
+void flecs_rest_prepared_query_fini(
+    ecs_rest_prepared_query_t *pq)
 {
-    ecs_strbuf_list_appendch(reply, '"');
-    ecs_strbuf_appendstrn(reply, field, field_len);
-    ecs_strbuf_appendlit(reply, "\":");
-    ecs_strbuf_list_push(reply, "{", ",");
-
-    flecs_rest_array_append(reply, "avg", m->gauge.avg, t);
-    flecs_rest_array_append(reply, "min", m->gauge.min, t);
-    flecs_rest_array_append(reply, "max", m->gauge.max, t);
-
-    if (brief) {
-        ecs_strbuf_list_appendlit(reply, "\"brief\":\"");
-        ecs_strbuf_appendstrn(reply, brief, brief_len);
-        ecs_strbuf_appendch(reply, '"');
-    }
-
-    ecs_strbuf_list_pop(reply, "}");
+    ecs_rule_fini(pq->rule);
+    ecs_os_free(pq->name);
 }
 
+/* Register a query that can be evaluated by name. The query is parsed and
+ * compiled once, so that clients that poll the same query don't pay for it on
+ * every request. Serializer parameters of the registration request are the
+ * defaults for requests that evaluate the query. */
 static
-void flecs_rest_counter_append(
-    ecs_strbuf_t *reply,
-    const ecs_metric_t *m,
-    const char *field,
-    int32_t field_len,
-    int32_t t,
-    const char *brief,
-    int32_t brief_len)
+bool flecs_rest_prepare_query(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply,
+    const char *name)
 {
-    flecs_rest_gauge_append(reply, m, field, field_len, t, brief, brief_len);
-}
+    const char *q = ecs_http_get_param(req, "q");
+    if (!q) {
+        flecs_reply_error(reply, "missing parameter 'q'");
+        reply->code = 400;
+        return true;
+    }
+
+    ecs_dbg_2("rest: prepare query '%s' (%s)", name, q);
+    bool prev_color = ecs_log_enable_colors(false);
+    rest_prev_log = ecs_os_api.log_;
+    ecs_os_api.log_ = flecs_rest_capture_log;
 
-#define ECS_GAUGE_APPEND_T(reply, s, field, t, brief)\
-    flecs_rest_gauge_append(reply, &(s)->field, #field, sizeof(#field) - 1, t, brief, sizeof(brief) - 1)
+    ecs_rule_t *r = ecs_rule_init(world, &(ecs_filter_desc_t){
+        .expr = q
+    });
+    if (!r) {
+        flecs_rest_reply_set_captured_log(reply);
+    }
 
-#define ECS_COUNTER_APPEND_T(reply, s, field, t, brief)\
-    flecs_rest_counter_append(reply, &(s)->field, #field, sizeof(#field) - 1, t, brief, sizeof(brief) - 1)
+    ecs_os_api.log_ = rest_prev_log;
+    ecs_log_enable_colors(prev_color);
 
-#define ECS_GAUGE_APPEND(reply, s, field, brief)\
-    ECS_GAUGE_APPEND_T(reply, s, field, (s)->t, brief)
+    if (!r) {
+        return true;
+    }
 
-#define ECS_COUNTER_APPEND(reply, s, field, brief)\
-    ECS_COUNTER_APPEND_T(reply, s, field, (s)->t, brief)
+    ecs_rest_prepared_query_t *pq = flecs_rest_get_prepared_query(
+        impl, name, NULL);
+    if (pq) {
+        ecs_rule_fini(pq->rule);
+    } else {
+        ecs_vec_init_if_t(&impl->prepared_queries, ecs_rest_prepared_query_t);
+        pq = ecs_vec_append_t(
+            NULL, &impl->prepared_queries, ecs_rest_prepared_query_t);
+        pq->name = ecs_os_strdup(name);
+    }
 
-static
-void flecs_world_stats_to_json(
-    ecs_strbuf_t *reply,
-    const EcsWorldStats *monitor_stats)
-{
-    const ecs_world_stats_t *stats = &monitor_stats->stats;
+    pq->rule = r;
+    ecs_os_zeromem(&pq->desc);
+    pq->desc.serialize_entities = true;
+    pq->desc.serialize_variables = true;
+    flecs_rest_parse_json_ser_iter_params(&pq->desc, req);
 
-    ecs_strbuf_list_push(reply, "{", ",");
-    ECS_GAUGE_APPEND(reply, stats, entities.count, "Alive entity ids in the world");
-    ECS_GAUGE_APPEND(reply, stats, entities.not_alive_count, "Not alive entity ids in the world");
-
-    ECS_GAUGE_APPEND(reply, stats, performance.fps, "Frames per second");
-    ECS_COUNTER_APPEND(reply, stats, performance.frame_time, "Time spent in frame");
-    ECS_COUNTER_APPEND(reply, stats, performance.system_time, "Time spent on running systems in frame");
-    ECS_COUNTER_APPEND(reply, stats, performance.emit_time, "Time spent on notifying observers in frame");
-    ECS_COUNTER_APPEND(reply, stats, performance.merge_time, "Time spent on merging commands in frame");
-    ECS_COUNTER_APPEND(reply, stats, performance.rematch_time, "Time spent on revalidating query caches in frame");
-
-    ECS_COUNTER_APPEND(reply, stats, commands.add_count, "Add commands executed");
-    ECS_COUNTER_APPEND(reply, stats, commands.remove_count, "Remove commands executed");
-    ECS_COUNTER_APPEND(reply, stats, commands.delete_count, "Delete commands executed");
-    ECS_COUNTER_APPEND(reply, stats, commands.clear_count, "Clear commands executed");
-    ECS_COUNTER_APPEND(reply, stats, commands.set_count, "Set commands executed");
-    ECS_COUNTER_APPEND(reply, stats, commands.ensure_count, "Get_mut commands executed");
-    ECS_COUNTER_APPEND(reply, stats, commands.modified_count, "Modified commands executed");
-    ECS_COUNTER_APPEND(reply, stats, commands.other_count, "Misc commands executed");
-    ECS_COUNTER_APPEND(reply, stats, commands.discard_count, "Commands for already deleted entities");
-    ECS_COUNTER_APPEND(reply, stats, commands.batched_entity_count, "Entities with batched commands");
-    ECS_COUNTER_APPEND(reply, stats, commands.batched_count, "Number of commands batched");
-
-    ECS_COUNTER_APPEND(reply, stats, frame.merge_count, "Number of merges (sync points)");
-    ECS_COUNTER_APPEND(reply, stats, frame.pipeline_build_count, "Pipeline rebuilds (happen when systems become active/enabled)");
-    ECS_COUNTER_APPEND(reply, stats, frame.systems_ran, "Systems ran in frame");
-    ECS_COUNTER_APPEND(reply, stats, frame.observers_ran, "Number of times an observer was invoked in frame");
-    ECS_COUNTER_APPEND(reply, stats, frame.event_emit_count, "Events emitted in frame");
-    ECS_COUNTER_APPEND(reply, stats, frame.rematch_count, "Number of query cache revalidations");
-
-    ECS_GAUGE_APPEND(reply, stats, tables.count, "Tables in the world (including empty)");
-    ECS_GAUGE_APPEND(reply, stats, tables.empty_count, "Empty tables in the world");
-    ECS_COUNTER_APPEND(reply, stats, tables.create_count, "Number of new tables created");
-    ECS_COUNTER_APPEND(reply, stats, tables.delete_count, "Number of tables deleted");
-
-    ECS_GAUGE_APPEND(reply, stats, components.tag_count, "Tag ids in use");
-    ECS_GAUGE_APPEND(reply, stats, components.component_count, "Component ids in use");
-    ECS_GAUGE_APPEND(reply, stats, components.pair_count, "Pair ids in use");
-    ECS_GAUGE_APPEND(reply, stats, components.type_count, "Registered component types");
-    ECS_COUNTER_APPEND(reply, stats, components.create_count, "Number of new component, tag and pair ids created");
-    ECS_COUNTER_APPEND(reply, stats, components.delete_count, "Number of component, pair and tag ids deleted");
-
-    ECS_GAUGE_APPEND(reply, stats, queries.query_count, "Queries in the world");
-    ECS_GAUGE_APPEND(reply, stats, queries.observer_count, "Observers in the world");
-    ECS_GAUGE_APPEND(reply, stats, queries.system_count, "Systems in the world");
-
-    ECS_COUNTER_APPEND(reply, stats, memory.alloc_count, "Allocations by OS API");
-    ECS_COUNTER_APPEND(reply, stats, memory.realloc_count, "Reallocs by OS API");
-    ECS_COUNTER_APPEND(reply, stats, memory.free_count, "Frees by OS API");
-    ECS_GAUGE_APPEND(reply, stats, memory.outstanding_alloc_count, "Outstanding allocations by OS API");
-    ECS_COUNTER_APPEND(reply, stats, memory.block_alloc_count, "Blocks allocated by block allocators");
-    ECS_COUNTER_APPEND(reply, stats, memory.block_free_count, "Blocks freed by block allocators");
-    ECS_GAUGE_APPEND(reply, stats, memory.block_outstanding_alloc_count, "Outstanding block allocations");
-    ECS_COUNTER_APPEND(reply, stats, memory.stack_alloc_count, "Pages allocated by stack allocators");
-    ECS_COUNTER_APPEND(reply, stats, memory.stack_free_count, "Pages freed by stack allocators");
-    ECS_GAUGE_APPEND(reply, stats, memory.stack_outstanding_alloc_count, "Outstanding page allocations");
-
-    ECS_COUNTER_APPEND(reply, stats, http.request_received_count, "Received requests");
-    ECS_COUNTER_APPEND(reply, stats, http.request_invalid_count, "Received invalid requests");
-    ECS_COUNTER_APPEND(reply, stats, http.request_handled_ok_count, "Requests handled successfully");
-    ECS_COUNTER_APPEND(reply, stats, http.request_handled_error_count, "Requests handled with error code");
-    ECS_COUNTER_APPEND(reply, stats, http.request_not_handled_count, "Requests not handled (unknown endpoint)");
-    ECS_COUNTER_APPEND(reply, stats, http.request_preflight_count, "Preflight requests received");
-    ECS_COUNTER_APPEND(reply, stats, http.send_ok_count, "Successful replies");
-    ECS_COUNTER_APPEND(reply, stats, http.send_error_count, "Unsuccessful replies");
-    ECS_COUNTER_APPEND(reply, stats, http.busy_count, "Dropped requests due to full send queue (503)");
+    /* Don't serve cached results of the previous query */
+    ecs_http_server_invalidate(impl->srv, req->path);
 
-    ecs_strbuf_list_pop(reply, "}");
+    return true;
+}
+
+static
+bool flecs_rest_reply_prepared_query(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply,
+    const char *name)
+{
+    ecs_rest_prepared_query_t *pq = flecs_rest_get_prepared_query(
+        impl, name, NULL);
+    if (!pq) {
+        flecs_reply_error(reply, "prepared query '%s' not found", name);
+        reply->code = 404;
+        return true;
+    }
+
+    ecs_dbg_2("rest: request prepared query '%s'", name);
+    bool prev_color = ecs_log_enable_colors(false);
+    rest_prev_log = ecs_os_api.log_;
+    ecs_os_api.log_ = flecs_rest_capture_log;
+
+    ecs_iter_t it = ecs_rule_iter(world, pq->rule);
+    const char *vars = ecs_http_get_param(req, "vars");
+    if (vars && ecs_rule_parse_vars(pq->rule, &it, vars) == NULL) {
+        ecs_iter_fini(&it);
+        flecs_rest_reply_set_captured_log(reply);
+    } else {
+        flecs_rest_iter_to_reply(
+            world, impl, req, reply, pq->rule, &it, &pq->desc);
+    }
+
+    ecs_os_api.log_ = rest_prev_log;
+    ecs_log_enable_colors(prev_color);
+
+    return true;
+}
+
+static
+bool flecs_rest_delete_prepared_query(
+    ecs_rest_ctx_t *impl,
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply,
+    const char *name)
+{
+    int32_t index;
+    ecs_rest_prepared_query_t *pq = flecs_rest_get_prepared_query(
+        impl, name, &index);
+    if (!pq) {
+        flecs_reply_error(reply, "prepared query '%s' not found", name);
+        reply->code = 404;
+        return true;
+    }
+
+    flecs_rest_prepared_query_fini(pq);
+    ecs_vec_remove_t(&impl->prepared_queries, ecs_rest_prepared_query_t, index);
+    ecs_http_server_invalidate(impl->srv, req->path);
+
+    return true;
+}
+
+#ifdef FLECS_MONITOR
+
+static
+void flecs_rest_array_append_(
+    ecs_strbuf_t *reply,
+    const char *field,
+    int32_t field_len,
+    const ecs_float_t *values,
+    int32_t t,
+    int32_t count)
+{
+    ecs_strbuf_list_appendch(reply, '"');
+    ecs_strbuf_appendstrn(reply, field, field_len);
+    ecs_strbuf_appendlit(reply, "\":");
+    ecs_strbuf_list_push(reply, "[", ",");
+
+    /* Append the last count samples, ending with the current sample */
+    int32_t i;
+    for (i = t + 1 + ECS_STAT_WINDOW - count; i <= (t + ECS_STAT_WINDOW); i ++) {
+        int32_t index = i % ECS_STAT_WINDOW;
+        ecs_strbuf_list_next(reply);
+        ecs_strbuf_appendflt(reply, (double)values[index], '"');
+    }
+
+    ecs_strbuf_list_pop(reply, "]");
+}
+
+#define flecs_rest_array_append(reply, field, values, t, count)\
+    flecs_rest_array_append_(reply, field, sizeof(field) - 1, values, t, count)
+
+static
+void flecs_rest_metric_append(
+    ecs_strbuf_t *reply,
+    const ecs_metric_t *m,
+    int32_t t,
+    int32_t count,
+    const char *brief,
+    int32_t brief_len)
+{
+    ecs_strbuf_list_push(reply, "{", ",");
+
+    flecs_rest_array_append(reply, "avg", m->gauge.avg, t, count);
+    flecs_rest_array_append(reply, "min", m->gauge.min, t, count);
+    flecs_rest_array_append(reply, "max", m->gauge.max, t, count);
+
+    /* Updates pushed to streams only contain the values */
+    if (brief && count == ECS_STAT_WINDOW) {
+        ecs_strbuf_list_appendlit(reply, "\"brief\":\"");
+        ecs_strbuf_appendstrn(reply, brief, brief_len);
+        ecs_strbuf_appendch(reply, '"');
+    }
+
+    ecs_strbuf_list_pop(reply, "}");
+}
+
+static
+void flecs_rest_gauge_append(
+    ecs_strbuf_t *reply,
+    const ecs_metric_t *m,
+    const char *field,
+    int32_t field_len,
+    int32_t t,
+    int32_t count,
+    const char *brief,
+    int32_t brief_len)
+{
+    ecs_strbuf_list_appendch(reply, '"');
+    ecs_strbuf_appendstrn(reply, field, field_len);
+    ecs_strbuf_appendlit(reply, "\":");
+    flecs_rest_metric_append(reply, m, t, count, brief, brief_len);
+}
+
+static
+void flecs_rest_counter_append(
+    ecs_strbuf_t *reply,
+    const ecs_metric_t *m,
+    const char *field,
+    int32_t field_len,
+    int32_t t,
+    int32_t count,
+    const char *brief,
+    int32_t brief_len)
+{
+    flecs_rest_gauge_append(
+        reply, m, field, field_len, t, count, brief, brief_len);
+}
+
+#define ECS_GAUGE_APPEND_T(reply, s, field, t, count, brief)\
+    flecs_rest_gauge_append(reply, &(s)->field, #field, sizeof(#field) - 1, t, count, brief, sizeof(brief) - 1)
+
+#define ECS_COUNTER_APPEND_T(reply, s, field, t, count, brief)\
+    flecs_rest_counter_append(reply, &(s)->field, #field, sizeof(#field) - 1, t, count, brief, sizeof(brief) - 1)
+
+#define ECS_GAUGE_APPEND(reply, s, field, count, brief)\
+    ECS_GAUGE_APPEND_T(reply, s, field, (s)->t, count, brief)
+
+#define ECS_COUNTER_APPEND(reply, s, field, count, brief)\
+    ECS_COUNTER_APPEND_T(reply, s, field, (s)->t, count, brief)
+
+static
+void flecs_world_stats_to_json(
+    ecs_strbuf_t *reply,
+    const EcsWorldStats *monitor_stats,
+    int32_t count)
+{
+    const ecs_world_stats_t *stats = &monitor_stats->stats;
+
+    ecs_strbuf_list_push(reply, "{", ",");
+    ECS_GAUGE_APPEND(reply, stats, entities.count, count, "Alive entity ids in the world");
+    ECS_GAUGE_APPEND(reply, stats, entities.not_alive_count, count, "Not alive entity ids in the world");
+
+    ECS_GAUGE_APPEND(reply, stats, performance.fps, count, "Frames per second");
+    ECS_COUNTER_APPEND(reply, stats, performance.frame_time, count, "Time spent in frame");
+    ECS_COUNTER_APPEND(reply, stats, performance.system_time, count, "Time spent on running systems in frame");
+    ECS_COUNTER_APPEND(reply, stats, performance.emit_time, count, "Time spent on notifying observers in frame");
+    ECS_COUNTER_APPEND(reply, stats, performance.merge_time, count, "Time spent on merging commands in frame");
+    ECS_COUNTER_APPEND(reply, stats, performance.rematch_time, count, "Time spent on revalidating query caches in frame");
+
+    ECS_COUNTER_APPEND(reply, stats, commands.add_count, count, "Add commands executed");
+    ECS_COUNTER_APPEND(reply, stats, commands.remove_count, count, "Remove commands executed");
+    ECS_COUNTER_APPEND(reply, stats, commands.delete_count, count, "Delete commands executed");
+    ECS_COUNTER_APPEND(reply, stats, commands.clear_count, count, "Clear commands executed");
+    ECS_COUNTER_APPEND(reply, stats, commands.set_count, count, "Set commands executed");
+    ECS_COUNTER_APPEND(reply, stats, commands.ensure_count, count, "Get_mut commands executed");
+    ECS_COUNTER_APPEND(reply, stats, commands.modified_count, count, "Modified commands executed");
+    ECS_COUNTER_APPEND(reply, stats, commands.other_count, count, "Misc commands executed");
+    ECS_COUNTER_APPEND(reply, stats, commands.discard_count, count, "Commands for already deleted entities");
+    ECS_COUNTER_APPEND(reply, stats, commands.batched_entity_count, count, "Entities with batched commands");
+    ECS_COUNTER_APPEND(reply, stats, commands.batched_count, count, "Number of commands batched");
+
+    ECS_COUNTER_APPEND(reply, stats, frame.merge_count, count, "Number of merges (sync points)");
+    ECS_COUNTER_APPEND(reply, stats, frame.pipeline_build_count, count, "Pipeline rebuilds (happen when systems become active/enabled)");
+    ECS_COUNTER_APPEND(reply, stats, frame.systems_ran, count, "Systems ran in frame");
+    ECS_COUNTER_APPEND(reply, stats, frame.observers_ran, count, "Number of times an observer was invoked in frame");
+    ECS_COUNTER_APPEND(reply, stats, frame.event_emit_count, count, "Events emitted in frame");
+    ECS_COUNTER_APPEND(reply, stats, frame.rematch_count, count, "Number of query cache revalidations");
+
+    ECS_GAUGE_APPEND(reply, stats, tables.count, count, "Tables in the world (including empty)");
+    ECS_GAUGE_APPEND(reply, stats, tables.empty_count, count, "Empty tables in the world");
+    ECS_COUNTER_APPEND(reply, stats, tables.create_count, count, "Number of new tables created");
+    ECS_COUNTER_APPEND(reply, stats, tables.delete_count, count, "Number of tables deleted");
+
+    ECS_GAUGE_APPEND(reply, stats, components.tag_count, count, "Tag ids in use");
+    ECS_GAUGE_APPEND(reply, stats, components.component_count, count, "Component ids in use");
+    ECS_GAUGE_APPEND(reply, stats, components.pair_count, count, "Pair ids in use");
+    ECS_GAUGE_APPEND(reply, stats, components.type_count, count, "Registered component types");
+    ECS_COUNTER_APPEND(reply, stats, components.create_count, count, "Number of new component, tag and pair ids created");
+    ECS_COUNTER_APPEND(reply, stats, components.delete_count, count, "Number of component, pair and tag ids deleted");
+
+    ECS_GAUGE_APPEND(reply, stats, queries.query_count, count, "Queries in the world");
+    ECS_GAUGE_APPEND(reply, stats, queries.observer_count, count, "Observers in the world");
+    ECS_GAUGE_APPEND(reply, stats, queries.system_count, count, "Systems in the world");
+
+    ECS_COUNTER_APPEND(reply, stats, memory.alloc_count, count, "Allocations by OS API");
+    ECS_COUNTER_APPEND(reply, stats, memory.realloc_count, count, "Reallocs by OS API");
+    ECS_COUNTER_APPEND(reply, stats, memory.free_count, count, "Frees by OS API");
+    ECS_GAUGE_APPEND(reply, stats, memory.outstanding_alloc_count, count, "Outstanding allocations by OS API");
+    ECS_COUNTER_APPEND(reply, stats, memory.block_alloc_count, count, "Blocks allocated by block allocators");
+    ECS_COUNTER_APPEND(reply, stats, memory.block_free_count, count, "Blocks freed by block allocators");
+    ECS_GAUGE_APPEND(reply, stats, memory.block_outstanding_alloc_count, count, "Outstanding block allocations");
+    ECS_COUNTER_APPEND(reply, stats, memory.stack_alloc_count, count, "Pages allocated by stack allocators");
+    ECS_COUNTER_APPEND(reply, stats, memory.stack_free_count, count, "Pages freed by stack allocators");
+    ECS_GAUGE_APPEND(reply, stats, memory.stack_outstanding_alloc_count, count, "Outstanding page allocations");
+
+    ECS_COUNTER_APPEND(reply, stats, http.request_received_count, count, "Received requests");
+    ECS_COUNTER_APPEND(reply, stats, http.request_invalid_count, count, "Received invalid requests");
+    ECS_COUNTER_APPEND(reply, stats, http.request_handled_ok_count, count, "Requests handled successfully");
+    ECS_COUNTER_APPEND(reply, stats, http.request_handled_error_count, count, "Requests handled with error code");
+    ECS_COUNTER_APPEND(reply, stats, http.request_not_handled_count, count, "Requests not handled (unknown endpoint)");
+    ECS_COUNTER_APPEND(reply, stats, http.request_preflight_count, count, "Preflight requests received");
+    ECS_COUNTER_APPEND(reply, stats, http.send_ok_count, count, "Successful replies");
+    ECS_COUNTER_APPEND(reply, stats, http.send_error_count, count, "Unsuccessful replies");
+    ECS_COUNTER_APPEND(reply, stats, http.busy_count, count, "Dropped requests due to full send queue (503)");
+
+    ecs_strbuf_list_pop(reply, "}");
 }
 
 static
@@ -699,7 +1334,8 @@ void flecs_system_stats_to_json(
     ecs_world_t *world,
     ecs_strbuf_t *reply,
     ecs_entity_t system,
-    const ecs_system_stats_t *stats)
+    const ecs_system_stats_t *stats,
+    int32_t count)
 {
     ecs_strbuf_list_push(reply, "{", ",");
     ecs_strbuf_list_appendlit(reply, "\"name\":\"");
@@ -707,11 +1343,26 @@ void flecs_system_stats_to_json(
     ecs_strbuf_appendch(reply, '"');
 
     if (!stats->task) {
-        ECS_GAUGE_APPEND(reply, &stats->query, matched_table_count, "");
-        ECS_GAUGE_APPEND(reply, &stats->query, matched_entity_count, "");
+        ECS_GAUGE_APPEND(reply, &stats->query, matched_table_count, count, "");
+        ECS_GAUGE_APPEND(reply, &stats->query, matched_entity_count, count, "");
+    }
+
+    ECS_COUNTER_APPEND_T(reply, stats, time_spent, stats->query.t, count, "");
+
+    int32_t i, stage_count = ecs_vec_count(&stats->stage_time_spent);
+    if (stage_count) {
+        const ecs_metric_t *stage_time = ecs_vec_first_t(
+            &stats->stage_time_spent, ecs_metric_t);
+        ecs_strbuf_list_appendlit(reply, "\"stage_time_spent\":");
+        ecs_strbuf_list_push(reply, "[", ",");
+        for (i = 0; i < stage_count; i ++) {
+            ecs_strbuf_list_next(reply);
+            flecs_rest_metric_append(
+                reply, &stage_time[i], stats->query.t, count, NULL, 0);
+        }
+        ecs_strbuf_list_pop(reply, "]");
     }
 
-    ECS_COUNTER_APPEND_T(reply, stats, time_spent, stats->query.t, "");
     ecs_strbuf_list_pop(reply, "}");
 }
 
@@ -719,13 +1370,15 @@ static
 void flecs_pipeline_stats_to_json(
     ecs_world_t *world,
     ecs_strbuf_t *reply,
-    const EcsPipelineStats *stats)
+    const EcsPipelineStats *stats,
+    int32_t count)
 {
     ecs_strbuf_list_push(reply, "[", ",");
 
-    int32_t i, count = ecs_vec_count(&stats->stats.systems), sync_cur = 0;
+    int32_t i, sync_cur = 0;
+    int32_t system_count = ecs_vec_count(&stats->stats.systems);
     ecs_entity_t *ids = ecs_vec_first_t(&stats->stats.systems, ecs_entity_t);
-    for (i = 0; i < count; i ++) {
+    for (i = 0; i < system_count; i ++) {
         ecs_entity_t id = ids[i];
         
         ecs_strbuf_list_next(reply);
@@ -733,7 +1386,7 @@ void flecs_pipeline_stats_to_json(
         if (id) {
             ecs_system_stats_t *sys_stats = ecs_map_get_deref(
                 &stats->stats.system_stats, ecs_system_stats_t, id);
-            flecs_system_stats_to_json(world, reply, id, sys_stats);
+            flecs_system_stats_to_json(world, reply, id, sys_stats, count);
         } else {
             /* Sync point */
             ecs_strbuf_list_push(reply, "{", ",");
@@ -746,75 +1399,1007 @@ void flecs_pipeline_stats_to_json(
             ecs_strbuf_list_appendlit(reply, "\"multi_threaded\":");
             ecs_strbuf_appendbool(reply, sync_stats->multi_threaded);
 
-            ecs_strbuf_list_appendlit(reply, "\"no_readonly\":");
-            ecs_strbuf_appendbool(reply, sync_stats->no_readonly);
+            ecs_strbuf_list_appendlit(reply, "\"no_readonly\":");
+            ecs_strbuf_appendbool(reply, sync_stats->no_readonly);
+
+            ECS_GAUGE_APPEND_T(reply, sync_stats, 
+                time_spent, stats->stats.t, count, "");
+            ECS_GAUGE_APPEND_T(reply, sync_stats, 
+                commands_enqueued, stats->stats.t, count, "");
+
+            ecs_strbuf_list_pop(reply, "}");
+            sync_cur ++;
+        }
+    }
+
+    ecs_strbuf_list_pop(reply, "]");
+}
+
+static
+void flecs_stage_stats_to_json(
+    ecs_strbuf_t *reply,
+    const EcsPipelineStats *stats,
+    int32_t count)
+{
+    ecs_strbuf_list_push(reply, "[", ",");
+
+    int32_t i, stage_count = ecs_vec_count(&stats->stats.stages);
+    ecs_stage_stats_t *stages = ecs_vec_first_t(
+        &stats->stats.stages, ecs_stage_stats_t);
+    for (i = 0; i < stage_count; i ++) {
+        ecs_strbuf_list_next(reply);
+        ecs_strbuf_list_push(reply, "{", ",");
+        ecs_strbuf_list_appendlit(reply, "\"stage\":");
+        ecs_strbuf_appendint(reply, i);
+        ECS_COUNTER_APPEND_T(reply, &stages[i], 
+            time_spent, stats->stats.t, count, "Time spent running systems");
+        ECS_COUNTER_APPEND_T(reply, &stages[i], 
+            wait_time, stats->stats.t, count, "Time spent waiting for other threads");
+        ECS_COUNTER_APPEND_T(reply, &stages[i], 
+            merge_time, stats->stats.t, count, "Time spent merging commands");
+        ecs_strbuf_list_pop(reply, "}");
+    }
+
+    ecs_strbuf_list_pop(reply, "]");
+}
+
+static
+bool flecs_rest_stats_param(
+    ecs_world_t *world,
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply,
+    const char *category,
+    ecs_entity_t *kind_out,
+    ecs_entity_t *period_out,
+    bool *stages_out)
+{
+    char *period_str = NULL;
+    flecs_rest_string_param(req, "period", &period_str);
+
+    ecs_entity_t period = EcsPeriod1s;
+    if (period_str) {
+        char *period_name = ecs_asprintf("Period%s", period_str);
+        period = ecs_lookup_child(world, ecs_id(FlecsMonitor), period_name);
+        ecs_os_free(period_name);
+        if (!period) {
+            flecs_reply_error(reply, "bad request (invalid period string)");
+            reply->code = 400;
+            return false;
+        }
+    }
+
+    if (!ecs_os_strcmp(category, "world")) {
+        *kind_out = ecs_id(EcsWorldStats);
+    } else if (!ecs_os_strcmp(category, "pipeline")) {
+        *kind_out = ecs_id(EcsPipelineStats);
+    } else if (!ecs_os_strcmp(category, "stages")) {
+        /* Stage statistics are stored with the pipeline statistics */
+        *kind_out = ecs_id(EcsPipelineStats);
+        *stages_out = true;
+    } else {
+        flecs_reply_error(reply, "bad request (unsupported category)");
+        reply->code = 400;
+        return false;
+    }
+
+    *period_out = period;
+    return true;
+}
+
+/* Serialize the last count samples of statistics */
+static
+void flecs_rest_stats_to_json(
+    ecs_world_t *world,
+    ecs_strbuf_t *buf,
+    ecs_entity_t kind,
+    ecs_entity_t period,
+    bool stages,
+    int32_t count)
+{
+    if (kind == ecs_id(EcsWorldStats)) {
+        const EcsWorldStats *stats = ecs_get_pair(world, EcsWorld, 
+            EcsWorldStats, period);
+        flecs_world_stats_to_json(buf, stats, count);
+    } else {
+        const EcsPipelineStats *stats = ecs_get_pair(world, EcsWorld, 
+            EcsPipelineStats, period);
+        if (stages) {
+            flecs_stage_stats_to_json(buf, stats, count);
+        } else {
+            flecs_pipeline_stats_to_json(world, buf, stats, count);
+        }
+    }
+}
+
+static
+bool flecs_rest_reply_stats(
+    ecs_world_t *world,
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply)
+{
+    ecs_entity_t kind, period;
+    bool stages = false;
+    if (!flecs_rest_stats_param(
+        world, req, reply, &req->path[6], &kind, &period, &stages)) 
+    {
+        return false;
+    }
+
+    flecs_rest_stats_to_json(world, &reply->body, kind, period, stages,
+        ECS_STAT_WINDOW);
+    return true;
+}
+#else
+static
+bool flecs_rest_reply_stats(
+    ecs_world_t *world,
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply)
+{
+    (void)world;
+    (void)req;
+    (void)reply;
+    return false;
+}
+#endif
+
+/* Sample of world statistics in the OpenMetrics reply. These don't depend on
+ * the contents of the world, so the layout is created at compile time. */
+typedef struct {
+    const char *header;       /* TYPE and HELP lines, NULL if same family */
+    const char *prefix;       /* Sample name and labels, ends with space */
+    int32_t offset;           /* Offset of value in ecs_world_info_t */
+    int32_t type;             /* 0 = ecs_ftime_t, 1 = int64_t, 2 = int32_t */
+} ecs_rest_om_world_sample_t;
+
+#define FLECS_REST_OM_HEADER(kind, name, help)\
+    "# TYPE " name " " kind "\n# HELP " name " " help "\n"
+
+#define FLECS_REST_OM_COUNTER(name, help, field, type)\
+    { FLECS_REST_OM_HEADER("counter", name, help), name "_total ",\
+        offsetof(ecs_world_info_t, field), type }
+
+#define FLECS_REST_OM_GAUGE(name, help, field, type)\
+    { FLECS_REST_OM_HEADER("gauge", name, help), name " ",\
+        offsetof(ecs_world_info_t, field), type }
+
+#define FLECS_REST_OM_COMMAND(header, kind, field)\
+    { header, "flecs_world_commands_total{kind=\"" kind "\"} ",\
+        offsetof(ecs_world_info_t, cmd.field), 1 }
+
+static const ecs_rest_om_world_sample_t flecs_rest_om_world[] = {
+    FLECS_REST_OM_COUNTER("flecs_world_frames", 
+        "Frames processed", frame_count_total, 1),
+    FLECS_REST_OM_COUNTER("flecs_world_frame_time_seconds", 
+        "Time spent processing frames", frame_time_total, 0),
+    FLECS_REST_OM_COUNTER("flecs_world_system_time_seconds", 
+        "Time spent in systems", system_time_total, 0),
+    FLECS_REST_OM_COUNTER("flecs_world_emit_time_seconds", 
+        "Time spent notifying observers", emit_time_total, 0),
+    FLECS_REST_OM_COUNTER("flecs_world_merge_time_seconds", 
+        "Time spent merging commands", merge_time_total, 0),
+    FLECS_REST_OM_COUNTER("flecs_world_rematch_time_seconds", 
+        "Time spent revalidating query caches", rematch_time_total, 0),
+    FLECS_REST_OM_COUNTER("flecs_world_simulation_time_seconds", 
+        "Time elapsed in simulation", world_time_total, 0),
+    FLECS_REST_OM_COUNTER("flecs_world_merges", 
+        "Command merges", merge_count_total, 1),
+    FLECS_REST_OM_COUNTER("flecs_world_rematches", 
+        "Query cache revalidations", rematch_count_total, 1),
+    FLECS_REST_OM_COUNTER("flecs_world_ids_created", 
+        "Ids created", id_create_total, 1),
+    FLECS_REST_OM_COUNTER("flecs_world_ids_deleted", 
+        "Ids deleted", id_delete_total, 1),
+    FLECS_REST_OM_COUNTER("flecs_world_tables_created", 
+        "Tables created", table_create_total, 1),
+    FLECS_REST_OM_COUNTER("flecs_world_tables_deleted", 
+        "Tables deleted", table_delete_total, 1),
+    FLECS_REST_OM_COUNTER("flecs_world_pipeline_builds", 
+        "Pipeline rebuilds", pipeline_build_count_total, 1),
+    FLECS_REST_OM_GAUGE("flecs_world_systems_ran", 
+        "Systems ran in last frame", systems_ran_frame, 1),
+    FLECS_REST_OM_GAUGE("flecs_world_observers_ran", 
+        "Observers invoked in last frame", observers_ran_frame, 1),
+    FLECS_REST_OM_GAUGE("flecs_world_tag_ids", 
+        "Tag ids in the world", tag_id_count, 2),
+    FLECS_REST_OM_GAUGE("flecs_world_component_ids", 
+        "Component ids in the world", component_id_count, 2),
+    FLECS_REST_OM_GAUGE("flecs_world_pair_ids", 
+        "Pair ids in the world", pair_id_count, 2),
+    FLECS_REST_OM_GAUGE("flecs_world_tables", 
+        "Tables in the world", table_count, 2),
+    FLECS_REST_OM_GAUGE("flecs_world_empty_tables", 
+        "Tables without entities", empty_table_count, 2),
+    FLECS_REST_OM_GAUGE("flecs_world_delta_time_seconds", 
+        "Time passed to last frame", delta_time, 0),
+    FLECS_REST_OM_GAUGE("flecs_world_target_fps", 
+        "Target frames per second", target_fps, 0),
+    FLECS_REST_OM_COMMAND(FLECS_REST_OM_HEADER("counter", 
+        "flecs_world_commands", "Commands processed"), "add", add_count),
+    FLECS_REST_OM_COMMAND(NULL, "remove", remove_count),
+    FLECS_REST_OM_COMMAND(NULL, "delete", delete_count),
+    FLECS_REST_OM_COMMAND(NULL, "clear", clear_count),
+    FLECS_REST_OM_COMMAND(NULL, "set", set_count),
+    FLECS_REST_OM_COMMAND(NULL, "ensure", ensure_count),
+    FLECS_REST_OM_COMMAND(NULL, "modified", modified_count),
+    FLECS_REST_OM_COMMAND(NULL, "discard", discard_count),
+    FLECS_REST_OM_COMMAND(NULL, "event", event_count),
+    FLECS_REST_OM_COMMAND(NULL, "other", other_count)
+};
+
+static
+void flecs_rest_om_name(
+    ecs_strbuf_t *buf,
+    const char *name)
+{
+    /* Metric names may only contain [a-zA-Z0-9_:] */
+    if (isdigit(name[0])) {
+        ecs_strbuf_appendch(buf, '_');
+    }
+    const char *ptr;
+    for (ptr = name; ptr[0]; ptr ++) {
+        char ch = ptr[0];
+        if (!isalnum(ch) && ch != ':') {
+            ch = '_';
+        }
+        ecs_strbuf_appendch(buf, ch);
+    }
+}
+
+static
+void flecs_rest_om_text(
+    ecs_strbuf_t *buf,
+    const char *text,
+    bool quote)
+{
+    const char *ptr;
+    for (ptr = text; ptr[0]; ptr ++) {
+        char ch = ptr[0];
+        if (ch == '\\') {
+            ecs_strbuf_appendlit(buf, "\\\\");
+        } else if (ch == '\n') {
+            ecs_strbuf_appendlit(buf, "\\n");
+        } else if (ch == '"' && quote) {
+            ecs_strbuf_appendlit(buf, "\\\"");
+        } else {
+            ecs_strbuf_appendch(buf, ch);
+        }
+    }
+}
+
+static
+void flecs_rest_om_label(
+    ecs_world_t *world,
+    ecs_strbuf_t *buf,
+    const char *label,
+    ecs_entity_t entity)
+{
+    char *path = ecs_get_fullpath(world, entity);
+    ecs_strbuf_appendstr(buf, label);
+    ecs_strbuf_appendlit(buf, "=\"");
+    flecs_rest_om_text(buf, path, true);
+    ecs_strbuf_appendch(buf, '"');
+    ecs_os_free(path);
+}
+
+static
+ecs_rest_om_family_t* flecs_rest_om_family(
+    ecs_rest_ctx_t *impl,
+    ecs_rest_om_kind_t kind,
+    const char *type,
+    const char *name,
+    const char *help)
+{
+    ecs_rest_om_family_t *family = ecs_vec_append_t(
+        NULL, &impl->om_families, ecs_rest_om_family_t);
+    family->kind = kind;
+    ecs_vec_init_t(NULL, &family->samples, ecs_rest_om_sample_t, 0);
+
+    ecs_strbuf_t buf = ECS_STRBUF_INIT;
+    ecs_strbuf_appendlit(&buf, "# TYPE ");
+    ecs_strbuf_appendstr(&buf, name);
+    ecs_strbuf_appendch(&buf, ' ');
+    ecs_strbuf_appendstr(&buf, type);
+    ecs_strbuf_appendch(&buf, '\n');
+    if (help) {
+        ecs_strbuf_appendlit(&buf, "# HELP ");
+        ecs_strbuf_appendstr(&buf, name);
+        ecs_strbuf_appendch(&buf, ' ');
+        flecs_rest_om_text(&buf, help, false);
+        ecs_strbuf_appendch(&buf, '\n');
+    }
+    family->header = ecs_strbuf_get(&buf);
+    return family;
+}
+
+static
+ecs_rest_om_sample_t* flecs_rest_om_sample(
+    ecs_rest_om_family_t *family,
+    ecs_strbuf_t *prefix,
+    ecs_entity_t entity,
+    ecs_id_t id,
+    int32_t offset)
+{
+    ecs_rest_om_sample_t *sample = ecs_vec_append_t(
+        NULL, &family->samples, ecs_rest_om_sample_t);
+    ecs_strbuf_appendch(prefix, ' ');
+    sample->prefix = ecs_strbuf_get(prefix);
+    sample->entity = entity;
+    sample->id = id;
+    sample->offset = offset;
+    return sample;
+}
+
+static
+void flecs_rest_om_layout_fini(
+    ecs_rest_ctx_t *impl)
+{
+    ecs_rest_om_family_t *families = ecs_vec_first(&impl->om_families);
+    int32_t i, count = ecs_vec_count(&impl->om_families);
+    for (i = 0; i < count; i ++) {
+        ecs_rest_om_family_t *family = &families[i];
+        ecs_rest_om_sample_t *samples = ecs_vec_first(&family->samples);
+        int32_t s, sample_count = ecs_vec_count(&family->samples);
+        for (s = 0; s < sample_count; s ++) {
+            ecs_os_free(samples[s].prefix);
+        }
+        ecs_vec_fini_t(NULL, &family->samples, ecs_rest_om_sample_t);
+        ecs_os_free(family->header);
+    }
+    ecs_vec_fini_t(NULL, &impl->om_families, ecs_rest_om_family_t);
+}
+
+/* The layout depends on which systems, metrics and alerts exist. Tables are
+ * marked dirty when entities are added or removed, so the layout only needs
+ * to be created again when the dirty state of one of their tables changes. */
+static
+uint64_t flecs_rest_om_layout_hash(
+    ecs_world_t *world)
+{
+    ecs_id_t ids[4] = { ecs_pair(ecs_id(EcsPoly), EcsSystem) };
+    int32_t i, id_count = 1;
+#ifdef FLECS_METRICS
+    ids[id_count ++] = EcsMetric;
+    ids[id_count ++] = ecs_id(EcsMetricValue);
+#endif
+#ifdef FLECS_ALERTS
+    ids[id_count ++] = ecs_id(EcsAlert);
+#endif
+
+    uint64_t hash = 0;
+    for (i = 0; i < id_count; i ++) {
+        ecs_id_record_t *idr = flecs_id_record_get(world, ids[i]);
+        ecs_table_cache_iter_t it;
+        if (!idr || !flecs_table_cache_all_iter(&idr->cache, &it)) {
+            continue;
+        }
+
+        const ecs_table_record_t *tr;
+        while ((tr = flecs_table_cache_next(&it, ecs_table_record_t))) {
+            ecs_table_t *table = tr->hdr.table;
+            int32_t *dirty_state = flecs_table_get_dirty_state(world, table);
+            hash = flecs_rest_hash_combine(hash, table->id);
+            hash = flecs_rest_hash_combine(hash, (uint32_t)dirty_state[0]);
+        }
+    }
+
+    return hash;
+}
+
+static
+void flecs_rest_om_layout_systems(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl)
+{
+    ecs_rest_om_family_t *family = NULL;
+    ecs_iter_t it = ecs_term_iter(world, &(ecs_term_t){ 
+        .id = ecs_pair(ecs_id(EcsPoly), EcsSystem),
+        .inout = EcsInOutNone
+    });
+
+    while (ecs_term_next(&it)) {
+        if (!family) {
+            family = flecs_rest_om_family(impl, EcsRestOmSystemTime, 
+                "counter", "flecs_system_time_seconds", 
+                "Time spent in system");
+        }
+
+        int32_t i;
+        for (i = 0; i < it.count; i ++) {
+            ecs_strbuf_t prefix = ECS_STRBUF_INIT;
+            ecs_strbuf_appendlit(&prefix, "flecs_system_time_seconds_total{");
+            flecs_rest_om_label(world, &prefix, "system", it.entities[i]);
+            ecs_strbuf_appendch(&prefix, '}');
+            flecs_rest_om_sample(family, &prefix, it.entities[i], 0, 0);
+        }
+    }
+}
+
+#ifdef FLECS_METRICS
+/* Histogram metrics are exported as summary with the percentiles as quantiles */
+static
+void flecs_rest_om_layout_histogram(
+    ecs_rest_ctx_t *impl,
+    ecs_entity_t metric,
+    const char *name,
+    const char *help)
+{
+    static const struct {
+        const char *quantile;
+        int32_t offset;
+    } quantiles[] = {
+        { "0.5", offsetof(EcsMetricHistogram, p50) },
+        { "0.9", offsetof(EcsMetricHistogram, p90) },
+        { "0.99", offsetof(EcsMetricHistogram, p99) }
+    };
+
+    ecs_rest_om_family_t *family = flecs_rest_om_family(impl, 
+        EcsRestOmMetricValue, "summary", name, help);
+
+    int32_t i;
+    for (i = 0; i < 3; i ++) {
+        ecs_strbuf_t prefix = ECS_STRBUF_INIT;
+        ecs_strbuf_appendstr(&prefix, name);
+        ecs_strbuf_appendlit(&prefix, "{quantile=\"");
+        ecs_strbuf_appendstr(&prefix, quantiles[i].quantile);
+        ecs_strbuf_appendlit(&prefix, "\"}");
+        flecs_rest_om_sample(family, &prefix, metric, 
+            ecs_id(EcsMetricHistogram), quantiles[i].offset);
+    }
+
+    ecs_strbuf_t prefix = ECS_STRBUF_INIT;
+    ecs_strbuf_appendstr(&prefix, name);
+    ecs_strbuf_appendlit(&prefix, "_sum");
+    flecs_rest_om_sample(family, &prefix, metric, 
+        ecs_id(EcsMetricHistogram), offsetof(EcsMetricHistogram, sum));
+
+    ecs_strbuf_appendstr(&prefix, name);
+    ecs_strbuf_appendlit(&prefix, "_count");
+    flecs_rest_om_sample(family, &prefix, metric, 
+        ecs_id(EcsMetricHistogram), offsetof(EcsMetricHistogram, count));
+}
+
+static
+void flecs_rest_om_layout_metric(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
+    ecs_entity_t metric)
+{
+    ecs_entity_t kind = ecs_get_target(world, metric, EcsMetric, 0);
+    bool counter = kind == EcsCounter || kind == EcsCounterIncrement || 
+        kind == EcsCounterId;
+
+    ecs_strbuf_t name_buf = ECS_STRBUF_INIT;
+    char *path = ecs_get_path_w_sep(world, 0, metric, "_", NULL);
+    flecs_rest_om_name(&name_buf, path);
+    ecs_os_free(path);
+    char *name = ecs_strbuf_get(&name_buf);
+
+    const char *help = NULL;
+#ifdef FLECS_DOC
+    help = ecs_doc_get_brief(world, metric);
+#endif
+
+    if (kind == EcsHistogram) {
+        flecs_rest_om_layout_histogram(impl, metric, name, help);
+        ecs_os_free(name);
+        return;
+    }
+
+    ecs_rest_om_family_t *family = flecs_rest_om_family(impl, 
+        EcsRestOmMetricValue, counter ? "counter" : "gauge", name, help);
+
+    /* Metrics that count ids store the value on the metric */
+    if (ecs_has(world, metric, EcsMetricValue)) {
+        ecs_strbuf_t prefix = ECS_STRBUF_INIT;
+        ecs_strbuf_appendstr(&prefix, name);
+        if (counter) {
+            ecs_strbuf_appendlit(&prefix, "_total");
+        }
+        flecs_rest_om_sample(family, &prefix, metric, 
+            ecs_id(EcsMetricValue), 0);
+    }
+
+    /* Instances of oneof metrics have a value for each member of the metric */
+    const EcsStruct *st = ecs_get(world, metric, EcsStruct);
+    ecs_id_t oneof_id = ecs_pair(metric, ecs_id(EcsMetricValue));
+
+    ecs_iter_t it = ecs_children(world, metric);
+    while (ecs_children_next(&it)) {
+        int32_t i;
+        for (i = 0; i < it.count; i ++) {
+            ecs_entity_t inst = it.entities[i];
+            ecs_id_t id = ecs_id(EcsMetricValue);
+            int32_t m, member_count = 1;
+            ecs_member_t *members = NULL;
+            if (!ecs_has(world, inst, EcsMetricValue)) {
+                if (!st || !ecs_has_id(world, inst, oneof_id)) {
+                    continue; /* Not an instance */
+                }
+                id = oneof_id;
+                members = ecs_vec_first(&st->members);
+                member_count = ecs_vec_count(&st->members);
+            }
+
+            const EcsMetricSource *src = ecs_get(world, inst, EcsMetricSource);
+            for (m = 0; m < member_count; m ++) {
+                ecs_strbuf_t prefix = ECS_STRBUF_INIT;
+                ecs_strbuf_appendstr(&prefix, name);
+                if (counter) {
+                    ecs_strbuf_appendlit(&prefix, "_total");
+                }
+                ecs_strbuf_appendch(&prefix, '{');
+                flecs_rest_om_label(world, &prefix, "entity", 
+                    src ? src->entity : inst);
+                if (members) {
+                    ecs_strbuf_appendlit(&prefix, ",value=\"");
+                    flecs_rest_om_text(&prefix, members[m].name, true);
+                    ecs_strbuf_appendch(&prefix, '"');
+                }
+                ecs_strbuf_appendch(&prefix, '}');
+                flecs_rest_om_sample(family, &prefix, inst, id, 
+                    members ? members[m].offset : 0);
+            }
+        }
+    }
+
+    ecs_os_free(name);
+}
+
+static
+void flecs_rest_om_layout_metrics(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl)
+{
+    if (!ecs_id(EcsMetricValue)) {
+        return; /* Metrics module is not imported */
+    }
+
+    ecs_iter_t it = ecs_term_iter(world, &(ecs_term_t){ 
+        .id = EcsMetric,
+        .inout = EcsInOutNone
+    });
+
+    while (ecs_term_next(&it)) {
+        int32_t i;
+        for (i = 0; i < it.count; i ++) {
+            flecs_rest_om_layout_metric(world, impl, it.entities[i]);
+        }
+    }
+}
+#endif
+
+#ifdef FLECS_ALERTS
+static
+void flecs_rest_om_layout_alerts(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl)
+{
+    if (!ecs_id(EcsAlert)) {
+        return; /* Alerts module is not imported */
+    }
+
+    ecs_rest_om_family_t *family = NULL;
+    ecs_iter_t it = ecs_term_iter(world, &(ecs_term_t){ 
+        .id = ecs_id(EcsAlert),
+        .inout = EcsInOutNone
+    });
+
+    while (ecs_term_next(&it)) {
+        if (!family) {
+            family = flecs_rest_om_family(impl, EcsRestOmAlertCount, 
+                "gauge", "flecs_alerts_active", "Active alert instances");
+        }
+
+        int32_t i;
+        for (i = 0; i < it.count; i ++) {
+            ecs_entity_t alert = it.entities[i];
+            ecs_entity_t severity = ecs_get_target(
+                world, alert, ecs_id(EcsAlert), 0);
+            ecs_strbuf_t prefix = ECS_STRBUF_INIT;
+            ecs_strbuf_appendlit(&prefix, "flecs_alerts_active{");
+            flecs_rest_om_label(world, &prefix, "alert", alert);
+            if (severity) {
+                ecs_strbuf_appendlit(&prefix, ",severity=\"");
+                flecs_rest_om_text(&prefix, ecs_get_name(world, severity), 
+                    true);
+                ecs_strbuf_appendch(&prefix, '"');
+            }
+            ecs_strbuf_appendch(&prefix, '}');
+            flecs_rest_om_sample(family, &prefix, alert, 0, 0);
+        }
+    }
+}
+
+static
+int32_t flecs_rest_om_alert_count(
+    ecs_world_t *world,
+    ecs_entity_t alert)
+{
+    /* Alert instances are created as children of the alert */
+    ecs_id_record_t *idr = flecs_id_record_get(world, ecs_childof(alert));
+    ecs_table_cache_iter_t it;
+    if (!idr || !flecs_table_cache_iter(&idr->cache, &it)) {
+        return 0;
+    }
+
+    int32_t result = 0;
+    const ecs_table_record_t *tr;
+    while ((tr = flecs_table_cache_next(&it, ecs_table_record_t))) {
+        ecs_table_t *table = tr->hdr.table;
+        if (ecs_table_has_id(world, table, ecs_id(EcsAlertInstance))) {
+            result += ecs_table_count(table);
+        }
+    }
+    return result;
+}
+#endif
+
+static
+void flecs_rest_om_layout(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl)
+{
+    uint64_t hash = flecs_rest_om_layout_hash(world);
+    if (hash == impl->om_layout_hash && ecs_vec_count(&impl->om_families)) {
+        return;
+    }
+
+    flecs_rest_om_layout_fini(impl);
+    ecs_vec_init_t(NULL, &impl->om_families, ecs_rest_om_family_t, 0);
+    flecs_rest_om_layout_systems(world, impl);
+#ifdef FLECS_METRICS
+    flecs_rest_om_layout_metrics(world, impl);
+#endif
+#ifdef FLECS_ALERTS
+    flecs_rest_om_layout_alerts(world, impl);
+#endif
+
+    impl->om_layout_hash = hash;
+}
+
+/* Metrics endpoint in OpenMetrics text format, used by Prometheus */
+static
+bool flecs_rest_reply_metrics(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
+    ecs_http_reply_t *reply)
+{
+    ecs_strbuf_t *buf = &reply->body;
+    reply->content_type = 
+        "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+    const ecs_world_info_t *info = ecs_get_world_info(world);
+    int32_t i, count = ECS_SIZEOF(flecs_rest_om_world) / 
+        ECS_SIZEOF(ecs_rest_om_world_sample_t);
+    for (i = 0; i < count; i ++) {
+        const ecs_rest_om_world_sample_t *s = &flecs_rest_om_world[i];
+        const void *ptr = ECS_OFFSET(info, s->offset);
+        if (s->header) {
+            ecs_strbuf_appendstr(buf, s->header);
+        }
+        ecs_strbuf_appendstr(buf, s->prefix);
+        if (s->type == 0) {
+            ecs_strbuf_appendflt(buf, (double)*(const ecs_ftime_t*)ptr, 0);
+        } else if (s->type == 1) {
+            ecs_strbuf_appendint(buf, *(const int64_t*)ptr);
+        } else {
+            ecs_strbuf_appendint(buf, *(const int32_t*)ptr);
+        }
+        ecs_strbuf_appendch(buf, '\n');
+    }
+
+    ecs_strbuf_appendstr(buf, FLECS_REST_OM_HEADER("gauge",
+        "flecs_world_entities", "Alive entities in the world"));
+    ecs_strbuf_appendlit(buf, "flecs_world_entities ");
+    ecs_strbuf_appendint(buf, flecs_entities_count(world));
+    ecs_strbuf_appendch(buf, '\n');
+
+    flecs_rest_om_layout(world, impl);
+
+    ecs_rest_om_family_t *families = ecs_vec_first(&impl->om_families);
+    count = ecs_vec_count(&impl->om_families);
+    for (i = 0; i < count; i ++) {
+        ecs_rest_om_family_t *family = &families[i];
+        ecs_strbuf_appendstr(buf, family->header);
+
+        ecs_rest_om_sample_t *samples = ecs_vec_first(&family->samples);
+        int32_t s, sample_count = ecs_vec_count(&family->samples);
+        for (s = 0; s < sample_count; s ++) {
+            ecs_rest_om_sample_t *sample = &samples[s];
+            double value = 0;
+            if (family->kind == EcsRestOmSystemTime) {
+                const ecs_system_t *sys = ecs_poly_get(
+                    world, sample->entity, ecs_system_t);
+                if (!sys) {
+                    continue;
+                }
+                value = (double)sys->time_spent;
+            } else if (family->kind == EcsRestOmMetricValue) {
+                const void *ptr = ecs_get_id(
+                    world, sample->entity, sample->id);
+                if (!ptr) {
+                    continue;
+                }
+                value = *(const double*)ECS_OFFSET(ptr, sample->offset);
+            } else {
+#ifdef FLECS_ALERTS
+                value = flecs_rest_om_alert_count(world, sample->entity);
+#endif
+            }
+
+            ecs_strbuf_appendstr(buf, sample->prefix);
+            ecs_strbuf_appendflt(buf, value, 0);
+            ecs_strbuf_appendch(buf, '\n');
+        }
+    }
+
+    ecs_strbuf_appendlit(buf, "# EOF\n");
+    return true;
+}
+
+static
+bool flecs_rest_query_event(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
+    ecs_rest_stream_t *stream,
+    ecs_strbuf_t *buf)
+{
+    uint64_t tables;
+    uint64_t hash = flecs_rest_query_changes(
+        world, impl, 0, stream->rule, &tables);
+    if (stream->pushed && hash == stream->hash) {
+        return false;
+    }
+
+    /* Only push the tables that changed if the result still matches the same
+     * entities, so that clients can merge the update with what they have */
+    bool delta = stream->changes && stream->pushed && 
+        tables == stream->tables;
+
+    ecs_iter_t it = ecs_rule_iter(world, stream->rule);
+    ecs_rest_changes_iter_t changes = { impl, stream->version };
+    ecs_iter_t cit, *iter = &it;
+    if (delta) {
+        cit = flecs_rest_changes_iter(&it, &changes);
+        iter = &cit;
+    }
+
+    uint64_t version = stream->version;
+    stream->hash = hash;
+    stream->tables = tables;
+    stream->version = impl->changes_version;
+    stream->pushed = true;
+
+    ecs_strbuf_t json = ECS_STRBUF_INIT;
+    if (ecs_iter_to_json_buf(world, iter, &json, &stream->desc)) {
+        ecs_strbuf_reset(&json);
+        return false;
+    }
+
+    /* Add version as first member of the object */
+    char *str = ecs_strbuf_get(&json);
+    ecs_strbuf_appendlit(buf, "data: {\"version\":");
+    ecs_strbuf_appendint(buf, flecs_uto(int64_t, impl->changes_version));
+    if (delta) {
+        ecs_strbuf_appendlit(buf, ",\"since\":");
+        ecs_strbuf_appendint(buf, flecs_uto(int64_t, version));
+    }
+    if (str[1] != '}') {
+        ecs_strbuf_appendch(buf, ',');
+    }
+    ecs_strbuf_appendstr(buf, &str[1]);
+    ecs_strbuf_appendlit(buf, "\n\n");
+    ecs_os_free(str);
+
+    return true;
+}
+
+#ifdef FLECS_MONITOR
+static
+bool flecs_rest_stats_event(
+    ecs_world_t *world,
+    ecs_rest_stream_t *stream,
+    ecs_strbuf_t *buf)
+{
+    const EcsStatsHeader *hdr = ecs_get_id(world, EcsWorld, 
+        ecs_pair(stream->kind, stream->period));
+    if (!hdr) {
+        return false;
+    }
+
+    /* The first event has all samples. Updates have the samples added since
+     * the last event, and repeat the last sample of the previous event, as it
+     * may have been combined with newer measurements. If a full window of
+     * samples was added, the update has all samples, like the first event. */
+    int32_t count = ECS_STAT_WINDOW;
+    if (stream->pushed) {
+        int64_t added = hdr->sample_count - stream->sample_count;
+        if (!added && hdr->reduce_count == stream->reduce_count) {
+            return false;
+        }
+        if (added < (ECS_STAT_WINDOW - 1)) {
+            count = (int32_t)added + 1;
+        }
+    }
+
+    stream->sample_count = hdr->sample_count;
+    stream->reduce_count = hdr->reduce_count;
+    stream->pushed = true;
+
+    ecs_strbuf_appendlit(buf, "data: ");
+    flecs_rest_stats_to_json(world, buf, stream->kind, stream->period, 
+        stream->stages, count);
+    ecs_strbuf_appendlit(buf, "\n\n");
+
+    return true;
+}
+#endif
+
+/* Append event to buffer if the stream has an update */
+static
+bool flecs_rest_stream_event(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
+    ecs_rest_stream_t *stream,
+    ecs_strbuf_t *buf)
+{
+    if (stream->rule) {
+        return flecs_rest_query_event(world, impl, stream, buf);
+    }
+#ifdef FLECS_MONITOR
+    return flecs_rest_stats_event(world, stream, buf);
+#else
+    return false;
+#endif
+}
 
-            ECS_GAUGE_APPEND_T(reply, sync_stats, 
-                time_spent, stats->stats.t, "");
-            ECS_GAUGE_APPEND_T(reply, sync_stats, 
-                commands_enqueued, stats->stats.t, "");
+static
+void flecs_rest_stream_fini(
+    ecs_rest_ctx_t *impl,
+    ecs_rest_stream_t *stream)
+{
+    if (stream->id) {
+        ecs_http_stream_close(impl->srv, stream->id);
+    }
+    if (stream->rule) {
+        ecs_rule_fini(stream->rule);
+    }
+}
 
-            ecs_strbuf_list_pop(reply, "}");
-            sync_cur ++;
-        }
+static
+void flecs_rest_stream_open(
+    ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
+    const ecs_http_request_t* req,
+    ecs_http_reply_t *reply,
+    ecs_rest_stream_t *stream)
+{
+    /* First event has the current result, and is sent with the headers */
+    flecs_rest_stream_event(world, impl, stream, &reply->body);
+
+    stream->id = ecs_http_reply_stream(req, reply);
+    if (!stream->id) {
+        /* Not a connection, reply with the first event */
+        flecs_rest_stream_fini(impl, stream);
+        return;
     }
 
-    ecs_strbuf_list_pop(reply, "]");
+    ecs_dbg_2("rest: stream opened for '%s'", req->path);
+    ecs_vec_init_if_t(&impl->streams, ecs_rest_stream_t);
+    ecs_vec_append_t(NULL, &impl->streams, ecs_rest_stream_t)[0] = *stream;
 }
 
 static
-bool flecs_rest_reply_stats(
+bool flecs_rest_reply_stream_query(
     ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
     const ecs_http_request_t* req,
     ecs_http_reply_t *reply)
 {
-    char *period_str = NULL;
-    flecs_rest_string_param(req, "period", &period_str);
-    char *category = &req->path[6];
+    const char *q = ecs_http_get_param(req, "q");
+    if (!q) {
+        flecs_reply_error(reply, "missing parameter 'q'");
+        reply->code = 400;
+        return true;
+    }
 
-    ecs_entity_t period = EcsPeriod1s;
-    if (period_str) {
-        char *period_name = ecs_asprintf("Period%s", period_str);
-        period = ecs_lookup_child(world, ecs_id(FlecsMonitor), period_name);
-        ecs_os_free(period_name);
-        if (!period) {
-            flecs_reply_error(reply, "bad request (invalid period string)");
-            reply->code = 400;
-            return false;
-        }
+    bool prev_color = ecs_log_enable_colors(false);
+    rest_prev_log = ecs_os_api.log_;
+    ecs_os_api.log_ = flecs_rest_capture_log;
+
+    ecs_rule_t *r = ecs_rule_init(world, &(ecs_filter_desc_t){
+        .expr = q
+    });
+    if (!r) {
+        flecs_rest_reply_set_captured_log(reply);
     }
 
-    if (!ecs_os_strcmp(category, "world")) {
-        const EcsWorldStats *stats = ecs_get_pair(world, EcsWorld, 
-            EcsWorldStats, period);
-        flecs_world_stats_to_json(&reply->body, stats);
-        return true;
+    ecs_os_api.log_ = rest_prev_log;
+    ecs_log_enable_colors(prev_color);
 
-    } else if (!ecs_os_strcmp(category, "pipeline")) {
-        const EcsPipelineStats *stats = ecs_get_pair(world, EcsWorld, 
-            EcsPipelineStats, period);
-        flecs_pipeline_stats_to_json(world, &reply->body, stats);
+    if (!r) {
         return true;
-
-    } else {
-        flecs_reply_error(reply, "bad request (unsupported category)");
-        reply->code = 400;
-        return false;
     }
+
+    ecs_rest_stream_t stream = {0};
+    stream.rule = r;
+    stream.desc.serialize_entities = true;
+    stream.desc.serialize_variables = true;
+    flecs_rest_parse_json_ser_iter_params(&stream.desc, req);
+    flecs_rest_bool_param(req, "changes", &stream.changes);
+
+    flecs_rest_stream_open(world, impl, req, reply, &stream);
+    return true;
 }
-#else
+
 static
-bool flecs_rest_reply_stats(
+bool flecs_rest_reply_stream_stats(
     ecs_world_t *world,
+    ecs_rest_ctx_t *impl,
     const ecs_http_request_t* req,
     ecs_http_reply_t *reply)
 {
+#ifdef FLECS_MONITOR
+    ecs_rest_stream_t stream = {0};
+    if (!flecs_rest_stats_param(
+        world, req, reply, &req->path[13], &stream.kind, &stream.period,
+        &stream.stages)) 
+    {
+        return false;
+    }
+
+    flecs_rest_stream_open(world, impl, req, reply, &stream);
+    return true;
+#else
     (void)world;
+    (void)impl;
     (void)req;
     (void)reply;
     return false;
-}
 #endif
+}
+
+/* Push updates to clients of open streams, at most once per frame. Streams are
+ * closed when the client went away. */
+static
+void flecs_rest_push_streams(
+    ecs_rest_ctx_t *impl)
+{
+    int32_t i, count = ecs_vec_count(&impl->streams);
+    if (!count) {
+        return;
+    }
+
+    ecs_world_t *world = impl->world;
+    int64_t frame = ecs_get_world_info(world)->frame_count_total;
+    if (frame == impl->stream_frame) {
+        return;
+    }
+    impl->stream_frame = frame;
+
+    ecs_strbuf_t buf = ECS_STRBUF_INIT;
+    for (i = count - 1; i >= 0; i --) {
+        ecs_rest_stream_t *stream = ecs_vec_get_t(
+            &impl->streams, ecs_rest_stream_t, i);
+        ecs_rest_stream_t prev = *stream;
+
+        /* Also called without an event, to find clients that went away */
+        buf.length = 0;
+        flecs_rest_stream_event(world, impl, stream, &buf);
+        int result = ecs_http_stream_send(impl->srv, stream->id, 
+            buf.content, ecs_strbuf_written(&buf));
+        if (result == 1) {
+            /* Client doesn't keep up, push the update in a later frame */
+            *stream = prev;
+        } else if (result == -1) {
+            ecs_dbg_2("rest: stream closed");
+            flecs_rest_stream_fini(impl, stream);
+            ecs_vec_remove_t(&impl->streams, ecs_rest_stream_t, i);
+        }
+    }
+    ecs_strbuf_reset(&buf);
+}
 
 static
 void flecs_rest_reply_table_append_type(
@@ -884,10 +2469,9 @@ bool flecs_rest_reply_tables(
     (void)req;
 
     ecs_strbuf_list_push(&reply->body, "[", ",");
-    ecs_sparse_t *tables = &world->store.tables;
-    int32_t i, count = flecs_sparse_count(tables);
-    for (i = 0; i < count; i ++) {
-        ecs_table_t *table = flecs_sparse_get_dense_t(tables, ecs_table_t, i);
+    ecs_sparse_iter_t it = flecs_sparse_iter(&world->store.tables);
+    ecs_table_t *table;
+    while ((table = flecs_sparse_next_t(&it, ecs_table_t, NULL))) {
         flecs_rest_reply_table_append(world, &reply->body, table);
     }
     ecs_strbuf_list_pop(&reply->body, "]");
@@ -895,6 +2479,147 @@ bool flecs_rest_reply_tables(
     return true;
 }
 
+#ifdef FLECS_STATS
+static
+void flecs_rest_reply_memory_append(
+    ecs_strbuf_t *reply,
+    const char *name,
+    const ecs_memory_t *memory)
+{
+    ecs_strbuf_list_next(reply);
+    ecs_strbuf_appendch(reply, '"');
+    ecs_strbuf_appendstr(reply, name);
+    ecs_strbuf_appendlit(reply, "\":{\"used\":");
+    ecs_strbuf_appendint(reply, memory->used);
+    ecs_strbuf_appendlit(reply, ",\"allocated\":");
+    ecs_strbuf_appendint(reply, memory->allocated);
+    ecs_strbuf_appendch(reply, '}');
+}
+
+static
+void flecs_rest_reply_memory_append_id(
+    const ecs_world_t *world,
+    ecs_strbuf_t *reply,
+    const ecs_id_record_t *idr)
+{
+    /* Only report ids that store data. Memory of wildcard ids is already
+     * reported for the ids that they match. */
+    if (!idr->type_info || ecs_id_is_wildcard(idr->id)) {
+        return;
+    }
+
+    ecs_id_memory_t memory;
+    ecs_id_memory_get(world, idr->id, &memory);
+    if (!memory.table_count) {
+        return;
+    }
+
+    ecs_strbuf_list_next(reply);
+    ecs_strbuf_list_push(reply, "{", ",");
+    ecs_strbuf_list_appendlit(reply, "\"id\":\"");
+    ecs_id_str_buf(world, idr->id, reply);
+    ecs_strbuf_appendch(reply, '"');
+    ecs_strbuf_list_append(reply, "\"table_count\":%d", memory.table_count);
+    flecs_rest_reply_memory_append(reply, "columns", &memory.columns);
+    flecs_rest_reply_memory_append(reply, "index", &memory.index);
+    ecs_strbuf_list_pop(reply, "}");
+}
+
+/* Memory endpoint. Reports memory per world subsystem, component, query and
+ * allocator size class. */
+static
+bool flecs_rest_reply_memory(
+    ecs_world_t *world,
+    ecs_http_reply_t *reply)
+{
+    ecs_strbuf_t *buf = &reply->body;
+    ecs_world_memory_t wm;
+    ecs_world_memory_get(world, &wm);
+
+    ecs_strbuf_list_push(buf, "{", ",");
+
+    ecs_strbuf_list_appendlit(buf, "\"world\":");
+    ecs_strbuf_list_push(buf, "{", ",");
+    flecs_rest_reply_memory_append(buf, "entity_index", &wm.entity_index);
+    flecs_rest_reply_memory_append(buf, "id_index", &wm.id_index);
+    flecs_rest_reply_memory_append(buf, "tables", &wm.tables);
+    flecs_rest_reply_memory_append(buf, "table_data", &wm.table_data);
+    flecs_rest_reply_memory_append(buf, "queries", &wm.queries);
+    flecs_rest_reply_memory_append(buf, "observers", &wm.observers);
+    flecs_rest_reply_memory_append(buf, "name_index", &wm.name_index);
+    flecs_rest_reply_memory_append(buf, "stages", &wm.stages);
+    flecs_rest_reply_memory_append(buf, "allocator", &wm.allocator);
+    ecs_strbuf_list_pop(buf, "}");
+
+    ecs_strbuf_list_appendlit(buf, "\"components\":");
+    ecs_strbuf_list_push(buf, "[", ",");
+    int32_t i;
+    for (i = 0; i < FLECS_HI_ID_RECORD_ID; i ++) {
+        const ecs_id_record_t *idr = &world->id_index_lo[i];
+        if (idr->id) {
+            flecs_rest_reply_memory_append_id(world, buf, idr);
+        }
+    }
+    ecs_map_iter_t it = ecs_map_iter(&world->id_index_hi);
+    while (ecs_map_next(&it)) {
+        flecs_rest_reply_memory_append_id(world, buf, ecs_map_ptr(&it));
+    }
+    ecs_strbuf_list_pop(buf, "]");
+
+    ecs_strbuf_list_appendlit(buf, "\"queries\":");
+    ecs_strbuf_list_push(buf, "[", ",");
+    ecs_id_record_t *idr = flecs_id_record_get(world, 
+        ecs_pair(ecs_id(EcsPoly), EcsQuery));
+    ecs_table_cache_iter_t tit;
+    const ecs_table_record_t *tr;
+    if (idr && flecs_table_cache_all_iter(&idr->cache, &tit)) {
+        while ((tr = flecs_table_cache_next(&tit, ecs_table_record_t))) {
+            ecs_table_t *table = tr->hdr.table;
+            EcsPoly *queries = ecs_table_get_column(table, tr->column, 0);
+            ecs_entity_t *entities = table->data.entities.array;
+            int32_t count = ecs_table_count(table);
+            for (i = 0; i < count; i ++) {
+                ecs_memory_t qm = ecs_query_memory_get(queries[i].poly);
+                ecs_strbuf_list_next(buf);
+                ecs_strbuf_list_push(buf, "{", ",");
+                ecs_strbuf_list_appendlit(buf, "\"entity\":\"");
+                ecs_get_path_w_sep_buf(world, 0, entities[i], ".", NULL, buf);
+                ecs_strbuf_appendch(buf, '"');
+                flecs_rest_reply_memory_append(buf, "memory", &qm);
+                ecs_strbuf_list_pop(buf, "}");
+            }
+        }
+    }
+    ecs_strbuf_list_pop(buf, "]");
+
+    ecs_strbuf_list_appendlit(buf, "\"size_classes\":");
+    ecs_strbuf_list_push(buf, "[", ",");
+    int32_t count = ecs_allocator_memory_get(world, NULL, 0);
+    if (count) {
+        ecs_size_class_memory_t *classes = ecs_os_malloc_n(
+            ecs_size_class_memory_t, count);
+        ecs_allocator_memory_get(world, classes, count);
+        for (i = 0; i < count; i ++) {
+            ecs_strbuf_list_next(buf);
+            ecs_strbuf_list_push(buf, "{", ",");
+            ecs_strbuf_list_append(buf, "\"size\":%d", classes[i].size);
+            ecs_strbuf_list_append(buf, "\"chunk_count\":%d", 
+                classes[i].chunk_count);
+            ecs_strbuf_list_append(buf, "\"block_count\":%d", 
+                classes[i].block_count);
+            flecs_rest_reply_memory_append(buf, "memory", &classes[i].memory);
+            ecs_strbuf_list_pop(buf, "}");
+        }
+        ecs_os_free(classes);
+    }
+    ecs_strbuf_list_pop(buf, "]");
+
+    ecs_strbuf_list_pop(buf, "}");
+
+    return true;
+}
+#endif
+
 static
 const char* flecs_rest_cmd_kind_to_str(
     ecs_cmd_kind_t kind)
@@ -970,6 +2695,28 @@ void flecs_rest_server_garbage_collect_all(
     }
 
     ecs_map_fini(&impl->cmd_captures);
+
+    ecs_map_iter_t tit = ecs_map_iter(&impl->table_versions);
+    while (ecs_map_next(&tit)) {
+        ecs_os_free(ecs_map_ptr(&tit));
+    }
+    ecs_map_fini(&impl->table_versions);
+
+    ecs_rest_prepared_query_t *queries = ecs_vec_first(&impl->prepared_queries);
+    int32_t i, count = ecs_vec_count(&impl->prepared_queries);
+    for (i = 0; i < count; i ++) {
+        flecs_rest_prepared_query_fini(&queries[i]);
+    }
+    ecs_vec_fini_t(NULL, &impl->prepared_queries, ecs_rest_prepared_query_t);
+
+    ecs_rest_stream_t *streams = ecs_vec_first(&impl->streams);
+    count = ecs_vec_count(&impl->streams);
+    for (i = 0; i < count; i ++) {
+        flecs_rest_stream_fini(impl, &streams[i]);
+    }
+    ecs_vec_fini_t(NULL, &impl->streams, ecs_rest_stream_t);
+
+    flecs_rest_om_layout_fini(impl);
 }
 
 static
@@ -1205,7 +2952,12 @@ bool flecs_rest_reply(
 
         /* Query endpoint */
         } else if (!ecs_os_strcmp(req->path, "query")) {
-            return flecs_rest_reply_query(world, req, reply);
+            return flecs_rest_reply_query(world, impl, req, reply);
+
+        /* Prepared query endpoint */
+        } else if (!ecs_os_strncmp(req->path, "query/", 6)) {
+            return flecs_rest_reply_prepared_query(
+                world, impl, req, reply, &req->path[6]);
 
         /* World endpoint */
         } else if (!ecs_os_strcmp(req->path, "world")) {
@@ -1226,6 +2978,28 @@ bool flecs_rest_reply(
         /* Commands request endpoint (request commands from specific frame) */
         } else if (!ecs_os_strncmp(req->path, "commands/frame/", 15)) {
             return flecs_rest_reply_commands_request(world, impl, req, reply);
+
+        /* Metrics endpoint */
+        } else if (!ecs_os_strcmp(req->path, "metrics")) {
+            return flecs_rest_reply_metrics(world, impl, reply);
+
+        /* Trace endpoint */
+        } else if (!ecs_os_strcmp(req->path, "trace")) {
+            return flecs_rest_reply_trace(world, reply);
+
+#ifdef FLECS_STATS
+        /* Memory endpoint */
+        } else if (!ecs_os_strcmp(req->path, "memory")) {
+            return flecs_rest_reply_memory(world, reply);
+#endif
+
+        /* Query stream endpoint */
+        } else if (!ecs_os_strcmp(req->path, "stream/query")) {
+            return flecs_rest_reply_stream_query(world, impl, req, reply);
+
+        /* Stats stream endpoint */
+        } else if (!ecs_os_strncmp(req->path, "stream/stats/", 13)) {
+            return flecs_rest_reply_stream_stats(world, impl, req, reply);
         }
 
     } else if (req->method == EcsHttpPut) {
@@ -1248,6 +3022,22 @@ bool flecs_rest_reply(
         /* Script endpoint */
         } else if (!ecs_os_strncmp(req->path, "script", 6)) {
             return flecs_rest_script(world, req, reply);
+
+        /* Trace endpoint */
+        } else if (!ecs_os_strcmp(req->path, "trace")) {
+            return flecs_rest_trace(world, req, reply);
+
+        /* Prepare query endpoint */
+        } else if (!ecs_os_strncmp(req->path, "query/", 6)) {
+            return flecs_rest_prepare_query(
+                world, impl, req, reply, &req->path[6]);
+        }
+
+    } else if (req->method == EcsHttpDelete) {
+        /* Delete prepared query endpoint */
+        if (!ecs_os_strncmp(req->path, "query/", 6)) {
+            return flecs_rest_delete_prepared_query(
+                impl, req, reply, &req->path[6]);
         }
     }
 
@@ -1279,10 +3069,174 @@ ecs_http_server_t* ecs_rest_server_init(
     return srv;
 }
 
+static
+void flecs_rest_dequeue(
+    ecs_rest_ctx_t *impl,
+    ecs_ftime_t delta_time)
+{
+    ecs_http_server_dequeue(impl->srv, delta_time);
+    flecs_rest_push_streams(impl);
+}
+
+/* Handle requests on the REST thread. Only GET requests, which don't modify
+ * the world, are handled. If another request is queued, all requests are left
+ * to the main thread, so that requests are handled in order. */
+static
+bool flecs_rest_dequeue_get(
+    ecs_rest_ctx_t *impl,
+    ecs_ftime_t delta_time)
+{
+    if (ecs_http_server_dequeue_method(impl->srv, delta_time, EcsHttpGet)) {
+        return true;
+    }
+    flecs_rest_push_streams(impl);
+    return false;
+}
+
+static
+double flecs_rest_now(void) {
+    ecs_time_t t = {0, 0};
+    return ecs_time_measure(&t);
+}
+
+static
+void* flecs_rest_thread(
+    void *arg)
+{
+    ecs_rest_ctx_t *impl = arg;
+    ecs_time_t t = {0, 0};
+    ecs_time_measure(&t);
+
+    ecs_os_mutex_lock(impl->lock);
+    while (impl->should_run) {
+        if (!impl->world_idle || impl->main_thread) {
+            ecs_os_cond_wait(impl->cond, impl->lock);
+            continue;
+        }
+
+        impl->busy = true;
+        ecs_os_mutex_unlock(impl->lock);
+
+        bool main_thread = flecs_rest_dequeue_get(
+            impl, (ecs_ftime_t)ecs_time_measure(&t));
+
+        ecs_os_mutex_lock(impl->lock);
+        impl->busy = false;
+        impl->main_thread = main_thread;
+        impl->last_dequeue = flecs_rest_now();
+
+        /* Signal main thread in case it's waiting to start the next frame */
+        ecs_os_cond_broadcast(impl->cond);
+        ecs_os_mutex_unlock(impl->lock);
+
+        /* Requests are dequeued at an interval, don't spin while waiting */
+        ecs_os_sleep(0, 1000 * 1000);
+
+        ecs_os_mutex_lock(impl->lock);
+    }
+    ecs_os_mutex_unlock(impl->lock);
+
+    return NULL;
+}
+
+/* Frame begin action that takes the world back from REST threads. Can't use
+ * the world until all threads are done. */
+static
+void flecs_rest_world_busy(
+    ecs_world_t *world,
+    void *ctx)
+{
+    (void)world;
+    ecs_rest_ctx_t *impl;
+    for (impl = ctx; impl; impl = impl->next) {
+        ecs_os_mutex_lock(impl->lock);
+        impl->world_idle = false;
+        while (impl->busy) {
+            ecs_os_cond_wait(impl->cond, impl->lock);
+        }
+        ecs_os_mutex_unlock(impl->lock);
+    }
+}
+
+/* Frame end action that hands the world to REST threads. This is the last
+ * step of a frame, after which the world isn't used until the next frame. */
+static
+void flecs_rest_world_idle(
+    ecs_world_t *world,
+    void *ctx)
+{
+    (void)world;
+    ecs_rest_ctx_t *impl;
+    for (impl = ctx; impl; impl = impl->next) {
+        if (!impl->hand_off) {
+            continue;
+        }
+
+        impl->hand_off = false;
+        ecs_os_mutex_lock(impl->lock);
+        impl->world_idle = true;
+        ecs_os_cond_broadcast(impl->cond);
+        ecs_os_mutex_unlock(impl->lock);
+    }
+}
+
+static
+void flecs_rest_thread_start(
+    ecs_rest_ctx_t *impl)
+{
+    impl->lock = ecs_os_mutex_new();
+    impl->cond = ecs_os_cond_new();
+    impl->should_run = true;
+    impl->last_dequeue = flecs_rest_now();
+    impl->thread = ecs_os_thread_new(flecs_rest_thread, impl);
+
+    /* Register with world, so the world can be taken back from the thread 
+     * before it's used */
+    ecs_world_t *world = impl->world;
+    impl->next = world->on_frame_begin_ctx;
+    world->on_frame_begin = flecs_rest_world_busy;
+    world->on_frame_begin_ctx = impl;
+    world->on_frame_end = flecs_rest_world_idle;
+    world->on_frame_end_ctx = impl;
+}
+
+static
+void flecs_rest_thread_stop(
+    ecs_rest_ctx_t *impl)
+{
+    if (!impl->thread) {
+        return;
+    }
+
+    ecs_os_mutex_lock(impl->lock);
+    impl->should_run = false;
+    ecs_os_cond_broadcast(impl->cond);
+    ecs_os_mutex_unlock(impl->lock);
+
+    ecs_os_thread_join(impl->thread);
+    ecs_os_cond_free(impl->cond);
+    ecs_os_mutex_free(impl->lock);
+    impl->thread = 0;
+
+    ecs_world_t *world = impl->world;
+    ecs_rest_ctx_t **ptr = (ecs_rest_ctx_t**)&world->on_frame_begin_ctx;
+    while (*ptr != impl) {
+        ptr = &(*ptr)->next;
+    }
+    *ptr = impl->next;
+    world->on_frame_end_ctx = world->on_frame_begin_ctx;
+    if (!world->on_frame_begin_ctx) {
+        world->on_frame_begin = NULL;
+        world->on_frame_end = NULL;
+    }
+}
+
+
 void ecs_rest_server_fini(
     ecs_http_server_t *srv)
 {
     ecs_rest_ctx_t *impl = ecs_http_server_ctx(srv);
+    flecs_rest_thread_stop(impl);
     flecs_rest_server_garbage_collect_all(impl);
     ecs_os_free(impl);
     ecs_http_server_fini(srv);
@@ -1315,6 +3269,10 @@ void flecs_on_set_rest(ecs_iter_t *it) {
         rest[i].impl = ecs_http_server_ctx(srv);
 
         ecs_http_server_start(srv);
+
+        if (rest[i].thread_mode == EcsRestBetweenFrames) {
+            flecs_rest_thread_start(rest[i].impl);
+        }
     }
 }
 
@@ -1331,10 +3289,27 @@ void DequeueRest(ecs_iter_t *it) {
     int32_t i;
     for(i = 0; i < it->count; i ++) {
         ecs_rest_ctx_t *ctx = rest[i].impl;
-        if (ctx) {
-            ecs_http_server_dequeue(ctx->srv, it->delta_time);
-            flecs_rest_server_garbage_collect(it->world, ctx);
+        if (!ctx) {
+            continue;
+        }
+
+        if (ctx->thread) {
+            /* Requests are handled by REST thread after the frame has ended,
+             * unless they modify the world, or the REST thread hasn't been
+             * able to handle requests for a while. */
+            if (ctx->main_thread || ((flecs_rest_now() - ctx->last_dequeue) > 
+                FLECS_REST_THREAD_TIMEOUT))
+            {
+                flecs_rest_dequeue(ctx, it->delta_time);
+                ctx->last_dequeue = flecs_rest_now();
+                ctx->main_thread = false;
+            }
+            ctx->hand_off = true;
+        } else {
+            flecs_rest_dequeue(ctx, it->delta_time);
         }
+
+        flecs_rest_server_garbage_collect(it->world, ctx);
     } 
 }
 
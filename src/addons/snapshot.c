@@ -15,28 +15,42 @@ struct ecs_snapshot_t {
     ecs_entity_index_t entity_index;
     ecs_vec_t tables;
     uint64_t last_id;
+    const ecs_snapshot_t *base; /* Base snapshot of delta snapshot */
 };
 
-/** Small footprint data structure for storing data associated with a table. */
+/** Small footprint data structure for storing data associated with a table. 
+ * Delta snapshots only store data that changed since the base snapshot. If no
+ * data changed, from_base is set. If only some columns changed, the columns
+ * that did not change are left empty. */
 typedef struct ecs_table_leaf_t {
-    ecs_table_t *table;
+    ecs_table_t *table;         /* Not owned, may be deleted (see table_id) */
     ecs_type_t type;
     ecs_data_t *data;
+    uint64_t table_id;          /* Table id (with generation) */
+    int32_t column_count;
+    int32_t *dirty_state;       /* Table dirty state when snapshot was taken */
+    int32_t base_index;         /* Index of table in base snapshot */
+    bool from_base;             /* Table data is stored in base snapshot */
 } ecs_table_leaf_t;
 
+/* Duplicate table data. If dirty_state and base_dirty_state are provided, only
+ * columns that changed since the base snapshot are copied. Columns that aren't
+ * stored by the source data are skipped. */
 static
 ecs_data_t* flecs_duplicate_data(
     ecs_world_t *world,
-    ecs_table_t *table,
-    ecs_data_t *main_data)
+    int32_t column_count,
+    ecs_data_t *main_data,
+    const int32_t *dirty_state,
+    const int32_t *base_dirty_state)
 {
-    int32_t count = ecs_table_count(table);
+    int32_t count = ecs_vec_count(&main_data->entities);
     if (!count) {
         return NULL;
     }
 
     ecs_data_t *result = ecs_os_calloc_t(ecs_data_t);
-    int32_t i, column_count = table->column_count;
+    int32_t i;
     result->columns = flecs_wdup_n(world, ecs_column_t, column_count,
         main_data->columns);
 
@@ -47,6 +61,13 @@ ecs_data_t* flecs_duplicate_data(
     /* Copy each column */
     for (i = 0; i < column_count; i ++) {
         ecs_column_t *column = &result->columns[i];
+        if (!ecs_vec_count(&column->data) || (base_dirty_state && 
+            (dirty_state[i + 1] == base_dirty_state[i + 1]))) 
+        {
+            ecs_os_zeromem(&column->data);
+            continue;
+        }
+
         ecs_type_info_t *ti = column->ti;
         ecs_assert(ti != NULL, ECS_INTERNAL_ERROR, NULL);
         int32_t size = ti->size;
@@ -70,25 +91,90 @@ ecs_data_t* flecs_duplicate_data(
     return result;
 }
 
+/* Find leaf in base snapshot that can be used as base for a delta leaf */
+static
+const ecs_table_leaf_t* flecs_snapshot_base_leaf(
+    const ecs_snapshot_t *base,
+    const ecs_table_t *table)
+{
+    int32_t index = (int32_t)table->id;
+    if (index >= ecs_vec_count(&base->tables)) {
+        return NULL;
+    }
+
+    const ecs_table_leaf_t *result = ecs_vec_get_t(
+        &base->tables, ecs_table_leaf_t, index);
+    if (result->table != table || result->table_id != table->id) {
+        return NULL; /* Table was recreated since base snapshot was taken */
+    }
+
+    if (!result->dirty_state || result->from_base) {
+        return NULL;
+    }
+
+    return result;
+}
+
 static
 void snapshot_table(
     const ecs_world_t *world,
     ecs_snapshot_t *snapshot,
-    ecs_table_t *table)
+    ecs_table_t *table,
+    bool track_changes)
 {
     if (table->flags & EcsTableHasBuiltins) {
         return;
     }
-    
+
+    ecs_world_t *w = ECS_CONST_CAST(ecs_world_t*, world);
     ecs_table_leaf_t *l = ecs_vec_get_t(
         &snapshot->tables, ecs_table_leaf_t, (int32_t)table->id);
     ecs_assert(l != NULL, ECS_INTERNAL_ERROR, NULL);
     
     l->table = table;
-    l->type = flecs_type_copy(
-        ECS_CONST_CAST(ecs_world_t*, world), &table->type);
-    l->data = flecs_duplicate_data(
-        ECS_CONST_CAST(ecs_world_t*, world), table, &table->data);
+    l->table_id = table->id;
+    l->column_count = table->column_count;
+    l->base_index = -1;
+    l->type = flecs_type_copy(w, &table->type);
+
+    if (!track_changes) {
+        l->data = flecs_duplicate_data(
+            w, l->column_count, &table->data, NULL, NULL);
+        return;
+    }
+
+    /* Store dirty state, so the snapshot can be used as base for deltas */
+    int32_t *dirty_state = flecs_table_get_dirty_state(w, table);
+    l->dirty_state = flecs_wdup_n(w, int32_t, table->column_count + 1, 
+        dirty_state);
+
+    const ecs_table_leaf_t *base = NULL;
+    if (snapshot->base) {
+        base = flecs_snapshot_base_leaf(snapshot->base, table);
+    }
+
+    if (!base || (base->dirty_state[0] != dirty_state[0])) {
+        /* No base or entities changed, store all table data */
+        l->data = flecs_duplicate_data(
+            w, l->column_count, &table->data, NULL, NULL);
+        return;
+    }
+
+    l->base_index = (int32_t)table->id;
+
+    int32_t i, column_count = table->column_count;
+    for (i = 0; i < column_count; i ++) {
+        if (base->dirty_state[i + 1] != dirty_state[i + 1]) {
+            break;
+        }
+    }
+
+    if (i == column_count) {
+        l->from_base = true;
+    } else {
+        l->data = flecs_duplicate_data(w, l->column_count, &table->data, 
+            dirty_state, base->dirty_state);
+    }
 }
 
 static
@@ -96,7 +182,8 @@ ecs_snapshot_t* snapshot_create(
     const ecs_world_t *world,
     const ecs_entity_index_t *entity_index,
     ecs_iter_t *iter,
-    ecs_iter_next_action_t next)
+    ecs_iter_next_action_t next,
+    const ecs_snapshot_t *base)
 {
     ecs_snapshot_t *result = ecs_os_calloc_t(ecs_snapshot_t);
     ecs_assert(result != NULL, ECS_OUT_OF_MEMORY, NULL);
@@ -104,6 +191,7 @@ ecs_snapshot_t* snapshot_create(
     ecs_run_aperiodic(ECS_CONST_CAST(ecs_world_t*, world), 0);
 
     result->world = ECS_CONST_CAST(ecs_world_t*, world);
+    result->base = base;
 
     /* If no iterator is provided, the snapshot will be taken of the entire
      * world, and we can simply copy the entity index as it will be restored
@@ -129,13 +217,15 @@ ecs_snapshot_t* snapshot_create(
     if (iter) {
         while (next(iter)) {
             ecs_table_t *table = iter->table;
-            snapshot_table(world, result, table);
+            snapshot_table(world, result, table, false);
         }
     } else {
         for (t = 1; t < table_count; t ++) {
-            ecs_table_t *table = flecs_sparse_get_t(
+            ecs_table_t *table = flecs_sparse_get_any_t(
                 &world->store.tables, ecs_table_t, t);
-            snapshot_table(world, result, table);
+            if (table) {
+                snapshot_table(world, result, table, true);
+            }
         }
     }
 
@@ -149,11 +239,34 @@ ecs_snapshot_t* ecs_snapshot_take(
     const ecs_world_t *world = ecs_get_world(stage);
 
     ecs_snapshot_t *result = snapshot_create(
-        world, ecs_eis(world), NULL, NULL);
+        world, ecs_eis(world), NULL, NULL, NULL);
+
+    result->last_id = flecs_entities_max_id(world);
+
+    return result;
+}
+
+/** Create a delta snapshot */
+ecs_snapshot_t* ecs_snapshot_take_delta(
+    ecs_world_t *stage,
+    const ecs_snapshot_t *base)
+{
+    const ecs_world_t *world = ecs_get_world(stage);
+    ecs_check(base != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(base->world == world, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(base->base == NULL, ECS_INVALID_PARAMETER, 
+        "base of delta snapshot cannot be a delta snapshot");
+    ecs_check(flecs_entity_index_count(&base->entity_index) > 0,
+        ECS_INVALID_PARAMETER, "base of delta snapshot cannot be filtered");
+
+    ecs_snapshot_t *result = snapshot_create(
+        world, ecs_eis(world), NULL, NULL, base);
 
     result->last_id = flecs_entities_max_id(world);
 
     return result;
+error:
+    return NULL;
 }
 
 /** Create a filtered snapshot */
@@ -164,94 +277,326 @@ ecs_snapshot_t* ecs_snapshot_take_w_iter(
     ecs_assert(world != NULL, ECS_INTERNAL_ERROR, NULL);
 
     ecs_snapshot_t *result = snapshot_create(
-        world, ecs_eis(world), iter, iter ? iter->next : NULL);
+        world, ecs_eis(world), iter, iter ? iter->next : NULL, NULL);
 
     result->last_id = flecs_entities_max_id(world);
 
     return result;
 }
 
+/* Get base leaf of delta snapshot table, or NULL if the table has no base */
+static
+const ecs_table_leaf_t* flecs_snapshot_leaf_base(
+    const ecs_snapshot_t *snapshot,
+    const ecs_table_leaf_t *leaf)
+{
+    if (leaf->base_index == -1) {
+        return NULL;
+    }
+
+    const ecs_snapshot_t *base = snapshot->base;
+    ecs_assert(base != NULL, ECS_INTERNAL_ERROR, NULL);
+    const ecs_table_leaf_t *result = ecs_vec_get_t(
+        &base->tables, ecs_table_leaf_t, leaf->base_index);
+    ecs_assert(result->column_count == leaf->column_count, 
+        ECS_INVALID_OPERATION, "base snapshot does not match delta snapshot");
+    return result;
+}
+
+/* Get data to restore for snapshot table. If the snapshot is kept, this
+ * returns a copy of the snapshot data. For delta snapshots, data that didn't
+ * change since the base snapshot is copied from the base. */
+static
+ecs_data_t* flecs_snapshot_leaf_data(
+    ecs_world_t *world,
+    const ecs_snapshot_t *snapshot,
+    ecs_table_leaf_t *leaf,
+    bool keep)
+{
+    ecs_data_t *data = leaf->data;
+    const ecs_table_leaf_t *base_leaf = flecs_snapshot_leaf_base(
+        snapshot, leaf);
+
+    if (leaf->from_base) {
+        if (!base_leaf->data) {
+            return NULL;
+        }
+        return flecs_duplicate_data(
+            world, leaf->column_count, base_leaf->data, NULL, NULL);
+    }
+
+    if (!data) {
+        return NULL;
+    }
+
+    if (keep) {
+        data = flecs_duplicate_data(
+            world, leaf->column_count, data, NULL, NULL);
+    }
+
+    if (base_leaf) {
+        /* Copy columns that didn't change since base snapshot */
+        int32_t i, column_count = leaf->column_count;
+        for (i = 0; i < column_count; i ++) {
+            ecs_column_t *column = &data->columns[i];
+            if (ecs_vec_count(&column->data)) {
+                continue;
+            }
+
+            ecs_assert(base_leaf->data != NULL, ECS_INTERNAL_ERROR, NULL);
+            ecs_column_t *src = &base_leaf->data->columns[i];
+            ecs_type_info_t *ti = column->ti;
+            int32_t size = ti->size, count = ecs_vec_count(&src->data);
+            ecs_allocator_t *a = &world->allocator;
+            ecs_copy_t copy = ti->hooks.copy_ctor;
+            if (copy) {
+                ecs_vec_init(a, &column->data, size, count);
+                ecs_vec_set_count(a, &column->data, size, count);
+                copy(ecs_vec_first(&column->data), ecs_vec_first(&src->data),
+                    count, ti);
+            } else {
+                column->data = ecs_vec_copy_shrink(a, &src->data, size);
+            }
+        }
+    }
+
+    return data;
+}
+
+/* Copy data of snapshot table into the existing storage of a world table. This
+ * is used when the snapshot is kept, so that rolling back doesn't allocate new
+ * storage for every table. Columns that didn't change since the base snapshot
+ * are copied from the base. */
+static
+void flecs_snapshot_leaf_copy(
+    ecs_world_t *world,
+    const ecs_snapshot_t *snapshot,
+    const ecs_table_leaf_t *leaf,
+    ecs_table_t *table)
+{
+    const ecs_table_leaf_t *base_leaf = flecs_snapshot_leaf_base(
+        snapshot, leaf);
+    const ecs_data_t *base_data = base_leaf ? base_leaf->data : NULL;
+    const ecs_data_t *data = leaf->from_base ? base_data : leaf->data;
+    if (!data) {
+        flecs_table_copy_data(world, table, NULL, NULL);
+        return;
+    }
+
+    int32_t i, column_count = leaf->column_count;
+    const ecs_vec_t **columns = NULL;
+    if (column_count) {
+        columns = flecs_walloc_n(world, const ecs_vec_t*, column_count);
+    }
+
+    for (i = 0; i < column_count; i ++) {
+        const ecs_vec_t *column = &data->columns[i].data;
+        if (!ecs_vec_count(column)) {
+            ecs_assert(base_data != NULL, ECS_INTERNAL_ERROR, NULL);
+            column = &base_data->columns[i].data;
+        }
+        columns[i] = column;
+    }
+
+    flecs_table_copy_data(world, table, &data->entities, columns);
+
+    if (columns) {
+        flecs_wfree_n(world, const ecs_vec_t*, column_count, columns);
+    }
+}
+
+/* Free data of a snapshot table. Delta data may not store all columns, and
+ * snapshot data isn't owned by the table, so this doesn't use the regular
+ * table cleanup functions. */
+static
+void flecs_snapshot_leaf_fini(
+    ecs_world_t *world,
+    ecs_table_leaf_t *leaf)
+{
+    ecs_data_t *data = leaf->data;
+    int32_t i, column_count = leaf->column_count;
+
+    if (data) {
+        ecs_allocator_t *a = &world->allocator;
+        for (i = 0; i < column_count; i ++) {
+            ecs_column_t *column = &data->columns[i];
+            int32_t count = ecs_vec_count(&column->data);
+            ecs_type_info_t *ti = column->ti;
+            if (count && ti->hooks.dtor) {
+                ti->hooks.dtor(ecs_vec_first(&column->data), count, ti);
+            }
+            ecs_vec_fini(a, &column->data, ti->size);
+        }
+        flecs_wfree_n(world, ecs_column_t, column_count, data->columns);
+        ecs_vec_fini_t(a, &data->entities, ecs_entity_t);
+        ecs_os_free(data);
+        leaf->data = NULL;
+    }
+
+    if (leaf->dirty_state) {
+        flecs_wfree_n(world, int32_t, column_count + 1, leaf->dirty_state);
+    }
+    flecs_type_free(world, &leaf->type);
+}
+
+/* Get world table of snapshot table. Tables can be deleted after a snapshot is
+ * taken, and their ids can be reused by tables with a different type, so the
+ * table is only used if it is alive with the same id and generation. If not,
+ * the table is looked up or recreated by type. */
+static
+ecs_table_t* flecs_snapshot_leaf_table(
+    ecs_world_t *world,
+    ecs_table_leaf_t *leaf)
+{
+    ecs_table_t *table = flecs_sparse_try_t(
+        &world->store.tables, ecs_table_t, leaf->table_id);
+    if (!table) {
+        table = flecs_table_find_or_create(world, &leaf->type);
+        ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+        leaf->table = table;
+        leaf->table_id = table->id;
+    }
+
+    ecs_assert(leaf->table == table, ECS_INTERNAL_ERROR, NULL);
+    return table;
+}
+
+/* Get entities stored for snapshot table */
+static
+const ecs_vec_t* flecs_snapshot_leaf_entities(
+    const ecs_snapshot_t *snapshot,
+    const ecs_table_leaf_t *leaf)
+{
+    const ecs_data_t *data = leaf->data;
+    if (leaf->from_base) {
+        data = ecs_vec_get_t(&snapshot->base->tables, ecs_table_leaf_t, 
+            leaf->base_index)->data;
+    }
+
+    if (!data) {
+        return NULL;
+    }
+
+    return &data->entities;
+}
+
 /* Restoring an unfiltered snapshot restores the world to the exact state it was
  * when the snapshot was taken. */
 static
 void restore_unfiltered(
     ecs_world_t *world,
-    ecs_snapshot_t *snapshot)
+    ecs_snapshot_t *snapshot,
+    bool keep)
 {
     flecs_entity_index_restore(ecs_eis(world), &snapshot->entity_index);
-    flecs_entity_index_fini(&snapshot->entity_index);
+    if (!keep) {
+        flecs_entity_index_fini(&snapshot->entity_index);
+    }
     
     flecs_entities_max_id(world) = snapshot->last_id;
 
     ecs_table_leaf_t *leafs = ecs_vec_first_t(&snapshot->tables, ecs_table_leaf_t);
-    int32_t i, count = (int32_t)flecs_sparse_last_id(&world->store.tables);
-    int32_t snapshot_count = ecs_vec_count(&snapshot->tables);
-
-    for (i = 1; i <= count; i ++) {
-        ecs_table_t *world_table = flecs_sparse_get_t(
-            &world->store.tables, ecs_table_t, (uint32_t)i);
-
-        if (world_table && (world_table->flags & EcsTableHasBuiltins)) {
+    int32_t i, snapshot_count = ecs_vec_count(&snapshot->tables);
+
+    /* Find world tables of snapshot tables, recreate tables that were deleted.
+     * The restored entity index points to the tables that existed when the
+     * snapshot was taken, so update records before deleting any tables. */
+    ecs_map_t restored; /* map<table id, 0> */
+    ecs_map_init(&restored, NULL);
+    for (i = 1; i < snapshot_count; i ++) {
+        ecs_table_leaf_t *leaf = &leafs[i];
+        if (!leaf->table) {
             continue;
         }
 
-        ecs_table_leaf_t *snapshot_table = NULL;
-        if (i < snapshot_count) {
-            snapshot_table = &leafs[i];
-            if (!snapshot_table->table) {
-                snapshot_table = NULL;
+        ecs_table_t *table = flecs_snapshot_leaf_table(world, leaf);
+        ecs_map_insert(&restored, table->id, 0);
+
+        const ecs_vec_t *entities = flecs_snapshot_leaf_entities(
+            snapshot, leaf);
+        if (entities) {
+            int32_t e, count = ecs_vec_count(entities);
+            const ecs_entity_t *ids = ecs_vec_first(entities);
+            for (e = 0; e < count; e ++) {
+                ecs_record_t *r = flecs_entities_get(world, ids[e]);
+                ecs_assert(r != NULL, ECS_INTERNAL_ERROR, NULL);
+                r->table = table;
             }
         }
+    }
+
+    /* Tables that aren't in the snapshot were created after the snapshot was
+     * taken and need to be deleted. Deleting a table invokes OnRemove triggers
+     * & updates the entity index. That is not what we want, since entities may
+     * no longer be valid (if they don't exist in the snapshot) or may have been
+     * restored in a different table. Therefore first clear the data from the
+     * table (which doesn't invoke triggers), and then delete the table. */
+    ecs_vec_t deleted;
+    ecs_vec_init_t(NULL, &deleted, ecs_table_t*, 0);
+    int32_t world_count = flecs_sparse_count(&world->store.tables);
+    for (i = 0; i < world_count; i ++) {
+        ecs_table_t *table = flecs_sparse_get_dense_t(
+            &world->store.tables, ecs_table_t, i);
+        /* Table with id 0 is a placeholder that reserves the root table id */
+        if (!table->id || (table->flags & EcsTableHasBuiltins)) {
+            continue;
+        }
+        if (!ecs_map_get(&restored, table->id)) {
+            ecs_vec_append_t(NULL, &deleted, ecs_table_t*)[0] = table;
+        }
+    }
 
-        /* If the world table no longer exists but the snapshot table does,
-         * reinsert it */
-        if (!world_table && snapshot_table) {
-            ecs_table_t *table = flecs_table_find_or_create(world, 
-                &snapshot_table->type);
-            ecs_assert(table != NULL, ECS_INTERNAL_ERROR, NULL);
+    int32_t deleted_count = ecs_vec_count(&deleted);
+    ecs_table_t **deleted_tables = ecs_vec_first(&deleted);
+    for (i = 0; i < deleted_count; i ++) {
+        ecs_table_t *table = deleted_tables[i];
+        flecs_table_clear_data(world, table, &table->data);
+        flecs_delete_table(world, table);
+    }
 
-            if (snapshot_table->data) {
-                flecs_table_replace_data(world, table, snapshot_table->data);
-            }
+    ecs_vec_fini_t(NULL, &deleted, ecs_table_t*);
+    ecs_map_fini(&restored);
 
-        /* If the world table still exists, replace its data */
-        } else if (world_table && snapshot_table) {
-            ecs_assert(snapshot_table->table == world_table, 
-                ECS_INTERNAL_ERROR, NULL);
+    /* Replace data of tables with snapshot data */
+    for (i = 1; i < snapshot_count; i ++) {
+        ecs_table_leaf_t *leaf = &leafs[i];
+        ecs_table_t *table = leaf->table;
+        if (!table) {
+            continue;
+        }
 
-            if (snapshot_table->data) {
-                flecs_table_replace_data(
-                    world, world_table, snapshot_table->data);
-            } else {
-                flecs_table_clear_data(
-                    world, world_table, &world_table->data);
-                flecs_table_init_data(world, world_table);
-            }
-        
-        /* If the snapshot table doesn't exist, this table was created after the
-         * snapshot was taken and needs to be deleted */
-        } else if (world_table && !snapshot_table) {
-            /* Deleting a table invokes OnRemove triggers & updates the entity
-             * index. That is not what we want, since entities may no longer be
-             * valid (if they don't exist in the snapshot) or may have been
-             * restored in a different table. Therefore first clear the data
-             * from the table (which doesn't invoke triggers), and then delete
-             * the table. */
-            flecs_table_clear_data(world, world_table, &world_table->data);
-            flecs_delete_table(world, world_table);
-        
-        /* If there is no world & snapshot table, nothing needs to be done */
-        } else { }
+        /* Union and bitset columns aren't stored by snapshots, so tables with
+         * those columns can't be copied into */
+        if (keep && !table->_->sw_count && !table->_->bs_count) {
+            flecs_snapshot_leaf_copy(world, snapshot, leaf, table);
+            continue;
+        }
 
-        if (snapshot_table) {
-            ecs_os_free(snapshot_table->data);
-            flecs_type_free(world, &snapshot_table->type);
+        ecs_data_t *data = flecs_snapshot_leaf_data(world, snapshot, leaf, keep);
+        if (data) {
+            flecs_table_replace_data(world, table, data);
+        } else {
+            flecs_table_clear_data(world, table, &table->data);
+            flecs_table_init_data(world, table);
+        }
+
+        if (data != leaf->data) {
+            ecs_os_free(data);
+        }
+        if (!keep) {
+            ecs_os_free(leaf->data);
+            leaf->data = NULL;
+            if (leaf->dirty_state) {
+                flecs_wfree_n(world, int32_t, leaf->column_count + 1, 
+                    leaf->dirty_state);
+            }
+            flecs_type_free(world, &leaf->type);
         }
     }
 
     /* Now that all tables have been restored and world is in a consistent
      * state, run OnSet systems */
-    int32_t world_count = flecs_sparse_count(&world->store.tables);
+    world_count = flecs_sparse_count(&world->store.tables);
     for (i = 0; i < world_count; i ++) {
         ecs_table_t *table = flecs_sparse_get_dense_t(
             &world->store.tables, ecs_table_t, i);
@@ -278,30 +623,38 @@ void restore_unfiltered(
 static
 void restore_filtered(
     ecs_world_t *world,
-    ecs_snapshot_t *snapshot)
+    ecs_snapshot_t *snapshot,
+    bool keep)
 {
     ecs_table_leaf_t *leafs = ecs_vec_first_t(&snapshot->tables, ecs_table_leaf_t);
     int32_t l = 0, snapshot_count = ecs_vec_count(&snapshot->tables);
 
     for (l = 0; l < snapshot_count; l ++) {
         ecs_table_leaf_t *snapshot_table = &leafs[l];
-        ecs_table_t *table = snapshot_table->table;
-
-        if (!table) {
+        if (!snapshot_table->table) {
             continue;
         }
 
         ecs_data_t *data = snapshot_table->data;
         if (!data) {
-            flecs_type_free(world, &snapshot_table->type);
+            if (!keep) {
+                flecs_type_free(world, &snapshot_table->type);
+            }
             continue;
         }
 
+        ecs_table_t *table = flecs_snapshot_leaf_table(world, snapshot_table);
+
+        /* If the snapshot is kept, merge a copy of its data */
+        if (keep) {
+            data = flecs_duplicate_data(
+                world, snapshot_table->column_count, data, NULL, NULL);
+        }
+
         /* Delete entity from storage first, so that when we restore it to the
          * current table we can be sure that there won't be any duplicates */
         int32_t i, entity_count = ecs_vec_count(&data->entities);
-        ecs_entity_t *entities = ecs_vec_first(
-            &snapshot_table->data->entities);
+        ecs_entity_t *entities = ecs_vec_first(&data->entities);
         for (i = 0; i < entity_count; i ++) {
             ecs_entity_t e = entities[i];
             ecs_record_t *r = flecs_entities_try(world, e);
@@ -315,10 +668,10 @@ void restore_filtered(
         }
 
         /* Merge data from snapshot table with world table */
-        int32_t old_count = ecs_table_count(snapshot_table->table);
-        int32_t new_count = flecs_table_data_count(snapshot_table->data);
+        int32_t old_count = ecs_table_count(table);
+        int32_t new_count = flecs_table_data_count(data);
 
-        flecs_table_merge(world, table, table, &table->data, snapshot_table->data);
+        flecs_table_merge(world, table, table, &table->data, data);
 
         /* Run OnSet systems for merged entities */
         if (new_count) {
@@ -333,10 +686,11 @@ void restore_filtered(
             }
         }
 
-        flecs_wfree_n(world, ecs_column_t, table->column_count,
-            snapshot_table->data->columns);
-        ecs_os_free(snapshot_table->data);
-        flecs_type_free(world, &snapshot_table->type);
+        flecs_wfree_n(world, ecs_column_t, table->column_count, data->columns);
+        ecs_os_free(data);
+        if (!keep) {
+            flecs_type_free(world, &snapshot_table->type);
+        }
     }
 }
 
@@ -350,9 +704,9 @@ void ecs_snapshot_restore(
     if (flecs_entity_index_count(&snapshot->entity_index) > 0) {
         /* Unfiltered snapshots have a copy of the entity index which is
          * copied back entirely when the snapshot is restored */
-        restore_unfiltered(world, snapshot);
+        restore_unfiltered(world, snapshot, false);
     } else {
-        restore_filtered(world, snapshot);
+        restore_filtered(world, snapshot, false);
     }
 
     ecs_vec_fini_t(NULL, &snapshot->tables, ecs_table_leaf_t);
@@ -360,11 +714,26 @@ void ecs_snapshot_restore(
     ecs_os_free(snapshot);
 }
 
+/** Roll back to a snapshot without consuming it */
+void ecs_snapshot_rollback(
+    ecs_world_t *world,
+    ecs_snapshot_t *snapshot)
+{
+    ecs_run_aperiodic(world, 0);
+
+    if (flecs_entity_index_count(&snapshot->entity_index) > 0) {
+        restore_unfiltered(world, snapshot, true);
+    } else {
+        restore_filtered(world, snapshot, true);
+    }
+}
+
 ecs_iter_t ecs_snapshot_iter(
     ecs_snapshot_t *snapshot)
 {
     ecs_snapshot_iter_t iter = {
         .tables = snapshot->tables,
+        .base = snapshot->base,
         .index = 0
     };
 
@@ -385,18 +754,25 @@ bool ecs_snapshot_next(
     int32_t i;
 
     for (i = iter->index; i < count; i ++) {
-        ecs_table_t *table = tables[i].table;
-        if (!table) {
+        if (!tables[i].table) {
             continue;
         }
 
+        ecs_table_t *table = flecs_snapshot_leaf_table(it->world, &tables[i]);
+
         ecs_data_t *data = tables[i].data;
+        if (tables[i].from_base) {
+            const ecs_snapshot_t *base = it->priv.iter.snapshot.base;
+            data = ecs_vec_get_t(&base->tables, ecs_table_leaf_t, 
+                tables[i].base_index)->data;
+        }
 
         it->table = table;
-        it->count = ecs_table_count(table);
         if (data) {
+            it->count = ecs_vec_count(&data->entities);
             it->entities = ecs_vec_first(&data->entities);
         } else {
+            it->count = 0;
             it->entities = NULL;
         }
 
@@ -424,16 +800,10 @@ void ecs_snapshot_free(
     int32_t i, count = ecs_vec_count(&snapshot->tables);
     for (i = 0; i < count; i ++) {
         ecs_table_leaf_t *snapshot_table = &tables[i];
-        ecs_table_t *table = snapshot_table->table;
-        if (table) {
-            ecs_data_t *data = snapshot_table->data;
-            if (data) {
-                flecs_table_clear_data(snapshot->world, table, data);
-                ecs_os_free(data);
-            }
-            flecs_type_free(snapshot->world, &snapshot_table->type);
+        if (snapshot_table->table) {
+            flecs_snapshot_leaf_fini(snapshot->world, snapshot_table);
         }
-    }    
+    }
 
     ecs_vec_fini_t(NULL, &snapshot->tables, ecs_table_leaf_t);
     ecs_os_free(snapshot);
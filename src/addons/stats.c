@@ -251,25 +251,29 @@ void ecs_world_stats_get(
 
     world = ecs_get_world(world);
 
+    /* Add up counters of stages without modifying the world */
+    ecs_world_info_t info = world->info;
+    flecs_stage_counters_get(world, &info);
+
     int32_t t = s->t = t_next(s->t);
 
     double delta_frame_count = 
-    ECS_COUNTER_RECORD(&s->frame.frame_count, t, world->info.frame_count_total);
-    ECS_COUNTER_RECORD(&s->frame.merge_count, t, world->info.merge_count_total);
-    ECS_COUNTER_RECORD(&s->frame.rematch_count, t, world->info.rematch_count_total);
-    ECS_COUNTER_RECORD(&s->frame.pipeline_build_count, t, world->info.pipeline_build_count_total);
-    ECS_COUNTER_RECORD(&s->frame.systems_ran, t, world->info.systems_ran_frame);
-    ECS_COUNTER_RECORD(&s->frame.observers_ran, t, world->info.observers_ran_frame);
+    ECS_COUNTER_RECORD(&s->frame.frame_count, t, info.frame_count_total);
+    ECS_COUNTER_RECORD(&s->frame.merge_count, t, info.merge_count_total);
+    ECS_COUNTER_RECORD(&s->frame.rematch_count, t, info.rematch_count_total);
+    ECS_COUNTER_RECORD(&s->frame.pipeline_build_count, t, info.pipeline_build_count_total);
+    ECS_COUNTER_RECORD(&s->frame.systems_ran, t, info.systems_ran_frame);
+    ECS_COUNTER_RECORD(&s->frame.observers_ran, t, info.observers_ran_frame);
     ECS_COUNTER_RECORD(&s->frame.event_emit_count, t, world->event_id);
 
     double delta_world_time = 
-    ECS_COUNTER_RECORD(&s->performance.world_time_raw, t, world->info.world_time_total_raw);
-    ECS_COUNTER_RECORD(&s->performance.world_time, t, world->info.world_time_total);
-    ECS_COUNTER_RECORD(&s->performance.frame_time, t, world->info.frame_time_total);
-    ECS_COUNTER_RECORD(&s->performance.system_time, t, world->info.system_time_total);
-    ECS_COUNTER_RECORD(&s->performance.emit_time, t, world->info.emit_time_total);
-    ECS_COUNTER_RECORD(&s->performance.merge_time, t, world->info.merge_time_total);
-    ECS_COUNTER_RECORD(&s->performance.rematch_time, t, world->info.rematch_time_total);
+    ECS_COUNTER_RECORD(&s->performance.world_time_raw, t, info.world_time_total_raw);
+    ECS_COUNTER_RECORD(&s->performance.world_time, t, info.world_time_total);
+    ECS_COUNTER_RECORD(&s->performance.frame_time, t, info.frame_time_total);
+    ECS_COUNTER_RECORD(&s->performance.system_time, t, info.system_time_total);
+    ECS_COUNTER_RECORD(&s->performance.emit_time, t, info.emit_time_total);
+    ECS_COUNTER_RECORD(&s->performance.merge_time, t, info.merge_time_total);
+    ECS_COUNTER_RECORD(&s->performance.rematch_time, t, info.rematch_time_total);
     ECS_GAUGE_RECORD(&s->performance.delta_time, t, delta_world_time);
     if (ECS_NEQZERO(delta_world_time) && ECS_NEQZERO(delta_frame_count)) {
         ECS_GAUGE_RECORD(&s->performance.fps, t, (double)1 / (delta_world_time / (double)delta_frame_count));
@@ -280,34 +284,34 @@ void ecs_world_stats_get(
     ECS_GAUGE_RECORD(&s->entities.count, t, flecs_entities_count(world));
     ECS_GAUGE_RECORD(&s->entities.not_alive_count, t, flecs_entities_not_alive_count(world));
 
-    ECS_GAUGE_RECORD(&s->components.tag_count, t, world->info.tag_id_count);
-    ECS_GAUGE_RECORD(&s->components.component_count, t, world->info.component_id_count);
-    ECS_GAUGE_RECORD(&s->components.pair_count, t, world->info.pair_id_count);
+    ECS_GAUGE_RECORD(&s->components.tag_count, t, info.tag_id_count);
+    ECS_GAUGE_RECORD(&s->components.component_count, t, info.component_id_count);
+    ECS_GAUGE_RECORD(&s->components.pair_count, t, info.pair_id_count);
     ECS_GAUGE_RECORD(&s->components.type_count, t, ecs_sparse_count(&world->type_info));
-    ECS_COUNTER_RECORD(&s->components.create_count, t, world->info.id_create_total);
-    ECS_COUNTER_RECORD(&s->components.delete_count, t, world->info.id_delete_total);
+    ECS_COUNTER_RECORD(&s->components.create_count, t, info.id_create_total);
+    ECS_COUNTER_RECORD(&s->components.delete_count, t, info.id_delete_total);
 
     ECS_GAUGE_RECORD(&s->queries.query_count, t, ecs_count_id(world, EcsQuery));
     ECS_GAUGE_RECORD(&s->queries.observer_count, t, ecs_count_id(world, EcsObserver));
     if (ecs_is_alive(world, EcsSystem)) {
         ECS_GAUGE_RECORD(&s->queries.system_count, t, ecs_count_id(world, EcsSystem));
     }
-    ECS_COUNTER_RECORD(&s->tables.create_count, t, world->info.table_create_total);
-    ECS_COUNTER_RECORD(&s->tables.delete_count, t, world->info.table_delete_total);
-    ECS_GAUGE_RECORD(&s->tables.count, t, world->info.table_count);
-    ECS_GAUGE_RECORD(&s->tables.empty_count, t, world->info.empty_table_count);
-
-    ECS_COUNTER_RECORD(&s->commands.add_count, t, world->info.cmd.add_count);
-    ECS_COUNTER_RECORD(&s->commands.remove_count, t, world->info.cmd.remove_count);
-    ECS_COUNTER_RECORD(&s->commands.delete_count, t, world->info.cmd.delete_count);
-    ECS_COUNTER_RECORD(&s->commands.clear_count, t, world->info.cmd.clear_count);
-    ECS_COUNTER_RECORD(&s->commands.set_count, t, world->info.cmd.set_count);
-    ECS_COUNTER_RECORD(&s->commands.ensure_count, t, world->info.cmd.ensure_count);
-    ECS_COUNTER_RECORD(&s->commands.modified_count, t, world->info.cmd.modified_count);
-    ECS_COUNTER_RECORD(&s->commands.other_count, t, world->info.cmd.other_count);
-    ECS_COUNTER_RECORD(&s->commands.discard_count, t, world->info.cmd.discard_count);
-    ECS_COUNTER_RECORD(&s->commands.batched_entity_count, t, world->info.cmd.batched_entity_count);
-    ECS_COUNTER_RECORD(&s->commands.batched_count, t, world->info.cmd.batched_command_count);
+    ECS_COUNTER_RECORD(&s->tables.create_count, t, info.table_create_total);
+    ECS_COUNTER_RECORD(&s->tables.delete_count, t, info.table_delete_total);
+    ECS_GAUGE_RECORD(&s->tables.count, t, info.table_count);
+    ECS_GAUGE_RECORD(&s->tables.empty_count, t, info.empty_table_count);
+
+    ECS_COUNTER_RECORD(&s->commands.add_count, t, info.cmd.add_count);
+    ECS_COUNTER_RECORD(&s->commands.remove_count, t, info.cmd.remove_count);
+    ECS_COUNTER_RECORD(&s->commands.delete_count, t, info.cmd.delete_count);
+    ECS_COUNTER_RECORD(&s->commands.clear_count, t, info.cmd.clear_count);
+    ECS_COUNTER_RECORD(&s->commands.set_count, t, info.cmd.set_count);
+    ECS_COUNTER_RECORD(&s->commands.ensure_count, t, info.cmd.ensure_count);
+    ECS_COUNTER_RECORD(&s->commands.modified_count, t, info.cmd.modified_count);
+    ECS_COUNTER_RECORD(&s->commands.other_count, t, info.cmd.other_count);
+    ECS_COUNTER_RECORD(&s->commands.discard_count, t, info.cmd.discard_count);
+    ECS_COUNTER_RECORD(&s->commands.batched_entity_count, t, info.cmd.batched_entity_count);
+    ECS_COUNTER_RECORD(&s->commands.batched_count, t, info.cmd.batched_command_count);
 
     int64_t outstanding_allocs = ecs_os_api_malloc_count + 
         ecs_os_api_calloc_count - ecs_os_api_free_count;
@@ -511,6 +515,176 @@ void ecs_system_stats_copy_last(
 
 #ifdef FLECS_PIPELINE
 
+/* Resize vector with per-stage statistics to number of elements in src */
+static
+void* flecs_stage_stats_ensure(
+    ecs_vec_t *dst,
+    const ecs_vec_t *src,
+    ecs_size_t size)
+{
+    int32_t count = ecs_vec_count(src);
+    ecs_vec_init_if(dst, size);
+    ecs_vec_set_min_count_zeromem(NULL, dst, size, count);
+    ecs_vec_set_count(NULL, dst, size, count);
+    return ecs_vec_first(dst);
+}
+
+static
+void flecs_pipeline_stage_stats_get(
+    const ecs_world_t *world,
+    ecs_pipeline_stats_t *s)
+{
+    int32_t i, count = world->stage_count;
+    ecs_vec_init_if_t(&s->stages, ecs_stage_stats_t);
+    ecs_vec_set_min_count_zeromem_t(NULL, &s->stages, ecs_stage_stats_t, count);
+    ecs_vec_set_count_t(NULL, &s->stages, ecs_stage_stats_t, count);
+    ecs_stage_stats_t *stages = ecs_vec_first_t(&s->stages, ecs_stage_stats_t);
+
+    for (i = 0; i < count; i ++) {
+        const ecs_stage_counters_t *counters = &world->stages[i].counters;
+        ECS_COUNTER_RECORD(&stages[i].time_spent, s->t, counters->system_time);
+        ECS_COUNTER_RECORD(&stages[i].wait_time, s->t, counters->wait_time);
+        ECS_COUNTER_RECORD(&stages[i].merge_time, s->t, counters->merge_time);
+    }
+}
+
+static
+void flecs_system_stage_stats_get(
+    const ecs_world_t *world,
+    ecs_entity_t system,
+    ecs_system_stats_t *s)
+{
+    int32_t i, count = world->stage_count;
+    ecs_vec_init_if_t(&s->stage_time_spent, ecs_metric_t);
+    ecs_vec_set_min_count_zeromem_t(NULL, &s->stage_time_spent, ecs_metric_t, count);
+    ecs_vec_set_count_t(NULL, &s->stage_time_spent, ecs_metric_t, count);
+    ecs_metric_t *metrics = ecs_vec_first_t(&s->stage_time_spent, ecs_metric_t);
+
+    for (i = 0; i < count; i ++) {
+        double *time_spent = ecs_map_get_deref(
+            &world->stages[i].system_time, double, system);
+        ECS_COUNTER_RECORD(&metrics[i], s->query.t, 
+            time_spent ? time_spent[0] : 0);
+    }
+}
+
+static
+void flecs_stage_stats_reduce(
+    ecs_pipeline_stats_t *dst,
+    const ecs_pipeline_stats_t *src)
+{
+    ecs_stage_stats_t *dst_stages = flecs_stage_stats_ensure(
+        &dst->stages, &src->stages, ECS_SIZEOF(ecs_stage_stats_t));
+    ecs_stage_stats_t *src_stages = ecs_vec_first(&src->stages);
+    int32_t i, count = ecs_vec_count(&src->stages);
+    for (i = 0; i < count; i ++) {
+        flecs_stats_reduce(ECS_METRIC_FIRST((&dst_stages[i])), 
+            ECS_METRIC_LAST((&dst_stages[i])), 
+            ECS_METRIC_FIRST((&src_stages[i])), dst->t, src->t);
+    }
+}
+
+static
+void flecs_system_stage_stats_reduce(
+    ecs_system_stats_t *dst,
+    const ecs_system_stats_t *src)
+{
+    int32_t count = ecs_vec_count(&src->stage_time_spent);
+    if (count) {
+        ecs_metric_t *metrics = flecs_stage_stats_ensure(&dst->stage_time_spent,
+            &src->stage_time_spent, ECS_SIZEOF(ecs_metric_t));
+        flecs_stats_reduce(metrics, &metrics[count - 1], 
+            ecs_vec_first(&src->stage_time_spent), dst->query.t, src->query.t);
+    }
+}
+
+static
+void flecs_stage_stats_reduce_last(
+    ecs_pipeline_stats_t *dst,
+    const ecs_pipeline_stats_t *src,
+    int32_t count)
+{
+    ecs_stage_stats_t *dst_stages = flecs_stage_stats_ensure(
+        &dst->stages, &src->stages, ECS_SIZEOF(ecs_stage_stats_t));
+    ecs_stage_stats_t *src_stages = ecs_vec_first(&src->stages);
+    int32_t i, stage_count = ecs_vec_count(&src->stages);
+    for (i = 0; i < stage_count; i ++) {
+        flecs_stats_reduce_last(ECS_METRIC_FIRST((&dst_stages[i])), 
+            ECS_METRIC_LAST((&dst_stages[i])), 
+            ECS_METRIC_FIRST((&src_stages[i])), dst->t, src->t, count);
+    }
+}
+
+static
+void flecs_system_stage_stats_reduce_last(
+    ecs_system_stats_t *dst,
+    const ecs_system_stats_t *src,
+    int32_t count)
+{
+    int32_t stage_count = ecs_vec_count(&src->stage_time_spent);
+    if (stage_count) {
+        ecs_metric_t *metrics = flecs_stage_stats_ensure(&dst->stage_time_spent,
+            &src->stage_time_spent, ECS_SIZEOF(ecs_metric_t));
+        flecs_stats_reduce_last(metrics, &metrics[stage_count - 1], 
+            ecs_vec_first(&src->stage_time_spent), dst->query.t, src->query.t,
+            count);
+    }
+}
+
+static
+void flecs_stage_stats_repeat_last(
+    ecs_pipeline_stats_t *stats)
+{
+    ecs_stage_stats_t *stages = ecs_vec_first(&stats->stages);
+    int32_t i, count = ecs_vec_count(&stats->stages);
+    for (i = 0; i < count; i ++) {
+        flecs_stats_repeat_last(ECS_METRIC_FIRST((&stages[i])), 
+            ECS_METRIC_LAST((&stages[i])), stats->t);
+    }
+}
+
+static
+void flecs_system_stage_stats_repeat_last(
+    ecs_system_stats_t *stats)
+{
+    int32_t count = ecs_vec_count(&stats->stage_time_spent);
+    if (count) {
+        ecs_metric_t *metrics = ecs_vec_first(&stats->stage_time_spent);
+        flecs_stats_repeat_last(metrics, &metrics[count - 1], stats->query.t);
+    }
+}
+
+static
+void flecs_stage_stats_copy_last(
+    ecs_pipeline_stats_t *dst,
+    const ecs_pipeline_stats_t *src)
+{
+    ecs_stage_stats_t *dst_stages = flecs_stage_stats_ensure(
+        &dst->stages, &src->stages, ECS_SIZEOF(ecs_stage_stats_t));
+    ecs_stage_stats_t *src_stages = ecs_vec_first(&src->stages);
+    int32_t i, count = ecs_vec_count(&src->stages);
+    for (i = 0; i < count; i ++) {
+        flecs_stats_copy_last(ECS_METRIC_FIRST((&dst_stages[i])), 
+            ECS_METRIC_LAST((&dst_stages[i])), 
+            ECS_METRIC_FIRST((&src_stages[i])), dst->t, t_next(src->t));
+    }
+}
+
+static
+void flecs_system_stage_stats_copy_last(
+    ecs_system_stats_t *dst,
+    const ecs_system_stats_t *src)
+{
+    int32_t count = ecs_vec_count(&src->stage_time_spent);
+    if (count) {
+        ecs_metric_t *metrics = flecs_stage_stats_ensure(&dst->stage_time_spent,
+            &src->stage_time_spent, ECS_SIZEOF(ecs_metric_t));
+        flecs_stats_copy_last(metrics, &metrics[count - 1], 
+            ecs_vec_first(&src->stage_time_spent), dst->query.t, 
+            t_next(src->query.t));
+    }
+}
+
 bool ecs_pipeline_stats_get(
     ecs_world_t *stage,
     ecs_entity_t pipeline,
@@ -618,6 +792,7 @@ bool ecs_pipeline_stats_get(
 
     /* Separately populate system stats map from build query, which includes
      * systems that aren't currently active */
+    bool measure_stage_time = world->flags & EcsWorldMeasureStageTime;
     it = ecs_query_iter(stage, pq->query);
     while (ecs_query_next(&it)) {
         int32_t i;
@@ -626,9 +801,16 @@ bool ecs_pipeline_stats_get(
                 ecs_system_stats_t, it.entities[i]);
             stats->query.t = s->t;
             ecs_system_stats_get(world, it.entities[i], stats);
+            if (measure_stage_time) {
+                flecs_system_stage_stats_get(world, it.entities[i], stats);
+            }
         }
     }
 
+    if (measure_stage_time) {
+        flecs_pipeline_stage_stats_get(world, s);
+    }
+
     s->t = t_next(s->t);
 
     return true;
@@ -642,11 +824,13 @@ void ecs_pipeline_stats_fini(
     ecs_map_iter_t it = ecs_map_iter(&stats->system_stats);
     while (ecs_map_next(&it)) {
         ecs_system_stats_t *elem = ecs_map_ptr(&it);
+        ecs_vec_fini_t(NULL, &elem->stage_time_spent, ecs_metric_t);
         ecs_os_free(elem);
     }
     ecs_map_fini(&stats->system_stats);
     ecs_vec_fini_t(NULL, &stats->systems, ecs_entity_t);
     ecs_vec_fini_t(NULL, &stats->sync_points, ecs_sync_stats_t);
+    ecs_vec_fini_t(NULL, &stats->stages, ecs_stage_stats_t);
 }
 
 void ecs_pipeline_stats_reduce(
@@ -684,7 +868,10 @@ void ecs_pipeline_stats_reduce(
             ecs_system_stats_t, ecs_map_key(&it));
         sys_dst->query.t = dst->t;
         ecs_system_stats_reduce(sys_dst, sys_src);
+        flecs_system_stage_stats_reduce(sys_dst, sys_src);
     }
+
+    flecs_stage_stats_reduce(dst, src);
     dst->t = t_next(dst->t);
 }
 
@@ -715,7 +902,10 @@ void ecs_pipeline_stats_reduce_last(
             ecs_system_stats_t, ecs_map_key(&it));
         sys_dst->query.t = dst->t;
         ecs_system_stats_reduce_last(sys_dst, sys_src, count);
+        flecs_system_stage_stats_reduce_last(sys_dst, sys_src, count);
     }
+
+    flecs_stage_stats_reduce_last(dst, src, count);
     dst->t = t_prev(dst->t);
 }
 
@@ -736,7 +926,10 @@ void ecs_pipeline_stats_repeat_last(
         ecs_system_stats_t *sys = ecs_map_ptr(&it);
         sys->query.t = stats->t;
         ecs_system_stats_repeat_last(sys);
+        flecs_system_stage_stats_repeat_last(sys);
     }
+
+    flecs_stage_stats_repeat_last(stats);
     stats->t = t_next(stats->t);
 }
 
@@ -769,7 +962,10 @@ void ecs_pipeline_stats_copy_last(
             ecs_system_stats_t, ecs_map_key(&it));
         sys_dst->query.t = dst->t;
         ecs_system_stats_copy_last(sys_dst, sys_src);
+        flecs_system_stage_stats_copy_last(sys_dst, sys_src);
     }
+
+    flecs_stage_stats_copy_last(dst, src);
 }
 
 #endif
@@ -69,10 +69,14 @@ ecs_entity_t ecs_run_intern(
 
     ecs_time_t time_start;
     bool measure_time = ECS_BIT_IS_SET(world->flags, EcsWorldMeasureSystemTime);
-    if (measure_time) {
+    bool measure_stage_time = ECS_BIT_IS_SET(world->flags, 
+        EcsWorldMeasureStageTime);
+    if (measure_time || measure_stage_time) {
         ecs_os_get_time(&time_start);
     }
 
+    flecs_trace_begin(world, trace_start);
+
     ecs_world_t *thread_ctx = world;
     if (stage) {
         thread_ctx = stage->thread_ctx;
@@ -128,10 +132,23 @@ ecs_entity_t ecs_run_intern(
 
     flecs_stage_set_system(stage, old_system);
 
-    if (measure_time) {
-        system_data->time_spent += (ecs_ftime_t)ecs_time_measure(&time_start);
+    if (measure_time || measure_stage_time) {
+        double time_spent = ecs_time_measure(&time_start);
+        if (measure_time) {
+            system_data->time_spent += (ecs_ftime_t)time_spent;
+        }
+
+        /* Each thread only writes to its own stage */
+        if (measure_stage_time) {
+            double *stage_time = ecs_map_ensure_alloc_t(
+                &stage->system_time, double, system);
+            stage_time[0] += time_spent;
+            stage->counters.system_time += time_spent;
+        }
     }
 
+    flecs_trace_end(world, stage, EcsTraceSystem, system, 0, trace_start);
+
     flecs_defer_end(world, stage);
 
     return it->interrupted_by;
@@ -0,0 +1,270 @@
+/**
+ * @file addons/trace.c
+ * @brief Trace addon.
+ */
+
+#include "../private_api.h"
+
+#ifdef FLECS_TRACE
+
+static
+int64_t flecs_trace_ns(
+    const ecs_time_t *t)
+{
+    return (int64_t)t->sec * 1000000000 + (int64_t)t->nanosec;
+}
+
+void flecs_trace_record(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_trace_kind_t kind,
+    uint64_t id,
+    int32_t count,
+    const ecs_time_t *start)
+{
+    ecs_time_t now;
+    ecs_os_get_time(&now);
+
+    ecs_trace_buffer_t *trace = &stage->trace;
+    if (!trace->events) {
+        /* Allocated by the thread that owns the stage when the stage records
+         * its first event, so stages that don't record don't use memory. */
+        trace->capacity = world->trace_capacity;
+        trace->events = ecs_os_malloc_n(ecs_trace_event_t, trace->capacity);
+    }
+
+    ecs_trace_event_t *ev = &trace->events[
+        trace->count & (trace->capacity - 1)];
+    int64_t t_start = flecs_trace_ns(start);
+    ev->start = t_start - flecs_trace_ns(&world->trace_start_time);
+    ev->duration = flecs_trace_ns(&now) - t_start;
+    ev->id = id;
+    ev->kind = kind;
+    ev->count = count;
+    trace->count ++;
+}
+
+void ecs_trace_start(
+    ecs_world_t *world,
+    int32_t capacity)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    ecs_check(!(world->flags & EcsWorldReadonly),
+        ECS_INVALID_OPERATION, NULL);
+    ecs_check(capacity >= 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(ecs_os_has_time(), ECS_MISSING_OS_API, NULL);
+
+    if (!capacity) {
+        capacity = ECS_TRACE_DEFAULT_CAPACITY;
+    }
+
+    /* Discard events of previous trace */
+    int32_t i;
+    for (i = 0; i < world->stage_count; i ++) {
+        ecs_trace_buffer_t *trace = &world->stages[i].trace;
+        ecs_os_free(trace->events);
+        ecs_os_zeromem(trace);
+    }
+
+    world->trace_capacity = flecs_next_pow_of_2(capacity);
+    ecs_os_get_time(&world->trace_start_time);
+    ecs_os_zeromem(&world->trace_frame_time);
+    world->flags |= EcsWorldTrace;
+error:
+    return;
+}
+
+void ecs_trace_stop(
+    ecs_world_t *world)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    world->flags &= ~EcsWorldTrace;
+}
+
+bool ecs_trace_is_recording(
+    const ecs_world_t *world)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    return (world->flags & EcsWorldTrace) != 0;
+}
+
+/* Append time in nanoseconds as microseconds, which is the unit of the Chrome
+ * Trace Event format. */
+static
+void flecs_trace_append_us(
+    ecs_strbuf_t *buf,
+    int64_t ns)
+{
+    ecs_strbuf_appendint(buf, ns / 1000);
+    ecs_strbuf_appendch(buf, '.');
+    int64_t frac = ns % 1000;
+    ecs_strbuf_appendch(buf, (char)('0' + (frac / 100)));
+    ecs_strbuf_appendch(buf, (char)('0' + ((frac / 10) % 10)));
+    ecs_strbuf_appendch(buf, (char)('0' + (frac % 10)));
+}
+
+static
+void flecs_trace_append_name(
+    const ecs_world_t *world,
+    ecs_strbuf_t *buf,
+    ecs_entity_t e)
+{
+    if (ecs_is_alive(world, e)) {
+        char *path = ecs_get_path_w_sep(world, 0, e, ".", NULL);
+        ecs_strbuf_appendesc(buf, path, '"');
+        ecs_os_free(path);
+    } else {
+        ecs_strbuf_appendch(buf, '#');
+        ecs_strbuf_appendint(buf, flecs_uto(int64_t, e));
+    }
+}
+
+static
+void flecs_trace_event_to_json(
+    const ecs_world_t *world,
+    ecs_strbuf_t *buf,
+    int32_t stage_id,
+    const ecs_trace_event_t *ev)
+{
+    ecs_strbuf_list_next(buf);
+    ecs_strbuf_appendlit(buf, "{\"name\":\"");
+
+    const char *cat = NULL;
+    switch(ev->kind) {
+    case EcsTraceFrame:
+        ecs_strbuf_appendlit(buf, "frame");
+        cat = "frame";
+        break;
+    case EcsTraceSystem:
+        flecs_trace_append_name(world, buf, ev->id);
+        cat = "system";
+        break;
+    case EcsTraceMerge:
+        ecs_strbuf_appendlit(buf, "merge");
+        cat = "merge";
+        break;
+    case EcsTraceObserver:
+        flecs_trace_append_name(world, buf, ev->id);
+        cat = "observer";
+        break;
+    case EcsTraceTable:
+        ecs_strbuf_appendlit(buf, "table");
+        cat = "table";
+        break;
+    }
+
+    ecs_strbuf_appendlit(buf, "\",\"cat\":\"");
+    ecs_strbuf_appendstr(buf, cat);
+    ecs_strbuf_appendlit(buf, "\",\"ph\":\"X\",\"ts\":");
+    flecs_trace_append_us(buf, ev->start);
+    ecs_strbuf_appendlit(buf, ",\"dur\":");
+    flecs_trace_append_us(buf, ev->duration);
+    ecs_strbuf_appendlit(buf, ",\"pid\":0,\"tid\":");
+    ecs_strbuf_appendint(buf, stage_id);
+    ecs_strbuf_appendlit(buf, ",\"args\":{");
+
+    switch(ev->kind) {
+    case EcsTraceFrame:
+        ecs_strbuf_appendlit(buf, "\"frame\":");
+        ecs_strbuf_appendint(buf, flecs_uto(int64_t, ev->id));
+        break;
+    case EcsTraceSystem:
+    case EcsTraceObserver:
+        ecs_strbuf_appendlit(buf, "\"entity\":");
+        ecs_strbuf_appendint(buf, flecs_uto(int64_t, ev->id));
+        break;
+    case EcsTraceMerge:
+        ecs_strbuf_appendlit(buf, "\"stage\":");
+        ecs_strbuf_appendint(buf, flecs_uto(int64_t, ev->id));
+        ecs_strbuf_appendlit(buf, ",\"commands\":");
+        ecs_strbuf_appendint(buf, ev->count);
+        break;
+    case EcsTraceTable: {
+        ecs_strbuf_appendlit(buf, "\"table\":");
+        ecs_strbuf_appendint(buf, flecs_uto(int64_t, ev->id));
+
+        /* Table ids can be recycled, so the type is of the table that
+         * currently has the id. */
+        ecs_table_t *table = flecs_sparse_try_t(
+            &world->store.tables, ecs_table_t, ev->id);
+        if (table) {
+            char *type = ecs_table_str(world, table);
+            if (type) {
+                ecs_strbuf_appendlit(buf, ",\"type\":\"");
+                ecs_strbuf_appendesc(buf, type, '"');
+                ecs_strbuf_appendch(buf, '"');
+                ecs_os_free(type);
+            }
+        }
+        break;
+    }
+    }
+
+    ecs_strbuf_appendlit(buf, "}}");
+}
+
+int ecs_trace_to_json_buf(
+    const ecs_world_t *world,
+    ecs_strbuf_t *buf)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    ecs_check(!(world->flags & EcsWorldReadonly),
+        ECS_INVALID_OPERATION, NULL);
+
+    ecs_strbuf_appendlit(buf, "{\"traceEvents\":");
+    ecs_strbuf_list_push(buf, "[", ",");
+
+    int32_t i;
+    for (i = 0; i < world->stage_count; i ++) {
+        const ecs_trace_buffer_t *trace = &world->stages[i].trace;
+        if (!trace->count) {
+            continue;
+        }
+
+        /* Thread name */
+        ecs_strbuf_list_appendlit(buf,
+            "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":");
+        ecs_strbuf_appendint(buf, i);
+        if (i) {
+            ecs_strbuf_appendlit(buf, ",\"args\":{\"name\":\"worker ");
+            ecs_strbuf_appendint(buf, i);
+            ecs_strbuf_appendlit(buf, "\"}}");
+        } else {
+            ecs_strbuf_appendlit(buf, ",\"args\":{\"name\":\"main\"}}");
+        }
+
+        /* Events from oldest to newest. When the ring buffer wrapped around,
+         * the oldest event is at the write position. */
+        int64_t cur = 0, count = trace->count;
+        if (count > trace->capacity) {
+            cur = count - trace->capacity;
+        }
+
+        for (; cur < count; cur ++) {
+            flecs_trace_event_to_json(world, buf, i,
+                &trace->events[cur & (trace->capacity - 1)]);
+        }
+    }
+
+    ecs_strbuf_list_pop(buf, "]");
+    ecs_strbuf_appendlit(buf, ",\"displayTimeUnit\":\"ns\"}");
+
+    return 0;
+error:
+    return -1;
+}
+
+char* ecs_trace_to_json(
+    const ecs_world_t *world)
+{
+    ecs_strbuf_t buf = ECS_STRBUF_INIT;
+
+    if (ecs_trace_to_json_buf(world, &buf)) {
+        ecs_strbuf_reset(&buf);
+        return NULL;
+    }
+
+    return ecs_strbuf_get(&buf);
+}
+
+#endif
@@ -19,12 +19,50 @@
 #include "private_api.h"
 
 /* -- Identifier Component -- */
+
+void flecs_identifier_free(
+    ecs_hashmap_t *pool,
+    EcsIdentifier *ptr)
+{
+    char *value = ptr->value;
+    if (!value) {
+        return;
+    }
+
+    ptr->value = NULL;
+
+    if (pool && !flecs_name_index_is_empty(pool)) {
+        /* The hash is reset when the identifier is removed, so recompute it
+         * to find the string in the pool. */
+        uint64_t hash = ptr->hash;
+        if (!hash) {
+            hash = flecs_hash(value, ecs_os_strlen(value));
+        }
+        if (flecs_string_pool_release(pool, value, hash)) {
+            return;
+        }
+    }
+
+    ecs_os_free(value);
+}
+
 static ECS_DTOR(EcsIdentifier, ptr, {
-    ecs_os_strset(&ptr->value, NULL);
+    flecs_identifier_free(type_info->hooks.ctx, ptr);
 })
 
 static ECS_COPY(EcsIdentifier, dst, src, {
-    ecs_os_strset(&dst->value, src->value);
+    ecs_hashmap_t *pool = type_info->hooks.ctx;
+    if (dst->value != src->value) {
+        flecs_identifier_free(pool, dst);
+        if (flecs_string_pool_has(pool, src->value, src->hash)) {
+            /* Share interned string instead of making a copy */
+            dst->value = ECS_CONST_CAST(char*, flecs_string_pool_intern(
+                pool, src->value, src->length, src->hash));
+        } else {
+            dst->value = ecs_os_strdup(src->value);
+        }
+    }
+
     dst->hash = src->hash;
     dst->length = src->length;
     dst->index_hash = src->index_hash;
@@ -32,7 +70,7 @@ static ECS_COPY(EcsIdentifier, dst, src, {
 })
 
 static ECS_MOVE(EcsIdentifier, dst, src, {
-    ecs_os_strset(&dst->value, NULL);
+    flecs_identifier_free(type_info->hooks.ctx, dst);
     dst->value = src->value;
     dst->hash = src->hash;
     dst->length = src->length;
@@ -56,6 +94,8 @@ void ecs_on_set(EcsIdentifier)(ecs_iter_t *it) {
     ecs_entity_t kind = ECS_PAIR_SECOND(evt_id); /* Name, Symbol, Alias */
     ecs_id_t pair = ecs_childof(0);
     ecs_hashmap_t *index = NULL;
+    ecs_hashmap_t *pool = &world->identifiers;
+    bool intern = ECS_BIT_IS_SET(world->flags, EcsWorldInternIdentifiers);
 
     if (kind == EcsSymbol) {
         index = &world->symbols;
@@ -91,6 +131,13 @@ void ecs_on_set(EcsIdentifier)(ecs_iter_t *it) {
         if (cur->value && (evt == EcsOnSet)) {
             len = cur->length = ecs_os_strlen(name);
             hash = cur->hash = flecs_hash(name, len);
+
+            if (intern && !flecs_string_pool_has(pool, name, hash)) {
+                /* Replace owned string with shared string from pool */
+                name = flecs_string_pool_intern(pool, name, len, hash);
+                ecs_os_free(cur->value);
+                cur->value = ECS_CONST_CAST(char*, name);
+            }
         } else {
             len = cur->length = 0;
             hash = cur->hash = 0;
@@ -736,7 +783,8 @@ void flecs_bootstrap(
         .copy = ecs_copy(EcsIdentifier),
         .move = ecs_move(EcsIdentifier),
         .on_set = ecs_on_set(EcsIdentifier),
-        .on_remove = ecs_on_set(EcsIdentifier)
+        .on_remove = ecs_on_set(EcsIdentifier),
+        .ctx = &world->identifiers
     });
 
     flecs_type_info_init(world, EcsPoly, {
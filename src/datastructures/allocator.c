@@ -27,19 +27,68 @@ void flecs_allocator_init(
     flecs_ballocator_init_n(&a->chunks, ecs_block_allocator_t,
         FLECS_SPARSE_PAGE_SIZE);
     flecs_sparse_init_t(&a->sizes, NULL, &a->chunks, ecs_block_allocator_t);
+    a->arena = NULL;
+    a->depot = NULL;
+    ecs_os_zeromem(&a->vm);
+}
+
+void flecs_allocator_init_w_arena(
+    ecs_allocator_t *a,
+    ecs_block_allocator_arena_t *arena)
+{
+    flecs_allocator_init(a);
+    a->chunks.arena = arena;
+    a->arena = arena;
+}
+
+void flecs_allocator_init_w_depot(
+    ecs_allocator_t *a,
+    ecs_block_allocator_depot_t *depot)
+{
+    flecs_allocator_init(a);
+    a->depot = depot;
 }
 
 void flecs_allocator_fini(
     ecs_allocator_t *a)
 {
-    int32_t i = 0, count = flecs_sparse_count(&a->sizes);
-    for (i = 0; i < count; i ++) {
-        ecs_block_allocator_t *ba = flecs_sparse_get_dense_t(
-            &a->sizes, ecs_block_allocator_t, i);
+    ecs_sparse_iter_t it = flecs_sparse_iter(&a->sizes);
+    ecs_block_allocator_t *ba;
+    while ((ba = flecs_sparse_next_t(&it, ecs_block_allocator_t, NULL))) {
         flecs_ballocator_fini(ba);
     }
     flecs_sparse_fini(&a->sizes);
     flecs_ballocator_fini(&a->chunks);
+
+    if (ecs_map_is_init(&a->vm.regions)) {
+        ecs_map_iter_t rit = ecs_map_iter(&a->vm.regions);
+        while (ecs_map_next(&rit)) {
+            ecs_os_vm_release((void*)(uintptr_t)ecs_map_key(&rit),
+                (ecs_size_t)ecs_map_value(&rit));
+        }
+        ecs_map_fini(&a->vm.regions);
+    }
+}
+
+bool flecs_allocator_set_vm_reserve(
+    ecs_allocator_t *a,
+    ecs_size_t size)
+{
+    ecs_assert(a != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(size >= 0, ECS_INVALID_PARAMETER, NULL);
+#ifdef FLECS_USE_OS_ALLOC
+    (void)a;
+    return !size;
+#else
+    if (size && !ecs_os_has_vm()) {
+        return false;
+    }
+
+    /* Round up so that regions can be committed in whole pages */
+    a->vm.reserve = ECS_ALIGN(size, 64 * 1024);
+    ecs_map_init_if(&a->vm.regions, NULL);
+    return true;
+#endif
 }
 
 ecs_block_allocator_t* flecs_allocator_get(
@@ -61,7 +110,14 @@ ecs_block_allocator_t* flecs_allocator_get(
     if (!result) {
         result = flecs_sparse_ensure_fast_t(&a->sizes, 
             ecs_block_allocator_t, (uint32_t)hash);
-        flecs_ballocator_init(result, size);
+        if (a->depot) {
+            flecs_ballocator_init_w_depot(result, size, a->depot);
+        } else {
+            flecs_ballocator_init_w_arena(result, size, a->arena);
+        }
+        if (size >= FLECS_VM_ALLOC_SIZE) {
+            result->vm = &a->vm;
+        }
     }
 
     ecs_assert(result->data_size == size, ECS_INTERNAL_ERROR, NULL);
@@ -15,8 +15,310 @@
 int64_t ecs_block_allocator_alloc_count = 0;
 int64_t ecs_block_allocator_free_count = 0;
 
+/* Arena pages start small so that small worlds don't waste memory, and grow
+ * geometrically so that large worlds need few pages. */
+#define FLECS_ARENA_MIN_PAGE_SIZE (64 * 1024)
+#define FLECS_ARENA_MAX_PAGE_SIZE (4 * 1024 * 1024)
+#define FLECS_ARENA_PAGE_OFFSET \
+    ECS_ALIGN(ECS_SIZEOF(ecs_block_allocator_arena_page_t), 16)
+
+static
+ecs_block_allocator_arena_page_t* flecs_ballocator_arena_page_new(
+    ecs_size_t size)
+{
+    ecs_block_allocator_arena_page_t *page = ecs_os_malloc(
+        FLECS_ARENA_PAGE_OFFSET + size);
+    page->next = NULL;
+    page->size = size;
+    page->sp = 0;
+    ecs_os_linc(&ecs_block_allocator_alloc_count);
+    return page;
+}
+
+void flecs_ballocator_arena_init(
+    ecs_block_allocator_arena_t *arena)
+{
+    ecs_assert(arena != NULL, ECS_INTERNAL_ERROR, NULL);
+    arena->page = NULL;
+    arena->page_size = FLECS_ARENA_MIN_PAGE_SIZE;
+    arena->page_count = 0;
+}
+
+void flecs_ballocator_arena_fini(
+    ecs_block_allocator_arena_t *arena)
+{
+    ecs_assert(arena != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    ecs_block_allocator_arena_page_t *page;
+    for (page = arena->page; page;) {
+        ecs_block_allocator_arena_page_t *next = page->next;
+        ecs_os_free(page);
+        ecs_os_linc(&ecs_block_allocator_free_count);
+        page = next;
+    }
+
+    arena->page = NULL;
+    arena->page_count = 0;
+}
+
+void* flecs_ballocator_arena_alloc(
+    ecs_block_allocator_arena_t *arena,
+    ecs_size_t size)
+{
+    ecs_assert(arena != NULL, ECS_INTERNAL_ERROR, NULL);
+    ecs_assert(size > 0, ECS_INTERNAL_ERROR, NULL);
+
+    size = ECS_ALIGN(size, 16);
+
+    ecs_block_allocator_arena_page_t *page = arena->page;
+    if (page && ((page->sp + size) <= page->size)) {
+        void *result = ECS_OFFSET(page, FLECS_ARENA_PAGE_OFFSET + page->sp);
+        page->sp += size;
+        return result;
+    }
+
+    arena->page_count ++;
+
+    /* Allocations that would occupy most of a page get their own page. The
+     * page is inserted after the current page so that the remaining space in
+     * the current page can still be used. */
+    if (size > (arena->page_size / 2)) {
+        ecs_block_allocator_arena_page_t *large = 
+            flecs_ballocator_arena_page_new(size);
+        large->sp = size;
+        if (page) {
+            large->next = page->next;
+            page->next = large;
+        } else {
+            arena->page = large;
+        }
+        return ECS_OFFSET(large, FLECS_ARENA_PAGE_OFFSET);
+    }
+
+    page = flecs_ballocator_arena_page_new(arena->page_size);
+    page->next = arena->page;
+    page->sp = size;
+    arena->page = page;
+
+    if (arena->page_size < FLECS_ARENA_MAX_PAGE_SIZE) {
+        arena->page_size *= 2;
+    }
+
+    return ECS_OFFSET(page, FLECS_ARENA_PAGE_OFFSET);
+}
+
+static
+bool flecs_ballocator_uses_pages(
+    const ecs_block_allocator_t *ba)
+{
+    return ba->block_size >= FLECS_PAGE_ALLOC_SIZE;
+}
+
+static
+void flecs_ballocator_block_free(
+    const ecs_block_allocator_t *ba,
+    ecs_block_allocator_block_t *block)
+{
+    if (flecs_ballocator_uses_pages(ba)) {
+        ecs_os_page_free(block->memory, ba->block_size);
+    }
+    ecs_os_free(block);
+    ecs_os_linc(&ecs_block_allocator_free_count);
+}
+
+/* List of free chunks exchanged with a depot */
+typedef struct ecs_block_allocator_magazine_t {
+    ecs_block_allocator_chunk_header_t *chunks;
+    int32_t count;
+} ecs_block_allocator_magazine_t;
+
+/* Magazines of a depot for a single chunk size */
+typedef struct ecs_block_allocator_depot_bin_t {
+    ecs_block_allocator_depot_t *depot;
+    ecs_block_allocator_magazine_t *magazines; /* Stack of magazines */
+    int32_t magazine_count;
+    int32_t magazine_size;                     /* Size of magazines array */
+    int32_t chunk_size;
+    int32_t chunks_per_magazine;
+    struct ecs_block_allocator_depot_bin_t *next;
+} ecs_block_allocator_depot_bin_t;
+
+struct ecs_block_allocator_depot_t {
+    ecs_os_mutex_t lock;                   /* 0 if threading is unavailable */
+    ecs_block_allocator_arena_t arena;     /* Memory of chunks */
+    ecs_block_allocator_depot_bin_t *bins;
+#ifdef FLECS_SANITIZE
+    int64_t alloc_count;
+#endif
+};
+
+static
+void flecs_ballocator_depot_lock(
+    ecs_block_allocator_depot_t *depot)
+{
+    if (depot->lock) {
+        ecs_os_mutex_lock(depot->lock);
+    }
+}
+
+static
+void flecs_ballocator_depot_unlock(
+    ecs_block_allocator_depot_t *depot)
+{
+    if (depot->lock) {
+        ecs_os_mutex_unlock(depot->lock);
+    }
+}
+
+ecs_block_allocator_depot_t* flecs_ballocator_depot_new(void) {
+    ecs_block_allocator_depot_t *result = 
+        ecs_os_calloc_t(ecs_block_allocator_depot_t);
+    if (ecs_os_has_threading()) {
+        result->lock = ecs_os_mutex_new();
+    }
+    flecs_ballocator_arena_init(&result->arena);
+    return result;
+}
+
+void flecs_ballocator_depot_free(
+    ecs_block_allocator_depot_t *depot)
+{
+    if (!depot) {
+        return;
+    }
+
+#ifdef FLECS_SANITIZE
+    ecs_assert(depot->alloc_count == 0, ECS_LEAK_DETECTED, 
+        "(count = %d)", (int32_t)depot->alloc_count);
+#endif
+
+    ecs_block_allocator_depot_bin_t *bin, *next;
+    for (bin = depot->bins; bin; bin = next) {
+        next = bin->next;
+        ecs_os_free(bin->magazines);
+        ecs_os_free(bin);
+    }
+
+    /* Chunks are released all at once with the arena */
+    flecs_ballocator_arena_fini(&depot->arena);
+    if (depot->lock) {
+        ecs_os_mutex_free(depot->lock);
+    }
+    ecs_os_free(depot);
+}
+
+static
+ecs_block_allocator_depot_bin_t* flecs_ballocator_depot_bin(
+    ecs_block_allocator_depot_t *depot,
+    const ecs_block_allocator_t *ba)
+{
+    flecs_ballocator_depot_lock(depot);
+
+    ecs_block_allocator_depot_bin_t *bin;
+    for (bin = depot->bins; bin; bin = bin->next) {
+        if (bin->chunk_size == ba->chunk_size) {
+            break;
+        }
+    }
+
+    if (!bin) {
+        bin = ecs_os_calloc_t(ecs_block_allocator_depot_bin_t);
+        bin->depot = depot;
+        bin->chunk_size = ba->chunk_size;
+        bin->chunks_per_magazine = ba->chunks_per_block;
+        bin->next = depot->bins;
+        depot->bins = bin;
+    }
+
+    flecs_ballocator_depot_unlock(depot);
+    return bin;
+}
+
 #ifndef FLECS_USE_OS_ALLOC
 
+/* Take magazine from depot. If the depot has no magazines, a new magazine is
+ * created from the depot arena. */
+static
+ecs_block_allocator_chunk_header_t* flecs_ballocator_depot_take(
+    ecs_block_allocator_depot_bin_t *bin,
+    int32_t *count_out)
+{
+    ecs_block_allocator_depot_t *depot = bin->depot;
+    ecs_block_allocator_chunk_header_t *result;
+
+    flecs_ballocator_depot_lock(depot);
+    if (bin->magazine_count) {
+        ecs_block_allocator_magazine_t *m = 
+            &bin->magazines[-- bin->magazine_count];
+        result = m->chunks;
+        *count_out = m->count;
+        flecs_ballocator_depot_unlock(depot);
+        return result;
+    }
+
+    int32_t i, count = bin->chunks_per_magazine, chunk_size = bin->chunk_size;
+    result = flecs_ballocator_arena_alloc(&depot->arena, count * chunk_size);
+    flecs_ballocator_depot_unlock(depot);
+
+    ecs_block_allocator_chunk_header_t *chunk = result;
+    for (i = 0; i < count - 1; i ++) {
+        chunk->next = ECS_OFFSET(chunk, chunk_size);
+        chunk = chunk->next;
+    }
+    chunk->next = NULL;
+
+    *count_out = count;
+    return result;
+}
+
+/* Return magazine to depot */
+static
+void flecs_ballocator_depot_give(
+    ecs_block_allocator_depot_bin_t *bin,
+    ecs_block_allocator_chunk_header_t *chunks,
+    int32_t count)
+{
+    ecs_block_allocator_depot_t *depot = bin->depot;
+
+    flecs_ballocator_depot_lock(depot);
+    if (bin->magazine_count == bin->magazine_size) {
+        bin->magazine_size = ECS_MAX(bin->magazine_size * 2, 4);
+        bin->magazines = ecs_os_realloc_n(bin->magazines, 
+            ecs_block_allocator_magazine_t, bin->magazine_size);
+    }
+
+    ecs_block_allocator_magazine_t *m = 
+        &bin->magazines[bin->magazine_count ++];
+    m->chunks = chunks;
+    m->count = count;
+    flecs_ballocator_depot_unlock(depot);
+}
+
+/* Return one magazine of free chunks to depot when the free list has enough
+ * chunks for two magazines. Keeping one magazine in the free list prevents a
+ * thread that alternates between allocating and freeing from taking and
+ * returning a magazine for each operation. */
+static
+void flecs_ballocator_depot_trim(
+    ecs_block_allocator_t *ba)
+{
+    ecs_block_allocator_depot_bin_t *bin = ba->depot;
+    int32_t i, count = bin->chunks_per_magazine;
+    if (ba->free_count < (count * 2)) {
+        return;
+    }
+
+    ecs_block_allocator_chunk_header_t *first = ba->head, *last = first;
+    for (i = 0; i < count - 1; i ++) {
+        last = last->next;
+    }
+
+    ba->head = last->next;
+    ba->free_count -= count;
+    last->next = NULL;
+    flecs_ballocator_depot_give(bin, first, count);
+}
+
 static
 ecs_block_allocator_chunk_header_t* flecs_balloc_block(
     ecs_block_allocator_t *allocator)
@@ -25,11 +327,31 @@ ecs_block_allocator_chunk_header_t* flecs_balloc_block(
         return NULL;
     }
 
-    ecs_block_allocator_block_t *block = 
-        ecs_os_malloc(ECS_SIZEOF(ecs_block_allocator_block_t) +
-            allocator->block_size);
-    ecs_block_allocator_chunk_header_t *first_chunk = ECS_OFFSET(block, 
-        ECS_SIZEOF(ecs_block_allocator_block_t));
+    ecs_block_allocator_block_t *block;
+    ecs_block_allocator_chunk_header_t *first_chunk;
+    if (flecs_ballocator_uses_pages(allocator)) {
+        /* Memory is not in the same allocation as the block, so that it starts
+         * at a page boundary and doesn't overflow into another page. */
+        ecs_flags32_t flags = 0;
+        if (allocator->block_size >= FLECS_HUGE_PAGE_ALLOC_SIZE) {
+            flags |= EcsOsPageHuge;
+        }
+        first_chunk = ecs_os_page_alloc(allocator->block_size, -1, flags);
+        ecs_assert(first_chunk != NULL, ECS_OUT_OF_MEMORY, NULL);
+        block = ecs_os_malloc_t(ecs_block_allocator_block_t);
+        ecs_os_linc(&ecs_block_allocator_alloc_count);
+    } else {
+        ecs_size_t size = ECS_SIZEOF(ecs_block_allocator_block_t) + 
+            allocator->block_size;
+        if (allocator->arena) {
+            block = flecs_ballocator_arena_alloc(allocator->arena, size);
+        } else {
+            block = ecs_os_malloc(size);
+            ecs_os_linc(&ecs_block_allocator_alloc_count);
+        }
+        first_chunk = ECS_OFFSET(block, 
+            ECS_SIZEOF(ecs_block_allocator_block_t));
+    }
 
     block->memory = first_chunk;
     if (!allocator->block_tail) {
@@ -50,14 +372,107 @@ ecs_block_allocator_chunk_header_t* flecs_balloc_block(
         chunk = chunk->next;
     }
 
-    ecs_os_linc(&ecs_block_allocator_alloc_count);
-
     chunk->next = NULL;
     return first_chunk;
 }
 
 #endif
 
+#ifndef FLECS_USE_OS_ALLOC
+
+/* -- Reserved virtual memory -- */
+
+static
+bool flecs_ballocator_uses_vm(
+    const ecs_block_allocator_t *ba)
+{
+    if (!ba || !ba->vm) {
+        return false;
+    }
+
+    /* Regions can outlive disabling the reserve, so keep checking them */
+    return ba->vm->reserve || ecs_map_count(&ba->vm->regions);
+}
+
+/* Allocate chunk in a new region. Returns NULL if the chunk doesn't fit in a
+ * region or no memory could be reserved, in which case it is allocated from
+ * the blocks of the allocator. */
+static
+void* flecs_balloc_vm(
+    ecs_block_allocator_t *ba)
+{
+    ecs_allocator_vm_t *vm = ba->vm;
+    ecs_size_t size = ba->data_size, reserve = vm->reserve;
+    if (reserve < size) {
+        return NULL;
+    }
+
+    void *result = ecs_os_vm_reserve(reserve);
+    if (!result) {
+        return NULL;
+    }
+
+    if (ecs_os_vm_commit(result, size)) {
+        ecs_os_vm_release(result, reserve);
+        return NULL;
+    }
+
+    ecs_map_insert(&vm->regions, (uintptr_t)result, (ecs_map_val_t)reserve);
+    vm->committed += size;
+    return result;
+}
+
+/* Release region of chunk. Returns false if chunk is not stored in a region. */
+static
+bool flecs_bfree_vm(
+    ecs_block_allocator_t *ba,
+    void *memory)
+{
+    ecs_allocator_vm_t *vm = ba->vm;
+    ecs_map_val_t *reserve = ecs_map_get(&vm->regions, (uintptr_t)memory);
+    if (!reserve) {
+        return false;
+    }
+
+    ecs_os_vm_release(memory, (ecs_size_t)reserve[0]);
+    ecs_map_remove(&vm->regions, (uintptr_t)memory);
+    vm->committed -= ba->data_size;
+    return true;
+}
+
+/* Grow chunk by committing more memory of its region. Returns false if the
+ * chunk is not in a region or the new size doesn't fit. */
+static
+bool flecs_brealloc_vm(
+    ecs_block_allocator_t *dst,
+    ecs_block_allocator_t *src,
+    void *memory)
+{
+    if (!dst || !memory || (dst->vm != src->vm)) {
+        return false;
+    }
+
+    /* Shrink by moving the chunk, so that memory is returned */
+    if (dst->data_size <= src->data_size) {
+        return false;
+    }
+
+    ecs_allocator_vm_t *vm = src->vm;
+    ecs_map_val_t *reserve = ecs_map_get(&vm->regions, (uintptr_t)memory);
+    if (!reserve || (dst->data_size > (ecs_size_t)reserve[0])) {
+        return false;
+    }
+
+    if (ecs_os_vm_commit(memory, dst->data_size)) {
+        return false;
+    }
+
+    vm->committed += dst->data_size - src->data_size;
+    return true;
+}
+
+#endif
+
 void flecs_ballocator_init(
     ecs_block_allocator_t *ba,
     ecs_size_t size)
@@ -74,6 +489,29 @@ void flecs_ballocator_init(
     ba->head = NULL;
     ba->block_head = NULL;
     ba->block_tail = NULL;
+    ba->arena = NULL;
+    ba->depot = NULL;
+    ba->free_count = 0;
+    ba->alloc_count = 0;
+    ba->vm = NULL;
+}
+
+void flecs_ballocator_init_w_arena(
+    ecs_block_allocator_t *ba,
+    ecs_size_t size,
+    ecs_block_allocator_arena_t *arena)
+{
+    flecs_ballocator_init(ba, size);
+    ba->arena = arena;
+}
+
+void flecs_ballocator_init_w_depot(
+    ecs_block_allocator_t *ba,
+    ecs_size_t size,
+    ecs_block_allocator_depot_t *depot)
+{
+    flecs_ballocator_init(ba, size);
+    ba->depot = flecs_ballocator_depot_bin(depot, ba);
 }
 
 ecs_block_allocator_t* flecs_ballocator_new(
@@ -89,16 +527,42 @@ void flecs_ballocator_fini(
 {
     ecs_assert(ba != NULL, ECS_INTERNAL_ERROR, NULL);
 
+    /* Free chunks are returned to the depot, which owns their memory. Chunks
+     * that are still allocated can be freed with another block allocator that
+     * uses the depot, so leaks are detected by the depot. */
+    if (ba->depot) {
+#ifndef FLECS_USE_OS_ALLOC
+        if (ba->head) {
+            flecs_ballocator_depot_give(ba->depot, ba->head, ba->free_count);
+        }
+#endif
+#ifdef FLECS_SANITIZE
+        ecs_block_allocator_depot_t *depot = ba->depot->depot;
+        flecs_ballocator_depot_lock(depot);
+        depot->alloc_count += ba->alloc_count;
+        flecs_ballocator_depot_unlock(depot);
+#endif
+        ba->head = NULL;
+        ba->free_count = 0;
+        return;
+    }
+
 #ifdef FLECS_SANITIZE
     ecs_assert(ba->alloc_count == 0, ECS_LEAK_DETECTED, 
         "(size = %u)", (uint32_t)ba->data_size);
 #endif
 
+    /* Blocks that were taken from an arena are released with the arena. Blocks
+     * with page memory are never taken from an arena. */
+    if (ba->arena && !flecs_ballocator_uses_pages(ba)) {
+        ba->block_head = NULL;
+        return;
+    }
+
     ecs_block_allocator_block_t *block;
     for (block = ba->block_head; block;) {
         ecs_block_allocator_block_t *next = block->next;
-        ecs_os_free(block);
-        ecs_os_linc(&ecs_block_allocator_free_count);
+        flecs_ballocator_block_free(ba, block);
         block = next;
     }
     ba->block_head = NULL;
@@ -121,7 +585,19 @@ void* flecs_balloc(
 
     if (!ba) return NULL;
 
-    if (!ba->head) {
+    if (flecs_ballocator_uses_vm(ba)) {
+        result = flecs_balloc_vm(ba);
+        if (result) {
+            return result;
+        }
+    }
+
+    if (ba->depot) {
+        if (!ba->head) {
+            ba->head = flecs_ballocator_depot_take(ba->depot, &ba->free_count);
+        }
+        ba->free_count --;
+    } else if (!ba->head) {
         ba->head = flecs_balloc_block(ba);
     }
 
@@ -129,7 +605,8 @@ void* flecs_balloc(
     ba->head = ba->head->next;
 
 #ifdef FLECS_SANITIZE
-    ecs_assert(ba->alloc_count >= 0, ECS_INTERNAL_ERROR, "corrupted allocator");
+    ecs_assert(ba->depot || ba->alloc_count >= 0, ECS_INTERNAL_ERROR, 
+        "corrupted allocator");
     ba->alloc_count ++;
     *(int64_t*)result = ba->chunk_size;
     result = ECS_OFFSET(result, ECS_SIZEOF(int64_t));
@@ -174,6 +651,10 @@ void flecs_bfree(
         return;
     }
 
+    if (flecs_ballocator_uses_vm(ba) && flecs_bfree_vm(ba, memory)) {
+        return;
+    }
+
 #ifdef FLECS_SANITIZE
     memory = ECS_OFFSET(memory, -ECS_SIZEOF(int64_t));
     if (*(int64_t*)memory != ba->chunk_size) {
@@ -189,7 +670,13 @@ void flecs_bfree(
     ecs_block_allocator_chunk_header_t *chunk = memory;
     chunk->next = ba->head;
     ba->head = chunk;
-    ecs_assert(ba->alloc_count >= 0, ECS_INTERNAL_ERROR, "corrupted allocator");
+    ecs_assert(ba->depot || ba->alloc_count >= 0, ECS_INTERNAL_ERROR, 
+        "corrupted allocator");
+
+    if (ba->depot) {
+        ba->free_count ++;
+        flecs_ballocator_depot_trim(ba);
+    }
 #endif
 }
 
@@ -207,15 +694,19 @@ void* flecs_brealloc(
         return memory;
     }
 
-    result = flecs_balloc(dst);
-    if (result && src) {
-        ecs_size_t size = src->data_size;
-        if (dst->data_size < size) {
-            size = dst->data_size;
+    if (flecs_ballocator_uses_vm(src) && flecs_brealloc_vm(dst, src, memory)) {
+        result = memory;
+    } else {
+        result = flecs_balloc(dst);
+        if (result && src) {
+            ecs_size_t size = src->data_size;
+            if (dst->data_size < size) {
+                size = dst->data_size;
+            }
+            ecs_os_memcpy(result, memory, size);
         }
-        ecs_os_memcpy(result, memory, size);
+        flecs_bfree(src, memory);
     }
-    flecs_bfree(src, memory);
 #endif
 #ifdef FLECS_MEMSET_UNINITIALIZED
     if (dst && src && (dst->data_size > src->data_size)) {
@@ -247,3 +738,124 @@ void* flecs_bdup(
     return result;
 #endif
 }
+
+static
+int flecs_ballocator_block_compare(
+    const void *ptr_a,
+    const void *ptr_b)
+{
+    uintptr_t a = (uintptr_t)(*(ecs_block_allocator_block_t* const*)ptr_a)->memory;
+    uintptr_t b = (uintptr_t)(*(ecs_block_allocator_block_t* const*)ptr_b)->memory;
+    return (a > b) - (a < b);
+}
+
+/* Find index of block that contains chunk in array sorted by block memory */
+static
+int32_t flecs_ballocator_block_find(
+    ecs_block_allocator_block_t **blocks,
+    int32_t count,
+    const void *chunk)
+{
+    uintptr_t ptr = (uintptr_t)chunk;
+    int32_t lo = 0, hi = count - 1;
+    while (lo < hi) {
+        int32_t mid = (lo + hi + 1) / 2;
+        if ((uintptr_t)blocks[mid]->memory <= ptr) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+int64_t flecs_ballocator_trim(
+    ecs_block_allocator_t *ba)
+{
+#ifdef FLECS_USE_OS_ALLOC
+    (void)ba;
+    return 0;
+#else
+    ecs_assert(ba != NULL, ECS_INTERNAL_ERROR, NULL);
+
+    /* Chunks of a depot may be used by other allocators, and blocks of an
+     * arena can only be freed together with the arena. */
+    if (ba->depot || !ba->head) {
+        return 0;
+    }
+    if (ba->arena && !flecs_ballocator_uses_pages(ba)) {
+        return 0;
+    }
+
+    int32_t i, block_count = 0;
+    ecs_block_allocator_block_t *block;
+    for (block = ba->block_head; block; block = block->next) {
+        block_count ++;
+    }
+
+    ecs_block_allocator_block_t **blocks = ecs_os_malloc_n(
+        ecs_block_allocator_block_t*, block_count);
+    int32_t *free_counts = ecs_os_calloc_n(int32_t, block_count);
+    for (i = 0, block = ba->block_head; block; block = block->next) {
+        blocks[i ++] = block;
+    }
+    qsort(blocks, flecs_itosize(block_count), 
+        ECS_SIZEOF(ecs_block_allocator_block_t*), 
+        flecs_ballocator_block_compare);
+
+    ecs_block_allocator_chunk_header_t *chunk;
+    for (chunk = ba->head; chunk; chunk = chunk->next) {
+        free_counts[flecs_ballocator_block_find(blocks, block_count, chunk)] ++;
+    }
+
+    int64_t result = 0;
+    int32_t free_block_count = 0;
+    for (i = 0; i < block_count; i ++) {
+        if (free_counts[i] == ba->chunks_per_block) {
+            free_block_count ++;
+        }
+    }
+
+    if (!free_block_count) {
+        goto done;
+    }
+
+    /* Remove chunks of free blocks from the free list */
+    ecs_block_allocator_chunk_header_t **prev_chunk = &ba->head;
+    for (chunk = ba->head; chunk; chunk = chunk->next) {
+        int32_t index = flecs_ballocator_block_find(blocks, block_count, chunk);
+        if (free_counts[index] != ba->chunks_per_block) {
+            *prev_chunk = chunk;
+            prev_chunk = &chunk->next;
+        }
+    }
+    *prev_chunk = NULL;
+
+    /* Remove free blocks from the block list. Blocks are only freed after the
+     * list is rebuilt, as the search reads the headers of all blocks. */
+    ecs_block_allocator_block_t **prev_block = &ba->block_head;
+    ba->block_tail = NULL;
+    for (block = ba->block_head; block; block = block->next) {
+        int32_t index = flecs_ballocator_block_find(
+            blocks, block_count, block->memory);
+        if (free_counts[index] != ba->chunks_per_block) {
+            *prev_block = block;
+            prev_block = &block->next;
+            ba->block_tail = block;
+        }
+    }
+    *prev_block = NULL;
+
+    for (i = 0; i < block_count; i ++) {
+        if (free_counts[i] == ba->chunks_per_block) {
+            flecs_ballocator_block_free(ba, blocks[i]);
+            result += ba->block_size;
+        }
+    }
+
+done:
+    ecs_os_free(blocks);
+    ecs_os_free(free_counts);
+    return result;
+#endif
+}
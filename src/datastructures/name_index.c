@@ -56,6 +56,12 @@ bool flecs_name_index_is_init(
     return hm->compare != NULL;
 }
 
+bool flecs_name_index_is_empty(
+    const ecs_hashmap_t *hm)
+{
+    return !ecs_map_count(&hm->impl);
+}
+
 ecs_hashmap_t* flecs_name_index_new(
     ecs_world_t *world,
     ecs_allocator_t *allocator) 
@@ -137,7 +143,9 @@ const uint64_t* flecs_name_index_find_ptr(
             continue;
         }
 
-        if (!ecs_os_strcmp(name, key->value)) {
+        if ((name == key->value) ||
+            !ecs_os_memcmp(name, key->value, hs.length))
+        {
             uint64_t *e = ecs_vec_get_t(&b->values, uint64_t, i);
             ecs_assert(e != NULL, ECS_INTERNAL_ERROR, NULL);
             return e;
@@ -236,3 +244,97 @@ void flecs_name_index_ensure(
 error:
     return;
 }
+
+/* A string pool is a name index that maps strings to a reference count. Keys
+ * point to strings owned by the pool. */
+
+void flecs_string_pool_fini(
+    ecs_hashmap_t *pool)
+{
+    flecs_hashmap_iter_t it = flecs_hashmap_iter(pool);
+    ecs_hashed_string_t *key;
+    while (flecs_hashmap_next_w_key(&it, ecs_hashed_string_t, &key, uint64_t)) {
+        ecs_os_free(key->value);
+    }
+    flecs_hashmap_fini(pool);
+}
+
+const char* flecs_string_pool_intern(
+    ecs_hashmap_t *pool,
+    const char *str,
+    ecs_size_t length,
+    uint64_t hash)
+{
+    ecs_hashed_string_t key = flecs_get_hashed_string(str, length, hash);
+    flecs_hashmap_result_t r = flecs_hashmap_ensure(pool, &key, uint64_t);
+    uint64_t *refcount = r.value;
+    ecs_hashed_string_t *pool_key = r.key;
+    if (!refcount[0]) {
+        /* New entry, make copy of string that's owned by the pool */
+        pool_key->value = ecs_os_memdup_n(str, char, key.length + 1);
+    }
+    refcount[0] ++;
+    return pool_key->value;
+}
+
+/* Find index of pooled string. Pooled strings are found by pointer, so that
+ * a string that is equal to, but not owned by the pool is not matched. */
+static
+int32_t flecs_string_pool_find(
+    ecs_hm_bucket_t *b,
+    const char *str)
+{
+    ecs_hashed_string_t *keys = ecs_vec_first(&b->keys);
+    int32_t i, count = ecs_vec_count(&b->keys);
+    for (i = 0; i < count; i ++) {
+        if (keys[i].value == str) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool flecs_string_pool_has(
+    const ecs_hashmap_t *pool,
+    const char *str,
+    uint64_t hash)
+{
+    if (!str || !hash) {
+        return false;
+    }
+
+    ecs_hm_bucket_t *b = flecs_hashmap_get_bucket(pool, hash);
+    if (!b) {
+        return false;
+    }
+
+    return flecs_string_pool_find(b, str) != -1;
+}
+
+bool flecs_string_pool_release(
+    ecs_hashmap_t *pool,
+    const char *str,
+    uint64_t hash)
+{
+    if (!str || !hash) {
+        return false;
+    }
+
+    ecs_hm_bucket_t *b = flecs_hashmap_get_bucket(pool, hash);
+    if (!b) {
+        return false;
+    }
+
+    int32_t index = flecs_string_pool_find(b, str);
+    if (index == -1) {
+        return false;
+    }
+
+    uint64_t *refcount = ecs_vec_get_t(&b->values, uint64_t, index);
+    if (!(-- refcount[0])) {
+        ecs_os_free(ECS_CONST_CAST(char*, str));
+        flecs_hm_bucket_remove(pool, b, hash, index);
+    }
+
+    return true;
+}
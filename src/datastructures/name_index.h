@@ -17,6 +17,9 @@ void flecs_name_index_init_if(
 bool flecs_name_index_is_init(
     const ecs_hashmap_t *hm);
 
+bool flecs_name_index_is_empty(
+    const ecs_hashmap_t *hm);
+
 ecs_hashmap_t* flecs_name_index_new(
     ecs_world_t *world,
     ecs_allocator_t *allocator);
@@ -65,4 +68,29 @@ void flecs_name_index_update_name(
     uint64_t hash,
     const char *name);
 
+/* Free pool and all strings owned by the pool. A pool is initialized with
+ * flecs_name_index_init(). */
+void flecs_string_pool_fini(
+    ecs_hashmap_t *pool);
+
+/* Return pooled string equal to str, increase its reference count */
+const char* flecs_string_pool_intern(
+    ecs_hashmap_t *pool,
+    const char *str,
+    ecs_size_t length,
+    uint64_t hash);
+
+/* Test if string is owned by pool */
+bool flecs_string_pool_has(
+    const ecs_hashmap_t *pool,
+    const char *str,
+    uint64_t hash);
+
+/* Decrease reference count of pooled string. Returns false if string is not
+ * owned by the pool. */
+bool flecs_string_pool_release(
+    ecs_hashmap_t *pool,
+    const char *str,
+    uint64_t hash);
+
 #endif
@@ -14,6 +14,15 @@
 /* Utility to get a pointer to the payload */
 #define DATA(array, size, offset) (ECS_OFFSET(array, size * offset))
 
+/* Number of elements the iterator prefetches ahead of the current element */
+#define FLECS_SPARSE_PREFETCH_DISTANCE (4)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FLECS_SPARSE_PREFETCH(ptr) __builtin_prefetch(ptr)
+#else
+#define FLECS_SPARSE_PREFETCH(ptr) (void)(ptr)
+#endif
+
 typedef struct ecs_page_t {
     int32_t *sparse;            /* Sparse array with indices to dense array */
     void *data;                 /* Store data in sparse array to reduce  
@@ -320,6 +329,51 @@ uint64_t flecs_sparse_new_id(
     return flecs_sparse_new_index(sparse);
 }
 
+const uint64_t* flecs_sparse_new_ids(
+    ecs_sparse_t *sparse,
+    int32_t new_count)
+{
+    ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(new_count >= 0, ECS_INVALID_PARAMETER, NULL);
+
+    int32_t dense_count = ecs_vec_count(&sparse->dense);
+    int32_t count = sparse->count;
+    int32_t recyclable = dense_count - count;
+    int32_t i, to_create = new_count - recyclable;
+
+    ecs_assert(count <= dense_count, ECS_INTERNAL_ERROR, NULL);
+
+    if (to_create > 0) {
+        /* Grow the dense array once, and only look up the page when the next
+         * id is in a different page than the previous one. */
+        ecs_vec_set_count_t(sparse->allocator, &sparse->dense, uint64_t,
+            dense_count + to_create);
+        uint64_t *dense_array = ecs_vec_first_t(&sparse->dense, uint64_t);
+        ecs_page_t *page = NULL;
+        int32_t page_index = -1;
+
+        for (i = 0; i < to_create; i ++) {
+            uint64_t index = flecs_sparse_inc_id(sparse);
+            int32_t cur_page_index = PAGE(index);
+            if (cur_page_index != page_index) {
+                page = flecs_sparse_get_or_create_page(sparse, cur_page_index);
+                page_index = cur_page_index;
+            }
+
+            ecs_assert(page->sparse[OFFSET(index)] == 0,
+                ECS_INTERNAL_ERROR, NULL);
+            flecs_sparse_assign_index(page, dense_array, index,
+                dense_count + i);
+        }
+    }
+
+    /* Unused elements in the dense array are recycled first, followed by the
+     * newly created elements. Both are stored directly after the alive ids. */
+    sparse->count += new_count;
+
+    return &ecs_vec_first_t(&sparse->dense, uint64_t)[count];
+}
+
 void* flecs_sparse_add(
     ecs_sparse_t *sparse,
     ecs_size_t size)
@@ -436,20 +490,13 @@ void* flecs_sparse_ensure_fast(
     return DATA(page->data, sparse->size, offset);
 }
 
-void flecs_sparse_remove(
+/* Remove element from page */
+static
+void flecs_sparse_remove_from_page(
     ecs_sparse_t *sparse,
-    ecs_size_t size,
+    ecs_page_t *page,
     uint64_t index)
 {
-    ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
-    ecs_assert(!size || size == sparse->size, ECS_INVALID_PARAMETER, NULL);
-    (void)size;
-
-    ecs_page_t *page = flecs_sparse_get_page(sparse, PAGE(index));
-    if (!page || !page->sparse) {
-        return;
-    }
-
     uint64_t gen = flecs_sparse_strip_generation(&index);
     int32_t offset = OFFSET(index);
     int32_t dense = page->sparse[offset];
@@ -482,13 +529,61 @@ void flecs_sparse_remove(
 
         /* Reset memory to zero on remove */
         void *ptr = DATA(page->data, sparse->size, offset);
-        ecs_os_memset(ptr, 0, size);
+        ecs_os_memset(ptr, 0, sparse->size);
     } else {
         /* Element is not paired and thus not alive, nothing to be done */
         return;
     }
 }
 
+void flecs_sparse_remove(
+    ecs_sparse_t *sparse,
+    ecs_size_t size,
+    uint64_t index)
+{
+    ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!size || size == sparse->size, ECS_INVALID_PARAMETER, NULL);
+    (void)size;
+
+    ecs_page_t *page = flecs_sparse_get_page(sparse, PAGE(index));
+    if (!page || !page->sparse) {
+        return;
+    }
+
+    flecs_sparse_remove_from_page(sparse, page, index);
+}
+
+void flecs_sparse_remove_n(
+    ecs_sparse_t *sparse,
+    ecs_size_t size,
+    const uint64_t *ids,
+    int32_t count)
+{
+    ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!size || size == sparse->size, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!count || ids != NULL, ECS_INVALID_PARAMETER, NULL);
+    (void)size;
+
+    /* Ids are typically created in bulk as well, so consecutive ids are likely
+     * to be in the same page. */
+    ecs_page_t *page = NULL;
+    int32_t i, page_index = -1;
+    for (i = 0; i < count; i ++) {
+        uint64_t index = ids[i];
+        int32_t cur_page_index = PAGE(index);
+        if (cur_page_index != page_index) {
+            page = flecs_sparse_get_page(sparse, cur_page_index);
+            page_index = cur_page_index;
+        }
+
+        if (!page || !page->sparse) {
+            continue;
+        }
+
+        flecs_sparse_remove_from_page(sparse, page, index);
+    }
+}
+
 void* flecs_sparse_get_dense(
     const ecs_sparse_t *sparse,
     ecs_size_t size,
@@ -532,6 +627,44 @@ bool flecs_sparse_is_alive(
     return true;
 }
 
+bool flecs_sparse_is_alive_n(
+    const ecs_sparse_t *sparse,
+    const uint64_t *ids,
+    int32_t count)
+{
+    ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!count || ids != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    const uint64_t *dense_array = ecs_vec_first_t(&sparse->dense, uint64_t);
+    int32_t alive_count = sparse->count;
+    const ecs_page_t *page = NULL;
+    int32_t i, page_index = -1;
+
+    for (i = 0; i < count; i ++) {
+        uint64_t index = ids[i];
+        int32_t cur_page_index = PAGE(index);
+        if (cur_page_index != page_index) {
+            page = flecs_sparse_get_page(sparse, cur_page_index);
+            if (!page || !page->sparse) {
+                return false;
+            }
+            page_index = cur_page_index;
+        }
+
+        int32_t dense = page->sparse[OFFSET(index)];
+        if (!dense || (dense >= alive_count)) {
+            return false;
+        }
+
+        /* Alive if dense element stores the id with the same generation */
+        if (dense_array[dense] != index) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void* flecs_sparse_try(
     const ecs_sparse_t *sparse,
     ecs_size_t size,
@@ -634,6 +767,54 @@ const uint64_t* flecs_sparse_ids(
     }
 }
 
+ecs_sparse_iter_t flecs_sparse_iter(
+    const ecs_sparse_t *sparse)
+{
+    ecs_assert(sparse != NULL, ECS_INVALID_PARAMETER, NULL);
+    return (ecs_sparse_iter_t){
+        .pages = ecs_vec_first(&sparse->pages),
+        .ids = flecs_sparse_ids(sparse),
+        .count = flecs_sparse_count(sparse),
+        .size = sparse->size
+    };
+}
+
+void* flecs_sparse_next(
+    ecs_sparse_iter_t *it,
+    ecs_size_t size,
+    uint64_t *id_out)
+{
+    ecs_assert(it != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!size || size == it->size, ECS_INVALID_PARAMETER, NULL);
+    (void)size;
+
+    int32_t i = it->index;
+    if (i >= it->count) {
+        return NULL;
+    }
+
+    it->index = i + 1;
+
+    const ecs_page_t *pages = it->pages;
+    const uint64_t *ids = it->ids;
+    ecs_size_t elem_size = it->size;
+
+    /* Dense elements are not ordered by id, so the hardware prefetcher can't
+     * predict which element is accessed next. Request it in advance. */
+    if ((i + FLECS_SPARSE_PREFETCH_DISTANCE) < it->count) {
+        uint64_t next = ids[i + FLECS_SPARSE_PREFETCH_DISTANCE];
+        FLECS_SPARSE_PREFETCH(
+            DATA(pages[PAGE(next)].data, elem_size, OFFSET(next)));
+    }
+
+    uint64_t index = ids[i];
+    if (id_out) {
+        *id_out = index;
+    }
+
+    return DATA(pages[PAGE(index)].data, elem_size, OFFSET(index));
+}
+
 void ecs_sparse_init(
     ecs_sparse_t *sparse,
     ecs_size_t elem_size)
@@ -675,3 +856,61 @@ void* ecs_sparse_get(
 {
     return flecs_sparse_get(sparse, elem_size, id);
 }
+
+void ecs_sparse_fini(
+    ecs_sparse_t *sparse)
+{
+    flecs_sparse_fini(sparse);
+}
+
+const uint64_t* ecs_sparse_ids(
+    const ecs_sparse_t *sparse)
+{
+    return flecs_sparse_ids(sparse);
+}
+
+const uint64_t* ecs_sparse_new_ids(
+    ecs_sparse_t *sparse,
+    int32_t count)
+{
+    return flecs_sparse_new_ids(sparse, count);
+}
+
+void ecs_sparse_remove(
+    ecs_sparse_t *sparse,
+    ecs_size_t elem_size,
+    uint64_t id)
+{
+    flecs_sparse_remove(sparse, elem_size, id);
+}
+
+void ecs_sparse_remove_n(
+    ecs_sparse_t *sparse,
+    ecs_size_t elem_size,
+    const uint64_t *ids,
+    int32_t count)
+{
+    flecs_sparse_remove_n(sparse, elem_size, ids, count);
+}
+
+bool ecs_sparse_is_alive_n(
+    const ecs_sparse_t *sparse,
+    const uint64_t *ids,
+    int32_t count)
+{
+    return flecs_sparse_is_alive_n(sparse, ids, count);
+}
+
+ecs_sparse_iter_t ecs_sparse_iter(
+    const ecs_sparse_t *sparse)
+{
+    return flecs_sparse_iter(sparse);
+}
+
+void* ecs_sparse_next(
+    ecs_sparse_iter_t *it,
+    ecs_size_t elem_size,
+    uint64_t *id_out)
+{
+    return flecs_sparse_next(it, elem_size, id_out);
+}
@@ -57,6 +57,9 @@ void* flecs_stack_alloc(
         sp = 0;
         next_sp = flecs_ito(int16_t, size);
         stack->tail_page = page;
+        if (page->id > stack->max_page_id) {
+            stack->max_page_id = page->id;
+        }
     }
 
     page->sp = next_sp;
@@ -160,6 +163,32 @@ void flecs_stack_reset(
     stack->tail_cursor = NULL;
 }
 
+int64_t flecs_stack_trim(
+    ecs_stack_t *stack)
+{
+    /* Keep pages that were used since the last trim, so that a stack that 
+     * needs the same number of pages each frame doesn't reallocate them. */
+    ecs_stack_page_t *last = stack->tail_page;
+    while (last->next && (last->id < stack->max_page_id)) {
+        last = last->next;
+    }
+
+    ecs_stack_page_t *page = last->next;
+    int64_t result = 0;
+    last->next = NULL;
+    while (page) {
+        ecs_stack_page_t *next = page->next;
+        ecs_os_linc(&ecs_stack_allocator_free_count);
+        ecs_os_free(page);
+        result += ECS_STACK_PAGE_SIZE;
+        page = next;
+    }
+
+    stack->max_page_id = stack->tail_page->id;
+
+    return result;
+}
+
 void flecs_stack_init(
     ecs_stack_t *stack)
 {
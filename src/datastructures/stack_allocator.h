@@ -20,6 +20,7 @@ typedef struct ecs_stack_t {
     ecs_stack_page_t first;
     ecs_stack_page_t *tail_page;
     ecs_stack_cursor_t *tail_cursor;
+    uint32_t max_page_id;   /* Highest page used since last trim */
 #ifdef FLECS_DEBUG
     int32_t cursor_count;
 #endif
@@ -71,6 +72,10 @@ void flecs_stack_free(
 void flecs_stack_reset(
     ecs_stack_t *stack);
 
+/* Free pages that are not in use. Returns the number of bytes freed. */
+int64_t flecs_stack_trim(
+    ecs_stack_t *stack);
+
 FLECS_DBG_API
 ecs_stack_cursor_t* flecs_stack_get_cursor(
     ecs_stack_t *stack);
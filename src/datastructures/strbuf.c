@@ -2,16 +2,12 @@
  * @file datastructures/strbuf.c
  * @brief Utility for constructing strings.
  *
- * A buffer builds up a list of elements which individually can be up to N bytes
- * large. While appending, data is added to these elements. More elements are
- * added on the fly when needed. When an application calls ecs_strbuf_get, all
- * elements are combined in one string and the element administration is freed.
- *
- * This approach prevents reallocs of large blocks of memory, and therefore
- * copying large blocks of memory when appending to a large buffer. A buffer
- * preallocates some memory for the element overhead so that for small strings
- * there is hardly any overhead, while for large strings the overhead is offset
- * by the reduced time spent on copying memory.
+ * A buffer starts out with a small string that is stored inline, so that small
+ * strings can be built without allocating. When more space is needed, the 
+ * buffer moves to the heap and grows geometrically, so that building a large
+ * string only reallocates a few times. Writers that know an upper bound for
+ * the number of characters they'll add can reserve space in advance and write
+ * to the buffer directly, which avoids checking for space per character.
  * 
  * The functionality provided by strbuf is similar to std::stringstream.
  */
@@ -28,7 +24,9 @@
 
 #define MAX_PRECISION	(10)
 #define EXP_THRESHOLD   (3)
+#define EXP_THRESHOLD_DIV (10000) /* 10 ^ (EXP_THRESHOLD + 1) */
 #define INT64_MAX_F ((double)INT64_MAX)
+#define EXACT_INT_MAX_F (1e15) /* Integers below 2^53 convert exactly */
 
 static const double rounders[MAX_PRECISION + 1] =
 {
@@ -45,43 +43,56 @@ static const double rounders[MAX_PRECISION + 1] =
 	0.00000000005		// 10
 };
 
+static const char flecs_strbuf_digits[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/* Convert integer to string. Digits are written two at a time, starting from
+ * the end so they don't have to be reversed. Returns end of written string. */
 static
 char* flecs_strbuf_itoa(
     char *buf,
     int64_t v)
 {
-    char *ptr = buf;
-    char * p1;
-	char c;
+    char tmp[20];
+    char *end = &tmp[20], *p = end;
+    uint64_t u;
 
-	if (!v) {
-		*ptr++ = '0';
+    if (v < 0) {
+        *buf++ = '-';
+        u = (uint64_t)0 - (uint64_t)v;
     } else {
-        if (v < 0) {
-            ptr[0] = '-';
-            ptr ++;
-            v *= -1;
-        }
+        u = (uint64_t)v;
+    }
 
-		char *p = ptr;
-		while (v) {
-            int64_t vdiv = v / 10;
-            int64_t vmod = v - (vdiv * 10);
-			p[0] = (char)('0' + vmod);
-            p ++;
-			v = vdiv;
-		}
+    while (u >= 100) {
+        uint64_t r = (u % 100) * 2;
+        u /= 100;
+        p -= 2;
+        p[0] = flecs_strbuf_digits[r];
+        p[1] = flecs_strbuf_digits[r + 1];
+    }
 
-		p1 = p;
+    if (u >= 10) {
+        p -= 2;
+        p[0] = flecs_strbuf_digits[u * 2];
+        p[1] = flecs_strbuf_digits[u * 2 + 1];
+    } else {
+        p --;
+        p[0] = (char)('0' + u);
+    }
 
-		while (p > ptr) {
-			c = *--p;
-			*p = *ptr;
-			*ptr++ = c;
-		}
-		ptr = p1;
-	}
-    return ptr;
+    ecs_size_t len = flecs_ito(ecs_size_t, end - p);
+    ecs_os_memcpy(buf, p, len);
+    return buf + len;
 }
 
 static
@@ -120,6 +131,18 @@ void flecs_strbuf_ftoa(
         }
     }
 
+    /* Fast path for integral values, which don't need the fraction code below.
+     * Values with more than EXP_THRESHOLD trailing zeros are written with an 
+     * exponent, so leave those to the slow path. */
+    if (f > -EXACT_INT_MAX_F && f < EXACT_INT_MAX_F) {
+        int64_t i = (int64_t)f;
+        double d = (double)i;
+        if (ECS_EQ(d, f) && (!i || (i % EXP_THRESHOLD_DIV))) {
+            ecs_strbuf_appendint(out, i);
+            return;
+        }
+    }
+
 	if (precision > MAX_PRECISION) {
 		precision = MAX_PRECISION;
     }
@@ -231,23 +254,48 @@ void flecs_strbuf_ftoa(
     ecs_strbuf_appendstrn(out, buf, (int32_t)(ptr - buf));
 }
 
-/* Add an extra element to the buffer */
+/* Grow buffer so that it can store at least required characters */
 static
 void flecs_strbuf_grow(
-    ecs_strbuf_t *b)
+    ecs_strbuf_t *b,
+    int32_t required)
 {
     if (!b->content) {
         b->content = b->small_string;
         b->size = ECS_STRBUF_SMALL_STRING_SIZE;
-    } else if (b->content == b->small_string) {
-        b->size *= 2;
-        b->content = ecs_os_malloc_n(char, b->size);
+        if (required <= b->size) {
+            return;
+        }
+    }
+
+    int32_t size = b->size * 2;
+    if (size < 16) size = 16;
+    while (size < required) {
+        size *= 2;
+    }
+
+    if (b->content == b->small_string) {
+        b->content = ecs_os_malloc_n(char, size);
         ecs_os_memcpy(b->content, b->small_string, b->length);
     } else {
-        b->size *= 2;
-        if (b->size < 16) b->size = 16;
-        b->content = ecs_os_realloc_n(b->content, char, b->size);
+        b->content = ecs_os_realloc_n(b->content, char, size);
+    }
+
+    b->size = size;
+}
+
+/* Make sure there's space for n characters plus a terminating 0, and return
+ * pointer to the write position. */
+static
+char* flecs_strbuf_reserve(
+    ecs_strbuf_t *b,
+    int32_t n)
+{
+    int32_t required = b->length + n + 1;
+    if (required > b->size) {
+        flecs_strbuf_grow(b, required);
     }
+    return &b->content[b->length];
 }
 
 static
@@ -291,11 +339,7 @@ void flecs_strbuf_vappend(
     ecs_assert(mem_required != -1, ECS_INTERNAL_ERROR, NULL);
 
     if ((mem_required + 1) >= mem_left) {
-        while ((mem_required + 1) >= mem_left) {
-            flecs_strbuf_grow(b);
-            mem_left = b->size - b->length;
-        }
-        vsnprintf(flecs_strbuf_ptr(b), 
+        vsnprintf(flecs_strbuf_reserve(b, mem_required + 1), 
             flecs_itosize(mem_required + 1), str, arg_cpy);
     }
 
@@ -310,13 +354,7 @@ void flecs_strbuf_appendstr(
     const char* str,
     int n)
 {
-    int32_t mem_left = b->size - b->length;
-    while (n >= mem_left) {
-        flecs_strbuf_grow(b);
-        mem_left = b->size - b->length;
-    }
-
-    ecs_os_memcpy(flecs_strbuf_ptr(b), str, n);
+    ecs_os_memcpy(flecs_strbuf_reserve(b, n), str, n);
     b->length += n;
 }
 
@@ -325,14 +363,121 @@ void flecs_strbuf_appendch(
     ecs_strbuf_t *b,
     char ch)
 {
-    if (b->size == b->length) {
-        flecs_strbuf_grow(b);
+    if ((b->length + 2) > b->size) {
+        flecs_strbuf_grow(b, b->length + 2);
     }
 
     flecs_strbuf_ptr(b)[0] = ch;
     b->length ++;
 }
 
+/* Escape character, same as ecs_chresc() but doesn't terminate output */
+static
+char* flecs_strbuf_chresc(
+    char *out, 
+    char in, 
+    char delimiter) 
+{
+    char esc;
+    switch(in) {
+    case '\a':
+        esc = 'a';
+        break;
+    case '\b':
+        esc = 'b';
+        break;
+    case '\f':
+        esc = 'f';
+        break;
+    case '\n':
+        esc = 'n';
+        break;
+    case '\r':
+        esc = 'r';
+        break;
+    case '\t':
+        esc = 't';
+        break;
+    case '\v':
+        esc = 'v';
+        break;
+    case '\\':
+        esc = '\\';
+        break;
+    case '\033':
+        out[0] = '['; /* Used for terminal colors */
+        return out + 1;
+    default:
+        if (in != delimiter) {
+            out[0] = in;
+            return out + 1;
+        }
+        esc = delimiter;
+        break;
+    }
+
+    out[0] = '\\';
+    out[1] = esc;
+    return out + 2;
+}
+
+#define FLECS_STRBUF_ONES (0x0101010101010101ull)
+#define FLECS_STRBUF_HIGH (0x8080808080808080ull)
+
+/* Test 8 characters at a time for a control character, backslash or delimiter.
+ * This uses plain 64bit integer arithmetic (SWAR) so it works on any platform.
+ * The test only needs to be exact about whether a word contains a character
+ * that may need escaping, not about which one. */
+static
+bool flecs_strbuf_has_esc(
+    uint64_t w,
+    uint64_t delimiter)
+{
+    uint64_t ctrl = (w - FLECS_STRBUF_ONES * 0x20) & ~w;
+    uint64_t bs = w ^ (FLECS_STRBUF_ONES * (uint8_t)'\\');
+    uint64_t dl = w ^ delimiter;
+    bs = (bs - FLECS_STRBUF_ONES) & ~bs;
+    dl = (dl - FLECS_STRBUF_ONES) & ~dl;
+    return ((ctrl | bs | dl) & FLECS_STRBUF_HIGH) != 0;
+}
+
+static
+void flecs_strbuf_appendesc(
+    ecs_strbuf_t *b,
+    const char *str,
+    int32_t len,
+    char delimiter)
+{
+    /* Escaping at most doubles the number of characters */
+    char *out = flecs_strbuf_reserve(b, len * 2);
+    char *start = out;
+    uint64_t delim = FLECS_STRBUF_ONES * 
+        (uint8_t)(delimiter ? delimiter : '\\');
+    int32_t i = 0, end;
+
+    while (i < len) {
+        if ((len - i) >= 8) {
+            uint64_t w;
+            ecs_os_memcpy(&w, &str[i], 8);
+            if (!flecs_strbuf_has_esc(w, delim)) {
+                ecs_os_memcpy(out, &str[i], 8);
+                out += 8;
+                i += 8;
+                continue;
+            }
+            end = i + 8;
+        } else {
+            end = len;
+        }
+
+        for (; i < end; i ++) {
+            out = flecs_strbuf_chresc(out, str[i], delimiter);
+        }
+    }
+
+    b->length += flecs_ito(int32_t, out - start);
+}
+
 void ecs_strbuf_vappend(
     ecs_strbuf_t *b,
     const char* fmt,
@@ -380,9 +525,8 @@ void ecs_strbuf_appendint(
     int64_t v)
 {
     ecs_assert(b != NULL, ECS_INVALID_PARAMETER, NULL); 
-    char numbuf[32];
-    char *ptr = flecs_strbuf_itoa(numbuf, v);
-    ecs_strbuf_appendstrn(b, numbuf, flecs_ito(int32_t, ptr - numbuf));
+    char *ptr = flecs_strbuf_reserve(b, 20);
+    b->length += flecs_ito(int32_t, flecs_strbuf_itoa(ptr, v) - ptr);
 }
 
 void ecs_strbuf_appendflt(
@@ -415,12 +559,42 @@ void ecs_strbuf_appendstr(
     flecs_strbuf_appendstr(b, str, ecs_os_strlen(str));
 }
 
+void ecs_strbuf_appendesc(
+    ecs_strbuf_t *b,
+    const char* str,
+    char delimiter)
+{
+    ecs_assert(b != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(str != NULL, ECS_INVALID_PARAMETER, NULL);
+    flecs_strbuf_appendesc(b, str, ecs_os_strlen(str), delimiter);
+}
+
+char* ecs_strbuf_reserve(
+    ecs_strbuf_t *b,
+    int32_t n)
+{
+    ecs_assert(b != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(n >= 0, ECS_INVALID_PARAMETER, NULL);
+    return flecs_strbuf_reserve(b, n);
+}
+
+void ecs_strbuf_commit(
+    ecs_strbuf_t *b,
+    int32_t n)
+{
+    ecs_assert(b != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(n >= 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!n || (b->length + n) < b->size, ECS_INVALID_PARAMETER, 
+        "more characters committed than reserved");
+    b->length += n;
+}
+
 void ecs_strbuf_mergebuff(
     ecs_strbuf_t *b,
     ecs_strbuf_t *src)
 {
     if (src->content) {
-        ecs_strbuf_appendstr(b, src->content);
+        ecs_strbuf_appendstrn(b, src->content, src->length);
     }
     ecs_strbuf_reset(src);
 }
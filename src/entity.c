@@ -3890,7 +3890,12 @@ ecs_entity_t flecs_set_identifier(
         flecs_defer_path(stage, 0, entity, name);
     }
 
-    ecs_os_strset(&ptr->value, name);
+    /* Copy name before freeing the old value, as name could point to it */
+    ecs_world_t *real_world =
+        ECS_CONST_CAST(ecs_world_t*, ecs_get_world(world));
+    char *value = ecs_os_strdup(name);
+    flecs_identifier_free(&real_world->identifiers, ptr);
+    ptr->value = value;
     ecs_modified_pair(world, entity, ecs_id(EcsIdentifier), tag);
     
     return entity;
@@ -4675,6 +4680,7 @@ ecs_table_t* flecs_cmd_batch_add_diff(
 static
 void flecs_cmd_batch_for_entity(
     ecs_world_t *world,
+    ecs_stage_t *stage,
     ecs_table_diff_builder_t *diff,
     ecs_entity_t entity,
     ecs_cmd_t *cmds,
@@ -4686,7 +4692,7 @@ void flecs_cmd_batch_for_entity(
         table = r->table;
     }
 
-    world->info.cmd.batched_entity_count ++;
+    stage->counters.batched_entity_count ++;
 
     ecs_table_t *start_table = table;
     ecs_cmd_t *cmd;
@@ -4733,7 +4739,7 @@ void flecs_cmd_batch_for_entity(
             /* fall through */
         case EcsCmdAdd:
             table = flecs_find_table_add(world, table, id, diff);
-            world->info.cmd.batched_command_count ++;
+            stage->counters.batched_command_count ++;
             break;
         case EcsCmdModified:
             if (start_table) {
@@ -4775,7 +4781,7 @@ void flecs_cmd_batch_for_entity(
         case EcsCmdSet:
         case EcsCmdEnsure:
             table = flecs_find_table_add(world, table, id, diff);
-            world->info.cmd.batched_command_count ++;
+            stage->counters.batched_command_count ++;
             has_set = true;
             break;
         case EcsCmdEmplace:
@@ -4784,7 +4790,7 @@ void flecs_cmd_batch_for_entity(
             break;
         case EcsCmdRemove:
             table = flecs_find_table_remove(world, table, id, diff);
-            world->info.cmd.batched_command_count ++;
+            stage->counters.batched_command_count ++;
             break;
         case EcsCmdClear:
             if (table) {
@@ -4794,7 +4800,7 @@ void flecs_cmd_batch_for_entity(
                     table->type.count);
             }
             table = &world->store.root;
-            world->info.cmd.batched_command_count ++;
+            stage->counters.batched_command_count ++;
             break;
         case EcsCmdClone:
         case EcsCmdBulkNew:
@@ -4933,6 +4939,8 @@ bool flecs_defer_end(
         ecs_vec_t *queue = &commands->queue;
 
         if (ecs_vec_count(queue)) {
+            flecs_trace_begin(world, trace_start);
+
             /* Internal callback for capturing commands */
             if (world->on_commands_active) {
                 world->on_commands_active(stage, queue, 
@@ -4955,9 +4963,10 @@ bool flecs_defer_end(
                 if (merge_to_world && (cmd->next_for_entity < 0)) {
                     /* Batch commands for entity to limit archetype moves */
                     if (is_alive) {
-                        flecs_cmd_batch_for_entity(world, &diff, e, cmds, i);
+                        flecs_cmd_batch_for_entity(
+                            world, stage, &diff, e, cmds, i);
                     } else {
-                        world->info.cmd.discard_count ++;
+                        stage->counters.discard_count ++;
                     }
                 }
 
@@ -4971,7 +4980,7 @@ bool flecs_defer_end(
                  * should be ignored. */
                 ecs_cmd_kind_t kind = cmd->kind;
                 if ((kind != EcsCmdPath) && ((kind == EcsCmdSkip) || (e && !is_alive))) {
-                    world->info.cmd.discard_count ++;
+                    stage->counters.discard_count ++;
                     flecs_discard_cmd(world, cmd);
                     continue;
                 }
@@ -4983,29 +4992,29 @@ bool flecs_defer_end(
                     ecs_assert(id != 0, ECS_INTERNAL_ERROR, NULL);
                     if (flecs_remove_invalid(world, id, &id)) {
                         if (id) {
-                            world->info.cmd.add_count ++;
+                            stage->counters.add_count ++;
                             flecs_add_id(world, e, id);
                         } else {
-                            world->info.cmd.discard_count ++;
+                            stage->counters.discard_count ++;
                         }
                     } else {
-                        world->info.cmd.discard_count ++;
+                        stage->counters.discard_count ++;
                         ecs_delete(world, e);
                     }
                     break;
                 case EcsCmdRemove:
                     flecs_remove_id(world, e, id);
-                    world->info.cmd.remove_count ++;
+                    stage->counters.remove_count ++;
                     break;
                 case EcsCmdClone:
                     ecs_clone(world, e, id, cmd->is._1.clone_value);
-                    world->info.cmd.other_count ++;
+                    stage->counters.other_count ++;
                     break;
                 case EcsCmdSet:
                     flecs_move_ptr_w_id(world, dst_stage, e, 
                         cmd->id, flecs_itosize(cmd->is._1.size), 
                         cmd->is._1.value, kind);
-                    world->info.cmd.set_count ++;
+                    stage->counters.set_count ++;
                     break;
                 case EcsCmdEmplace:
                     if (merge_to_world) {
@@ -5014,53 +5023,53 @@ bool flecs_defer_end(
                     flecs_move_ptr_w_id(world, dst_stage, e, 
                         cmd->id, flecs_itosize(cmd->is._1.size), 
                         cmd->is._1.value, kind);
-                    world->info.cmd.ensure_count ++;
+                    stage->counters.ensure_count ++;
                     break;
                 case EcsCmdEnsure:
                     flecs_move_ptr_w_id(world, dst_stage, e, 
                         cmd->id, flecs_itosize(cmd->is._1.size), 
                         cmd->is._1.value, kind);
-                    world->info.cmd.ensure_count ++;
+                    stage->counters.ensure_count ++;
                     break;
                 case EcsCmdModified:
                     flecs_modified_id_if(world, e, id, true);
-                    world->info.cmd.modified_count ++;
+                    stage->counters.modified_count ++;
                     break;
                 case EcsCmdModifiedNoHook:
                     flecs_modified_id_if(world, e, id, false);
-                    world->info.cmd.modified_count ++;
+                    stage->counters.modified_count ++;
                     break;
                 case EcsCmdAddModified:
                     flecs_add_id(world, e, id);
                     flecs_modified_id_if(world, e, id, true);
-                    world->info.cmd.set_count ++;
+                    stage->counters.set_count ++;
                     break;
                 case EcsCmdDelete: {
                     ecs_delete(world, e);
-                    world->info.cmd.delete_count ++;
+                    stage->counters.delete_count ++;
                     break;
                 }
                 case EcsCmdClear:
                     ecs_clear(world, e);
-                    world->info.cmd.clear_count ++;
+                    stage->counters.clear_count ++;
                     break;
                 case EcsCmdOnDeleteAction:
                     ecs_defer_begin(world);
                     flecs_on_delete(world, id, e, false);
                     ecs_defer_end(world);
-                    world->info.cmd.other_count ++;
+                    stage->counters.other_count ++;
                     break;
                 case EcsCmdEnable:
                     ecs_enable_id(world, e, id, true);
-                    world->info.cmd.other_count ++;
+                    stage->counters.other_count ++;
                     break;
                 case EcsCmdDisable:
                     ecs_enable_id(world, e, id, false);
-                    world->info.cmd.other_count ++;
+                    stage->counters.other_count ++;
                     break;
                 case EcsCmdBulkNew:
                     flecs_flush_bulk_new(world, cmd);
-                    world->info.cmd.other_count ++;
+                    stage->counters.other_count ++;
                     continue;
                 case EcsCmdPath: {
                     bool keep_alive = true;
@@ -5078,7 +5087,7 @@ bool flecs_defer_end(
                     }
                     ecs_os_free(cmd->is._1.value);
                     cmd->is._1.value = NULL;
-                    world->info.cmd.other_count ++;
+                    stage->counters.other_count ++;
                     break;
                 }
                 case EcsCmdEvent: {
@@ -5086,7 +5095,7 @@ bool flecs_defer_end(
                     ecs_assert(desc != NULL, ECS_INTERNAL_ERROR, NULL);
                     ecs_emit((ecs_world_t*)stage, desc);
                     flecs_free_cmd_event(world, desc);
-                    world->info.cmd.event_count ++;
+                    stage->counters.event_count ++;
                     break;
                 }
                 case EcsCmdSkip:
@@ -5104,6 +5113,10 @@ bool flecs_defer_end(
 
             flecs_table_diff_builder_fini(world, &diff);
 
+            /* Commands are merged by the main thread */
+            flecs_trace_end(world, &world->stages[0], EcsTraceMerge, 
+                flecs_ito(uint64_t, stage->id), count, trace_start);
+
             /* Internal callback for capturing commands, signal queue is done */
             if (world->on_commands_active) {
                 world->on_commands_active(stage, NULL, 
@@ -120,12 +120,15 @@ ecs_entity_t flecs_get_builtin(
 static
 bool flecs_is_sep(
     const char **ptr,
-    const char *sep)
+    const char *sep,
+    ecs_size_t sep_len)
 {
-    ecs_size_t len = ecs_os_strlen(sep);
+    if ((*ptr)[0] != sep[0]) {
+        return false;
+    }
 
-    if (!ecs_os_strncmp(*ptr, sep, len)) {
-        *ptr += len;
+    if (sep_len == 1 || !ecs_os_strncmp(*ptr, sep, sep_len)) {
+        *ptr += sep_len;
         return true;
     } else {
         return false;
@@ -136,6 +139,7 @@ static
 const char* flecs_path_elem(
     const char *path,
     const char *sep,
+    ecs_size_t sep_len,
     int32_t *len)
 {
     const char *ptr;
@@ -152,7 +156,7 @@ const char* flecs_path_elem(
 
         ecs_check(template_nesting >= 0, ECS_INVALID_PARAMETER, path);
 
-        if (!template_nesting && flecs_is_sep(&ptr, sep)) {
+        if (!template_nesting && flecs_is_sep(&ptr, sep, sep_len)) {
             break;
         }
 
@@ -210,6 +214,34 @@ ecs_entity_t flecs_get_parent_from_path(
     return parent;
 }
 
+/* Copy path element to buffer, which is reallocated if the element doesn't 
+ * fit, and lookup the element in parent. */
+static
+ecs_entity_t flecs_lookup_child_n(
+    const ecs_world_t *world,
+    ecs_entity_t parent,
+    const char *name,
+    int32_t len,
+    char **buf,
+    int32_t *size)
+{
+    char *elem = *buf;
+    if (len >= *size) {
+        if (*size == ECS_NAME_BUFFER_LENGTH) {
+            elem = NULL;
+        }
+
+        elem = ecs_os_realloc(elem, len + 1);
+        *buf = elem;
+        *size = len + 1;
+    }
+
+    ecs_os_memcpy(elem, name, len);
+    elem[len] = '\0';
+
+    return ecs_lookup_child(world, parent, elem);
+}
+
 static
 void flecs_on_set_symbol(ecs_iter_t *it) {
     EcsIdentifier *n = ecs_field(it, EcsIdentifier, 1);
@@ -371,9 +403,11 @@ ecs_entity_t ecs_lookup_path_w_sep(
         return e;
     }
 
-    e = flecs_name_index_find(&world->aliases, path, 0, 0);
-    if (e) {
-        return e;
+    if (!flecs_name_index_is_empty(&world->aliases)) {
+        e = flecs_name_index_find(&world->aliases, path, 0, 0);
+        if (e) {
+            return e;
+        }
     }
 
     char buff[ECS_NAME_BUFFER_LENGTH];
@@ -399,27 +433,15 @@ ecs_entity_t ecs_lookup_path_w_sep(
         return ecs_lookup_child(world, parent, path);
     }
 
+    ecs_size_t sep_len = ecs_os_strlen(sep);
+
 retry:
     cur = parent;
     ptr_start = ptr = path;
 
-    while ((ptr = flecs_path_elem(ptr, sep, &len))) {
-        if (len < size) {
-            ecs_os_memcpy(elem, ptr_start, len);
-        } else {
-            if (size == ECS_NAME_BUFFER_LENGTH) {
-                elem = NULL;
-            }
-
-            elem = ecs_os_realloc(elem, len + 1);
-            ecs_os_memcpy(elem, ptr_start, len);
-            size = len + 1;
-        }
-
-        elem[len] = '\0';
+    while ((ptr = flecs_path_elem(ptr, sep, sep_len, &len))) {
+        cur = flecs_lookup_child_n(world, cur, ptr_start, len, &elem, &size);
         ptr_start = ptr;
-
-        cur = ecs_lookup_child(world, cur, elem);
         if (!cur) {
             goto tail;
         }
@@ -454,6 +476,175 @@ error:
     return 0;
 }
 
+/* Maximum number of path elements for which a bulk lookup caches scopes */
+#define FLECS_LOOKUP_CACHE_DEPTH (32)
+
+/* Resolve path from parent, using scopes of path prefixes that were resolved
+ * by earlier paths. Cache keys include the root prefix, so that paths that 
+ * start from the root don't share entries with relative paths. */
+static
+ecs_entity_t flecs_lookup_path_cached(
+    const ecs_world_t *world,
+    ecs_hashmap_t *cache,
+    ecs_entity_t parent,
+    const char *path,
+    const char *sep,
+    ecs_size_t sep_len,
+    const char *prefix,
+    char **buf,
+    int32_t *size)
+{
+    const char *start = path;
+    if (flecs_is_root_path(path, prefix)) {
+        path += ecs_os_strlen(prefix);
+        parent = 0;
+    }
+
+    /* Find elements of path */
+    int32_t elem_start[FLECS_LOOKUP_CACHE_DEPTH];
+    int32_t elem_len[FLECS_LOOKUP_CACHE_DEPTH];
+    uint64_t hash[FLECS_LOOKUP_CACHE_DEPTH];
+    const char *ptr = path, *ptr_start = path;
+    int32_t len, i, depth = 0;
+    while ((ptr = flecs_path_elem(ptr, sep, sep_len, &len))) {
+        if (depth == FLECS_LOOKUP_CACHE_DEPTH) {
+            return ecs_lookup_path_w_sep(
+                world, parent, start, sep, prefix, false);
+        }
+
+        elem_start[depth] = flecs_ito(int32_t, ptr_start - start);
+        elem_len[depth] = len;
+        ptr_start = ptr;
+        depth ++;
+    }
+
+    /* Find the longest prefix that is already resolved. Usually this is the
+     * scope of the last element, as paths often share a parent. */
+    ecs_entity_t cur = parent;
+    int32_t first = 0;
+    for (i = depth - 1; i > 0; i --) {
+        ecs_size_t prefix_len = elem_start[i - 1] + elem_len[i - 1];
+        ecs_hashed_string_t key = {
+            .value = ECS_CONST_CAST(char*, start),
+            .length = prefix_len,
+            .hash = flecs_hash(start, prefix_len)
+        };
+
+        hash[i] = key.hash;
+
+        const uint64_t *e = flecs_hashmap_get(cache, &key, uint64_t);
+        if (e) {
+            cur = e[0];
+            first = i;
+            break;
+        }
+    }
+
+    /* Resolve remaining elements, and add resolved scopes to the cache */
+    for (i = first; i < depth; i ++) {
+        cur = flecs_lookup_child_n(
+            world, cur, &start[elem_start[i]], elem_len[i], buf, size);
+        if (!cur) {
+            break;
+        }
+
+        if (i < (depth - 1)) {
+            ecs_size_t prefix_len = elem_start[i] + elem_len[i];
+            ecs_hashed_string_t key = {
+                .value = ECS_CONST_CAST(char*, start),
+                .length = prefix_len,
+                .hash = hash[i + 1] /* Computed while searching the cache */
+            };
+            flecs_hashmap_set(cache, &key, &cur);
+        }
+    }
+
+    return cur;
+}
+
+int32_t ecs_bulk_lookup_path(
+    const ecs_world_t *world,
+    ecs_entity_t parent,
+    const char *const *paths,
+    int32_t count,
+    const char *sep,
+    const char *prefix,
+    bool recursive,
+    ecs_entity_t *entities)
+{
+    ecs_check(world != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(count >= 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!count || paths != NULL, ECS_INVALID_PARAMETER, NULL);
+    ecs_check(!count || entities != NULL, ECS_INVALID_PARAMETER, NULL);
+
+    const ecs_world_t *stage = world;
+    world = ecs_get_world(world);
+
+    if (!sep) {
+        sep = ".";
+    }
+
+    ecs_size_t sep_len = ecs_os_strlen(sep);
+    bool has_aliases = !flecs_name_index_is_empty(&world->aliases);
+    ecs_entity_t scope = parent ? parent : ecs_get_scope(stage);
+
+    ecs_hashmap_t cache;
+    flecs_name_index_init(&cache, NULL);
+
+    char buff[ECS_NAME_BUFFER_LENGTH];
+    char *elem = buff;
+    int32_t i, size = ECS_NAME_BUFFER_LENGTH, found = 0;
+
+    for (i = 0; i < count; i ++) {
+        const char *path = paths[i];
+        ecs_entity_t e = 0;
+        if (!path) {
+            goto next;
+        }
+
+        if (!sep[0]) {
+            e = ecs_lookup_path_w_sep(stage, parent, path, sep, prefix, 
+                recursive);
+            goto next;
+        }
+
+        e = flecs_get_builtin(path);
+        if (e) {
+            goto next;
+        }
+
+        if (has_aliases) {
+            e = flecs_name_index_find(&world->aliases, path, 0, 0);
+            if (e) {
+                goto next;
+            }
+        }
+
+        e = flecs_lookup_path_cached(world, &cache, scope, path, sep, sep_len,
+            prefix, &elem, &size);
+
+        /* Searching parents of the scope and the lookup path doesn't benefit 
+         * from the cache, as it's done only for paths that weren't found. */
+        if (!e && recursive) {
+            e = ecs_lookup_path_w_sep(stage, parent, path, sep, prefix, true);
+        }
+
+next:
+        entities[i] = e;
+        found += (e != 0);
+    }
+
+    if (elem != buff) {
+        ecs_os_free(elem);
+    }
+
+    flecs_name_index_fini(&cache);
+
+    return found;
+error:
+    return 0;
+}
+
 ecs_entity_t ecs_set_scope(
     ecs_world_t *world,
     ecs_entity_t scope)
@@ -558,6 +749,8 @@ ecs_entity_t ecs_add_path_w_sep(
         sep = ".";
     }
 
+    ecs_size_t sep_len = ecs_os_strlen(sep);
+
     if (!path) {
         if (!entity) {
             entity = ecs_new_id(world);
@@ -589,7 +782,7 @@ ecs_entity_t ecs_add_path_w_sep(
     char *name = NULL;
 
     if (sep[0]) {
-        while ((ptr = flecs_path_elem(ptr, sep, &len))) {
+        while ((ptr = flecs_path_elem(ptr, sep, sep_len, &len))) {
             if (len < size) {
                 ecs_os_memcpy(elem, ptr_start, len);
             } else {
@@ -615,7 +808,7 @@ ecs_entity_t ecs_add_path_w_sep(
 
                 /* If this is the last entity in the path, use the provided id */
                 bool last_elem = false;
-                if (!flecs_path_elem(ptr, sep, NULL)) {
+                if (!flecs_path_elem(ptr, sep, sep_len, NULL)) {
                     e = entity;
                     last_elem = true;
                 }
@@ -1041,6 +1041,8 @@ bool ecs_worker_next_instanced(
     ecs_worker_iter_t *iter = &it->priv.iter.worker;
     int32_t res_count = iter->count, res_index = iter->index;
     int32_t per_worker, instances_per_worker, first;
+    bool table_affinity = ECS_BIT_IS_SET(
+        it->real_world->flags, EcsWorldWorkerTableAffinity);
 
     do {
         if (!ecs_iter_next(chain_it)) {
@@ -1055,6 +1057,21 @@ bool ecs_worker_next_instanced(
 
         int32_t count = it->count;
         int32_t instance_count = it->instance_count;
+
+        if (table_affinity && it->table) {
+            /* Assign table to worker by id, so that all rows of a table are
+             * processed by the same worker each frame */
+            first = 0;
+            if ((int32_t)(it->table->id % (uint64_t)res_count) == res_index) {
+                per_worker = count;
+                instances_per_worker = instance_count;
+            } else {
+                per_worker = 0;
+                instances_per_worker = 0;
+            }
+            continue;
+        }
+
         per_worker = count / res_count;
         instances_per_worker = instance_count / res_count;
         first = per_worker * res_index;
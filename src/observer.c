@@ -300,9 +300,11 @@ void flecs_observer_invoke(
 
     ecs_log_push_3();
 
+    flecs_trace_begin(world, trace_start);
+
     ecs_entity_t old_system = flecs_stage_set_system(
         &world->stages[0], observer->filter.entity);
-    world->info.observers_ran_frame ++;
+    world->stages[0].counters.observers_ran ++;
 
     ecs_filter_t *filter = &observer->filter;
     ecs_assert(term_index < filter->term_count, ECS_INTERNAL_ERROR, NULL);
@@ -353,6 +355,9 @@ void flecs_observer_invoke(
 
     flecs_stage_set_system(&world->stages[0], old_system);
 
+    flecs_trace_end(world, &world->stages[0], EcsTraceObserver, 
+        observer->filter.entity, 0, trace_start);
+
     ecs_log_pop_3();
 }
 
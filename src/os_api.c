@@ -331,6 +331,56 @@ void ecs_os_api_free(void *ptr) {
     free(ptr);
 }
 
+/* The pointer returned by malloc is stored right before the aligned memory, so
+ * that it can be passed to free. */
+static
+void* ecs_os_api_aligned_alloc(ecs_size_t size, ecs_size_t alignment) {
+    ecs_assert(size > 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(alignment > 0, ECS_INVALID_PARAMETER, NULL);
+    ecs_assert(!(alignment & (alignment - 1)), ECS_INVALID_PARAMETER,
+        "alignment must be a power of 2");
+
+    if (alignment < ECS_SIZEOF(void*)) {
+        alignment = ECS_SIZEOF(void*);
+    }
+
+    void *ptr = ecs_os_malloc(size + alignment + ECS_SIZEOF(void*));
+    if (!ptr) {
+        return NULL;
+    }
+
+    uintptr_t mask = (uintptr_t)alignment - 1;
+    uintptr_t addr = ((uintptr_t)ptr + sizeof(void*) + mask) & ~mask;
+    ((void**)addr)[-1] = ptr;
+    return (void*)addr;
+}
+
+static
+void ecs_os_api_aligned_free(void *ptr) {
+    if (ptr) {
+        ecs_os_free(((void**)ptr)[-1]);
+    }
+}
+
+/* Without an OS specific implementation pages are allocated from the heap, and
+ * the NUMA node and flags are ignored. */
+static
+void* ecs_os_api_page_alloc(
+    ecs_size_t size, 
+    int32_t numa_node, 
+    ecs_flags32_t flags)
+{
+    (void)numa_node;
+    (void)flags;
+    return ecs_os_aligned_alloc(size, 4096);
+}
+
+static
+void ecs_os_api_page_free(void *ptr, ecs_size_t size) {
+    (void)size;
+    ecs_os_aligned_free(ptr);
+}
+
 static
 char* ecs_os_api_strdup(const char *str) {
     if (str) {
@@ -422,6 +472,10 @@ void ecs_os_set_api_defaults(void)
     ecs_os_api.free_ = ecs_os_api_free;
     ecs_os_api.realloc_ = ecs_os_api_realloc;
     ecs_os_api.calloc_ = ecs_os_api_calloc;
+    ecs_os_api.aligned_alloc_ = ecs_os_api_aligned_alloc;
+    ecs_os_api.aligned_free_ = ecs_os_api_aligned_free;
+    ecs_os_api.page_alloc_ = ecs_os_api_page_alloc;
+    ecs_os_api.page_free_ = ecs_os_api_page_free;
 
     /* Strings */
     ecs_os_api.strdup_ = ecs_os_api_strdup;
@@ -461,6 +515,13 @@ bool ecs_os_has_heap(void) {
         (ecs_os_api.free_ != NULL);
 }
 
+bool ecs_os_has_vm(void) {
+    return 
+        (ecs_os_api.vm_reserve_ != NULL) &&
+        (ecs_os_api.vm_commit_ != NULL) &&
+        (ecs_os_api.vm_release_ != NULL);
+}
+
 bool ecs_os_has_threading(void) {
     return
         (ecs_os_api.mutex_new_ != NULL) &&
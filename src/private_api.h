@@ -47,6 +47,11 @@ void flecs_bootstrap(
 /* Bootstrap functions for other parts in the code */
 void flecs_bootstrap_hierarchy(ecs_world_t *world);
 
+/* Free identifier string, release it if it's owned by the string pool */
+void flecs_identifier_free(
+    ecs_hashmap_t *pool,
+    EcsIdentifier *ptr);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 //// Entity API
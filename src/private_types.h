@@ -12,6 +12,12 @@
 #endif
 #endif
 
+/* Enables Linux extensions used by the OS API implementation, like anonymous
+ * memory mappings, mbind and thread affinity */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include <stdlib.h>
 #include <limits.h>
 #include <stdio.h>
@@ -29,6 +35,9 @@ extern const ecs_entity_t EcsFlag;
 #define ECS_MAX_JOBS_PER_WORKER (16)
 #define ECS_MAX_DEFER_STACK (8)
 
+/* Size of a cache line, used to keep data written by different threads apart */
+#define ECS_CACHE_LINE_SIZE (64)
+
 /* Magic number for a flecs object */
 #define ECS_OBJECT_MAGIC (0x6563736f)
 
@@ -309,7 +318,16 @@ typedef struct ecs_world_allocators_t {
     ecs_table_diff_builder_t diff_builder;
 } ecs_world_allocators_t;
 
-/* Stage level allocators are for operations that can be multithreaded */
+/* State of incremental memory compaction (see ecs_set_compaction()) */
+typedef struct ecs_compaction_t {
+    ecs_compaction_desc_t desc;
+    ecs_compaction_stats_t stats;
+    int32_t phase;                   /* Phase of current pass */
+    int32_t cursor;                  /* Next table or allocator in phase */
+} ecs_compaction_t;
+
+/* Stage level allocators are for operations that can be multithreaded. They
+ * share free chunks through the stage depot of the world. */
 typedef struct ecs_stage_allocators_t {
     ecs_stack_t iter_stack;
     ecs_stack_t deser_stack;
@@ -384,6 +402,59 @@ typedef void (*ecs_on_commands_action_t)(
     const ecs_vec_t *commands,
     void *ctx);
 
+/** Kinds of events recorded by the trace addon */
+typedef enum ecs_trace_kind_t {
+    EcsTraceFrame,
+    EcsTraceSystem,
+    EcsTraceMerge,
+    EcsTraceObserver,
+    EcsTraceTable
+} ecs_trace_kind_t;
+
+/** Event recorded by the trace addon */
+typedef struct ecs_trace_event_t {
+    int64_t start;              /* Nanoseconds since start of trace */
+    int64_t duration;           /* Nanoseconds */
+    uint64_t id;                /* Frame, system, observer, stage or table id */
+    ecs_trace_kind_t kind;
+    int32_t count;              /* Number of merged commands */
+} ecs_trace_event_t;
+
+/** Ring buffer with trace events. Events are only recorded by the thread that
+ * owns the stage, so no locks or atomics are needed. */
+typedef struct ecs_trace_buffer_t {
+    ecs_trace_event_t *events;
+    int32_t capacity;           /* Power of 2 */
+    int64_t count;              /* Number of events recorded since start */
+} ecs_trace_buffer_t;
+
+/** Statistics counters of a stage. Counters are only updated by the thread 
+ * that owns the stage, and are added up when statistics are requested. This 
+ * prevents threads from writing to the same counters. */
+typedef struct ecs_stage_counters_t {
+    int64_t systems_ran;
+    int64_t observers_ran;
+
+    /* Command counts */
+    int64_t add_count;
+    int64_t remove_count;
+    int64_t delete_count;
+    int64_t clear_count;
+    int64_t set_count;
+    int64_t ensure_count;
+    int64_t modified_count;
+    int64_t discard_count;
+    int64_t event_count;
+    int64_t other_count;
+    int64_t batched_entity_count;
+    int64_t batched_command_count;
+
+    /* Time measurements (see ecs_measure_stage_time()) */
+    double system_time;         /* Time spent in systems */
+    double wait_time;           /* Time spent waiting at sync points */
+    double merge_time;          /* Time spent merging commands of stage */
+} ecs_stage_counters_t;
+
 /** A stage is a context that allows for safely using the API from multiple 
  * threads. Stage pointers can be passed to the world argument of API 
  * operations, which causes the operation to be ran on the stage instead of the
@@ -430,6 +501,18 @@ struct ecs_stage_t {
     /* Caches for rule creation */
     ecs_vec_t variables;
     ecs_vec_t operations;
+
+    /* Time spent per system (see ecs_measure_stage_time()) */
+    ecs_map_t system_time;           /* map<system, double*> */
+    ecs_time_t sync_time;            /* Time at which worker reached sync */
+
+    /* Events recorded by trace addon (see ecs_trace_start()) */
+    ecs_trace_buffer_t trace;
+
+    /* Statistics counters. Padding makes sure that the counters don't share a
+     * cache line with the next stage. */
+    ecs_stage_counters_t counters;
+    char counters_padding[ECS_CACHE_LINE_SIZE];
 };
 
 /* Component monitor */
@@ -530,6 +613,7 @@ struct ecs_world_t {
     /* -- Identifiers -- */
     ecs_hashmap_t aliases;
     ecs_hashmap_t symbols;
+    ecs_hashmap_t identifiers;       /* Pool with interned identifier strings */
 
     /* -- Staging -- */
     ecs_stage_t *stages;             /* Stages */
@@ -544,6 +628,17 @@ struct ecs_world_t {
     void *on_commands_ctx;
     void *on_commands_ctx_active;
 
+    /* Internal callback that's invoked before the world is used at the start
+     * of a frame and when the world is deleted. Used by addons that access the
+     * world from another thread while the world is idle between frames. */
+    ecs_fini_action_t on_frame_begin;
+    void *on_frame_begin_ctx;
+
+    /* Internal callback that's invoked as the last step of ecs_progress, after
+     * which the world isn't used until the next frame begins. */
+    ecs_fini_action_t on_frame_end;
+    void *on_frame_end_ctx;
+
     /* -- Multithreading -- */
     ecs_os_cond_t worker_cond;       /* Signal that worker threads can start */
     ecs_os_cond_t sync_cond;         /* Signal that worker thread job is done */
@@ -552,14 +647,19 @@ struct ecs_world_t {
     int32_t workers_waiting;         /* Number of workers waiting on sync */
     ecs_pipeline_state_t* pq;        /* Pointer to the pipeline for the workers to execute */
     bool workers_use_task_api;       /* Workers are short-lived tasks, not long-running threads */
+    ecs_vec_t worker_affinity;       /* Placement of worker threads (see ecs_set_worker_affinity()) */
 
     /* -- Time management -- */
     ecs_time_t world_start_time;     /* Timestamp of simulation start */
     ecs_time_t frame_start_time;     /* Timestamp of frame start */
+    ecs_time_t trace_start_time;     /* Timestamp of trace start */
+    ecs_time_t trace_frame_time;     /* Timestamp of frame start when tracing */
+    int32_t trace_capacity;          /* Number of trace events per stage */
     ecs_ftime_t fps_sleep;           /* Sleep time to prevent fps overshoot */
 
     /* -- Metrics -- */
     ecs_world_info_t info;
+    ecs_stage_counters_t stage_counters; /* Counters of deleted stages */
 
     /* -- World flags -- */
     ecs_flags32_t flags;
@@ -573,6 +673,9 @@ struct ecs_world_t {
     /* -- Allocators -- */
     ecs_world_allocators_t allocators; /* Static allocation sizes */
     ecs_allocator_t allocator;       /* Dynamic allocation sizes */
+    ecs_block_allocator_arena_t *arena; /* Arena for allocator blocks (optional) */
+    ecs_block_allocator_depot_t *stage_depot; /* Free chunks shared by stages */
+    ecs_compaction_t compaction;     /* Incremental memory compaction */
 
     void *ctx;                       /* Application context */
     void *binding_ctx;               /* Binding-specific context */
@@ -69,6 +69,25 @@ ecs_cmd_t* flecs_cmd_new_batched(
     return cmd;
 }
 
+/* Merge commands of stage, and measure time per stage if enabled */
+static
+void flecs_stage_merge(
+    ecs_world_t *world,
+    ecs_stage_t *stage)
+{
+    if (!(world->flags & EcsWorldMeasureStageTime)) {
+        flecs_defer_end(world, stage);
+        return;
+    }
+
+    /* Worker threads are not running during a merge, so it's safe to update
+     * the counters of their stages. */
+    ecs_time_t t_start = {0};
+    ecs_os_get_time(&t_start);
+    flecs_defer_end(world, stage);
+    stage->counters.merge_time += ecs_time_measure(&t_start);
+}
+
 static
 void flecs_stages_merge(
     ecs_world_t *world,
@@ -95,7 +114,7 @@ void flecs_stages_merge(
         if (force_merge || stage->auto_merge) {
             ecs_assert(stage->defer == 1, ECS_INVALID_OPERATION, 
                 "mismatching defer_begin/defer_end detected");
-            flecs_defer_end(world, stage);
+            flecs_stage_merge(world, stage);
         }
     } else {
         /* Merge stages. Only merge if the stage has auto_merging turned on, or 
@@ -105,7 +124,7 @@ void flecs_stages_merge(
             ecs_stage_t *s = (ecs_stage_t*)ecs_get_stage(world, i);
             ecs_poly_assert(s, ecs_stage_t);
             if (force_merge || s->auto_merge) {
-                flecs_defer_end(world, s);
+                flecs_stage_merge(world, s);
             }
         }
     }
@@ -121,6 +140,8 @@ void flecs_stages_merge(
     /* If stage is asynchronous, deferring is always enabled */
     if (stage->async) {
         flecs_defer_begin(world, stage);
+    } else {
+        flecs_stage_counters_aggregate(world);
     }
     
     ecs_log_pop_3();
@@ -611,6 +632,69 @@ void flecs_commands_pop(
     stage->cmd = &stage->cmd_stack[sp];
 }
 
+static
+void flecs_stage_counters_add(
+    ecs_stage_counters_t *dst,
+    const ecs_stage_counters_t *src)
+{
+    dst->systems_ran += src->systems_ran;
+    dst->observers_ran += src->observers_ran;
+    dst->add_count += src->add_count;
+    dst->remove_count += src->remove_count;
+    dst->delete_count += src->delete_count;
+    dst->clear_count += src->clear_count;
+    dst->set_count += src->set_count;
+    dst->ensure_count += src->ensure_count;
+    dst->modified_count += src->modified_count;
+    dst->discard_count += src->discard_count;
+    dst->event_count += src->event_count;
+    dst->other_count += src->other_count;
+    dst->batched_entity_count += src->batched_entity_count;
+    dst->batched_command_count += src->batched_command_count;
+    dst->system_time += src->system_time;
+    dst->wait_time += src->wait_time;
+    dst->merge_time += src->merge_time;
+}
+
+void flecs_stage_counters_get(
+    const ecs_world_t *world,
+    ecs_world_info_t *info)
+{
+    ecs_poly_assert(world, ecs_world_t);
+
+    if (world->flags & EcsWorldMultiThreaded) {
+        /* Counters are being updated by worker threads */
+        return;
+    }
+
+    ecs_stage_counters_t sum = world->stage_counters;
+    int32_t i, count = world->stage_count;
+    for (i = 0; i < count; i ++) {
+        flecs_stage_counters_add(&sum, &world->stages[i].counters);
+    }
+
+    info->systems_ran_frame = sum.systems_ran;
+    info->observers_ran_frame = sum.observers_ran;
+    info->cmd.add_count = sum.add_count;
+    info->cmd.remove_count = sum.remove_count;
+    info->cmd.delete_count = sum.delete_count;
+    info->cmd.clear_count = sum.clear_count;
+    info->cmd.set_count = sum.set_count;
+    info->cmd.ensure_count = sum.ensure_count;
+    info->cmd.modified_count = sum.modified_count;
+    info->cmd.discard_count = sum.discard_count;
+    info->cmd.event_count = sum.event_count;
+    info->cmd.other_count = sum.other_count;
+    info->cmd.batched_entity_count = sum.batched_entity_count;
+    info->cmd.batched_command_count = sum.batched_command_count;
+}
+
+void flecs_stage_counters_aggregate(
+    ecs_world_t *world)
+{
+    flecs_stage_counters_get(world, &world->info);
+}
+
 void flecs_stage_init(
     ecs_world_t *world,
     ecs_stage_t *stage)
@@ -625,9 +709,10 @@ void flecs_stage_init(
 
     flecs_stack_init(&stage->allocators.iter_stack);
     flecs_stack_init(&stage->allocators.deser_stack);
-    flecs_allocator_init(&stage->allocator);
-    flecs_ballocator_init_n(&stage->allocators.cmd_entry_chunk, ecs_cmd_entry_t,
-        FLECS_SPARSE_PAGE_SIZE);
+    flecs_allocator_init_w_depot(&stage->allocator, world->stage_depot);
+    flecs_ballocator_init_w_depot(&stage->allocators.cmd_entry_chunk, 
+        FLECS_SPARSE_PAGE_SIZE * ECS_SIZEOF(ecs_cmd_entry_t), 
+        world->stage_depot);
 
     ecs_allocator_t *a = &stage->allocator;
     ecs_vec_init_t(a, &stage->post_frame_actions, ecs_action_elem_t, 0);
@@ -638,24 +723,37 @@ void flecs_stage_init(
     }
 
     stage->cmd = &stage->cmd_stack[0];
+
+    ecs_map_init(&stage->system_time, a);
+    ecs_os_zeromem(&stage->trace);
+    ecs_os_zeromem(&stage->counters);
 }
 
 void flecs_stage_fini(
     ecs_world_t *world,
     ecs_stage_t *stage)
 {
-    (void)world;
     ecs_poly_assert(world, ecs_world_t);
     ecs_poly_assert(stage, ecs_stage_t);
 
     ecs_poly_fini(stage, ecs_stage_t);
 
+    /* Keep counters of stage so that world statistics don't go backwards */
+    flecs_stage_counters_add(&world->stage_counters, &stage->counters);
+
     ecs_allocator_t *a = &stage->allocator;
     
     ecs_vec_fini_t(a, &stage->post_frame_actions, ecs_action_elem_t);
     ecs_vec_fini(NULL, &stage->variables, 0);
     ecs_vec_fini(NULL, &stage->operations, 0);
 
+    ecs_map_iter_t it = ecs_map_iter(&stage->system_time);
+    while (ecs_map_next(&it)) {
+        ecs_os_free(ecs_map_ptr(&it));
+    }
+    ecs_map_fini(&stage->system_time);
+    ecs_os_free(stage->trace.events);
+
     int32_t i;
     for (i = 0; i < ECS_MAX_DEFER_STACK; i ++) {
         flecs_commands_fini(stage, &stage->cmd_stack[i]);
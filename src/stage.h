@@ -16,6 +16,15 @@ void flecs_stage_fini(
     ecs_world_t *world,
     ecs_stage_t *stage);
 
+/* Add up statistics counters of stages and store them in info */
+void flecs_stage_counters_get(
+    const ecs_world_t *world,
+    ecs_world_info_t *info);
+
+/* Add up statistics counters of stages and store them in world info */
+void flecs_stage_counters_aggregate(
+    ecs_world_t *world);
+
 /* Post-frame merge actions */
 void flecs_stage_merge_post_frame(
     ecs_world_t *world,
@@ -2305,6 +2305,14 @@ void flecs_table_replace_data(
         flecs_table_init_data(world, table);
     }
 
+    /* All table data changed */
+    if (table->dirty_state) {
+        int32_t i, column_count = table->column_count;
+        for (i = 0; i <= column_count; i ++) {
+            table->dirty_state[i] ++;
+        }
+    }
+
     int32_t count = ecs_table_count(table);
 
     if (!prev_count && count) {
@@ -2316,6 +2324,74 @@ void flecs_table_replace_data(
     flecs_table_check_sanity(table);
 }
 
+/* Replace data of table with a copy of the provided entities and columns. This
+ * reuses the storage of the table, unlike flecs_table_replace_data which takes
+ * ownership of new storage. Union and bitset columns are not copied. */
+void flecs_table_copy_data(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    const ecs_vec_t *entities,
+    const ecs_vec_t **columns)
+{
+    ecs_data_t *table_data = &table->data;
+    ecs_assert(!table->_->lock, ECS_LOCKED_STORAGE, NULL);
+    ecs_assert(!table->_->sw_count, ECS_UNSUPPORTED, NULL);
+    ecs_assert(!table->_->bs_count, ECS_UNSUPPORTED, NULL);
+
+    flecs_table_check_sanity(table);
+
+    int32_t prev_count = ecs_table_count(table);
+    flecs_table_notify_on_remove(world, table, table_data);
+    if (prev_count) {
+        flecs_table_dtor_all(
+            world, table, table_data, 0, prev_count, false, false);
+    }
+
+    ecs_allocator_t *a = &world->allocator;
+    int32_t i, count = entities ? ecs_vec_count(entities) : 0;
+    ecs_vec_set_count_t(a, &table_data->entities, ecs_entity_t, count);
+    if (count) {
+        ecs_os_memcpy_n(ecs_vec_first(&table_data->entities), 
+            ecs_vec_first(entities), ecs_entity_t, count);
+    }
+
+    int32_t column_count = table->column_count;
+    for (i = 0; i < column_count; i ++) {
+        ecs_column_t *column = &table_data->columns[i];
+        ecs_vec_set_count(a, &column->data, column->size, count);
+        if (!count) {
+            continue;
+        }
+
+        ecs_assert(ecs_vec_count(columns[i]) == count, 
+            ECS_INTERNAL_ERROR, NULL);
+        void *dst = ecs_vec_first(&column->data);
+        const void *src = ecs_vec_first(columns[i]);
+        ecs_copy_t copy = column->ti->hooks.copy_ctor;
+        if (copy) {
+            copy(dst, src, count, column->ti);
+        } else {
+            ecs_os_memcpy(dst, src, column->size * count);
+        }
+    }
+
+    table->_->traversable_count = 0;
+    table->flags &= ~EcsTableHasTraversable;
+
+    /* All table data changed */
+    if (table->dirty_state) {
+        for (i = 0; i <= column_count; i ++) {
+            table->dirty_state[i] ++;
+        }
+    }
+
+    if (!prev_count != !count) {
+        flecs_table_set_empty(world, table);
+    }
+
+    flecs_table_check_sanity(table);
+}
+
 /* Internal mechanism for propagating information to tables */
 void flecs_table_notify(
     ecs_world_t *world,
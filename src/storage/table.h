@@ -219,6 +219,13 @@ void flecs_table_replace_data(
     ecs_table_t *table,
     ecs_data_t *data);
 
+/* Replace data with copy of entities and columns, reusing table storage */
+void flecs_table_copy_data(
+    ecs_world_t *world,
+    ecs_table_t *table,
+    const ecs_vec_t *entities,
+    const ecs_vec_t **columns);
+
 /* Merge data of one table into another table */
 void flecs_table_merge(
     ecs_world_t *world,
@@ -537,6 +537,8 @@ ecs_table_t *flecs_create_table(
     flecs_hashmap_result_t table_elem,
     ecs_table_t *prev)
 {
+    flecs_trace_begin(world, trace_start);
+
     ecs_table_t *result = flecs_sparse_add_t(&world->store.tables, ecs_table_t);
     ecs_assert(result != NULL, ECS_INTERNAL_ERROR, NULL);
     result->_ = flecs_calloc_t(&world->allocator, ecs_table__t);
@@ -587,6 +589,9 @@ ecs_table_t *flecs_create_table(
     world->info.empty_table_count ++;
     world->info.table_create_total ++;
 
+    flecs_trace_end(world, &world->stages[0], EcsTraceTable, result->id, 0, 
+        trace_start);
+
     ecs_log_pop_2();
 
     return result;
@@ -724,8 +724,10 @@ void flecs_world_allocators_init(
     ecs_world_t *world)
 {
     ecs_world_allocators_t *a = &world->allocators;
+    ecs_block_allocator_arena_t *arena = world->arena;
 
-    flecs_allocator_init(&world->allocator);
+    flecs_allocator_init_w_arena(&world->allocator, arena);
+    world->stage_depot = flecs_ballocator_depot_new();
 
     ecs_map_params_init(&a->ptr, &world->allocator);
     ecs_map_params_init(&a->query_table_list, &world->allocator);
@@ -740,6 +742,18 @@ void flecs_world_allocators_init(
     flecs_ballocator_init_n(&a->sparse_chunk, int32_t, FLECS_SPARSE_PAGE_SIZE);
     flecs_ballocator_init_t(&a->hashmap, ecs_hashmap_t);
     flecs_table_diff_builder_init(world, &world->allocators.diff_builder);
+
+    if (arena) {
+        a->query_table.arena = arena;
+        a->query_table_match.arena = arena;
+        a->graph_edge_lo.arena = arena;
+        a->graph_edge.arena = arena;
+        a->id_record.arena = arena;
+        a->id_record_chunk.arena = arena;
+        a->table_diff.arena = arena;
+        a->sparse_chunk.arena = arena;
+        a->hashmap.arena = arena;
+    }
 }
 
 static
@@ -763,6 +777,17 @@ void flecs_world_allocators_fini(
     flecs_table_diff_builder_fini(world, &world->allocators.diff_builder);
 
     flecs_allocator_fini(&world->allocator);
+
+    /* Stage allocators have returned their chunks when stages were deleted */
+    flecs_ballocator_depot_free(world->stage_depot);
+    world->stage_depot = NULL;
+
+    /* Release all blocks of the world allocators in one go */
+    if (world->arena) {
+        flecs_ballocator_arena_fini(world->arena);
+        ecs_os_free(world->arena);
+        world->arena = NULL;
+    }
 }
 
 #define ECS_STRINGIFY_INNER(x) #x
@@ -806,6 +831,9 @@ static const char *flecs_addons_info[] = {
 #ifdef FLECS_MONITOR
     "FLECS_MONITOR",
 #endif
+#ifdef FLECS_TRACE
+    "FLECS_TRACE",
+#endif
 #ifdef FLECS_METRICS
     "FLECS_METRICS",
 #endif
@@ -923,7 +951,10 @@ const ecs_world_info_t* ecs_get_world_info(
     return &world->info;
 }
 
-ecs_world_t *ecs_mini(void) {
+static
+ecs_world_t* flecs_mini(
+    bool use_arena)
+{
 #ifdef FLECS_OS_API_IMPL
     ecs_set_os_api_impl();
 #endif
@@ -954,6 +985,12 @@ ecs_world_t *ecs_mini(void) {
 
     world->flags |= EcsWorldInit;
 
+    if (use_arena) {
+        world->arena = ecs_os_calloc_t(ecs_block_allocator_arena_t);
+        flecs_ballocator_arena_init(world->arena);
+        ecs_trace("world allocators use arena");
+    }
+
     flecs_world_allocators_init(world);
     ecs_allocator_t *a = &world->allocator;
 
@@ -974,6 +1011,7 @@ ecs_world_t *ecs_mini(void) {
 
     flecs_name_index_init(&world->aliases, a);
     flecs_name_index_init(&world->symbols, a);
+    flecs_name_index_init(&world->identifiers, a);
     ecs_vec_init_t(a, &world->fini_actions, ecs_action_elem_t, 0);
 
     world->info.time_scale = 1.0;
@@ -996,9 +1034,10 @@ ecs_world_t *ecs_mini(void) {
     return world;
 }
 
-ecs_world_t *ecs_init(void) {
-    ecs_world_t *world = ecs_mini();
-
+static
+void flecs_import_addons(
+    ecs_world_t *world)
+{
 #ifdef FLECS_MODULE_H
     ecs_trace("#[bold]import addons");
     ecs_log_push();
@@ -1029,7 +1068,28 @@ ecs_world_t *ecs_init(void) {
 #endif
     ecs_trace("addons imported!");
     ecs_log_pop();
+#else
+    (void)world;
 #endif
+}
+
+ecs_world_t *ecs_mini(void) {
+    return flecs_mini(false);
+}
+
+ecs_world_t* ecs_mini_w_arena(void) {
+    return flecs_mini(true);
+}
+
+ecs_world_t *ecs_init(void) {
+    ecs_world_t *world = ecs_mini();
+    flecs_import_addons(world);
+    return world;
+}
+
+ecs_world_t* ecs_init_w_arena(void) {
+    ecs_world_t *world = ecs_mini_w_arena();
+    flecs_import_addons(world);
     return world;
 }
 
@@ -1386,11 +1446,9 @@ static
 void flecs_fini_type_info(
     ecs_world_t *world)
 {
-    int32_t i, count = flecs_sparse_count(&world->type_info);
-    ecs_sparse_t *type_info = &world->type_info;
-    for (i = 0; i < count; i ++) {
-        ecs_type_info_t *ti = flecs_sparse_get_dense_t(type_info,
-            ecs_type_info_t, i);
+    ecs_sparse_iter_t it = flecs_sparse_iter(&world->type_info);
+    ecs_type_info_t *ti;
+    while ((ti = flecs_sparse_next_t(&it, ecs_type_info_t, NULL))) {
         flecs_type_info_fini(ti);
     }
     flecs_sparse_fini(&world->type_info);
@@ -1426,6 +1484,11 @@ int ecs_fini(
 
     world->flags |= EcsWorldQuit;
 
+    /* Make sure no other thread is accessing the world */
+    if (world->on_frame_begin) {
+        world->on_frame_begin(world, world->on_frame_begin_ctx);
+    }
+
     /* Delete root entities first using regular APIs. This ensures that cleanup
      * policies get a chance to execute. */
     ecs_dbg_1("#[bold]cleanup root entities");
@@ -1487,6 +1550,7 @@ int ecs_fini(
     flecs_observable_fini(&world->observable);
     flecs_name_index_fini(&world->aliases);
     flecs_name_index_fini(&world->symbols);
+    flecs_string_pool_fini(&world->identifiers);
     ecs_set_stage_count(world, 0);
     ecs_log_pop_1();
 
@@ -1551,6 +1615,17 @@ error:
     return;
 }
 
+void ecs_measure_stage_time(
+    ecs_world_t *world,
+    bool enable)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    ecs_check(ecs_os_has_time(), ECS_MISSING_OS_API, NULL);
+    ECS_BIT_COND(world->flags, EcsWorldMeasureStageTime, enable);
+error:
+    return;
+}
+
 void ecs_set_target_fps(
     ecs_world_t *world,
     ecs_ftime_t fps)
@@ -1646,6 +1721,16 @@ bool ecs_enable_range_check(
     return old_value;
 }
 
+bool ecs_enable_name_interning(
+    ecs_world_t *world,
+    bool enable)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    bool old_value = ECS_BIT_IS_SET(world->flags, EcsWorldInternIdentifiers);
+    ECS_BIT_COND(world->flags, EcsWorldInternIdentifiers, enable);
+    return old_value;
+}
+
 ecs_entity_t ecs_get_max_id(
     const ecs_world_t *world)
 {
@@ -1860,10 +1945,14 @@ ecs_ftime_t flecs_insert_sleep(
     return delta_time;
 }
 
+/* Measures the time passed since the start of the last frame, and sleeps if
+ * the frame is early. This only reads the world, which may still be used by
+ * another thread. The start of the new frame is stored in frame_start. */
 static
 ecs_ftime_t flecs_start_measure_frame(
     ecs_world_t *world,
-    ecs_ftime_t user_delta_time)
+    ecs_ftime_t user_delta_time,
+    ecs_time_t *frame_start)
 {
     ecs_poly_assert(world, ecs_world_t);
 
@@ -1894,10 +1983,7 @@ ecs_ftime_t flecs_start_measure_frame(
         /* Keep trying while delta_time is zero */
         } while (ECS_EQZERO(delta_time));
 
-        world->frame_start_time = t;
-
-        /* Keep track of total time passed in world */
-        world->info.world_time_total_raw += (ecs_ftime_t)delta_time;
+        *frame_start = t;
     }
 
     return (ecs_ftime_t)delta_time;
@@ -1925,11 +2011,32 @@ ecs_ftime_t ecs_frame_begin(
         ECS_MISSING_OS_API, "get_time");
 
     /* Start measuring total frame time */
-    ecs_ftime_t delta_time = flecs_start_measure_frame(world, user_delta_time);
+    ecs_time_t frame_start = {0, 0};
+    ecs_ftime_t delta_time = flecs_start_measure_frame(
+        world, user_delta_time, &frame_start);
     if (ECS_EQZERO(user_delta_time)) {
         user_delta_time = delta_time;
     }
 
+    /* Make sure no other thread is accessing the world before it's modified.
+     * Other threads can read the world while the frame sleeps. */
+    if (world->on_frame_begin) {
+        world->on_frame_begin(world, world->on_frame_begin_ctx);
+    }
+
+    if (frame_start.sec || frame_start.nanosec) {
+        world->frame_start_time = frame_start;
+
+        /* Keep track of total time passed in world */
+        world->info.world_time_total_raw += delta_time;
+    }
+
+#ifdef FLECS_TRACE
+    if (world->flags & EcsWorldTrace) {
+        ecs_os_get_time(&world->trace_frame_time);
+    }
+#endif
+
     world->info.delta_time_raw = user_delta_time;
     world->info.delta_time = user_delta_time * world->info.time_scale;
 
@@ -1958,12 +2065,31 @@ void ecs_frame_end(
 
     world->info.frame_count_total ++;
 
+#ifdef FLECS_TRACE
+    /* Record before post frame actions, which can hand the world to another
+     * thread. Skip frames that started before the trace. */
+    if ((world->flags & EcsWorldTrace) && 
+        (world->trace_frame_time.sec || world->trace_frame_time.nanosec)) 
+    {
+        flecs_trace_record(world, &world->stages[0], EcsTraceFrame, 
+            flecs_ito(uint64_t, world->info.frame_count_total), 0, 
+            &world->trace_frame_time);
+    }
+#endif
+
+    /* Compact before post frame actions, which can hand the world to another
+     * thread until the next frame starts. */
+    if (ECS_NEQZERO(world->compaction.desc.time_budget_seconds)) {
+        ecs_compact(world, world->compaction.desc.time_budget_seconds);
+    }
+
     ecs_stage_t *stages = world->stages;
     int32_t i, count = world->stage_count;
     for (i = 0; i < count; i ++) {
         flecs_stage_merge_post_frame(world, &stages[i]);
     }
 
+    flecs_stage_counters_aggregate(world);
     flecs_stop_measure_frame(world);
 
     /* Reset command handler each frame */
@@ -2238,3 +2364,229 @@ done:
 
     return delete_count;
 }
+
+/* Phases of a compaction pass */
+#define EcsCompactTables (0)
+#define EcsCompactAllocators (1)
+#define EcsCompactStacks (2)
+
+static
+int64_t flecs_compact_table_capacity(
+    const ecs_table_t *table)
+{
+    int64_t result = (int64_t)table->data.entities.size * 
+        ECS_SIZEOF(ecs_entity_t);
+    int32_t i, count = table->column_count;
+    for (i = 0; i < count; i ++) {
+        const ecs_column_t *column = &table->data.columns[i];
+        result += (int64_t)column->data.size * column->size;
+    }
+    return result;
+}
+
+static
+void flecs_compact_table_shrink(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    ecs_compaction_stats_t *stats = &world->compaction.stats;
+    int64_t capacity = flecs_compact_table_capacity(table);
+    if (flecs_table_shrink(world, table)) {
+        stats->column_bytes += capacity - flecs_compact_table_capacity(table);
+        stats->shrink_count ++;
+    }
+}
+
+/* Compact a single table. Returns true if the table was deleted. */
+static
+bool flecs_compact_table(
+    ecs_world_t *world,
+    ecs_table_t *table)
+{
+    const ecs_compaction_desc_t *desc = &world->compaction.desc;
+
+    if (table->_->lock) {
+        return false;
+    }
+
+    int32_t count = ecs_table_count(table);
+    if (count) {
+        /* Only shrink tables that have lost most of their entities, so that
+         * tables that are still growing don't have to reallocate. */
+        if (table->data.entities.size > (count * 2)) {
+            flecs_compact_table_shrink(world, table);
+        }
+        return false;
+    }
+
+    uint16_t gen = ++ table->_->generation;
+    if (desc->delete_generation && (gen > desc->delete_generation)) {
+        world->compaction.stats.column_bytes += 
+            flecs_compact_table_capacity(table);
+        world->compaction.stats.delete_count ++;
+        flecs_table_free(world, table);
+        return true;
+    } else if (desc->clear_generation && (gen > desc->clear_generation)) {
+        flecs_compact_table_shrink(world, table);
+    }
+
+    return false;
+}
+
+/* Return block allocator for allocator phase, or NULL if phase is done */
+static
+ecs_block_allocator_t* flecs_compact_get_ballocator(
+    ecs_world_t *world,
+    int32_t index)
+{
+    ecs_sparse_t *sizes = &world->allocator.sizes;
+    int32_t count = flecs_sparse_count(sizes);
+    if (index < count) {
+        return flecs_sparse_get_dense_t(sizes, ecs_block_allocator_t, index);
+    }
+
+    ecs_world_allocators_t *a = &world->allocators;
+    ecs_block_allocator_t *allocators[] = {
+        &a->ptr.entry_allocator,
+        &a->query_table_list.entry_allocator,
+        &a->query_table,
+        &a->query_table_match,
+        &a->graph_edge_lo,
+        &a->graph_edge,
+        &a->id_record,
+        &a->id_record_chunk,
+        &a->table_diff,
+        &a->sparse_chunk,
+        &a->hashmap,
+        &world->allocator.chunks,
+        &world->store.entity_index.page_allocator
+    };
+
+    index -= count;
+    if (index < (ECS_SIZEOF(allocators) / ECS_SIZEOF(allocators[0]))) {
+        return allocators[index];
+    }
+
+    return NULL;
+}
+
+static
+void flecs_compact_stacks(
+    ecs_world_t *world)
+{
+    ecs_compaction_stats_t *stats = &world->compaction.stats;
+    int32_t i, s;
+    for (s = 0; s < world->stage_count; s ++) {
+        ecs_stage_t *stage = &world->stages[s];
+        for (i = 0; i < ECS_MAX_DEFER_STACK; i ++) {
+            stats->stack_bytes += flecs_stack_trim(&stage->cmd_stack[i].stack);
+        }
+        stats->stack_bytes += flecs_stack_trim(&stage->allocators.iter_stack);
+        stats->stack_bytes += flecs_stack_trim(&stage->allocators.deser_stack);
+    }
+}
+
+void ecs_set_compaction(
+    ecs_world_t *world,
+    const ecs_compaction_desc_t *desc)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    ecs_compaction_t *c = &world->compaction;
+    if (desc) {
+        ecs_check(desc->time_budget_seconds >= 0, ECS_INVALID_PARAMETER, NULL);
+        c->desc = *desc;
+    } else {
+        ecs_os_zeromem(&c->desc);
+    }
+error:
+    return;
+}
+
+bool ecs_compact(
+    ecs_world_t *world,
+    double time_budget_seconds)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    ecs_check(!(world->flags & EcsWorldReadonly), ECS_INVALID_OPERATION, NULL);
+    ecs_check(!(world->flags & EcsWorldMultiThreaded), 
+        ECS_INVALID_OPERATION, NULL);
+
+    ecs_compaction_t *c = &world->compaction;
+    ecs_time_t start = {0}, cur;
+    bool time_budget = ECS_NEQZERO(time_budget_seconds);
+    if (time_budget) {
+        ecs_time_measure(&start);
+    }
+
+    /* Make sure empty tables are in the empty table lists */
+    ecs_run_aperiodic(world, EcsAperiodicEmptyTables);
+
+    while (c->phase <= EcsCompactStacks) {
+        if (time_budget) {
+            cur = start;
+            if (ecs_time_measure(&cur) > time_budget_seconds) {
+                return false;
+            }
+        }
+
+        if (c->phase == EcsCompactTables) {
+            ecs_sparse_t *tables = &world->store.tables;
+            if (!c->cursor) {
+                c->cursor = 1; /* Skip dummy table with id 0 */
+            }
+
+            if (c->cursor >= flecs_sparse_count(tables)) {
+                c->phase ++;
+                c->cursor = 0;
+                continue;
+            }
+
+            ecs_table_t *table = flecs_sparse_get_dense_t(
+                tables, ecs_table_t, c->cursor);
+
+            /* When a table is deleted, the last table is moved to its place */
+            if (!flecs_compact_table(world, table)) {
+                c->cursor ++;
+            }
+        } else if (c->phase == EcsCompactAllocators) {
+            ecs_block_allocator_t *ba = flecs_compact_get_ballocator(
+                world, c->cursor);
+            if (!ba) {
+                c->phase ++;
+                c->cursor = 0;
+                continue;
+            }
+
+            c->stats.block_bytes += flecs_ballocator_trim(ba);
+            c->cursor ++;
+        } else {
+            flecs_compact_stacks(world);
+            c->phase ++;
+        }
+    }
+
+    c->phase = EcsCompactTables;
+    c->cursor = 0;
+    c->stats.pass_count ++;
+    return true;
+error:
+    return false;
+}
+
+const ecs_compaction_stats_t* ecs_get_compaction_stats(
+    const ecs_world_t *world)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    return &world->compaction.stats;
+}
+
+bool ecs_set_reserved_storage(
+    ecs_world_t *world,
+    ecs_size_t reserve_size)
+{
+    ecs_poly_assert(world, ecs_world_t);
+    ecs_check(reserve_size >= 0, ECS_INVALID_PARAMETER, NULL);
+    return flecs_allocator_set_vm_reserve(&world->allocator, reserve_size);
+error:
+    return false;
+}
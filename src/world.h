@@ -114,6 +114,35 @@ void flecs_resume_readonly(
     ecs_world_t *world,
     ecs_suspend_readonly_state_t *state);
 
+#ifdef FLECS_TRACE
+/* Record event in the trace of a stage. Events are recorded when they end, with
+ * the time at which they started. */
+void flecs_trace_record(
+    ecs_world_t *world,
+    ecs_stage_t *stage,
+    ecs_trace_kind_t kind,
+    uint64_t id,
+    int32_t count,
+    const ecs_time_t *start);
+
+/* Store start time of event in t if the world is recording a trace. */
+#define flecs_trace_begin(world, t)\
+    ecs_time_t t = {0};\
+    bool t##_traced = ((world)->flags & EcsWorldTrace) != 0;\
+    if (t##_traced) {\
+        ecs_os_get_time(&t);\
+    }
+
+/* Record event that started at t, if t was stored by flecs_trace_begin. */
+#define flecs_trace_end(world, stage, kind, id, count, t)\
+    if (t##_traced) {\
+        flecs_trace_record(world, stage, kind, id, count, &t);\
+    }
+#else
+#define flecs_trace_begin(world, t)
+#define flecs_trace_end(world, stage, kind, id, count, t)
+#endif
+
 /* Convenience macro's for world allocator */
 #define flecs_walloc(world, size)\
     flecs_alloc(&world->allocator, size)
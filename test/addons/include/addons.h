@@ -107,6 +107,36 @@ bool test_iter(
 const ecs_entity_t* bulk_new_w_type(
     ecs_world_t *world, ecs_entity_t type_ent, int32_t count);
 
+#ifdef ECS_TARGET_POSIX
+
+// Utilities for sending requests to a HTTP server over a socket
+typedef struct http_test_recv_t {
+    char *data;
+    int32_t length;
+    bool closed;
+} http_test_recv_t;
+
+int http_test_connect(
+    uint16_t port,
+    int rcvbuf);
+
+void http_test_send(
+    int sock,
+    const char *str);
+
+// Receive data that's available within timeout (ms)
+void http_test_recv_some(
+    int sock,
+    http_test_recv_t *r,
+    int timeout);
+
+// Count occurrences of str in received data
+int32_t http_test_count(
+    const http_test_recv_t *r,
+    const char *str);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,10 @@
 #include <addons.h>
 
+#ifdef ECS_TARGET_POSIX
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 static bool OnRequest(
     const ecs_http_request_t* request, 
     ecs_http_reply_t *reply,
@@ -8,6 +13,16 @@ static bool OnRequest(
     return true;
 }
 
+static bool OnRequestPath(
+    const ecs_http_request_t* request, 
+    ecs_http_reply_t *reply,
+    void *ctx)
+{
+    ecs_strbuf_appendstr(ctx, request->path);
+    ecs_strbuf_appendch(ctx, ';');
+    return true;
+}
+
 void Http_teardown(void) {
     ecs_set_os_api_impl();
 
@@ -68,3 +83,671 @@ void Http_stop_start(void) {
     
     ecs_http_server_fini(srv);
 }
+
+void Http_request_leading_empty_line(void) {
+    ecs_set_os_api_impl();
+
+    ecs_strbuf_t paths = ECS_STRBUF_INIT;
+    ecs_http_server_t *srv = ecs_http_server_init(&(ecs_http_server_desc_t){
+        .port = 27754,
+        .callback = OnRequestPath,
+        .ctx = &paths
+    });
+
+    test_assert(srv != NULL);
+
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    const char *req = "\r\nGET /foo HTTP/1.1\r\n\r\n";
+    test_int(ecs_http_server_http_request(srv, req, 0, &reply), 0);
+    test_int(reply.code, 200);
+    ecs_os_free(reply.body.content);
+
+    char *str = ecs_strbuf_get(&paths);
+    test_str(str, "foo;");
+    ecs_os_free(str);
+
+    ecs_http_server_fini(srv);
+}
+
+void Http_request_invalid_request_line(void) {
+    ecs_set_os_api_impl();
+
+    ecs_http_server_t *srv = ecs_http_server_init(&(ecs_http_server_desc_t){
+        .port = 27755,
+        .callback = OnRequest
+    });
+
+    test_assert(srv != NULL);
+
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    const char *req = "GARBAGE\r\n\r\n";
+    test_int(ecs_http_server_http_request(srv, req, 0, &reply), -1);
+    test_int(reply.code, 400);
+    ecs_os_free(reply.body.content);
+
+    ecs_http_server_fini(srv);
+}
+
+void Http_request_pipelined(void) {
+    ecs_set_os_api_impl();
+
+    ecs_strbuf_t paths = ECS_STRBUF_INIT;
+    ecs_http_server_t *srv = ecs_http_server_init(&(ecs_http_server_desc_t){
+        .port = 27756,
+        .callback = OnRequestPath,
+        .ctx = &paths
+    });
+
+    test_assert(srv != NULL);
+
+    /* Only the first request is handled */
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    const char *req = 
+        "GET /foo HTTP/1.1\r\n\r\n"
+        "GET /bar HTTP/1.1\r\n\r\n";
+    test_int(ecs_http_server_http_request(srv, req, 0, &reply), 0);
+    test_int(reply.code, 200);
+    ecs_os_free(reply.body.content);
+
+    char *str = ecs_strbuf_get(&paths);
+    test_str(str, "foo;");
+    ecs_os_free(str);
+
+    ecs_http_server_fini(srv);
+}
+
+#ifdef ECS_TARGET_POSIX
+
+#define HTTP_TEST_LARGE_CHUNK (64 * 1024)
+#define HTTP_TEST_BIG_BODY (4 * 1024 * 1024)
+#define HTTP_TEST_GZIP_CHUNK (8 * 1024)
+#define HTTP_TEST_GZIP_CHUNK_COUNT (8)
+
+typedef struct {
+    ecs_strbuf_t paths;
+    int request_sock;       /* Socket on which "large" sends a request */
+    int32_t large_chunks;   /* Chunks flushed by "large" */
+    bool flush_failed;
+} http_test_ctx_t;
+
+static const char *http_test_request_foo = "GET /foo HTTP/1.1\r\n\r\n";
+
+static bool OnSocketRequest(
+    const ecs_http_request_t* request, 
+    ecs_http_reply_t *reply,
+    void *ctx)
+{
+    http_test_ctx_t *c = ctx;
+    ecs_strbuf_appendstr(&c->paths, request->path);
+    ecs_strbuf_appendch(&c->paths, ';');
+
+    if (!ecs_os_strcmp(request->path, "large")) {
+        if (c->request_sock != -1) {
+            /* Received by the server thread while the reply is flushed */
+            test_assert(send(c->request_sock, http_test_request_foo, 
+                strlen(http_test_request_foo), 0) > 0);
+        }
+
+        char *chunk = ecs_os_malloc(HTTP_TEST_LARGE_CHUNK);
+        ecs_os_memset(chunk, 'x', HTTP_TEST_LARGE_CHUNK);
+        int32_t i;
+        for (i = 0; i < c->large_chunks; i ++) {
+            ecs_strbuf_appendstrn(&reply->body, chunk, HTTP_TEST_LARGE_CHUNK);
+            if (ecs_http_reply_flush(request, reply)) {
+                c->flush_failed = true;
+                break;
+            }
+        }
+        ecs_os_free(chunk);
+    } else if (!ecs_os_strcmp(request->path, "many")) {
+        /* Each flush queues a send request */
+        int32_t i;
+        for (i = 0; i < 300; i ++) {
+            ecs_strbuf_appendch(&reply->body, 'x');
+            test_int(ecs_http_reply_flush(request, reply), 0);
+        }
+    } else if (!ecs_os_strcmp(request->path, "gzip")) {
+        /* Chunks that don't compress by themselves, but repeat each other */
+        char *chunk = ecs_os_malloc(HTTP_TEST_GZIP_CHUNK);
+        uint32_t seed = 1;
+        int32_t i;
+        for (i = 0; i < HTTP_TEST_GZIP_CHUNK; i ++) {
+            seed = seed * 1103515245 + 12345;
+            chunk[i] = (char)('a' + ((seed >> 16) % 26));
+        }
+        for (i = 0; i < HTTP_TEST_GZIP_CHUNK_COUNT; i ++) {
+            ecs_strbuf_appendstrn(&reply->body, chunk, HTTP_TEST_GZIP_CHUNK);
+            test_int(ecs_http_reply_flush(request, reply), 0);
+        }
+        ecs_os_free(chunk);
+    } else if (!ecs_os_strcmp(request->path, "big")) {
+        char *body = ecs_os_malloc(HTTP_TEST_BIG_BODY);
+        int32_t i;
+        for (i = 0; i < HTTP_TEST_BIG_BODY; i ++) {
+            body[i] = (char)('a' + (i % 26));
+        }
+        ecs_strbuf_appendstrn(&reply->body, body, HTTP_TEST_BIG_BODY);
+        ecs_os_free(body);
+    } else {
+        ecs_strbuf_appendstr(&reply->body, request->path);
+    }
+
+    return true;
+}
+
+static
+ecs_http_server_t* http_test_server(
+    uint16_t port,
+    http_test_ctx_t *ctx)
+{
+    ecs_set_os_api_impl();
+
+    ecs_os_zeromem(ctx);
+    ctx->request_sock = -1;
+
+    ecs_http_server_t *srv = ecs_http_server_init(&(ecs_http_server_desc_t){
+        .port = port,
+        .ipaddr = "127.0.0.1",
+        .callback = OnSocketRequest,
+        .ctx = ctx
+    });
+    test_assert(srv != NULL);
+    test_int(ecs_http_server_start(srv), 0);
+    return srv;
+}
+
+/* Dequeue requests and receive data until count occurrences of str have been
+ * received, or the connection is closed. */
+static
+void http_test_recv(
+    ecs_http_server_t *srv,
+    int sock,
+    http_test_recv_t *r,
+    const char *str,
+    int32_t count)
+{
+    ecs_time_t t = {0};
+    ecs_time_measure(&t);
+    while (http_test_count(r, str) < count && !r->closed) {
+        ecs_time_t now = t;
+        test_assert(ecs_time_measure(&now) < 10.0);
+        ecs_http_server_dequeue(srv, 1.0);
+        http_test_recv_some(sock, r, 10);
+    }
+}
+
+/* Decoder for the deflate blocks the server encodes, which are fixed Huffman
+ * blocks and empty stored blocks */
+typedef struct {
+    const uint8_t *in;
+    int32_t length;
+    int32_t bit;
+} http_test_bits_t;
+
+static
+uint32_t http_test_bits(
+    http_test_bits_t *b,
+    int32_t count)
+{
+    uint32_t result = 0;
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        test_assert((b->bit >> 3) < b->length);
+        uint32_t bit = (b->in[b->bit >> 3] >> (b->bit & 7)) & 1;
+        result |= bit << i;
+        b->bit ++;
+    }
+    return result;
+}
+
+/* Huffman codes are packed starting at the most significant bit */
+static
+uint32_t http_test_code(
+    http_test_bits_t *b,
+    uint32_t code,
+    int32_t count)
+{
+    int32_t i;
+    for (i = 0; i < count; i ++) {
+        code = (code << 1) | http_test_bits(b, 1);
+    }
+    return code;
+}
+
+static
+int32_t http_test_symbol(
+    http_test_bits_t *b)
+{
+    uint32_t code = http_test_code(b, 0, 7);
+    if (code <= 0x17) {
+        return 256 + (int32_t)code;
+    }
+    code = http_test_code(b, code, 1);
+    if (code >= 0x30 && code <= 0xBF) {
+        return (int32_t)code - 0x30;
+    }
+    if (code >= 0xC0 && code <= 0xC7) {
+        return 280 + (int32_t)code - 0xC0;
+    }
+    code = http_test_code(b, code, 1);
+    test_assert(code >= 0x190 && code <= 0x1FF);
+    return 144 + (int32_t)code - 0x190;
+}
+
+static
+uint32_t http_test_crc32(
+    const uint8_t *data,
+    int32_t length)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    int32_t i, k;
+    for (i = 0; i < length; i ++) {
+        crc ^= data[i];
+        for (k = 0; k < 8; k ++) {
+            crc = (crc & 1) ? (0xEDB88320u ^ (crc >> 1)) : (crc >> 1);
+        }
+    }
+    return ~crc;
+}
+
+/* Returns decoded data, which must be freed */
+static
+char* http_test_gunzip(
+    const uint8_t *in,
+    int32_t length,
+    int32_t *length_out)
+{
+    static const uint16_t length_base[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 
+        59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    static const uint8_t length_extra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 
+        4, 5, 5, 5, 5, 0
+    };
+    static const uint16_t dist_base[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385,
+        513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+    };
+    static const uint8_t dist_extra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10,
+        10, 11, 11, 12, 12, 13, 13
+    };
+
+    test_assert(length > 18);
+    test_int(in[0], 0x1f);
+    test_int(in[1], 0x8b);
+    test_int(in[2], 8);
+
+    http_test_bits_t b = { .in = in, .length = length, .bit = 10 * 8 };
+    uint8_t *out = NULL;
+    int32_t count = 0, size = 0;
+
+    bool last;
+    do {
+        last = http_test_bits(&b, 1);
+        uint32_t type = http_test_bits(&b, 2);
+        if (type == 0) {
+            b.bit = (b.bit + 7) & ~7;
+            uint32_t len = http_test_bits(&b, 16);
+            uint32_t nlen = http_test_bits(&b, 16);
+            test_int(len, ~nlen & 0xFFFF);
+            test_int(len, 0);
+            continue;
+        }
+
+        test_int(type, 1);
+        int32_t sym;
+        while ((sym = http_test_symbol(&b)) != 256) {
+            if (count + 258 > size) {
+                size = (size + 258) * 2;
+                out = ecs_os_realloc(out, size);
+            }
+
+            if (sym < 256) {
+                out[count ++] = (uint8_t)sym;
+                continue;
+            }
+
+            sym -= 257;
+            test_assert(sym < 29);
+            int32_t len = length_base[sym] + 
+                (int32_t)http_test_bits(&b, length_extra[sym]);
+            int32_t d = (int32_t)http_test_code(&b, 0, 5);
+            test_assert(d < 30);
+            int32_t dist = dist_base[d] + 
+                (int32_t)http_test_bits(&b, dist_extra[d]);
+            test_assert(dist <= count);
+
+            int32_t i;
+            for (i = 0; i < len; i ++, count ++) {
+                out[count] = out[count - dist];
+            }
+        }
+    } while (!last);
+
+    b.bit = (b.bit + 7) & ~7;
+    uint32_t crc = http_test_bits(&b, 32);
+    uint32_t isize = http_test_bits(&b, 32);
+    test_int(b.bit, length * 8);
+    test_assert(crc == http_test_crc32(out, count));
+    test_int(isize, count);
+
+    *length_out = count;
+    return (char*)out;
+}
+
+/* Returns the body of a chunked reply, which must be freed */
+static
+char* http_test_dechunk(
+    const char *reply,
+    int32_t length,
+    int32_t *length_out)
+{
+    const char *ptr = strstr(reply, "\r\n\r\n");
+    test_assert(ptr != NULL);
+    ptr += 4;
+
+    char *out = ecs_os_malloc(length);
+    int32_t count = 0;
+    for (;;) {
+        char *end;
+        long chunk = strtol(ptr, &end, 16);
+        test_assert(end != ptr);
+        test_assert(!ecs_os_strncmp(end, "\r\n", 2));
+        ptr = end + 2;
+        if (!chunk) {
+            break;
+        }
+        test_assert((ptr - reply) + chunk + 2 <= length);
+        ecs_os_memcpy(&out[count], ptr, (int32_t)chunk);
+        count += (int32_t)chunk;
+        ptr += chunk;
+        test_assert(!ecs_os_strncmp(ptr, "\r\n", 2));
+        ptr += 2;
+    }
+
+    *length_out = count;
+    return out;
+}
+
+static
+void http_test_server_fini(
+    ecs_http_server_t *srv,
+    http_test_ctx_t *ctx)
+{
+    ecs_http_server_fini(srv);
+    ecs_strbuf_reset(&ctx->paths);
+}
+
+void Http_socket_keep_alive(void) {
+    http_test_ctx_t ctx;
+    ecs_http_server_t *srv = http_test_server(27757, &ctx);
+
+    int sock = http_test_connect(27757, 0);
+    http_test_recv_t r = {0};
+
+    http_test_send(sock, "GET /foo HTTP/1.1\r\n\r\n");
+    http_test_recv(srv, sock, &r, "foo", 1);
+    test_int(http_test_count(&r, "HTTP/1.1 200"), 1);
+
+    /* Second request is received on the same connection */
+    http_test_send(sock, "GET /bar HTTP/1.1\r\n\r\n");
+    http_test_recv(srv, sock, &r, "bar", 1);
+    test_bool(r.closed, false);
+    test_int(http_test_count(&r, "HTTP/1.1 200"), 2);
+    test_int(http_test_count(&r, "Connection: close"), 0);
+
+    char *paths = ecs_strbuf_get(&ctx.paths);
+    test_str(paths, "foo;bar;");
+    ecs_os_free(paths);
+
+    close(sock);
+    ecs_os_free(r.data);
+    http_test_server_fini(srv, &ctx);
+}
+
+void Http_socket_pipelined_reply_order(void) {
+    http_test_ctx_t ctx;
+    ecs_http_server_t *srv = http_test_server(27758, &ctx);
+
+    int sock = http_test_connect(27758, 0);
+    http_test_recv_t r = {0};
+
+    /* Requests are handled in a different order than they were received, but
+     * replies are sent in the order of the requests */
+    http_test_send(sock, 
+        "GET /first HTTP/1.1\r\n\r\n"
+        "GET /second HTTP/1.1\r\n\r\n"
+        "GET /third HTTP/1.1\r\n\r\n");
+    ecs_os_sleep(0, 100 * 1000 * 1000);
+    http_test_recv(srv, sock, &r, "HTTP/1.1 200", 3);
+    http_test_recv(srv, sock, &r, "third", 1);
+
+    const char *first = strstr(r.data, "first");
+    const char *second = strstr(r.data, "second");
+    const char *third = strstr(r.data, "third");
+    test_assert(first != NULL);
+    test_assert(second != NULL);
+    test_assert(third != NULL);
+    test_assert(first < second);
+    test_assert(second < third);
+
+    close(sock);
+    ecs_os_free(r.data);
+    http_test_server_fini(srv, &ctx);
+}
+
+void Http_socket_partial_send(void) {
+    http_test_ctx_t ctx;
+    ecs_http_server_t *srv = http_test_server(27759, &ctx);
+
+    /* Small receive buffer, so the reply doesn't fit in the socket buffers
+     * and is sent in parts as the client receives data */
+    int sock = http_test_connect(27759, 4096);
+    http_test_recv_t r = {0};
+
+    http_test_send(sock, "GET /big HTTP/1.1\r\n\r\n");
+    ecs_os_sleep(0, 100 * 1000 * 1000);
+    ecs_http_server_dequeue(srv, 1.0);
+
+    /* Don't read until the server had to wait for the socket */
+    ecs_os_sleep(0, 200 * 1000 * 1000);
+
+    ecs_time_t t = {0};
+    ecs_time_measure(&t);
+    const char *body = NULL;
+    while (!r.closed) {
+        http_test_recv_some(sock, &r, 10);
+        body = r.data ? strstr(r.data, "\r\n\r\n") : NULL;
+        if (body && ((r.length - (body + 4 - r.data)) >= HTTP_TEST_BIG_BODY)) {
+            break;
+        }
+        ecs_time_t now = t;
+        test_assert(ecs_time_measure(&now) < 10.0);
+    }
+
+    test_assert(body != NULL);
+    test_int(http_test_count(&r, "Content-Length: 4194304"), 1);
+    body += 4;
+    test_int(r.length - (body - r.data), HTTP_TEST_BIG_BODY);
+
+    int32_t i;
+    for (i = 0; i < HTTP_TEST_BIG_BODY; i ++) {
+        if (body[i] != (char)('a' + (i % 26))) {
+            test_int(i, -1); /* Data was sent out of order */
+        }
+    }
+
+    close(sock);
+    ecs_os_free(r.data);
+    http_test_server_fini(srv, &ctx);
+}
+
+void Http_socket_send_queue_limit(void) {
+    http_test_ctx_t ctx;
+    ecs_http_server_t *srv = http_test_server(27760, &ctx);
+
+    int sock = http_test_connect(27760, 0);
+    http_test_recv_t r = {0};
+
+    /* The last request is handled first, and queues more send requests than
+     * the server allows. The reply to the first request is rejected. */
+    http_test_send(sock, 
+        "GET /foo HTTP/1.1\r\n\r\n"
+        "GET /many HTTP/1.1\r\n\r\n");
+    ecs_os_sleep(0, 100 * 1000 * 1000);
+    http_test_recv(srv, sock, &r, "HTTP/1.1 503", 1);
+    test_int(http_test_count(&r, "HTTP/1.1 503"), 1);
+    test_int(http_test_count(&r, "Connection: close"), 1);
+
+    /* Connection is closed after the rejected reply */
+    while (!r.closed) {
+        ecs_http_server_dequeue(srv, 1.0);
+        http_test_recv_some(sock, &r, 10);
+    }
+    test_int(http_test_count(&r, "HTTP/1.1 200"), 0);
+
+    close(sock);
+    ecs_os_free(r.data);
+    http_test_server_fini(srv, &ctx);
+}
+
+void Http_socket_flush_slow_client(void) {
+    http_test_ctx_t ctx;
+    ecs_http_server_t *srv = http_test_server(27761, &ctx);
+    ctx.large_chunks = 256;
+
+    /* Client that stops receiving data */
+    int sock = http_test_connect(27761, 4096);
+    http_test_send(sock, "GET /large HTTP/1.1\r\n\r\n");
+    ecs_os_sleep(0, 100 * 1000 * 1000);
+
+    /* Handler doesn't wait indefinitely for the client */
+    ecs_time_t t = {0};
+    ecs_time_measure(&t);
+    ecs_log_set_level(-4);
+    ecs_http_server_dequeue(srv, 1.0);
+    test_assert(ecs_time_measure(&t) < 5.0);
+    test_bool(ctx.flush_failed, true);
+
+    /* Connection is closed */
+    http_test_recv_t r = {0};
+    ecs_time_measure(&t);
+    while (!r.closed) {
+        http_test_recv_some(sock, &r, 10);
+        ecs_time_t now = t;
+        test_assert(ecs_time_measure(&now) < 10.0);
+    }
+
+    close(sock);
+    ecs_os_free(r.data);
+    http_test_server_fini(srv, &ctx);
+}
+
+void Http_socket_request_during_flush(void) {
+    http_test_ctx_t ctx;
+    ecs_http_server_t *srv = http_test_server(27762, &ctx);
+    ctx.large_chunks = 256;
+
+    int slow = http_test_connect(27762, 4096);
+    int sock = http_test_connect(27762, 0);
+    ctx.request_sock = sock;
+
+    /* Handler of the slow request sends a request on the other connection,
+     * which is received while the handler waits for the slow client */
+    http_test_send(slow, "GET /large HTTP/1.1\r\n\r\n");
+    ecs_os_sleep(0, 100 * 1000 * 1000);
+    ecs_log_set_level(-4);
+    ecs_http_server_dequeue(srv, 1.0);
+    test_bool(ctx.flush_failed, true);
+    ctx.request_sock = -1;
+
+    /* Request received during the flush is handled by the next dequeue */
+    http_test_recv_t r = {0};
+    http_test_recv(srv, sock, &r, "HTTP/1.1 200", 1);
+    http_test_recv(srv, sock, &r, "foo", 1);
+    test_bool(r.closed, false);
+
+    char *paths = ecs_strbuf_get(&ctx.paths);
+    test_str(paths, "large;foo;");
+    ecs_os_free(paths);
+
+    close(slow);
+    close(sock);
+    ecs_os_free(r.data);
+    http_test_server_fini(srv, &ctx);
+}
+
+void Http_socket_gzip_chunked(void) {
+    http_test_ctx_t ctx;
+    ecs_http_server_t *srv = http_test_server(27767, &ctx);
+
+    int sock = http_test_connect(27767, 0);
+    http_test_recv_t r = {0};
+
+    http_test_send(sock, 
+        "GET /gzip HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n");
+    http_test_recv(srv, sock, &r, "\r\n0\r\n\r\n", 1);
+    test_bool(r.closed, false);
+    test_int(http_test_count(&r, "Content-Encoding: gzip"), 1);
+    test_int(http_test_count(&r, "Transfer-Encoding: chunked"), 1);
+
+    int32_t gzip_length;
+    char *gzip = http_test_dechunk(r.data, r.length, &gzip_length);
+
+    /* Chunks refer to data in earlier chunks */
+    test_assert(gzip_length < 2 * HTTP_TEST_GZIP_CHUNK);
+
+    int32_t length;
+    char *body = http_test_gunzip((uint8_t*)gzip, gzip_length, &length);
+    test_int(length, HTTP_TEST_GZIP_CHUNK * HTTP_TEST_GZIP_CHUNK_COUNT);
+
+    uint32_t seed = 1;
+    int32_t i;
+    for (i = 0; i < length; i ++) {
+        if (!(i % HTTP_TEST_GZIP_CHUNK)) {
+            seed = 1;
+        }
+        seed = seed * 1103515245 + 12345;
+        test_assert(body[i] == (char)('a' + ((seed >> 16) % 26)));
+    }
+
+    ecs_os_free(body);
+    ecs_os_free(gzip);
+    close(sock);
+    ecs_os_free(r.data);
+    http_test_server_fini(srv, &ctx);
+}
+
+#else
+
+void Http_socket_keep_alive(void) {
+    /* Socket tests use POSIX sockets */
+}
+
+void Http_socket_pipelined_reply_order(void) {
+    /* Socket tests use POSIX sockets */
+}
+
+void Http_socket_partial_send(void) {
+    /* Socket tests use POSIX sockets */
+}
+
+void Http_socket_send_queue_limit(void) {
+    /* Socket tests use POSIX sockets */
+}
+
+void Http_socket_flush_slow_client(void) {
+    /* Socket tests use POSIX sockets */
+}
+
+void Http_socket_request_during_flush(void) {
+    /* Socket tests use POSIX sockets */
+}
+
+void Http_socket_gzip_chunked(void) {
+    /* Socket tests use POSIX sockets */
+}
+
+#endif
@@ -2417,3 +2417,400 @@ void Metrics_pair_member_counter_increment(void) {
 
     ecs_fini(world);
 }
+
+void Metrics_histogram_linear(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_IMPORT(world, FlecsMetrics);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { "x", ecs_id(ecs_f32_t) },
+            { "y", ecs_id(ecs_f32_t) },
+        }
+    });
+
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.position_y" }),
+        .member = ecs_lookup(world, "Position.y"),
+        .kind = EcsHistogram,
+        .histogram = { .min = 0, .max = 100, .bucket_count = 10 }
+    });
+    test_assert(m != 0);
+    test_assert(ecs_has_pair(world, m, EcsMetric, EcsHistogram));
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_set(world, 0, Position, {0, (float)i});
+    }
+
+    ecs_progress(world, 0);
+
+    /* Histogram metrics don't create instances */
+    ecs_iter_t it = ecs_children(world, m);
+    test_bool(false, ecs_children_next(&it));
+
+    const EcsMetricHistogram *h = ecs_get(world, m, EcsMetricHistogram);
+    test_assert(h != NULL);
+    test_int(h->bucket_count, 10);
+    test_flt(h->count, 100);
+    test_flt(h->sum, 4950);
+    test_flt(h->min, 0);
+    test_flt(h->max, 99);
+    for (i = 0; i < 10; i ++) {
+        test_flt(h->bounds[i], (i + 1) * 10);
+        test_flt(h->buckets[i], 10);
+    }
+    test_flt(h->p50, 50);
+    test_flt(h->p90, 90);
+    test_flt(h->p99, 98.1);
+
+    ecs_fini(world);
+}
+
+void Metrics_histogram_log(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_IMPORT(world, FlecsMetrics);
+
+    typedef struct {
+        double value;
+    } Latency;
+
+    ECS_COMPONENT(world, Latency);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Latency),
+        .members = {
+            { "value", ecs_id(ecs_f64_t) }
+        }
+    });
+
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.latency" }),
+        .member = ecs_lookup(world, "Latency.value"),
+        .kind = EcsHistogram,
+        .histogram = { 
+            .min = 1, .bucket_count = 8, .log = true, .sub_bucket_count = 4 
+        }
+    });
+    test_assert(m != 0);
+
+    ecs_set(world, 0, Latency, {1});
+    ecs_set(world, 0, Latency, {1.3});
+    ecs_set(world, 0, Latency, {2});
+    ecs_set(world, 0, Latency, {3.6});
+    ecs_set(world, 0, Latency, {100});
+    ecs_set(world, 0, Latency, {0.5});
+    ecs_set(world, 0, Latency, {-1});
+
+    ecs_progress(world, 0);
+
+    const EcsMetricHistogram *h = ecs_get(world, m, EcsMetricHistogram);
+    test_assert(h != NULL);
+    test_int(h->bucket_count, 8);
+    test_flt(h->count, 7);
+    test_flt(h->min, -1);
+    test_flt(h->max, 100);
+
+    test_flt(h->bounds[0], 1.25);
+    test_flt(h->bounds[1], 1.5);
+    test_flt(h->bounds[2], 1.75);
+    test_flt(h->bounds[3], 2);
+    test_flt(h->bounds[4], 2.5);
+    test_flt(h->bounds[5], 3);
+    test_flt(h->bounds[6], 3.5);
+    test_flt(h->bounds[7], 4);
+
+    test_flt(h->buckets[0], 3);
+    test_flt(h->buckets[1], 1);
+    test_flt(h->buckets[2], 0);
+    test_flt(h->buckets[3], 0);
+    test_flt(h->buckets[4], 1);
+    test_flt(h->buckets[5], 0);
+    test_flt(h->buckets[6], 0);
+    test_flt(h->buckets[7], 2);
+
+    ecs_fini(world);
+}
+
+void Metrics_histogram_out_of_range(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_IMPORT(world, FlecsMetrics);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { "x", ecs_id(ecs_f32_t) },
+            { "y", ecs_id(ecs_f32_t) },
+        }
+    });
+
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.position_x" }),
+        .member = ecs_lookup(world, "Position.x"),
+        .kind = EcsHistogram,
+        .histogram = { .min = 0, .max = 10, .bucket_count = 2 }
+    });
+    test_assert(m != 0);
+
+    ecs_set(world, 0, Position, {-5, 0});
+    ecs_set(world, 0, Position, {2, 0});
+    ecs_set(world, 0, Position, {7, 0});
+    ecs_set(world, 0, Position, {50, 0});
+
+    ecs_progress(world, 0);
+
+    const EcsMetricHistogram *h = ecs_get(world, m, EcsMetricHistogram);
+    test_assert(h != NULL);
+    test_flt(h->count, 4);
+    test_flt(h->min, -5);
+    test_flt(h->max, 50);
+    test_flt(h->buckets[0], 2);
+    test_flt(h->buckets[1], 2);
+
+    /* Percentiles are interpolated between observed min/max for first and
+     * last buckets */
+    test_flt(h->p50, 5);
+    test_flt(h->p90, 5 + 45 * 0.8);
+
+    ecs_fini(world);
+}
+
+void Metrics_histogram_multiple_tables(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_IMPORT(world, FlecsMetrics);
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { "x", ecs_id(ecs_f32_t) },
+            { "y", ecs_id(ecs_f32_t) },
+        }
+    });
+
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.position_x" }),
+        .member = ecs_lookup(world, "Position.x"),
+        .kind = EcsHistogram,
+        .histogram = { .min = 0, .max = 1000, .bucket_count = 4 }
+    });
+    test_assert(m != 0);
+
+    /* Tables with more samples than are assigned to buckets at a time */
+    int i;
+    for (i = 0; i < 1000; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, Position, {(float)i, 0});
+        if (i % 2) {
+            ecs_add(world, e, Tag);
+        }
+    }
+
+    ecs_progress(world, 0);
+
+    const EcsMetricHistogram *h = ecs_get(world, m, EcsMetricHistogram);
+    test_assert(h != NULL);
+    test_flt(h->count, 1000);
+    test_flt(h->sum, 499500);
+    test_flt(h->min, 0);
+    test_flt(h->max, 999);
+    test_flt(h->buckets[0], 250);
+    test_flt(h->buckets[1], 250);
+    test_flt(h->buckets[2], 250);
+    test_flt(h->buckets[3], 250);
+    test_flt(h->p50, 500);
+
+    ecs_fini(world);
+}
+
+void Metrics_histogram_update(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_IMPORT(world, FlecsMetrics);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { "x", ecs_id(ecs_f32_t) },
+            { "y", ecs_id(ecs_f32_t) },
+        }
+    });
+
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.position_x" }),
+        .member = ecs_lookup(world, "Position.x"),
+        .kind = EcsHistogram,
+        .histogram = { .min = 0, .max = 10, .bucket_count = 2 }
+    });
+    test_assert(m != 0);
+
+    ecs_progress(world, 0);
+
+    const EcsMetricHistogram *h = ecs_get(world, m, EcsMetricHistogram);
+    test_assert(h != NULL);
+    test_flt(h->count, 0);
+    test_flt(h->p50, 0);
+    test_flt(h->buckets[0], 0);
+    test_flt(h->buckets[1], 0);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {1, 0});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {2, 0});
+
+    ecs_progress(world, 0);
+
+    h = ecs_get(world, m, EcsMetricHistogram);
+    test_flt(h->count, 2);
+    test_flt(h->buckets[0], 2);
+    test_flt(h->buckets[1], 0);
+
+    ecs_set(world, e1, Position, {8, 0});
+    ecs_delete(world, e2);
+
+    ecs_progress(world, 0);
+
+    h = ecs_get(world, m, EcsMetricHistogram);
+    test_flt(h->count, 1);
+    test_flt(h->min, 8);
+    test_flt(h->max, 8);
+    test_flt(h->buckets[0], 0);
+    test_flt(h->buckets[1], 1);
+    test_flt(h->p50, 8);
+
+    ecs_fini(world);
+}
+
+void Metrics_histogram_dotmember(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_IMPORT(world, FlecsMetrics);
+
+    typedef struct {
+        int32_t value;
+    } Cost;
+
+    typedef struct {
+        Cost cost;
+    } Path;
+
+    ECS_COMPONENT(world, Cost);
+    ECS_COMPONENT(world, Path);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Cost),
+        .members = {
+            { "value", ecs_id(ecs_i32_t) }
+        }
+    });
+
+    ecs_struct(world, {
+        .entity = ecs_id(Path),
+        .members = {
+            { "cost", ecs_id(Cost) }
+        }
+    });
+
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.path_cost" }),
+        .id = ecs_id(Path),
+        .dotmember = "cost.value",
+        .kind = EcsHistogram,
+        .histogram = { .min = 0, .max = 4, .bucket_count = 4 }
+    });
+    test_assert(m != 0);
+
+    ecs_set(world, 0, Path, {{1}});
+    ecs_set(world, 0, Path, {{3}});
+    ecs_set(world, 0, Path, {{3}});
+
+    ecs_progress(world, 0);
+
+    const EcsMetricHistogram *h = ecs_get(world, m, EcsMetricHistogram);
+    test_assert(h != NULL);
+    test_flt(h->count, 3);
+    test_flt(h->sum, 7);
+    test_flt(h->buckets[0], 0);
+    test_flt(h->buckets[1], 1);
+    test_flt(h->buckets[2], 0);
+    test_flt(h->buckets[3], 2);
+
+    ecs_fini(world);
+}
+
+void Metrics_histogram_invalid_bucket_count(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_IMPORT(world, FlecsMetrics);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { "x", ecs_id(ecs_f32_t) },
+            { "y", ecs_id(ecs_f32_t) },
+        }
+    });
+
+    ecs_log_set_level(-4);
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.position_x" }),
+        .member = ecs_lookup(world, "Position.x"),
+        .kind = EcsHistogram,
+        .histogram = { 
+            .min = 0, .max = 10, 
+            .bucket_count = ECS_METRIC_HISTOGRAM_BUCKET_COUNT_MAX + 1
+        }
+    });
+    test_assert(m == 0);
+
+    ecs_fini(world);
+}
+
+void Metrics_histogram_log_invalid_min(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_IMPORT(world, FlecsMetrics);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { "x", ecs_id(ecs_f32_t) },
+            { "y", ecs_id(ecs_f32_t) },
+        }
+    });
+
+    ecs_log_set_level(-4);
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.position_x" }),
+        .member = ecs_lookup(world, "Position.x"),
+        .kind = EcsHistogram,
+        .histogram = { .min = 0, .log = true }
+    });
+    test_assert(m == 0);
+
+    ecs_fini(world);
+}
+
+void Metrics_histogram_wo_member(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_IMPORT(world, FlecsMetrics);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_log_set_level(-4);
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.position" }),
+        .id = ecs_id(Position),
+        .kind = EcsHistogram,
+        .histogram = { .min = 0, .max = 10 }
+    });
+    test_assert(m == 0);
+
+    ecs_fini(world);
+}
@@ -1382,3 +1382,215 @@ void MultiThread_run_single_thread_on_main(void) {
 
     ecs_fini(world);
 }
+
+static
+void AddTag(ecs_iter_t *it) {
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        ecs_add(it->world, it->entities[i], Tag);
+    }
+}
+
+void MultiThread_stats_counters_w_workers(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT_DEFINE(world, Position);
+    ECS_TAG_DEFINE(world, Tag);
+
+    ecs_system(world, {
+        .entity = ecs_entity(world, { .add = { ecs_dependson(EcsOnUpdate) } }),
+        .query.filter.terms = {{ ecs_id(Position) }, { Tag, .oper = EcsNot }},
+        .callback = AddTag,
+        .multi_threaded = true
+    });
+
+    int i, ENTITIES = 1000, THREADS = 4;
+    for (i = 0; i < ENTITIES; i ++) {
+        ecs_new(world, Position);
+    }
+
+    /* Counters are added up at the end of a frame */
+    ecs_frame_begin(world, 1);
+    ecs_frame_end(world);
+
+    const ecs_world_info_t *info = ecs_get_world_info(world);
+    int64_t systems_ran = info->systems_ran_frame;
+    int64_t add_count = info->cmd.add_count;
+
+    ecs_set_threads(world, THREADS);
+    ecs_progress(world, 0);
+
+    test_int(ecs_count(world, Tag), ENTITIES);
+
+    info = ecs_get_world_info(world);
+    test_int(info->systems_ran_frame - systems_ran, THREADS);
+    test_int(info->cmd.add_count - add_count, ENTITIES);
+
+    /* Counters of deleted stages are kept */
+    ecs_set_threads(world, 2);
+    ecs_frame_begin(world, 1);
+    ecs_frame_end(world);
+    info = ecs_get_world_info(world);
+    test_int(info->systems_ran_frame - systems_ran, THREADS);
+    test_int(info->cmd.add_count - add_count, ENTITIES);
+
+    ecs_fini(world);
+}
+
+static
+void RecordStage(ecs_iter_t *it) {
+    Position *p = ecs_field(it, Position, 1);
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        p[i].x = (float)ecs_get_stage_id(it->world);
+        p[i].y ++;
+    }
+}
+
+void MultiThread_worker_table_affinity(void) {
+    ecs_world_t *world = ecs_init();
+    ECS_COMPONENT(world, Position);
+
+    ecs_system(world, {
+        .entity = ecs_entity(world, {
+            .name = "RecordStage", .add = { ecs_dependson(EcsOnUpdate) } }),
+        .query.filter.terms = {{ ecs_id(Position) }},
+        .callback = RecordStage,
+        .multi_threaded = true
+    });
+
+    ecs_entity_t e[8][10];
+    int i, j;
+    for (i = 0; i < 8; i ++) {
+        ecs_entity_t tag = ecs_new_id(world);
+        for (j = 0; j < 10; j ++) {
+            e[i][j] = ecs_new_id(world);
+            ecs_set(world, e[i][j], Position, {0, 0});
+            ecs_add_id(world, e[i][j], tag);
+        }
+    }
+
+    ecs_set_threads(world, 4);
+    ecs_set_worker_table_affinity(world, true);
+    ecs_progress(world, 0);
+
+    float stage[8];
+    bool used[4] = {false};
+    for (i = 0; i < 8; i ++) {
+        stage[i] = ecs_get(world, e[i][0], Position)->x;
+        used[(int)stage[i]] = true;
+        for (j = 0; j < 10; j ++) {
+            const Position *p = ecs_get(world, e[i][j], Position);
+            test_int(p->x, stage[i]);
+            test_int(p->y, 1);
+        }
+    }
+
+    /* Tables are spread out over all workers */
+    for (i = 0; i < 4; i ++) {
+        test_bool(used[i], true);
+    }
+
+    /* Tables stay on the same worker */
+    ecs_progress(world, 0);
+    for (i = 0; i < 8; i ++) {
+        for (j = 0; j < 10; j ++) {
+            const Position *p = ecs_get(world, e[i][j], Position);
+            test_int(p->x, stage[i]);
+            test_int(p->y, 2);
+        }
+    }
+
+    /* Rows are split across workers when disabled */
+    ecs_set_worker_table_affinity(world, false);
+    ecs_progress(world, 0);
+    for (i = 0; i < 8; i ++) {
+        test_int(ecs_get(world, e[i][0], Position)->x, 0);
+        test_int(ecs_get(world, e[i][9], Position)->x, 3);
+    }
+
+    ecs_fini(world);
+}
+
+static int32_t affinity_calls = 0;
+static int32_t affinity_cpu_sum = 0;
+static int32_t affinity_node_sum = 0;
+
+static
+int set_affinity(int32_t cpu, int32_t numa_node) {
+    ecs_os_ainc(&affinity_calls);
+    int32_t i;
+    for (i = 0; i < cpu; i ++) {
+        ecs_os_ainc(&affinity_cpu_sum);
+    }
+    for (i = 0; i < numa_node; i ++) {
+        ecs_os_ainc(&affinity_node_sum);
+    }
+    return 0;
+}
+
+void MultiThread_worker_affinity(void) {
+    ecs_world_t *world = init_world();
+    ecs_os_api.thread_set_affinity_ = set_affinity;
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {0});
+
+    ecs_set_worker_affinity(world, (ecs_worker_affinity_t[]){
+        { .cpu = 2, .numa_node = -1 },
+        { .cpu = -1, .numa_node = 1 },
+        { .cpu = -1, .numa_node = -1 }
+    }, 3);
+    test_int(affinity_calls, 0);
+
+    ecs_set_threads(world, 5);
+    ecs_progress(world, 0);
+    test_int(ecs_get(world, e, Position)->x, 1);
+
+    /* Workers 1, 2 and 4 are pinned, worker 3 is not */
+    test_int(affinity_calls, 3);
+    test_int(affinity_cpu_sum, 4);
+    test_int(affinity_node_sum, 1);
+
+    ecs_fini(world);
+}
+
+void MultiThread_worker_affinity_restart_threads(void) {
+    ecs_world_t *world = init_world();
+    ecs_os_api.thread_set_affinity_ = set_affinity;
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {0});
+
+    ecs_set_threads(world, 3);
+    ecs_progress(world, 0);
+    test_int(ecs_get(world, e, Position)->x, 1);
+    test_int(affinity_calls, 0);
+
+    /* Running workers are restarted */
+    ecs_set_worker_affinity(world, (ecs_worker_affinity_t[]){
+        { .cpu = 1, .numa_node = -1 }
+    }, 1);
+
+    ecs_progress(world, 0);
+    test_int(ecs_get(world, e, Position)->x, 2);
+    test_int(affinity_calls, 2);
+    test_int(affinity_cpu_sum, 2);
+
+    ecs_fini(world);
+}
+
+void MultiThread_worker_affinity_numa_node(void) {
+    ecs_world_t *world = init_world();
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {0});
+
+    /* Uses OS API implementation if available */
+    ecs_set_worker_affinity(world, (ecs_worker_affinity_t[]){
+        { .cpu = -1, .numa_node = 0 }
+    }, 1);
+
+    ecs_set_threads(world, 2);
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+    test_int(ecs_get(world, e, Position)->x, 2);
+
+    ecs_fini(world);
+}
@@ -1,5 +1,9 @@
 #include <addons.h>
 
+#ifdef ECS_TARGET_POSIX
+#include <unistd.h>
+#endif
+
 void Rest_teardown(void) {
     ecs_world_t *world = ecs_init();
 
@@ -463,3 +467,1045 @@ void Rest_request_commands_garbage_collect(void) {
 
     ecs_fini(world);
 }
+
+void Rest_query_large(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    ECS_COMPONENT(world, Position);
+
+    int32_t i, count = 20000;
+    for (i = 0; i < count; i ++) {
+        ecs_new(world, Position);
+    }
+
+    ecs_query_t *q = ecs_query(world, { .filter.terms = {{ ecs_id(Position) }}});
+    ecs_iter_t it = ecs_query_iter(world, q);
+    ecs_iter_t pit = ecs_page_iter(&it, 0, count);
+    char *expect = ecs_iter_to_json(world, &pit, &(ecs_iter_to_json_desc_t){
+        .serialize_entities = true,
+        .serialize_variables = true
+    });
+    test_assert(expect != NULL);
+    test_assert(ecs_os_strlen(expect) > ECS_JSON_STREAM_CHUNK_SIZE);
+
+    /* Requests that don't have a connection receive the entire body */
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    test_int(0, ecs_http_server_request(srv, "GET",
+        "/query?q=Position&limit=20000", &reply));
+    test_int(reply.code, 200);
+    test_bool(reply.chunked, false);
+
+    char *reply_str = ecs_strbuf_get(&reply.body);
+    test_assert(reply_str != NULL);
+    test_str(reply_str, expect);
+    ecs_os_free(reply_str);
+    ecs_os_free(expect);
+
+    ecs_query_fini(q);
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+void Rest_teardown_between_frames(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_singleton_set(world, EcsRest, {
+        .port = 27761, 
+        .thread_mode = EcsRestBetweenFrames
+    });
+
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    ecs_fini(world);
+
+    test_assert(true); // Ensure teardown was successful
+}
+
+void Rest_remove_between_frames(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_singleton_set(world, EcsRest, {
+        .port = 27762, 
+        .thread_mode = EcsRestBetweenFrames
+    });
+
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    /* World can only be modified inside a frame in this mode */
+    ecs_frame_begin(world, 0);
+    ecs_singleton_remove(world, EcsRest);
+    ecs_frame_end(world);
+
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    ecs_fini(world);
+
+    test_assert(true); // Ensure teardown was successful
+}
+
+#ifdef ECS_TARGET_POSIX
+
+static const char *rest_test_get = "GET /entity/e1 HTTP/1.1\r\n\r\n";
+static const char *rest_test_put = "PUT /disable/e1 HTTP/1.1\r\n\r\n";
+
+typedef struct {
+    ecs_os_thread_id_t thread;
+    int32_t invoked;
+    int sock;
+    http_test_recv_t recv;
+} rest_test_ctx_t;
+
+static
+void OnDisable(ecs_iter_t *it) {
+    rest_test_ctx_t *ctx = it->ctx;
+    ctx->thread = ecs_os_thread_self();
+    ctx->invoked ++;
+}
+
+static
+void SendGet(ecs_iter_t *it) {
+    rest_test_ctx_t *ctx = it->ctx;
+    http_test_send(ctx->sock, rest_test_get);
+
+    /* Keep the world busy for longer than the REST thread timeout, so the 
+     * request is handled on the main thread */
+    ecs_os_sleep(1, 100 * 1000 * 1000);
+}
+
+static
+void RecvReply(ecs_iter_t *it) {
+    rest_test_ctx_t *ctx = it->ctx;
+    http_test_recv_some(ctx->sock, &ctx->recv, 1000);
+}
+
+static
+void rest_test_recv(
+    int sock,
+    http_test_recv_t *r,
+    const char *str)
+{
+    ecs_time_t t = {0};
+    ecs_time_measure(&t);
+    while (!http_test_count(r, str) && !r->closed) {
+        ecs_time_t now = t;
+        test_assert(ecs_time_measure(&now) < 10.0);
+        http_test_recv_some(sock, r, 10);
+    }
+}
+
+static
+ecs_world_t* rest_test_world(
+    uint16_t port,
+    rest_test_ctx_t *ctx)
+{
+    ecs_world_t *world = ecs_init();
+
+    ecs_os_zeromem(ctx);
+    ecs_new_entity(world, "e1");
+
+    ecs_observer(world, {
+        .filter.terms = {{ EcsDisabled }},
+        .events = { EcsOnAdd },
+        .callback = OnDisable,
+        .ctx = ctx
+    });
+
+    ecs_singleton_set(world, EcsRest, {
+        .port = port, 
+        .thread_mode = EcsRestBetweenFrames
+    });
+
+    ctx->sock = http_test_connect(port, 0);
+
+    return world;
+}
+
+static
+void rest_test_fini(
+    ecs_world_t *world,
+    rest_test_ctx_t *ctx)
+{
+    close(ctx->sock);
+    ecs_os_free(ctx->recv.data);
+    ecs_fini(world);
+}
+
+#endif
+
+void Rest_request_between_frames(void) {
+#ifdef ECS_TARGET_POSIX
+    rest_test_ctx_t ctx;
+    ecs_world_t *world = rest_test_world(27763, &ctx);
+
+    /* Hands world to REST thread */
+    ecs_progress(world, 0);
+
+    /* Request is handled without the main thread progressing the world */
+    http_test_send(ctx.sock, rest_test_get);
+    rest_test_recv(ctx.sock, &ctx.recv, "\"e1\"");
+    test_int(http_test_count(&ctx.recv, "HTTP/1.1 200"), 1);
+    test_int(http_test_count(&ctx.recv, "\"e1\""), 1);
+
+    rest_test_fini(world, &ctx);
+#else
+    /* Socket tests use POSIX sockets */
+#endif
+}
+
+void Rest_request_between_frames_timeout(void) {
+#ifdef ECS_TARGET_POSIX
+    rest_test_ctx_t ctx;
+    ecs_world_t *world = rest_test_world(27764, &ctx);
+
+    ecs_system(world, {
+        .entity = ecs_entity(world, { .add = { ecs_dependson(EcsOnUpdate) } }),
+        .callback = SendGet,
+        .ctx = &ctx
+    });
+
+    /* Runs after DequeueRest, while the REST thread can't use the world */
+    ecs_system(world, {
+        .entity = ecs_entity(world, { .add = { ecs_dependson(EcsPostFrame) } }),
+        .callback = RecvReply,
+        .ctx = &ctx
+    });
+
+    ecs_progress(world, 0.1);
+    test_int(http_test_count(&ctx.recv, "HTTP/1.1 200"), 1);
+
+    rest_test_fini(world, &ctx);
+#else
+    /* Socket tests use POSIX sockets */
+#endif
+}
+
+void Rest_put_between_frames(void) {
+#ifdef ECS_TARGET_POSIX
+    rest_test_ctx_t ctx;
+    ecs_world_t *world = rest_test_world(27765, &ctx);
+
+    /* Hands world to REST thread */
+    ecs_progress(world, 0);
+
+    /* Requests that modify the world aren't handled by the REST thread */
+    http_test_send(ctx.sock, rest_test_put);
+    http_test_recv_some(ctx.sock, &ctx.recv, 200);
+    test_int(ctx.recv.length, 0);
+    test_int(ctx.invoked, 0);
+
+    ecs_time_t t = {0};
+    ecs_time_measure(&t);
+    while (!ctx.invoked) {
+        ecs_time_t now = t;
+        test_assert(ecs_time_measure(&now) < 10.0);
+        ecs_progress(world, 0);
+    }
+
+    test_int(ctx.invoked, 1);
+    test_assert(ctx.thread == ecs_os_thread_self());
+
+    rest_test_recv(ctx.sock, &ctx.recv, "HTTP/1.1 200");
+    test_int(http_test_count(&ctx.recv, "HTTP/1.1 200"), 1);
+
+    rest_test_fini(world, &ctx);
+#else
+    /* Socket tests use POSIX sockets */
+#endif
+}
+
+void Rest_stats_between_frames(void) {
+#ifdef ECS_TARGET_POSIX
+    rest_test_ctx_t ctx;
+    ecs_world_t *world = rest_test_world(27766, &ctx);
+
+    ECS_IMPORT(world, FlecsMonitor);
+
+    /* Leave time between frames for the REST thread */
+    ecs_set_target_fps(world, 100);
+
+    /* Request world data and statistics while frames run */
+    int32_t i, count = 50;
+    for (i = 0; i < count; i ++) {
+        http_test_send(ctx.sock, "GET /world HTTP/1.1\r\n\r\n");
+        http_test_send(ctx.sock, "GET /stats/world HTTP/1.1\r\n\r\n");
+        http_test_send(ctx.sock, "GET /metrics HTTP/1.1\r\n\r\n");
+        ecs_progress(world, 0);
+        http_test_recv_some(ctx.sock, &ctx.recv, 0);
+    }
+
+    ecs_time_t t = {0};
+    ecs_time_measure(&t);
+    while (http_test_count(&ctx.recv, "HTTP/1.1 200") < (count * 3)) {
+        ecs_time_t now = t;
+        test_assert(ecs_time_measure(&now) < 10.0);
+        test_assert(!ctx.recv.closed);
+        ecs_progress(world, 0);
+        http_test_recv_some(ctx.sock, &ctx.recv, 0);
+    }
+
+    test_int(http_test_count(&ctx.recv, "HTTP/1.1 200"), count * 3);
+
+    rest_test_fini(world, &ctx);
+#else
+    /* Socket tests use POSIX sockets */
+#endif
+}
+
+void Rest_query_etag(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Foo);
+
+    ecs_entity_t e1 = ecs_new_entity(world, "e1");
+    ecs_add(world, e1, Foo);
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    /* ETag is only computed when requested */
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET",
+            "/query?q=Foo", &reply));
+        test_int(reply.code, 200);
+        test_int(ecs_strbuf_written(&reply.headers), 0);
+        ecs_strbuf_reset(&reply.headers);
+        ecs_os_free(ecs_strbuf_get(&reply.body));
+    }
+
+    char etag[64] = {0};
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET",
+            "/query?q=Foo&etag=true", &reply));
+        test_int(reply.code, 200);
+
+        char *headers = ecs_strbuf_get(&reply.headers);
+        test_assert(headers != NULL);
+        test_assert(!ecs_os_strncmp(headers, "ETag: \"", 7));
+        char *end = strchr(headers, '\r');
+        test_assert(end != NULL);
+        ecs_os_memcpy(etag, &headers[6], (int32_t)(end - headers) - 6);
+        ecs_os_free(headers);
+        ecs_os_free(ecs_strbuf_get(&reply.body));
+    }
+
+    char req[256];
+    ecs_os_snprintf(req, 256, 
+        "GET /query?q=Foo&etag=true HTTP/1.1\r\nIf-None-Match: %s\r\n\r\n",
+        etag);
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_http_request(srv, req, 0, &reply));
+        test_int(reply.code, 304);
+        test_int(ecs_strbuf_written(&reply.body), 0);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    ecs_entity_t e2 = ecs_new_entity(world, "e2");
+    ecs_add(world, e2, Foo);
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_http_request(srv, req, 0, &reply));
+        test_int(reply.code, 200);
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_str(reply_str, 
+            "{\"results\":[{\"entities\":[\"e1\", \"e2\"]}]}");
+        ecs_os_free(reply_str);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+void Rest_query_since(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t e1 = ecs_new_entity(world, "e1");
+    ecs_add(world, e1, Foo);
+    ecs_entity_t e2 = ecs_new_entity(world, "e2");
+    ecs_add(world, e2, Foo);
+    ecs_add(world, e2, Bar);
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET",
+            "/query?q=Foo&since=0", &reply));
+        test_int(reply.code, 200);
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_str(reply_str, "{\"version\":1,\"results\":["
+            "{\"entities\":[\"e1\"]}, {\"entities\":[\"e2\"]}]}");
+        ecs_os_free(reply_str);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET",
+            "/query?q=Foo&since=1", &reply));
+        test_int(reply.code, 200);
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_str(reply_str, "{\"version\":1,\"results\":[]}");
+        ecs_os_free(reply_str);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    /* Create entity directly in table, so other table doesn't change */
+    ecs_entity(world, { .name = "e3", .add = { Foo, Bar } });
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET",
+            "/query?q=Foo&since=1", &reply));
+        test_int(reply.code, 200);
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_str(reply_str, "{\"version\":2,\"results\":["
+            "{\"entities\":[\"e2\", \"e3\"]}]}");
+        ecs_os_free(reply_str);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+static
+char* rest_get(
+    ecs_http_server_t *srv,
+    const char *path)
+{
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    test_int(0, ecs_http_server_request(srv, "GET", path, &reply));
+    test_int(reply.code, 200);
+    ecs_strbuf_reset(&reply.headers);
+    return ecs_strbuf_get(&reply.body);
+}
+
+void Rest_query_since_w_source(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_new_entity(world, "e1");
+    ecs_set(world, e1, Position, {10, 20});
+    ecs_entity_t g = ecs_new_entity(world, "g");
+    ecs_set(world, g, Velocity, {1, 2});
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    char *reply = rest_get(srv, "/query?q=Position&since=0");
+    test_assert(!ecs_os_strncmp(reply, "{\"version\":1,", 13));
+    ecs_os_free(reply);
+
+    /* Query that matches the same table with a source doesn't change the
+     * version of the table */
+    reply = rest_get(srv, "/query?q=Position,Velocity(g)&since=0");
+    test_assert(!ecs_os_strncmp(reply, "{\"version\":1,", 13));
+    ecs_os_free(reply);
+
+    for (int i = 0; i < 2; i ++) {
+        reply = rest_get(srv, "/query?q=Position&since=1");
+        test_str(reply, "{\"version\":1,\"results\":[]}");
+        ecs_os_free(reply);
+
+        reply = rest_get(srv, "/query?q=Position,Velocity(g)&since=1");
+        test_str(reply, "{\"version\":1,\"results\":[]}");
+        ecs_os_free(reply);
+    }
+
+    /* Changing the table of e1 is reported for both queries */
+    ecs_set(world, e1, Position, {30, 40});
+
+    reply = rest_get(srv, "/query?q=Position&since=1");
+    test_assert(!ecs_os_strncmp(reply, "{\"version\":2,\"results\":[{", 25));
+    ecs_os_free(reply);
+
+    reply = rest_get(srv, "/query?q=Position,Velocity(g)&since=1");
+    test_assert(!ecs_os_strncmp(reply, "{\"version\":2,\"results\":[{", 25));
+    ecs_os_free(reply);
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+void Rest_prepared_query(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t e1 = ecs_new_entity(world, "e1");
+    ecs_add(world, e1, Foo);
+    ecs_entity_t e2 = ecs_new_entity(world, "e2");
+    ecs_add(world, e2, Bar);
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "PUT",
+            "/query/q?q=Foo&ids=false", &reply));
+        test_int(reply.code, 200);
+        ecs_strbuf_reset(&reply.body);
+    }
+
+    /* Serializer parameters of registration are used as defaults */
+    for (int i = 0; i < 2; i ++) {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET", "/query/q", &reply));
+        test_int(reply.code, 200);
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_str(reply_str, "{\"results\":[{\"entities\":[\"e1\"]}]}");
+        ecs_os_free(reply_str);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    /* Parameters of request override defaults */
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET", 
+            "/query/q?entities=false", &reply));
+        test_int(reply.code, 200);
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_str(reply_str, "{\"results\":[{}]}");
+        ecs_os_free(reply_str);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    /* Replace query */
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "PUT",
+            "/query/q?q=Bar&ids=false", &reply));
+        test_int(reply.code, 200);
+        ecs_strbuf_reset(&reply.body);
+    }
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET", "/query/q", &reply));
+        test_int(reply.code, 200);
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_str(reply_str, "{\"results\":[{\"entities\":[\"e2\"]}]}");
+        ecs_os_free(reply_str);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "DELETE", "/query/q", &reply));
+        test_int(reply.code, 200);
+        ecs_strbuf_reset(&reply.body);
+    }
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(-1, ecs_http_server_request(srv, "GET", "/query/q", &reply));
+        test_int(reply.code, 404);
+        ecs_strbuf_reset(&reply.body);
+    }
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+static
+void rest_expect_reply(
+    ecs_http_server_t *srv,
+    const char *method,
+    const char *path,
+    int code,
+    const char *expect)
+{
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    ecs_http_server_request(srv, method, path, &reply);
+    test_int(reply.code, code);
+    char *reply_str = ecs_strbuf_get(&reply.body);
+    if (expect) {
+        test_str(reply_str, expect);
+    }
+    ecs_os_free(reply_str);
+    ecs_strbuf_reset(&reply.headers);
+}
+
+void Rest_prepared_query_cached(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Foo);
+    ECS_TAG(world, Bar);
+
+    ecs_entity_t e1 = ecs_new_entity(world, "e1");
+    ecs_add(world, e1, Foo);
+    ecs_entity_t e2 = ecs_new_entity(world, "e2");
+    ecs_add(world, e2, Bar);
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world,
+        &(ecs_http_server_desc_t){
+            .cache_timeout = 100.0
+        });
+    test_assert(srv != NULL);
+
+    rest_expect_reply(srv, "PUT", "/query/q?q=Foo&ids=false", 200, NULL);
+    rest_expect_reply(srv, "GET", "/query/q", 200,
+        "{\"results\":[{\"entities\":[\"e1\"]}]}");
+    rest_expect_reply(srv, "GET", "/query/q?entities=false", 200,
+        "{\"results\":[{}]}");
+
+    /* Redefining the query invalidates cached replies */
+    rest_expect_reply(srv, "PUT", "/query/q?q=Bar&ids=false", 200, NULL);
+    rest_expect_reply(srv, "GET", "/query/q", 200,
+        "{\"results\":[{\"entities\":[\"e2\"]}]}");
+    rest_expect_reply(srv, "GET", "/query/q?entities=false", 200,
+        "{\"results\":[{}]}");
+
+    /* Deleting the query invalidates cached replies */
+    rest_expect_reply(srv, "DELETE", "/query/q", 200, NULL);
+    rest_expect_reply(srv, "GET", "/query/q", 404, NULL);
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+void Rest_prepared_query_invalid(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(-1, ecs_http_server_request(srv, "PUT",
+            "/query/q?q=Foo", &reply));
+        test_int(reply.code, 400);
+        ecs_strbuf_reset(&reply.body);
+    }
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(-1, ecs_http_server_request(srv, "PUT", "/query/q", &reply));
+        test_int(reply.code, 400);
+        ecs_strbuf_reset(&reply.body);
+    }
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(-1, ecs_http_server_request(srv, "GET", "/query/q", &reply));
+        test_int(reply.code, 404);
+        ecs_strbuf_reset(&reply.body);
+    }
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+void Rest_stream_query(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Foo);
+
+    ecs_entity_t e1 = ecs_new_entity(world, "e1");
+    ecs_add(world, e1, Foo);
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    /* Request is not made on a connection, so reply has the first event */
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    test_int(0, ecs_http_server_request(srv, "GET",
+        "/stream/query?q=Foo", &reply));
+    test_int(reply.code, 200);
+    test_str(reply.content_type, "text/event-stream");
+    char *reply_str = ecs_strbuf_get(&reply.body);
+    test_str(reply_str, "data: {\"version\":1,\"results\":["
+        "{\"entities\":[\"e1\"]}]}\n\n");
+    ecs_os_free(reply_str);
+    ecs_strbuf_reset(&reply.headers);
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+void Rest_stream_stats(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMonitor);
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    ecs_progress(world, 0);
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET",
+            "/stream/stats/world?period=1s", &reply));
+        test_int(reply.code, 200);
+        test_str(reply.content_type, "text/event-stream");
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_assert(reply_str != NULL);
+        test_assert(!ecs_os_strncmp(reply_str, "data: {", 7));
+        test_assert(strstr(reply_str, "\"entities.count\"") != NULL);
+        test_assert(!ecs_os_strcmp(
+            &reply_str[ecs_os_strlen(reply_str) - 3], "}\n\n"));
+        ecs_os_free(reply_str);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(-1, ecs_http_server_request(srv, "GET",
+            "/stream/stats/foo", &reply));
+        test_int(reply.code, 404);
+        ecs_strbuf_reset(&reply.body);
+        ecs_strbuf_reset(&reply.headers);
+    }
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+#ifdef ECS_TARGET_POSIX
+static
+void rest_test_stream_recv(
+    ecs_world_t *world,
+    int sock,
+    http_test_recv_t *r,
+    int32_t event_count)
+{
+    ecs_time_t t = {0};
+    ecs_time_measure(&t);
+    while (http_test_count(r, "data: ") < event_count) {
+        ecs_time_t now = t;
+        test_assert(ecs_time_measure(&now) < 10.0);
+        test_assert(!r->closed);
+        ecs_progress(world, 0.001);
+        http_test_recv_some(sock, r, 10);
+    }
+}
+
+/* Number of samples in the last pushed event */
+static
+int32_t rest_test_stream_samples(
+    http_test_recv_t *r)
+{
+    const char *member = "\"entities.count\":{\"avg\":[";
+    char *ptr = NULL, *next = r->data;
+    while ((next = strstr(next, member))) {
+        ptr = next = &next[ecs_os_strlen(member)];
+    }
+    test_assert(ptr != NULL);
+
+    int32_t count = 1;
+    for (; *ptr != ']'; ptr ++) {
+        count += *ptr == ',';
+    }
+    return count;
+}
+#endif
+
+void Rest_stream_stats_window(void) {
+#ifdef ECS_TARGET_POSIX
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMonitor);
+
+    ecs_singleton_set(world, EcsRest, { .port = 27768 });
+
+    int sock = http_test_connect(27768, 0);
+    http_test_recv_t r = {0};
+    http_test_send(sock, 
+        "GET /stream/stats/world?period=1m HTTP/1.1\r\n\r\n");
+
+    /* First event has all samples, with descriptions */
+    rest_test_stream_recv(world, sock, &r, 1);
+    test_int(rest_test_stream_samples(&r), ECS_STAT_WINDOW);
+    test_int(http_test_count(&r, "Alive entity ids"), 1);
+
+    /* Update repeats the last sample of the previous event */
+    EcsWorldStats *stats = ecs_get_mut_pair(
+        world, EcsWorld, EcsWorldStats, EcsPeriod1m);
+    stats->hdr.sample_count += 3;
+    rest_test_stream_recv(world, sock, &r, 2);
+    test_int(rest_test_stream_samples(&r), 4);
+    test_int(http_test_count(&r, "Alive entity ids"), 1);
+
+    /* When the client missed a full window of samples, the sample index is
+     * the same as in the last event. Update has all samples. */
+    stats = ecs_get_mut_pair(world, EcsWorld, EcsWorldStats, EcsPeriod1m);
+    stats->hdr.sample_count += ECS_STAT_WINDOW;
+    rest_test_stream_recv(world, sock, &r, 3);
+    test_int(rest_test_stream_samples(&r), ECS_STAT_WINDOW);
+    test_int(http_test_count(&r, "Alive entity ids"), 2);
+
+    close(sock);
+    ecs_os_free(r.data);
+    ecs_fini(world);
+#else
+    /* Socket tests use POSIX sockets */
+#endif
+}
+
+void Rest_metrics(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    ecs_entity_t s = ecs_system(world, {
+        .entity = ecs_entity(world, { .name = "MySystem" })
+    });
+    test_assert(s != 0);
+
+    ecs_progress(world, 0);
+
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    test_int(0, ecs_http_server_request(srv, "GET", "/metrics", &reply));
+    test_int(reply.code, 200);
+    test_str(reply.content_type, 
+        "application/openmetrics-text; version=1.0.0; charset=utf-8");
+    char *reply_str = ecs_strbuf_get(&reply.body);
+    test_assert(reply_str != NULL);
+    test_assert(strstr(reply_str, 
+        "# TYPE flecs_world_frames counter\n") != NULL);
+    test_assert(strstr(reply_str, "\nflecs_world_frames_total 1\n") != NULL);
+    test_assert(strstr(reply_str, 
+        "\nflecs_world_commands_total{kind=\"add\"} ") != NULL);
+    test_assert(strstr(reply_str, 
+        "\nflecs_system_time_seconds_total{system=\"MySystem\"} ") != NULL);
+    test_assert(!ecs_os_strcmp(
+        &reply_str[ecs_os_strlen(reply_str) - 6], "# EOF\n"));
+    ecs_os_free(reply_str);
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+void Rest_metrics_w_histogram(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMetrics);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { "x", ecs_id(ecs_f32_t) },
+            { "y", ecs_id(ecs_f32_t) },
+        }
+    });
+
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.position_y" }),
+        .member = ecs_lookup(world, "Position.y"),
+        .kind = EcsHistogram,
+        .histogram = { .min = 0, .max = 100, .bucket_count = 10 }
+    });
+    test_assert(m != 0);
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_set(world, 0, Position, {0, (float)i});
+    }
+
+    ecs_progress(world, 0);
+
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    test_int(0, ecs_http_server_request(srv, "GET", "/metrics", &reply));
+    char *reply_str = ecs_strbuf_get(&reply.body);
+    test_assert(reply_str != NULL);
+    test_assert(strstr(reply_str, 
+        "# TYPE metrics_position_y summary\n"
+        "metrics_position_y{quantile=\"0.5\"} 50\n"
+        "metrics_position_y{quantile=\"0.9\"} 90\n"
+        "metrics_position_y{quantile=\"0.99\"} 98.1\n"
+        "metrics_position_y_sum 4950\n"
+        "metrics_position_y_count 100\n") != NULL);
+    ecs_os_free(reply_str);
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+void Rest_metrics_w_metric_instances(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_IMPORT(world, FlecsMetrics);
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            { "x", ecs_id(ecs_f32_t) },
+            { "y", ecs_id(ecs_f32_t) },
+        }
+    });
+
+    ecs_entity_t m = ecs_metric(world, {
+        .entity = ecs_entity(world, { .name = "metrics.position_y" }),
+        .member = ecs_lookup(world, "Position.y"),
+        .kind = EcsGauge
+    });
+    test_assert(m != 0);
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_set_name(world, e1, "e1");
+
+    ecs_progress(world, 0);
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET", "/metrics", &reply));
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_assert(reply_str != NULL);
+        test_assert(strstr(reply_str, 
+            "# TYPE metrics_position_y gauge\n") != NULL);
+        test_assert(strstr(reply_str, 
+            "\nmetrics_position_y{entity=\"e1\"} 20\n") != NULL);
+        test_assert(strstr(reply_str, "e2") == NULL);
+        ecs_os_free(reply_str);
+    }
+
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+    ecs_set_name(world, e2, "e2");
+
+    ecs_progress(world, 0);
+
+    {
+        ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+        test_int(0, ecs_http_server_request(srv, "GET", "/metrics", &reply));
+        char *reply_str = ecs_strbuf_get(&reply.body);
+        test_assert(reply_str != NULL);
+        test_assert(strstr(reply_str, 
+            "\nmetrics_position_y{entity=\"e1\"} 20\n") != NULL);
+        test_assert(strstr(reply_str, 
+            "\nmetrics_position_y{entity=\"e2\"} 40\n") != NULL);
+        ecs_os_free(reply_str);
+    }
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+static void Noop(ecs_iter_t *it) { }
+
+void Rest_trace(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    ecs_entity_t s = ecs_system(world, {
+        .entity = ecs_entity(world, { 
+            .name = "MySystem", .add = { ecs_dependson(EcsOnUpdate) } }),
+        .callback = Noop
+    });
+    test_assert(s != 0);
+
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    test_int(0, ecs_http_server_request(srv, "PUT", 
+        "/trace?enabled=true&capacity=1024", &reply));
+    test_int(reply.code, 200);
+    ecs_strbuf_reset(&reply.body);
+    test_bool(ecs_trace_is_recording(world), true);
+
+    ecs_progress(world, 0);
+
+    reply = ECS_HTTP_REPLY_INIT;
+    test_int(0, ecs_http_server_request(srv, "PUT", 
+        "/trace?enabled=false", &reply));
+    test_int(reply.code, 200);
+    ecs_strbuf_reset(&reply.body);
+    test_bool(ecs_trace_is_recording(world), false);
+
+    reply = ECS_HTTP_REPLY_INIT;
+    test_int(0, ecs_http_server_request(srv, "GET", "/trace", &reply));
+    test_int(reply.code, 200);
+    char *reply_str = ecs_strbuf_get(&reply.body);
+    test_assert(reply_str != NULL);
+    test_assert(!ecs_os_strncmp(reply_str, "{\"traceEvents\":[", 16));
+    test_assert(strstr(reply_str, 
+        "{\"name\":\"MySystem\",\"cat\":\"system\"") != NULL);
+    ecs_os_free(reply_str);
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
+
+void Rest_memory(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_query_t *q = ecs_query(world, { 
+        .filter = {
+            .entity = ecs_entity(world, { .name = "MyQuery" }),
+            .terms = {{ ecs_id(Position) }}
+        }
+    });
+    test_assert(q != NULL);
+
+    ecs_set(world, 0, Position, {10, 20});
+
+    ecs_http_server_t *srv = ecs_rest_server_init(world, NULL);
+    test_assert(srv != NULL);
+
+    ecs_http_reply_t reply = ECS_HTTP_REPLY_INIT;
+    test_int(0, ecs_http_server_request(srv, "GET", "/memory", &reply));
+    test_int(reply.code, 200);
+    char *reply_str = ecs_strbuf_get(&reply.body);
+    test_assert(reply_str != NULL);
+    test_assert(!ecs_os_strncmp(reply_str, 
+        "{\"world\":{\"entity_index\":{\"used\":", 33));
+    test_assert(strstr(reply_str, "\"table_data\":{\"used\":") != NULL);
+    test_assert(strstr(reply_str, 
+        "{\"id\":\"Position\",\"table_count\":1,\"columns\":{\"used\":8,") != NULL);
+    test_assert(strstr(reply_str, 
+        "{\"entity\":\"MyQuery\",\"memory\":{\"used\":") != NULL);
+    test_assert(strstr(reply_str, "\"size_classes\":[{\"size\":") != NULL);
+    ecs_os_free(reply_str);
+
+    ecs_rest_server_fini(srv);
+
+    ecs_fini(world);
+}
@@ -877,3 +877,544 @@ void Snapshot_snapshot_from_stage(void) {
 
     ecs_fini(world);
 }
+
+void Snapshot_rollback_simple(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    for (int i = 0; i < 3; i ++) {
+        Position *p = ecs_ensure(world, e, Position);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+
+        p->x += i + 1;
+        p->y += i + 1;
+
+        ecs_snapshot_rollback(world, s);
+
+        test_assert(ecs_has(world, e, Position));
+        const Position *cp = ecs_get(world, e, Position);
+        test_int(cp->x, 10);
+        test_int(cp->y, 20);
+    }
+
+    ecs_snapshot_free(s);
+
+    ecs_fini(world);
+}
+
+void Snapshot_rollback_after_new(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e = ecs_new(world, Position);
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    for (int i = 0; i < 3; i ++) {
+        ecs_entity_t e2 = ecs_new(world, Position);
+        test_assert(e2 != 0);
+
+        ecs_snapshot_rollback(world, s);
+
+        test_assert(ecs_is_alive(world, e));
+        test_assert(!ecs_is_alive(world, e2));
+        test_assert(ecs_has(world, e, Position));
+    }
+
+    ecs_snapshot_free(s);
+
+    ecs_fini(world);
+}
+
+void Snapshot_rollback_after_new_type(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    test_assert(e != 0);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    for (int i = 0; i < 3; i ++) {
+        ecs_set(world, e, Velocity, {1, 2});
+        test_assert(ecs_has(world, e, Velocity));
+
+        ecs_snapshot_rollback(world, s);
+
+        test_assert(ecs_has(world, e, Position));
+        test_assert(!ecs_has(world, e, Velocity));
+
+        const Position *p = ecs_get(world, e, Position);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+    }
+
+    ecs_snapshot_free(s);
+
+    ecs_fini(world);
+}
+
+void Snapshot_rollback_after_delete_table(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_table_t *table = ecs_get_table(world, e);
+    test_assert(table != NULL);
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    for (int i = 0; i < 3; i ++) {
+        ecs_remove(world, e, Velocity);
+        int32_t table_count = ecs_get_world_info(world)->table_count;
+
+        /* First pass marks the table, second pass deletes it */
+        test_int(0, ecs_delete_empty_tables(
+            world, ecs_id(Velocity), 0, 1, 0, 0));
+        test_int(1, ecs_delete_empty_tables(
+            world, ecs_id(Velocity), 0, 1, 0, 0));
+        test_int(ecs_get_world_info(world)->table_count, table_count - 1);
+
+        /* Table id of deleted table may be reused by a different type */
+        ecs_entity_t tmp = ecs_new_w_pair(world, EcsChildOf, e);
+
+        for (int j = 0; j < 2; j ++) {
+            ecs_snapshot_rollback(world, s);
+
+            test_assert(!ecs_is_alive(world, tmp));
+            test_assert(ecs_has(world, e, Position));
+            test_assert(ecs_has(world, e, Velocity));
+
+            table = ecs_get_table(world, e);
+            test_assert(table != NULL);
+            test_assert(ecs_table_has_id(world, table, ecs_id(Velocity)));
+            test_int(ecs_table_count(table), 1);
+
+            const Position *p = ecs_get(world, e, Position);
+            test_assert(p != NULL);
+            test_int(p->x, 10);
+            test_int(p->y, 20);
+
+            const Velocity *v = ecs_get(world, e, Velocity);
+            test_assert(v != NULL);
+            test_int(v->x, 1);
+            test_int(v->y, 2);
+        }
+    }
+
+    ecs_delete_empty_tables(world, 0, 0, 1, 0, 0);
+    ecs_delete_empty_tables(world, 0, 0, 1, 0, 0);
+
+    test_assert(ecs_get_table(world, e) == table);
+    test_assert(ecs_get(world, e, Position) != NULL);
+    test_assert(ecs_get(world, e, Velocity) != NULL);
+
+    ecs_snapshot_free(s);
+
+    ecs_fini(world);
+}
+
+void Snapshot_rollback_w_filter(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Velocity, {1, 2});
+
+    ecs_filter_t f = ECS_FILTER_INIT;
+    ecs_filter_init(world, &(ecs_filter_desc_t){
+        .storage = &f,
+        .terms = {{ ecs_id(Position) }}
+    });
+
+    ecs_iter_t it = ecs_filter_iter(world, &f);
+    ecs_snapshot_t *s = ecs_snapshot_take_w_iter(&it);
+
+    for (int i = 0; i < 3; i ++) {
+        ecs_set(world, e1, Position, {11, 21});
+        ecs_set(world, e2, Velocity, {i + 2, i + 3});
+
+        ecs_snapshot_rollback(world, s);
+
+        const Position *p = ecs_get(world, e1, Position);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+
+        const Velocity *v = ecs_get(world, e2, Velocity);
+        test_int(v->x, i + 2);
+        test_int(v->y, i + 3);
+    }
+
+    ecs_snapshot_free(s);
+
+    ecs_filter_fini(&f);
+
+    ecs_fini(world);
+}
+
+typedef struct {
+    char *value;
+} StringComponent;
+
+static ECS_COPY(StringComponent, dst, src, {
+    ecs_os_free(dst->value);
+    dst->value = ecs_os_strdup(src->value);
+})
+
+static ECS_MOVE(StringComponent, dst, src, {
+    ecs_os_free(dst->value);
+    dst->value = src->value;
+    src->value = NULL;
+})
+
+static ECS_DTOR(StringComponent, ptr, {
+    ecs_os_free(ptr->value);
+})
+
+void Snapshot_rollback_w_copy_hooks(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, StringComponent);
+
+    ecs_set_hooks(world, StringComponent, {
+        .ctor = ecs_default_ctor,
+        .copy = ecs_copy(StringComponent),
+        .move = ecs_move(StringComponent),
+        .dtor = ecs_dtor(StringComponent)
+    });
+
+    ecs_entity_t e = ecs_new(world, StringComponent);
+    ecs_get_mut(world, e, StringComponent)->value = ecs_os_strdup("foo");
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+
+    for (int i = 0; i < 3; i ++) {
+        StringComponent *ptr = ecs_get_mut(world, e, StringComponent);
+        ecs_os_free(ptr->value);
+        ptr->value = ecs_os_strdup("bar");
+
+        ecs_snapshot_rollback(world, s);
+
+        const StringComponent *cptr = ecs_get(world, e, StringComponent);
+        test_assert(cptr != NULL);
+        test_str(cptr->value, "foo");
+    }
+
+    ecs_snapshot_free(s);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_unchanged(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Velocity, {1, 2});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world);
+    ecs_snapshot_t *delta = ecs_snapshot_take_delta(world, base);
+    test_assert(delta != NULL);
+
+    ecs_set(world, e1, Position, {11, 21});
+    ecs_set(world, e2, Velocity, {3, 4});
+
+    ecs_snapshot_restore(world, delta);
+
+    const Position *p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    const Velocity *v = ecs_get(world, e2, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_snapshot_free(base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_changed_column(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world);
+
+    ecs_set(world, e, Position, {11, 21});
+
+    ecs_snapshot_t *delta = ecs_snapshot_take_delta(world, base);
+
+    ecs_set(world, e, Position, {12, 22});
+    ecs_set(world, e, Velocity, {3, 4});
+
+    ecs_snapshot_restore(world, delta);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 11);
+    test_int(p->y, 21);
+
+    const Velocity *v = ecs_get(world, e, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_snapshot_free(base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_new_entity(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world);
+
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+
+    ecs_snapshot_t *delta = ecs_snapshot_take_delta(world, base);
+
+    ecs_delete(world, e2);
+    ecs_set(world, e1, Position, {11, 21});
+
+    ecs_snapshot_restore(world, delta);
+
+    test_assert(ecs_is_alive(world, e2));
+
+    const Position *p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    p = ecs_get(world, e2, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 30);
+    test_int(p->y, 40);
+
+    ecs_snapshot_free(base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_new_table(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world);
+
+    ecs_entity_t e2 = ecs_set(world, 0, Velocity, {1, 2});
+
+    ecs_snapshot_t *delta = ecs_snapshot_take_delta(world, base);
+
+    ecs_delete(world, e1);
+    ecs_set(world, e2, Velocity, {3, 4});
+
+    ecs_snapshot_restore(world, delta);
+
+    test_assert(ecs_is_alive(world, e1));
+    test_assert(ecs_is_alive(world, e2));
+
+    const Position *p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    const Velocity *v = ecs_get(world, e2, Velocity);
+    test_assert(v != NULL);
+    test_int(v->x, 1);
+    test_int(v->y, 2);
+
+    ecs_snapshot_free(base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_rollback(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world);
+
+    ecs_set(world, e, Velocity, {3, 4});
+
+    ecs_snapshot_t *delta = ecs_snapshot_take_delta(world, base);
+
+    for (int i = 0; i < 3; i ++) {
+        ecs_set(world, e, Position, {i, i});
+        ecs_set(world, e, Velocity, {i, i});
+
+        ecs_snapshot_rollback(world, delta);
+
+        const Position *p = ecs_get(world, e, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 10);
+        test_int(p->y, 20);
+
+        const Velocity *v = ecs_get(world, e, Velocity);
+        test_assert(v != NULL);
+        test_int(v->x, 3);
+        test_int(v->y, 4);
+    }
+
+    ecs_snapshot_free(delta);
+    ecs_snapshot_free(base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_w_copy_hooks(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, StringComponent);
+    ECS_COMPONENT(world, Position);
+
+    ecs_set_hooks(world, StringComponent, {
+        .ctor = ecs_default_ctor,
+        .copy = ecs_copy(StringComponent),
+        .move = ecs_move(StringComponent),
+        .dtor = ecs_dtor(StringComponent)
+    });
+
+    ecs_entity_t e = ecs_new(world, StringComponent);
+    ecs_get_mut(world, e, StringComponent)->value = ecs_os_strdup("foo");
+    ecs_modified(world, e, StringComponent);
+    ecs_set(world, e, Position, {10, 20});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world);
+
+    ecs_set(world, e, Position, {11, 21});
+
+    ecs_snapshot_t *delta = ecs_snapshot_take_delta(world, base);
+
+    for (int i = 0; i < 3; i ++) {
+        StringComponent *ptr = ecs_get_mut(world, e, StringComponent);
+        ecs_os_free(ptr->value);
+        ptr->value = ecs_os_strdup("bar");
+        ecs_modified(world, e, StringComponent);
+
+        ecs_snapshot_rollback(world, delta);
+
+        const StringComponent *cptr = ecs_get(world, e, StringComponent);
+        test_assert(cptr != NULL);
+        test_str(cptr->value, "foo");
+
+        const Position *p = ecs_get(world, e, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 11);
+        test_int(p->y, 21);
+    }
+
+    ecs_snapshot_free(delta);
+    ecs_snapshot_free(base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_delta_iter(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Velocity, {1, 2});
+
+    ecs_snapshot_t *base = ecs_snapshot_take(world);
+
+    ecs_set(world, e2, Velocity, {3, 4});
+
+    ecs_snapshot_t *delta = ecs_snapshot_take_delta(world, base);
+
+    bool e1_found = false, e2_found = false;
+    ecs_iter_t it = ecs_snapshot_iter(delta);
+    while (ecs_snapshot_next(&it)) {
+        for (int i = 0; i < it.count; i ++) {
+            test_assert(it.entities != NULL);
+            if (it.entities[i] == e1) {
+                e1_found = true;
+            }
+            if (it.entities[i] == e2) {
+                e2_found = true;
+            }
+        }
+    }
+
+    test_bool(e1_found, true);
+    test_bool(e2_found, true);
+
+    ecs_snapshot_free(delta);
+    ecs_snapshot_free(base);
+
+    ecs_fini(world);
+}
+
+void Snapshot_rollback_reuses_storage(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    
+    ecs_entity_t e1 = ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e2 = ecs_set(world, 0, Position, {30, 40});
+
+    ecs_snapshot_t *s = ecs_snapshot_take(world);
+    const Position *ptr = ecs_get(world, e1, Position);
+
+    for (int i = 0; i < 3; i ++) {
+        ecs_set(world, e1, Position, {i, i});
+        ecs_delete(world, e2);
+
+        ecs_snapshot_rollback(world, s);
+
+        test_assert(ecs_is_alive(world, e2));
+        test_assert(ecs_get(world, e1, Position) == ptr);
+        test_int(ptr->x, 10);
+        test_int(ptr->y, 20);
+
+        const Position *p = ecs_get(world, e2, Position);
+        test_assert(p != NULL);
+        test_int(p->x, 30);
+        test_int(p->y, 40);
+    }
+
+    ecs_snapshot_free(s);
+
+    ecs_fini(world);
+}
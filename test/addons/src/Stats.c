@@ -312,3 +312,334 @@ void Stats_get_not_alive_entity_count(void) {
 
     ecs_fini(world);
 }
+void Stats_get_pipeline_stats_w_stage_time(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_new(world, Position); // Make sure system is active
+
+    ecs_system(world, {
+        .entity = ecs_entity(world, { .name = "FooSys", .add = { ecs_dependson(EcsOnUpdate) } }),
+        .query.filter.terms = {{ ecs_id(Position) }},
+        .callback = FooSys,
+        .multi_threaded = true
+    });
+
+    ecs_set_threads(world, 2);
+    ecs_measure_stage_time(world, true);
+
+    ecs_entity_t pipeline = ecs_get_pipeline(world);
+    test_assert(pipeline != 0);
+
+    ecs_progress(world, 0);
+
+    ecs_pipeline_stats_t stats = {0};
+    test_bool(ecs_pipeline_stats_get(world, pipeline, &stats), true);
+    test_int(ecs_vec_count(&stats.stages), 2);
+
+    ecs_entity_t foo = ecs_lookup(world, "FooSys");
+    test_assert(foo != 0);
+    ecs_system_stats_t *sys_stats = ecs_map_get_deref(
+        &stats.system_stats, ecs_system_stats_t, foo);
+    test_assert(sys_stats != NULL);
+    test_int(ecs_vec_count(&sys_stats->stage_time_spent), 2);
+
+    ecs_metric_t *stage_time = ecs_vec_first_t(
+        &sys_stats->stage_time_spent, ecs_metric_t);
+    ecs_stage_stats_t *stages = ecs_vec_first_t(
+        &stats.stages, ecs_stage_stats_t);
+    double sys_time = stage_time[0].counter.value[1] + 
+        stage_time[1].counter.value[1];
+    double stage_sys_time = stages[0].time_spent.counter.value[0] + 
+        stages[1].time_spent.counter.value[0];
+    test_assert(sys_time > 0);
+    test_assert(stage_sys_time >= sys_time);
+
+    ecs_pipeline_stats_fini(&stats);
+
+    ecs_fini(world);
+}
+
+static void AddTagSys(ecs_iter_t *it) {
+    ecs_id_t tag = *(ecs_id_t*)it->ctx;
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        ecs_add_id(it->world, it->entities[i], tag);
+    }
+}
+
+void Stats_get_pipeline_stats_w_merge_time(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Tag);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_new(world, Position);
+    }
+
+    ecs_system(world, {
+        .entity = ecs_entity(world, { .name = "AddTagSys", .add = { ecs_dependson(EcsOnUpdate) } }),
+        .query.filter.terms = {{ ecs_id(Position) }, { Tag, .oper = EcsNot }},
+        .callback = AddTagSys,
+        .ctx = &Tag,
+        .multi_threaded = true
+    });
+
+    ecs_set_threads(world, 2);
+    ecs_measure_stage_time(world, true);
+
+    ecs_progress(world, 0);
+    test_int(ecs_count(world, Tag), 100);
+
+    ecs_pipeline_stats_t stats = {0};
+    test_bool(ecs_pipeline_stats_get(world, ecs_get_pipeline(world), &stats),
+        true);
+    test_int(ecs_vec_count(&stats.stages), 2);
+
+    ecs_stage_stats_t *stages = ecs_vec_first_t(
+        &stats.stages, ecs_stage_stats_t);
+    test_assert(stages[0].merge_time.counter.value[0] > 0);
+    test_assert(stages[1].merge_time.counter.value[0] > 0);
+
+    ecs_pipeline_stats_fini(&stats);
+
+    ecs_fini(world);
+}
+
+void Stats_get_world_memory(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_query_t *q = ecs_query(world, { .filter.terms = {{ ecs_id(Position) }}});
+    test_assert(q != NULL);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_set(world, 0, Position, {10, 20});
+    }
+
+    ecs_world_memory_t memory;
+    ecs_world_memory_get(world, &memory);
+
+    test_assert(memory.entity_index.used > 0);
+    test_assert(memory.id_index.used > 0);
+    test_assert(memory.tables.used > 0);
+    test_assert(memory.table_data.used >= 100 * ECS_SIZEOF(Position));
+    test_assert(memory.queries.used > 0);
+    test_assert(memory.observers.used > 0);
+    test_assert(memory.name_index.used > 0);
+    test_assert(memory.allocator.used > 0);
+
+    test_assert(memory.entity_index.allocated >= memory.entity_index.used);
+    test_assert(memory.id_index.allocated >= memory.id_index.used);
+    test_assert(memory.tables.allocated >= memory.tables.used);
+    test_assert(memory.table_data.allocated >= memory.table_data.used);
+    test_assert(memory.queries.allocated >= memory.queries.used);
+    test_assert(memory.name_index.allocated >= memory.name_index.used);
+    test_assert(memory.stages.allocated >= memory.stages.used);
+    test_assert(memory.allocator.allocated >= memory.allocator.used);
+
+    ecs_fini(world);
+}
+
+void Stats_get_table_memory(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+
+    ecs_entity_t e = 0;
+    int i;
+    for (i = 0; i < 10; i ++) {
+        e = ecs_set(world, 0, Position, {10, 20});
+        ecs_set(world, e, Velocity, {1, 2});
+    }
+
+    ecs_table_t *table = ecs_get_table(world, e);
+    test_assert(table != NULL);
+
+    ecs_table_memory_t memory;
+    ecs_table_memory_get(world, table, &memory);
+
+    test_int(memory.entities.used, 10 * ECS_SIZEOF(ecs_entity_t));
+    test_assert(memory.entities.allocated >= memory.entities.used);
+    test_int(memory.columns.used, 
+        10 * (ECS_SIZEOF(Position) + ECS_SIZEOF(Velocity)));
+    test_assert(memory.columns.allocated >= memory.columns.used);
+    test_assert(memory.metadata.used > 0);
+    test_assert(memory.metadata.allocated >= memory.metadata.used);
+
+    ecs_delete_with(world, ecs_id(Position));
+
+    ecs_table_memory_get(world, table, &memory);
+    test_int(memory.entities.used, 0);
+    test_int(memory.columns.used, 0);
+
+    ecs_fini(world);
+}
+
+void Stats_get_id_memory(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_TAG(world, Tag);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        ecs_set(world, 0, Position, {10, 20});
+        ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+        ecs_set(world, e, Velocity, {1, 2});
+        ecs_add(world, e, Tag);
+    }
+
+    ecs_id_memory_t memory;
+    /* Includes empty table with (Position, Velocity) */
+    ecs_id_memory_get(world, ecs_id(Position), &memory);
+    test_int(memory.table_count, 3);
+    test_int(memory.columns.used, 20 * ECS_SIZEOF(Position));
+    test_assert(memory.columns.allocated >= memory.columns.used);
+    test_assert(memory.index.used > 0);
+    test_assert(memory.index.allocated >= memory.index.used);
+
+    ecs_id_memory_get(world, ecs_id(Velocity), &memory);
+    test_int(memory.table_count, 2);
+    test_int(memory.columns.used, 10 * ECS_SIZEOF(Velocity));
+
+    ecs_id_memory_get(world, Tag, &memory);
+    test_int(memory.table_count, 1);
+    test_int(memory.columns.used, 0);
+    test_int(memory.columns.allocated, 0);
+
+    ecs_id_memory_get(world, ecs_new_id(world), &memory);
+    test_int(memory.table_count, 0);
+    test_int(memory.columns.used, 0);
+    test_int(memory.index.used, 0);
+
+    ecs_fini(world);
+}
+
+void Stats_get_id_memory_wildcard(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, TgtA);
+    ECS_TAG(world, TgtB);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        ecs_set_pair(world, e, Position, TgtA, {10, 20});
+        ecs_set_pair(world, e, Position, TgtB, {10, 20});
+    }
+
+    ecs_id_memory_t memory;
+    /* Includes empty table with (Position, TgtA) */
+    ecs_id_memory_get(world, ecs_pair(ecs_id(Position), TgtA), &memory);
+    test_int(memory.table_count, 2);
+    test_int(memory.columns.used, 10 * ECS_SIZEOF(Position));
+
+    ecs_id_memory_get(world, ecs_pair(ecs_id(Position), EcsWildcard), &memory);
+    test_int(memory.table_count, 2);
+    test_int(memory.columns.used, 20 * ECS_SIZEOF(Position));
+
+    ecs_fini(world);
+}
+
+void Stats_get_query_memory(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+
+    ecs_query_t *q = ecs_query(world, { .filter.terms = {{ ecs_id(Position) }}});
+    test_assert(q != NULL);
+
+    ecs_memory_t empty = ecs_query_memory_get(q);
+    test_assert(empty.used > 0);
+    test_assert(empty.allocated >= empty.used);
+
+    ecs_set(world, 0, Position, {10, 20});
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+    ecs_add(world, e, TagA);
+    e = ecs_set(world, 0, Position, {10, 20});
+    ecs_add(world, e, TagB);
+
+    ecs_memory_t memory = ecs_query_memory_get(q);
+    test_assert(memory.used > empty.used);
+    test_assert(memory.allocated >= memory.used);
+
+    ecs_fini(world);
+}
+
+void Stats_get_observer_memory(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t o = ecs_observer(world, {
+        .filter.terms = {{ ecs_id(Position) }},
+        .events = { EcsOnAdd },
+        .callback = FooSys
+    });
+    test_assert(o != 0);
+
+    const EcsPoly *poly = ecs_get_pair(world, o, EcsPoly, EcsObserver);
+    test_assert(poly != NULL);
+    const ecs_observer_t *observer = poly->poly;
+
+    ecs_memory_t memory = ecs_observer_memory_get(observer);
+    test_assert(memory.used >= ECS_SIZEOF(ecs_observer_t) + 
+        ECS_SIZEOF(ecs_term_t));
+    test_int(memory.allocated, memory.used);
+
+    ecs_fini(world);
+}
+
+void Stats_get_allocator_memory(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    int i;
+    for (i = 0; i < 100; i ++) {
+        ecs_set(world, 0, Position, {10, 20});
+    }
+
+    int32_t count = ecs_allocator_memory_get(world, NULL, 0);
+    test_assert(count > 0);
+
+    ecs_size_class_memory_t *classes = ecs_os_malloc_n(
+        ecs_size_class_memory_t, count);
+    test_int(ecs_allocator_memory_get(world, classes, count), count);
+
+    int64_t used = 0;
+    for (i = 0; i < count; i ++) {
+        test_assert(classes[i].size > 0);
+        if (i) {
+            test_assert(classes[i].size > classes[i - 1].size);
+        }
+        test_assert(classes[i].chunk_count >= 0);
+        test_assert(classes[i].memory.allocated >= classes[i].memory.used);
+        used += classes[i].memory.used;
+    }
+    test_assert(used > 0);
+
+    ecs_world_memory_t memory;
+    ecs_world_memory_get(world, &memory);
+    test_int(memory.allocator.used, used);
+
+    /* Only first size class is written */
+    ecs_size_class_memory_t first;
+    test_int(ecs_allocator_memory_get(world, &first, 1), count);
+    test_int(first.size, classes[0].size);
+
+    ecs_os_free(classes);
+
+    ecs_fini(world);
+}
@@ -0,0 +1,229 @@
+#include <addons.h>
+
+static
+int32_t trace_count(const char *json, const char *str) {
+    int32_t count = 0;
+    const char *ptr = json;
+    while ((ptr = strstr(ptr, str))) {
+        count ++;
+        ptr ++;
+    }
+    return count;
+}
+
+static void Foo(ecs_iter_t *it) { }
+
+static void AddTag(ecs_iter_t *it) {
+    ecs_id_t tag = *(ecs_id_t*)it->ctx;
+    int i;
+    for (i = 0; i < it->count; i ++) {
+        ecs_add_id(it->world, it->entities[i], tag);
+    }
+}
+
+void Trace_not_started(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_SYSTEM(world, Foo, EcsOnUpdate, 0);
+
+    ecs_progress(world, 0);
+
+    test_bool(ecs_trace_is_recording(world), false);
+
+    char *json = ecs_trace_to_json(world);
+    test_str(json, "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\"}");
+    ecs_os_free(json);
+
+    ecs_fini(world);
+}
+
+void Trace_frame_and_system(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_SYSTEM(world, Foo, EcsOnUpdate, 0);
+
+    ecs_trace_start(world, 0);
+    test_bool(ecs_trace_is_recording(world), true);
+
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    char *json = ecs_trace_to_json(world);
+    test_assert(json != NULL);
+    test_assert(strstr(json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+        "\"tid\":0,\"args\":{\"name\":\"main\"}}") != NULL);
+    test_int(trace_count(json, "{\"name\":\"frame\",\"cat\":\"frame\""), 2);
+    test_int(trace_count(json, "{\"name\":\"Foo\",\"cat\":\"system\""), 2);
+    test_assert(strstr(json, "\"args\":{\"frame\":2}") != NULL);
+    ecs_os_free(json);
+
+    ecs_fini(world);
+}
+
+void Trace_observer(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, TagA);
+    ECS_OBSERVER(world, Foo, EcsOnAdd, TagA);
+
+    ecs_trace_start(world, 0);
+
+    ecs_new(world, TagA);
+
+    char *json = ecs_trace_to_json(world);
+    test_int(trace_count(json, "{\"name\":\"Foo\",\"cat\":\"observer\""), 1);
+    ecs_os_free(json);
+
+    ecs_fini(world);
+}
+
+void Trace_merge(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, TagA);
+
+    ecs_system(world, {
+        .entity = ecs_entity(world, {
+            .name = "AddTag", .add = { ecs_dependson(EcsOnUpdate) } }),
+        .query.filter.terms = {{ ecs_id(Position) }, { TagA, .oper = EcsNot }},
+        .callback = AddTag,
+        .ctx = &TagA
+    });
+
+    ecs_new(world, Position);
+    ecs_new(world, Position);
+
+    ecs_trace_start(world, 0);
+
+    ecs_progress(world, 0);
+
+    char *json = ecs_trace_to_json(world);
+    test_assert(strstr(json, "{\"name\":\"merge\",\"cat\":\"merge\"") != NULL);
+    test_assert(strstr(json, "\"args\":{\"stage\":0,\"commands\":2}") != NULL);
+    ecs_os_free(json);
+
+    ecs_fini(world);
+}
+
+void Trace_table_create(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+
+    ecs_trace_start(world, 0);
+
+    ecs_entity_t e = ecs_new(world, TagA);
+    ecs_add(world, e, TagB);
+
+    char *json = ecs_trace_to_json(world);
+    test_int(trace_count(json, "{\"name\":\"table\",\"cat\":\"table\""), 2);
+    test_assert(strstr(json, ",\"type\":\"TagA, TagB\"}") != NULL);
+    ecs_os_free(json);
+
+    ecs_fini(world);
+}
+
+void Trace_stop(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_SYSTEM(world, Foo, EcsOnUpdate, 0);
+
+    ecs_trace_start(world, 0);
+    ecs_progress(world, 0);
+    ecs_trace_stop(world);
+    test_bool(ecs_trace_is_recording(world), false);
+    ecs_progress(world, 0);
+
+    char *json = ecs_trace_to_json(world);
+    test_int(trace_count(json, "{\"name\":\"Foo\",\"cat\":\"system\""), 1);
+    ecs_os_free(json);
+
+    /* Restarting discards events of the previous trace */
+    ecs_trace_start(world, 0);
+    json = ecs_trace_to_json(world);
+    test_str(json, "{\"traceEvents\":[],\"displayTimeUnit\":\"ns\"}");
+    ecs_os_free(json);
+
+    ecs_fini(world);
+}
+
+void Trace_ring_buffer_wrap(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_SYSTEM(world, Foo, EcsOnUpdate, 0);
+
+    /* Rounded up to 4 */
+    ecs_trace_start(world, 3);
+
+    int i;
+    for (i = 0; i < 10; i ++) {
+        ecs_progress(world, 0);
+    }
+
+    /* Last two frames, each with a system and a frame event */
+    char *json = ecs_trace_to_json(world);
+    test_int(trace_count(json, "\"ph\":\"X\""), 4);
+    test_int(trace_count(json, "{\"name\":\"Foo\",\"cat\":\"system\""), 2);
+    test_assert(strstr(json, "\"args\":{\"frame\":9}") != NULL);
+    test_assert(strstr(json, "\"args\":{\"frame\":10}") != NULL);
+    ecs_os_free(json);
+
+    ecs_fini(world);
+}
+
+void Trace_multi_threaded(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_system(world, {
+        .entity = ecs_entity(world, {
+            .name = "Foo", .add = { ecs_dependson(EcsOnUpdate) } }),
+        .query.filter.terms = {{ ecs_id(Position) }},
+        .callback = Foo,
+        .multi_threaded = true
+    });
+
+    ecs_new(world, Position);
+
+    ecs_set_threads(world, 2);
+    ecs_trace_start(world, 0);
+
+    ecs_progress(world, 0);
+
+    char *json = ecs_trace_to_json(world);
+    test_assert(strstr(json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+        "\"tid\":1,\"args\":{\"name\":\"worker 1\"}}") != NULL);
+    test_int(trace_count(json, "{\"name\":\"Foo\",\"cat\":\"system\""), 2);
+    test_int(trace_count(json, "\"pid\":0,\"tid\":1,\"args\":{\"entity\":"), 1);
+    ecs_os_free(json);
+
+    ecs_fini(world);
+}
+
+void Trace_escape_names(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t tag = ecs_new_entity(world, "Tag\\A");
+
+    ecs_system(world, {
+        .entity = ecs_entity(world, {
+            .name = "Sys\"Foo\"", .add = { ecs_dependson(EcsOnUpdate) } }),
+        .callback = Foo
+    });
+
+    ecs_trace_start(world, 0);
+
+    ecs_new_w_id(world, tag);
+    ecs_progress(world, 0);
+
+    char *json = ecs_trace_to_json(world);
+    test_int(trace_count(json,
+        "{\"name\":\"Sys\\\"Foo\\\"\",\"cat\":\"system\""), 1);
+    test_assert(strstr(json, ",\"type\":\"Tag\\\\A\"}") != NULL);
+    ecs_os_free(json);
+
+    ecs_fini(world);
+}
@@ -1552,6 +1552,15 @@ void Stats_get_pipeline_stats_after_progress_2_systems_one_merge(void);
 void Stats_get_entity_count(void);
 void Stats_get_pipeline_stats_w_task_system(void);
 void Stats_get_not_alive_entity_count(void);
+void Stats_get_pipeline_stats_w_stage_time(void);
+void Stats_get_world_memory(void);
+void Stats_get_table_memory(void);
+void Stats_get_id_memory(void);
+void Stats_get_id_memory_wildcard(void);
+void Stats_get_query_memory(void);
+void Stats_get_observer_memory(void);
+void Stats_get_allocator_memory(void);
+void Stats_get_pipeline_stats_w_merge_time(void);
 
 // Testsuite 'Run'
 void Run_setup(void);
@@ -1629,6 +1638,11 @@ void MultiThread_bulk_new_in_no_readonly_w_multithread(void);
 void MultiThread_bulk_new_in_no_readonly_w_multithread_2(void);
 void MultiThread_run_first_worker_on_main(void);
 void MultiThread_run_single_thread_on_main(void);
+void MultiThread_stats_counters_w_workers(void);
+void MultiThread_worker_table_affinity(void);
+void MultiThread_worker_affinity(void);
+void MultiThread_worker_affinity_restart_threads(void);
+void MultiThread_worker_affinity_numa_node(void);
 
 // Testsuite 'MultiThreadStaging'
 void MultiThreadStaging_setup(void);
@@ -1744,6 +1758,20 @@ void Snapshot_restore_recycled(void);
 void Snapshot_snapshot_w_new_in_onset(void);
 void Snapshot_snapshot_w_new_in_onset_in_snapshot_table(void);
 void Snapshot_snapshot_from_stage(void);
+void Snapshot_rollback_simple(void);
+void Snapshot_rollback_after_new(void);
+void Snapshot_rollback_after_new_type(void);
+void Snapshot_rollback_after_delete_table(void);
+void Snapshot_rollback_w_filter(void);
+void Snapshot_rollback_w_copy_hooks(void);
+void Snapshot_delta_unchanged(void);
+void Snapshot_delta_changed_column(void);
+void Snapshot_delta_new_entity(void);
+void Snapshot_delta_new_table(void);
+void Snapshot_delta_rollback(void);
+void Snapshot_delta_w_copy_hooks(void);
+void Snapshot_delta_iter(void);
+void Snapshot_rollback_reuses_storage(void);
 
 // Testsuite 'Modules'
 void Modules_setup(void);
@@ -1785,6 +1813,16 @@ void Http_teardown(void);
 void Http_teardown_started(void);
 void Http_teardown_stopped(void);
 void Http_stop_start(void);
+void Http_request_leading_empty_line(void);
+void Http_request_invalid_request_line(void);
+void Http_request_pipelined(void);
+void Http_socket_keep_alive(void);
+void Http_socket_pipelined_reply_order(void);
+void Http_socket_partial_send(void);
+void Http_socket_send_queue_limit(void);
+void Http_socket_flush_slow_client(void);
+void Http_socket_request_during_flush(void);
+void Http_socket_gzip_chunked(void);
 
 // Testsuite 'Rest'
 void Rest_teardown(void);
@@ -1800,6 +1838,27 @@ void Rest_request_commands_2_syncs(void);
 void Rest_request_commands_no_frames(void);
 void Rest_request_commands_no_commands(void);
 void Rest_request_commands_garbage_collect(void);
+void Rest_query_large(void);
+void Rest_teardown_between_frames(void);
+void Rest_remove_between_frames(void);
+void Rest_query_etag(void);
+void Rest_query_since(void);
+void Rest_prepared_query(void);
+void Rest_prepared_query_invalid(void);
+void Rest_stream_query(void);
+void Rest_stream_stats(void);
+void Rest_metrics(void);
+void Rest_metrics_w_metric_instances(void);
+void Rest_trace(void);
+void Rest_metrics_w_histogram(void);
+void Rest_memory(void);
+void Rest_prepared_query_cached(void);
+void Rest_query_since_w_source(void);
+void Rest_request_between_frames(void);
+void Rest_request_between_frames_timeout(void);
+void Rest_put_between_frames(void);
+void Rest_stats_between_frames(void);
+void Rest_stream_stats_window(void);
 
 // Testsuite 'Metrics'
 void Metrics_member_gauge_1_entity(void);
@@ -1839,6 +1898,15 @@ void Metrics_pair_member_tgt_type(void);
 void Metrics_pair_dotmember_rel_type(void);
 void Metrics_pair_dotmember_tgt_type(void);
 void Metrics_pair_member_counter_increment(void);
+void Metrics_histogram_linear(void);
+void Metrics_histogram_log(void);
+void Metrics_histogram_out_of_range(void);
+void Metrics_histogram_multiple_tables(void);
+void Metrics_histogram_update(void);
+void Metrics_histogram_dotmember(void);
+void Metrics_histogram_invalid_bucket_count(void);
+void Metrics_histogram_log_invalid_min(void);
+void Metrics_histogram_wo_member(void);
 
 // Testsuite 'Alerts'
 void Alerts_one_active_alert(void);
@@ -1878,6 +1946,17 @@ void Alerts_member_range_from_var_after_remove(void);
 void Alerts_retained_alert_w_dead_source(void);
 void Alerts_alert_counts(void);
 
+// Testsuite 'Trace'
+void Trace_not_started(void);
+void Trace_frame_and_system(void);
+void Trace_observer(void);
+void Trace_merge(void);
+void Trace_table_create(void);
+void Trace_stop(void);
+void Trace_ring_buffer_wrap(void);
+void Trace_multi_threaded(void);
+void Trace_escape_names(void);
+
 bake_test_case Parser_testcases[] = {
     {
         "resolve_this",
@@ -7927,6 +8006,42 @@ bake_test_case Stats_testcases[] = {
     {
         "get_not_alive_entity_count",
         Stats_get_not_alive_entity_count
+    },
+    {
+        "get_pipeline_stats_w_stage_time",
+        Stats_get_pipeline_stats_w_stage_time
+    },
+    {
+        "get_world_memory",
+        Stats_get_world_memory
+    },
+    {
+        "get_table_memory",
+        Stats_get_table_memory
+    },
+    {
+        "get_id_memory",
+        Stats_get_id_memory
+    },
+    {
+        "get_id_memory_wildcard",
+        Stats_get_id_memory_wildcard
+    },
+    {
+        "get_query_memory",
+        Stats_get_query_memory
+    },
+    {
+        "get_observer_memory",
+        Stats_get_observer_memory
+    },
+    {
+        "get_allocator_memory",
+        Stats_get_allocator_memory
+    },
+    {
+        "get_pipeline_stats_w_merge_time",
+        Stats_get_pipeline_stats_w_merge_time
     }
 };
 
@@ -8217,6 +8332,26 @@ bake_test_case MultiThread_testcases[] = {
     {
         "run_single_thread_on_main",
         MultiThread_run_single_thread_on_main
+    },
+    {
+        "stats_counters_w_workers",
+        MultiThread_stats_counters_w_workers
+    },
+    {
+        "worker_table_affinity",
+        MultiThread_worker_table_affinity
+    },
+    {
+        "worker_affinity",
+        MultiThread_worker_affinity
+    },
+    {
+        "worker_affinity_restart_threads",
+        MultiThread_worker_affinity_restart_threads
+    },
+    {
+        "worker_affinity_numa_node",
+        MultiThread_worker_affinity_numa_node
     }
 };
 
@@ -8645,6 +8780,62 @@ bake_test_case Snapshot_testcases[] = {
     {
         "snapshot_from_stage",
         Snapshot_snapshot_from_stage
+    },
+    {
+        "rollback_simple",
+        Snapshot_rollback_simple
+    },
+    {
+        "rollback_after_new",
+        Snapshot_rollback_after_new
+    },
+    {
+        "rollback_after_new_type",
+        Snapshot_rollback_after_new_type
+    },
+    {
+        "rollback_after_delete_table",
+        Snapshot_rollback_after_delete_table
+    },
+    {
+        "rollback_w_filter",
+        Snapshot_rollback_w_filter
+    },
+    {
+        "rollback_w_copy_hooks",
+        Snapshot_rollback_w_copy_hooks
+    },
+    {
+        "delta_unchanged",
+        Snapshot_delta_unchanged
+    },
+    {
+        "delta_changed_column",
+        Snapshot_delta_changed_column
+    },
+    {
+        "delta_new_entity",
+        Snapshot_delta_new_entity
+    },
+    {
+        "delta_new_table",
+        Snapshot_delta_new_table
+    },
+    {
+        "delta_rollback",
+        Snapshot_delta_rollback
+    },
+    {
+        "delta_w_copy_hooks",
+        Snapshot_delta_w_copy_hooks
+    },
+    {
+        "delta_iter",
+        Snapshot_delta_iter
+    },
+    {
+        "rollback_reuses_storage",
+        Snapshot_rollback_reuses_storage
     }
 };
 
@@ -8790,6 +8981,46 @@ bake_test_case Http_testcases[] = {
     {
         "stop_start",
         Http_stop_start
+    },
+    {
+        "request_leading_empty_line",
+        Http_request_leading_empty_line
+    },
+    {
+        "request_invalid_request_line",
+        Http_request_invalid_request_line
+    },
+    {
+        "request_pipelined",
+        Http_request_pipelined
+    },
+    {
+        "socket_keep_alive",
+        Http_socket_keep_alive
+    },
+    {
+        "socket_pipelined_reply_order",
+        Http_socket_pipelined_reply_order
+    },
+    {
+        "socket_partial_send",
+        Http_socket_partial_send
+    },
+    {
+        "socket_send_queue_limit",
+        Http_socket_send_queue_limit
+    },
+    {
+        "socket_flush_slow_client",
+        Http_socket_flush_slow_client
+    },
+    {
+        "socket_request_during_flush",
+        Http_socket_request_during_flush
+    },
+    {
+        "socket_gzip_chunked",
+        Http_socket_gzip_chunked
     }
 };
 
@@ -8845,6 +9076,90 @@ bake_test_case Rest_testcases[] = {
     {
         "request_commands_garbage_collect",
         Rest_request_commands_garbage_collect
+    },
+    {
+        "query_large",
+        Rest_query_large
+    },
+    {
+        "teardown_between_frames",
+        Rest_teardown_between_frames
+    },
+    {
+        "remove_between_frames",
+        Rest_remove_between_frames
+    },
+    {
+        "query_etag",
+        Rest_query_etag
+    },
+    {
+        "query_since",
+        Rest_query_since
+    },
+    {
+        "prepared_query",
+        Rest_prepared_query
+    },
+    {
+        "prepared_query_invalid",
+        Rest_prepared_query_invalid
+    },
+    {
+        "stream_query",
+        Rest_stream_query
+    },
+    {
+        "stream_stats",
+        Rest_stream_stats
+    },
+    {
+        "metrics",
+        Rest_metrics
+    },
+    {
+        "metrics_w_metric_instances",
+        Rest_metrics_w_metric_instances
+    },
+    {
+        "trace",
+        Rest_trace
+    },
+    {
+        "metrics_w_histogram",
+        Rest_metrics_w_histogram
+    },
+    {
+        "memory",
+        Rest_memory
+    },
+    {
+        "prepared_query_cached",
+        Rest_prepared_query_cached
+    },
+    {
+        "query_since_w_source",
+        Rest_query_since_w_source
+    },
+    {
+        "request_between_frames",
+        Rest_request_between_frames
+    },
+    {
+        "request_between_frames_timeout",
+        Rest_request_between_frames_timeout
+    },
+    {
+        "put_between_frames",
+        Rest_put_between_frames
+    },
+    {
+        "stats_between_frames",
+        Rest_stats_between_frames
+    },
+    {
+        "stream_stats_window",
+        Rest_stream_stats_window
     }
 };
 
@@ -8996,6 +9311,42 @@ bake_test_case Metrics_testcases[] = {
     {
         "pair_member_counter_increment",
         Metrics_pair_member_counter_increment
+    },
+    {
+        "histogram_linear",
+        Metrics_histogram_linear
+    },
+    {
+        "histogram_log",
+        Metrics_histogram_log
+    },
+    {
+        "histogram_out_of_range",
+        Metrics_histogram_out_of_range
+    },
+    {
+        "histogram_multiple_tables",
+        Metrics_histogram_multiple_tables
+    },
+    {
+        "histogram_update",
+        Metrics_histogram_update
+    },
+    {
+        "histogram_dotmember",
+        Metrics_histogram_dotmember
+    },
+    {
+        "histogram_invalid_bucket_count",
+        Metrics_histogram_invalid_bucket_count
+    },
+    {
+        "histogram_log_invalid_min",
+        Metrics_histogram_log_invalid_min
+    },
+    {
+        "histogram_wo_member",
+        Metrics_histogram_wo_member
     }
 };
 
@@ -9147,6 +9498,45 @@ bake_test_case Alerts_testcases[] = {
 };
 
 
+bake_test_case Trace_testcases[] = {
+    {
+        "not_started",
+        Trace_not_started
+    },
+    {
+        "frame_and_system",
+        Trace_frame_and_system
+    },
+    {
+        "observer",
+        Trace_observer
+    },
+    {
+        "merge",
+        Trace_merge
+    },
+    {
+        "table_create",
+        Trace_table_create
+    },
+    {
+        "stop",
+        Trace_stop
+    },
+    {
+        "ring_buffer_wrap",
+        Trace_ring_buffer_wrap
+    },
+    {
+        "multi_threaded",
+        Trace_multi_threaded
+    },
+    {
+        "escape_names",
+        Trace_escape_names
+    }
+};
+
 static bake_test_suite suites[] = {
     {
         "Parser",
@@ -9313,7 +9703,7 @@ static bake_test_suite suites[] = {
         "Stats",
         NULL,
         NULL,
-        11,
+        20,
         Stats_testcases
     },
     {
@@ -9327,7 +9717,7 @@ static bake_test_suite suites[] = {
         "MultiThread",
         MultiThread_setup,
         NULL,
-        50,
+        55,
         MultiThread_testcases
     },
     {
@@ -9355,7 +9745,7 @@ static bake_test_suite suites[] = {
         "Snapshot",
         NULL,
         NULL,
-        26,
+        40,
         Snapshot_testcases
     },
     {
@@ -9376,21 +9766,21 @@ static bake_test_suite suites[] = {
         "Http",
         NULL,
         NULL,
-        4,
+        14,
         Http_testcases
     },
     {
         "Rest",
         NULL,
         NULL,
-        13,
+        34,
         Rest_testcases
     },
     {
         "Metrics",
         NULL,
         NULL,
-        37,
+        46,
         Metrics_testcases
     },
     {
@@ -9399,9 +9789,16 @@ static bake_test_suite suites[] = {
         NULL,
         36,
         Alerts_testcases
+    },
+    {
+        "Trace",
+        NULL,
+        NULL,
+        9,
+        Trace_testcases
     }
 };
 
 int main(int argc, char *argv[]) {
-    return bake_test_run("addons", argc, argv, suites, 36);
+    return bake_test_run("addons", argc, argv, suites, 37);
 }
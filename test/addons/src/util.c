@@ -1,6 +1,14 @@
 #include <addons.h>
 #include <stdio.h>
 
+#ifdef ECS_TARGET_POSIX
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <poll.h>
+#endif
+
 void probe_system_w_ctx(
     ecs_iter_t *it,
     Probe *ctx) 
@@ -317,3 +325,81 @@ bool test_iter(
 
     return true;
 }
+
+#ifdef ECS_TARGET_POSIX
+
+/* Connect to server. The server thread binds the socket asynchronously, so
+ * retry until the server accepts connections. */
+int http_test_connect(
+    uint16_t port,
+    int rcvbuf)
+{
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int i;
+    for (i = 0; i < 500; i ++) {
+        int sock = socket(AF_INET, SOCK_STREAM, 0);
+        test_assert(sock >= 0);
+        if (rcvbuf) {
+            setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+        }
+        if (!connect(sock, (struct sockaddr*)&addr, sizeof(addr))) {
+            return sock;
+        }
+        close(sock);
+        ecs_os_sleep(0, 10 * 1000 * 1000);
+    }
+
+    test_assert(false); /* Server did not accept connection */
+    return -1;
+}
+
+void http_test_send(
+    int sock,
+    const char *str)
+{
+    ecs_size_t len = ecs_os_strlen(str);
+    test_int(send(sock, str, (size_t)len, 0), len);
+}
+
+/* Receive data that's available within timeout (ms) */
+void http_test_recv_some(
+    int sock,
+    http_test_recv_t *r,
+    int timeout)
+{
+    struct pollfd pfd = { .fd = sock, .events = POLLIN };
+    while (poll(&pfd, 1, timeout) > 0) {
+        char buf[16 * 1024];
+        ssize_t n = recv(sock, buf, sizeof(buf), 0);
+        if (n <= 0) {
+            r->closed = true;
+            return;
+        }
+
+        r->data = ecs_os_realloc(r->data, r->length + (int32_t)n + 1);
+        ecs_os_memcpy(&r->data[r->length], buf, (int32_t)n);
+        r->length += (int32_t)n;
+        r->data[r->length] = '\0';
+        timeout = 0;
+    }
+}
+
+int32_t http_test_count(
+    const http_test_recv_t *r,
+    const char *str)
+{
+    /* Data can contain zero bytes, so don't use strstr */
+    int32_t result = 0, i, len = ecs_os_strlen(str);
+    for (i = 0; i <= (r->length - len); i ++) {
+        if (!ecs_os_memcmp(&r->data[i], str, len)) {
+            result ++;
+        }
+    }
+    return result;
+}
+
+#endif
@@ -716,3 +716,145 @@ void Lookup_lookup_symbol_path(void) {
 
     ecs_fini(world);
 }
+
+void Lookup_bulk_lookup_path(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t level = ecs_new_entity(world, "level");
+    ecs_entity_t room = ecs_new_entity(world, "level.room");
+    ecs_entity_t chair = ecs_new_entity(world, "level.room.chair");
+    ecs_entity_t table = ecs_new_entity(world, "level.room.table");
+    ecs_entity_t hall = ecs_new_entity(world, "level.hall");
+
+    const char *paths[] = {
+        "level.room.chair", "level.room.table", "level.hall", 
+        "level.room", "level", "level.room.chair"
+    };
+
+    ecs_entity_t entities[6];
+    test_int(ecs_bulk_lookup_path(
+        world, 0, paths, 6, ".", NULL, false, entities), 6);
+    test_assert(entities[0] == chair);
+    test_assert(entities[1] == table);
+    test_assert(entities[2] == hall);
+    test_assert(entities[3] == room);
+    test_assert(entities[4] == level);
+    test_assert(entities[5] == chair);
+
+    ecs_fini(world);
+}
+
+void Lookup_bulk_lookup_path_not_found(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t chair = ecs_new_entity(world, "level.room.chair");
+
+    const char *paths[] = {
+        "level.room.lamp", "level.room.chair", "level.attic.chair", NULL
+    };
+
+    ecs_entity_t entities[4];
+    test_int(ecs_bulk_lookup_path(
+        world, 0, paths, 4, ".", NULL, false, entities), 1);
+    test_assert(entities[0] == 0);
+    test_assert(entities[1] == chair);
+    test_assert(entities[2] == 0);
+    test_assert(entities[3] == 0);
+
+    ecs_fini(world);
+}
+
+void Lookup_bulk_lookup_path_w_parent(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t level = ecs_new_entity(world, "level");
+    ecs_entity_t room = ecs_new_entity(world, "level.room");
+    ecs_entity_t chair = ecs_new_entity(world, "level.room.chair");
+    ecs_entity_t other_room = ecs_new_entity(world, "room");
+
+    const char *paths[] = { "room.chair", "room", "::room", "::level.room" };
+
+    ecs_entity_t entities[4];
+    test_int(ecs_bulk_lookup_path(
+        world, level, paths, 4, ".", "::", false, entities), 4);
+    test_assert(entities[0] == chair);
+    test_assert(entities[1] == room);
+    test_assert(entities[2] == other_room);
+    test_assert(entities[3] == room);
+
+    ecs_fini(world);
+}
+
+void Lookup_bulk_lookup_path_recursive(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t level = ecs_new_entity(world, "level");
+    ecs_entity_t room = ecs_new_entity(world, "level.room");
+    ecs_entity_t lamp = ecs_new_entity(world, "lamp");
+
+    const char *paths[] = { "lamp", "level.room", "Component", "*" };
+
+    ecs_entity_t entities[4];
+    test_int(ecs_bulk_lookup_path(
+        world, room, paths, 4, ".", NULL, false, entities), 1);
+    test_assert(entities[0] == 0);
+    test_assert(entities[1] == 0);
+    test_assert(entities[2] == 0);
+    test_assert(entities[3] == EcsWildcard);
+
+    test_int(ecs_bulk_lookup_path(
+        world, room, paths, 4, ".", NULL, true, entities), 4);
+    test_assert(entities[0] == lamp);
+    test_assert(entities[1] == room);
+    test_assert(entities[2] == ecs_id(EcsComponent));
+    test_assert(entities[3] == EcsWildcard);
+
+    (void)level;
+
+    ecs_fini(world);
+}
+
+void Lookup_bulk_lookup_path_w_alias(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_entity_t chair = ecs_new_entity(world, "level.room.chair");
+    ecs_set_alias(world, chair, "MyChair");
+
+    const char *paths[] = { "MyChair", "level.room.chair" };
+
+    ecs_entity_t entities[2];
+    test_int(ecs_bulk_lookup_path(
+        world, 0, paths, 2, ".", NULL, false, entities), 2);
+    test_assert(entities[0] == chair);
+    test_assert(entities[1] == chair);
+
+    ecs_fini(world);
+}
+
+void Lookup_bulk_lookup_path_deep(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_strbuf_t buf = ECS_STRBUF_INIT;
+    for (int i = 0; i < 40; i ++) {
+        if (i) {
+            ecs_strbuf_appendch(&buf, '.');
+        }
+        ecs_strbuf_append(&buf, "e%d", i);
+    }
+    char *path = ecs_strbuf_get(&buf);
+
+    ecs_entity_t e = ecs_new_entity(world, path);
+    test_assert(e != 0);
+
+    const char *paths[] = { path, path };
+
+    ecs_entity_t entities[2];
+    test_int(ecs_bulk_lookup_path(
+        world, 0, paths, 2, ".", NULL, false, entities), 2);
+    test_assert(entities[0] == e);
+    test_assert(entities[1] == e);
+
+    ecs_os_free(path);
+
+    ecs_fini(world);
+}
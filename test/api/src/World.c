@@ -1520,3 +1520,443 @@ void World_set_get_binding_context_w_free(void) {
 
     test_int(ctx, 10);
 }
+
+void World_mini_w_arena(void) {
+    ecs_world_t *world = ecs_mini_w_arena();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_new(world, Position);
+    ecs_set(world, e, Position, {10, 20});
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void World_init_w_arena(void) {
+    ecs_world_t *world = ecs_init_w_arena();
+
+    ECS_COMPONENT(world, Position);
+    ECS_COMPONENT(world, Velocity);
+    ECS_SYSTEM(world, Move, EcsOnUpdate, Position, Velocity);
+
+    ecs_entity_t e = ecs_new(world, 0);
+    ecs_set(world, e, Position, {0, 0});
+    ecs_set(world, e, Velocity, {1, 2});
+
+    ecs_progress(world, 1);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 1);
+    test_int(p->y, 2);
+
+    ecs_fini(world);
+}
+
+void World_arena_create_delete_tables(void) {
+    ecs_world_t *world = ecs_mini_w_arena();
+
+    ECS_TAG(world, Tag);
+    ecs_run_aperiodic(world, 0);
+
+    const ecs_world_info_t *info = ecs_get_world_info(world);
+    int32_t old_empty_table_count = info->empty_table_count;
+
+    ecs_entity_t e = ecs_new(world, Tag);
+    for (int i = 0; i < 1000; i ++) {
+        ecs_add_id(world, e, ecs_new_id(world));
+    }
+
+    ecs_run_aperiodic(world, 0);
+    test_int(info->empty_table_count, old_empty_table_count + 1000);
+
+    int32_t deleted;
+    deleted = ecs_delete_empty_tables(world, 0, 0, 1, 0, 0);
+    test_int(deleted, 0);
+
+    deleted = ecs_delete_empty_tables(world, 0, 0, 1, 0, 0);
+    test_assert(deleted >= 1000);
+
+    ecs_fini(world);
+}
+
+void World_recreate_world_w_arena(void) {
+    for (int i = 0; i < 10; i ++) {
+        ecs_world_t *world = ecs_mini_w_arena();
+        ECS_COMPONENT(world, Position);
+        ecs_entity_t e = ecs_new(world, Position);
+        test_assert(ecs_has(world, e, Position));
+        ecs_fini(world);
+    }
+}
+
+void World_compact_shrink_table(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e[100];
+    for (int i = 0; i < 100; i ++) {
+        e[i] = ecs_new(world, Position);
+    }
+    for (int i = 1; i < 100; i ++) {
+        ecs_delete(world, e[i]);
+    }
+
+    ecs_table_t *table = ecs_get_table(world, e[0]);
+    test_assert(table != NULL);
+    test_int(ecs_table_count(table), 1);
+
+    test_bool(ecs_compact(world, 0), true);
+
+    const ecs_compaction_stats_t *stats = ecs_get_compaction_stats(world);
+    test_assert(stats->shrink_count >= 1);
+    test_assert(stats->column_bytes > 0);
+    test_int(stats->pass_count, 1);
+    test_int(stats->delete_count, 0);
+
+    test_assert(ecs_get_table(world, e[0]) == table);
+    test_assert(ecs_has(world, e[0], Position));
+
+    ecs_fini(world);
+}
+
+void World_compact_delete_empty_tables(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_TAG(world, TagA);
+    ECS_TAG(world, TagB);
+
+    ecs_entity_t e = ecs_new_w_id(world, TagA);
+    ecs_add(world, e, TagB);
+    ecs_delete(world, e);
+
+    ecs_set_compaction(world, &(ecs_compaction_desc_t){
+        .delete_generation = 1
+    });
+
+    test_bool(ecs_compact(world, 0), true); /* Increase to 1 */
+    const ecs_compaction_stats_t *stats = ecs_get_compaction_stats(world);
+    test_int(stats->delete_count, 0);
+
+    test_bool(ecs_compact(world, 0), true); /* Delete */
+    test_assert(stats->delete_count != 0);
+    test_int(stats->pass_count, 2);
+
+    /* Tables can be recreated */
+    e = ecs_new_w_id(world, TagA);
+    ecs_add(world, e, TagB);
+    test_assert(ecs_has(world, e, TagA));
+    test_assert(ecs_has(world, e, TagB));
+
+    ecs_fini(world);
+}
+
+void World_compact_keep_nonempty_tables(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_entity_t e = ecs_set(world, 0, Position, {10, 20});
+
+    ecs_set_compaction(world, &(ecs_compaction_desc_t){
+        .clear_generation = 1,
+        .delete_generation = 1
+    });
+
+    test_bool(ecs_compact(world, 0), true);
+    test_bool(ecs_compact(world, 0), true);
+    test_bool(ecs_compact(world, 0), true);
+
+    const Position *p = ecs_get(world, e, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void World_compact_on_progress(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_TAG(world, Tag);
+
+    ecs_entity_t e = ecs_new(world, Tag);
+    ecs_delete(world, e);
+
+    ecs_set_compaction(world, &(ecs_compaction_desc_t){
+        .time_budget_seconds = 1,
+        .delete_generation = 1
+    });
+
+    ecs_progress(world, 0);
+    ecs_progress(world, 0);
+
+    const ecs_compaction_stats_t *stats = ecs_get_compaction_stats(world);
+    test_int(stats->pass_count, 2);
+    test_assert(stats->delete_count != 0);
+
+    ecs_set_compaction(world, NULL);
+    ecs_progress(world, 0);
+    test_int(stats->pass_count, 2);
+
+    ecs_fini(world);
+}
+
+void World_compact_stack_pages(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, Position);
+
+    /* Enqueue enough commands to spill into additional stack pages */
+    ecs_defer_begin(world);
+    for (int i = 0; i < 10000; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        ecs_set(world, e, Position, {10, 20});
+    }
+    ecs_defer_end(world);
+
+    /* First pass resets high water mark, second pass frees pages */
+    test_bool(ecs_compact(world, 0), true);
+    test_bool(ecs_compact(world, 0), true);
+
+    const ecs_compaction_stats_t *stats = ecs_get_compaction_stats(world);
+    test_assert(stats->stack_bytes > 0);
+
+    /* Stack can be used after pages were freed */
+    ecs_defer_begin(world);
+    for (int i = 0; i < 10000; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        ecs_set(world, e, Position, {10, 20});
+    }
+    ecs_defer_end(world);
+
+    test_int(ecs_count(world, Position), 20000);
+
+    ecs_fini(world);
+}
+
+void World_intern_names(void) {
+    ecs_world_t *world = ecs_mini();
+
+    test_bool(ecs_enable_name_interning(world, true), false);
+
+    ecs_entity_t p1 = ecs_new_entity(world, "p1");
+    ecs_entity_t p2 = ecs_new_entity(world, "p2");
+    ecs_entity_t c1 = ecs_new_w_pair(world, EcsChildOf, p1);
+    ecs_entity_t c2 = ecs_new_w_pair(world, EcsChildOf, p2);
+    ecs_set_name(world, c1, "child");
+    ecs_set_name(world, c2, "child");
+
+    const char *n1 = ecs_get_name(world, c1);
+    const char *n2 = ecs_get_name(world, c2);
+    test_str(n1, "child");
+    test_str(n2, "child");
+    test_assert(n1 == n2);
+
+    test_assert(ecs_lookup_fullpath(world, "p1.child") == c1);
+    test_assert(ecs_lookup_fullpath(world, "p2.child") == c2);
+
+    ecs_fini(world);
+}
+
+void World_intern_names_rename(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_name_interning(world, true);
+
+    ecs_entity_t e1 = ecs_new_entity(world, "p1.foo");
+    ecs_entity_t e2 = ecs_new_entity(world, "p2.bar");
+
+    ecs_set_name(world, e1, "bar");
+    test_str(ecs_get_name(world, e1), "bar");
+    test_assert(ecs_get_name(world, e1) == ecs_get_name(world, e2));
+
+    /* Set name to its own (interned) value */
+    ecs_set_name(world, e2, ecs_get_name(world, e2));
+    test_str(ecs_get_name(world, e2), "bar");
+    test_assert(ecs_get_name(world, e1) == ecs_get_name(world, e2));
+
+    ecs_set_name(world, e2, "foo");
+    test_str(ecs_get_name(world, e1), "bar");
+    test_str(ecs_get_name(world, e2), "foo");
+    test_assert(ecs_lookup_fullpath(world, "p2.foo") == e2);
+    test_assert(ecs_lookup_fullpath(world, "p1.bar") == e1);
+
+    ecs_set_name(world, e1, NULL);
+    test_assert(ecs_get_name(world, e1) == NULL);
+    test_str(ecs_get_name(world, e2), "foo");
+
+    ecs_fini(world);
+}
+
+void World_intern_names_delete(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_name_interning(world, true);
+
+    ecs_entity_t p1 = ecs_new_entity(world, "p1");
+    ecs_entity_t p2 = ecs_new_entity(world, "p2");
+    ecs_entity_t c1 = ecs_new_entity(world, "p1.child");
+    ecs_entity_t c2 = ecs_new_entity(world, "p2.child");
+    test_assert(ecs_get_name(world, c1) == ecs_get_name(world, c2));
+
+    ecs_delete(world, p1);
+    test_assert(!ecs_is_alive(world, c1));
+    test_str(ecs_get_name(world, c2), "child");
+    test_assert(ecs_lookup_fullpath(world, "p2.child") == c2);
+
+    ecs_delete(world, c2);
+    test_assert(ecs_lookup_fullpath(world, "p2.child") == 0);
+
+    ecs_entity_t c3 = ecs_new_entity(world, "p2.child");
+    test_str(ecs_get_name(world, c3), "child");
+    test_assert(ecs_get_parent(world, c3) == p2);
+
+    ecs_fini(world);
+}
+
+void World_intern_symbol_alias(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_name_interning(world, true);
+
+    ecs_entity_t e1 = ecs_new_entity(world, "Foo");
+    ecs_entity_t e2 = ecs_new_id(world);
+    ecs_set_symbol(world, e1, "Foo");
+    ecs_set_alias(world, e2, "Foo_alias");
+    ecs_entity_t e3 = ecs_new_id(world);
+    ecs_set_symbol(world, e3, "Foo_alias");
+
+    test_assert(ecs_get_name(world, e1) == ecs_get_symbol(world, e1));
+    test_assert(ecs_get_symbol(world, e3) == ecs_get_pair(
+        world, e2, EcsIdentifier, EcsAlias)->value);
+
+    test_assert(ecs_lookup_symbol(world, "Foo", false, false) == e1);
+    test_assert(ecs_lookup_symbol(world, "Foo_alias", false, false) == e3);
+    test_assert(ecs_lookup(world, "Foo_alias") == e2);
+
+    ecs_remove_pair(world, e2, ecs_id(EcsIdentifier), EcsAlias);
+    test_str(ecs_get_symbol(world, e3), "Foo_alias");
+    test_assert(ecs_lookup(world, "Foo_alias") == 0);
+
+    ecs_fini(world);
+}
+
+void World_intern_names_instantiate(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_name_interning(world, true);
+
+    ecs_entity_t base = ecs_new_prefab(world, "Base");
+    ecs_entity_t base_child = ecs_new_prefab(world, "Base.Child");
+
+    ecs_entity_t i1 = ecs_new_w_pair(world, EcsIsA, base);
+    ecs_entity_t i2 = ecs_new_w_pair(world, EcsIsA, base);
+
+    ecs_entity_t c1 = ecs_lookup_child(world, i1, "Child");
+    ecs_entity_t c2 = ecs_lookup_child(world, i2, "Child");
+    test_assert(c1 != 0);
+    test_assert(c2 != 0);
+    test_assert(c1 != c2);
+    test_assert(ecs_get_name(world, c1) == ecs_get_name(world, base_child));
+    test_assert(ecs_get_name(world, c2) == ecs_get_name(world, base_child));
+
+    ecs_delete(world, base);
+    test_str(ecs_get_name(world, c1), "Child");
+    test_str(ecs_get_name(world, c2), "Child");
+
+    ecs_fini(world);
+}
+
+void World_intern_names_disable(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_enable_name_interning(world, true);
+
+    ecs_entity_t e1 = ecs_new_entity(world, "p1.child");
+    ecs_entity_t e2 = ecs_new_entity(world, "p2.child");
+    test_assert(ecs_get_name(world, e1) == ecs_get_name(world, e2));
+
+    test_bool(ecs_enable_name_interning(world, false), true);
+
+    ecs_entity_t e3 = ecs_new_entity(world, "p3.child");
+    test_str(ecs_get_name(world, e3), "child");
+    test_assert(ecs_get_name(world, e3) != ecs_get_name(world, e1));
+
+    /* Previously interned names are still released correctly */
+    ecs_set_name(world, e1, "other");
+    ecs_delete(world, e2);
+    test_str(ecs_get_name(world, e1), "other");
+    test_str(ecs_get_name(world, e3), "child");
+
+    ecs_fini(world);
+}
+
+typedef struct {
+    int64_t v[8];
+} BigComponent;
+
+void World_reserved_storage_grow_column(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, BigComponent);
+
+    test_bool(ecs_set_reserved_storage(world, 256 * 1024 * 1024), true);
+
+    /* Column becomes large enough to be stored in reserved memory */
+    int32_t i, count = FLECS_VM_ALLOC_SIZE / ECS_SIZEOF(BigComponent) + 1;
+    ecs_entity_t first = 0;
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = ecs_set(world, 0, BigComponent, {{ i }});
+        if (!first) {
+            first = e;
+        }
+    }
+
+    const BigComponent *ptr = ecs_get(world, first, BigComponent);
+    test_assert(ptr != NULL);
+
+    /* Growing the column doesn't move it */
+    for (i = count; i < count * 8; i ++) {
+        ecs_set(world, 0, BigComponent, {{ i }});
+    }
+
+    test_assert(ecs_get(world, first, BigComponent) == ptr);
+    test_int(ptr[0].v[0], 0);
+    test_int(ptr[count - 1].v[0], count - 1);
+    test_int(ptr[count * 8 - 1].v[0], count * 8 - 1);
+
+    ecs_fini(world);
+}
+
+void World_reserved_storage_disable(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ECS_COMPONENT(world, BigComponent);
+
+    test_bool(ecs_set_reserved_storage(world, 256 * 1024 * 1024), true);
+
+    int32_t i, count = FLECS_VM_ALLOC_SIZE / ECS_SIZEOF(BigComponent) + 1;
+    ecs_entity_t first = ecs_set(world, 0, BigComponent, {{ 0 }});
+    for (i = 1; i < count; i ++) {
+        ecs_set(world, 0, BigComponent, {{ i }});
+    }
+
+    /* Existing reservations keep growing in place after disabling */
+    test_bool(ecs_set_reserved_storage(world, 0), true);
+    const BigComponent *ptr = ecs_get(world, first, BigComponent);
+    for (i = count; i < count * 2; i ++) {
+        ecs_set(world, 0, BigComponent, {{ i }});
+    }
+
+    test_assert(ecs_get(world, first, BigComponent) == ptr);
+    test_int(ptr[count * 2 - 1].v[0], count * 2 - 1);
+
+    ecs_fini(world);
+}
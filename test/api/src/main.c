@@ -900,6 +900,12 @@ void Lookup_lookup_digit_from_wrong_scope(void);
 void Lookup_lookup_core_entity_from_wrong_scope(void);
 void Lookup_lookup_alias_w_number(void);
 void Lookup_lookup_symbol_path(void);
+void Lookup_bulk_lookup_path(void);
+void Lookup_bulk_lookup_path_not_found(void);
+void Lookup_bulk_lookup_path_w_parent(void);
+void Lookup_bulk_lookup_path_recursive(void);
+void Lookup_bulk_lookup_path_w_alias(void);
+void Lookup_bulk_lookup_path_deep(void);
 
 // Testsuite 'Singleton'
 void Singleton_add_singleton(void);
@@ -2437,6 +2443,23 @@ void World_set_get_context(void);
 void World_set_get_binding_context(void);
 void World_set_get_context_w_free(void);
 void World_set_get_binding_context_w_free(void);
+void World_mini_w_arena(void);
+void World_init_w_arena(void);
+void World_arena_create_delete_tables(void);
+void World_recreate_world_w_arena(void);
+void World_compact_shrink_table(void);
+void World_compact_delete_empty_tables(void);
+void World_compact_keep_nonempty_tables(void);
+void World_compact_on_progress(void);
+void World_compact_stack_pages(void);
+void World_intern_names(void);
+void World_intern_names_rename(void);
+void World_intern_names_delete(void);
+void World_intern_symbol_alias(void);
+void World_intern_names_instantiate(void);
+void World_intern_names_disable(void);
+void World_reserved_storage_grow_column(void);
+void World_reserved_storage_disable(void);
 
 // Testsuite 'WorldInfo'
 void WorldInfo_get_tick(void);
@@ -6208,6 +6231,30 @@ bake_test_case Lookup_testcases[] = {
     {
         "lookup_symbol_path",
         Lookup_lookup_symbol_path
+    },
+    {
+        "bulk_lookup_path",
+        Lookup_bulk_lookup_path
+    },
+    {
+        "bulk_lookup_path_not_found",
+        Lookup_bulk_lookup_path_not_found
+    },
+    {
+        "bulk_lookup_path_w_parent",
+        Lookup_bulk_lookup_path_w_parent
+    },
+    {
+        "bulk_lookup_path_recursive",
+        Lookup_bulk_lookup_path_recursive
+    },
+    {
+        "bulk_lookup_path_w_alias",
+        Lookup_bulk_lookup_path_w_alias
+    },
+    {
+        "bulk_lookup_path_deep",
+        Lookup_bulk_lookup_path_deep
     }
 };
 
@@ -12245,6 +12292,74 @@ bake_test_case World_testcases[] = {
     {
         "set_get_binding_context_w_free",
         World_set_get_binding_context_w_free
+    },
+    {
+        "mini_w_arena",
+        World_mini_w_arena
+    },
+    {
+        "init_w_arena",
+        World_init_w_arena
+    },
+    {
+        "arena_create_delete_tables",
+        World_arena_create_delete_tables
+    },
+    {
+        "recreate_world_w_arena",
+        World_recreate_world_w_arena
+    },
+    {
+        "compact_shrink_table",
+        World_compact_shrink_table
+    },
+    {
+        "compact_delete_empty_tables",
+        World_compact_delete_empty_tables
+    },
+    {
+        "compact_keep_nonempty_tables",
+        World_compact_keep_nonempty_tables
+    },
+    {
+        "compact_on_progress",
+        World_compact_on_progress
+    },
+    {
+        "compact_stack_pages",
+        World_compact_stack_pages
+    },
+    {
+        "intern_names",
+        World_intern_names
+    },
+    {
+        "intern_names_rename",
+        World_intern_names_rename
+    },
+    {
+        "intern_names_delete",
+        World_intern_names_delete
+    },
+    {
+        "intern_symbol_alias",
+        World_intern_symbol_alias
+    },
+    {
+        "intern_names_instantiate",
+        World_intern_names_instantiate
+    },
+    {
+        "intern_names_disable",
+        World_intern_names_disable
+    },
+    {
+        "reserved_storage_grow_column",
+        World_reserved_storage_grow_column
+    },
+    {
+        "reserved_storage_disable",
+        World_reserved_storage_disable
     }
 };
 
@@ -13671,7 +13786,7 @@ static bake_test_suite suites[] = {
         "Lookup",
         Lookup_setup,
         NULL,
-        49,
+        55,
         Lookup_testcases
     },
     {
@@ -13804,7 +13919,7 @@ static bake_test_suite suites[] = {
         "World",
         World_setup,
         NULL,
-        55,
+        72,
         World_testcases
     },
     {
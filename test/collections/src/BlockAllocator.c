@@ -0,0 +1,480 @@
+#include <collections.h>
+
+void BlockAllocator_setup(void) {
+    ecs_os_set_api_defaults();
+#ifdef FLECS_OS_API_IMPL
+    ecs_set_os_api_impl();
+#endif
+}
+
+void BlockAllocator_alloc_free(void) {
+    ecs_block_allocator_t ba;
+    flecs_ballocator_init_t(&ba, int64_t);
+
+    int64_t *v1 = flecs_balloc(&ba);
+    int64_t *v2 = flecs_balloc(&ba);
+    test_assert(v1 != NULL);
+    test_assert(v2 != NULL);
+    test_assert(v1 != v2);
+    *v1 = 10;
+    *v2 = 20;
+
+    flecs_bfree(&ba, v1);
+    test_assert(flecs_balloc(&ba) == v1);
+
+    flecs_bfree(&ba, v1);
+    flecs_bfree(&ba, v2);
+    flecs_ballocator_fini(&ba);
+}
+
+void BlockAllocator_depot_alloc_free(void) {
+    ecs_block_allocator_depot_t *depot = flecs_ballocator_depot_new();
+    ecs_block_allocator_t ba;
+    flecs_ballocator_init_w_depot(&ba, ECS_SIZEOF(int64_t), depot);
+
+    int64_t *v1 = flecs_balloc(&ba);
+    int64_t *v2 = flecs_balloc(&ba);
+    test_assert(v1 != NULL);
+    test_assert(v2 != NULL);
+    test_assert(v1 != v2);
+    *v1 = 10;
+    *v2 = 20;
+
+    flecs_bfree(&ba, v1);
+    test_assert(flecs_balloc(&ba) == v1);
+
+    flecs_bfree(&ba, v1);
+    flecs_bfree(&ba, v2);
+    flecs_ballocator_fini(&ba);
+    flecs_ballocator_depot_free(depot);
+}
+
+void BlockAllocator_depot_free_w_other_allocator(void) {
+    ecs_block_allocator_depot_t *depot = flecs_ballocator_depot_new();
+    ecs_block_allocator_t ba_1, ba_2;
+    flecs_ballocator_init_w_depot(&ba_1, ECS_SIZEOF(int64_t), depot);
+    flecs_ballocator_init_w_depot(&ba_2, ECS_SIZEOF(int64_t), depot);
+
+    int64_t *v = flecs_balloc(&ba_1);
+    test_assert(v != NULL);
+    flecs_bfree(&ba_2, v);
+
+    /* Chunk is now in the free list of the other allocator */
+    test_assert(flecs_balloc(&ba_2) == v);
+    flecs_bfree(&ba_1, v);
+
+    flecs_ballocator_fini(&ba_1);
+    flecs_ballocator_fini(&ba_2);
+    flecs_ballocator_depot_free(depot);
+}
+
+void BlockAllocator_depot_reuse_after_fini(void) {
+    ecs_block_allocator_depot_t *depot = flecs_ballocator_depot_new();
+    ecs_block_allocator_t ba_1, ba_2;
+    flecs_ballocator_init_w_depot(&ba_1, ECS_SIZEOF(int64_t), depot);
+
+    int64_t *v = flecs_balloc(&ba_1);
+    test_assert(v != NULL);
+    flecs_bfree(&ba_1, v);
+    flecs_ballocator_fini(&ba_1);
+
+    /* Free chunks of the first allocator were returned to the depot */
+    flecs_ballocator_init_w_depot(&ba_2, ECS_SIZEOF(int64_t), depot);
+    test_assert(flecs_balloc(&ba_2) == v);
+    flecs_bfree(&ba_2, v);
+    flecs_ballocator_fini(&ba_2);
+
+    flecs_ballocator_depot_free(depot);
+}
+
+void BlockAllocator_depot_return_magazine(void) {
+    ecs_block_allocator_depot_t *depot = flecs_ballocator_depot_new();
+    ecs_block_allocator_t ba_1, ba_2;
+    flecs_ballocator_init_w_depot(&ba_1, ECS_SIZEOF(int64_t), depot);
+    flecs_ballocator_init_w_depot(&ba_2, ECS_SIZEOF(int64_t), depot);
+
+    /* Allocate enough chunks for more than two magazines */
+    int32_t i, count = ba_1.chunks_per_block * 3;
+    int64_t **ptrs = ecs_os_malloc_n(int64_t*, count);
+    for (i = 0; i < count; i ++) {
+        ptrs[i] = flecs_balloc(&ba_1);
+        *ptrs[i] = i;
+    }
+
+    /* Freeing returns magazines to the depot, so the free list of the 
+     * allocator never has more chunks than two magazines */
+    for (i = 0; i < count; i ++) {
+        flecs_bfree(&ba_1, ptrs[i]);
+        test_assert(ba_1.free_count < (ba_1.chunks_per_block * 2));
+    }
+
+    /* Other allocator takes magazine that was returned */
+    int64_t *v = flecs_balloc(&ba_2);
+    for (i = 0; i < count; i ++) {
+        if (ptrs[i] == v) {
+            break;
+        }
+    }
+    test_assert(i != count);
+    flecs_bfree(&ba_2, v);
+
+    ecs_os_free(ptrs);
+    flecs_ballocator_fini(&ba_1);
+    flecs_ballocator_fini(&ba_2);
+    flecs_ballocator_depot_free(depot);
+}
+
+void BlockAllocator_depot_different_sizes(void) {
+    ecs_block_allocator_depot_t *depot = flecs_ballocator_depot_new();
+    ecs_block_allocator_t ba_1, ba_2;
+    flecs_ballocator_init_w_depot(&ba_1, 16, depot);
+    flecs_ballocator_init_w_depot(&ba_2, 64, depot);
+
+    void *v1 = flecs_balloc(&ba_1);
+    flecs_bfree(&ba_1, v1);
+    flecs_ballocator_fini(&ba_1);
+
+    /* Chunks of a different size are not reused */
+    void *v2 = flecs_balloc(&ba_2);
+    test_assert(v2 != v1);
+    ecs_os_memset(v2, 0, 64);
+    flecs_bfree(&ba_2, v2);
+    flecs_ballocator_fini(&ba_2);
+
+    flecs_ballocator_depot_free(depot);
+}
+
+void BlockAllocator_allocator_w_depot(void) {
+    ecs_block_allocator_depot_t *depot = flecs_ballocator_depot_new();
+    ecs_allocator_t a_1, a_2;
+    flecs_allocator_init_w_depot(&a_1, depot);
+    flecs_allocator_init_w_depot(&a_2, depot);
+
+    char *str = flecs_strdup(&a_1, "Hello World");
+    test_str(str, "Hello World");
+    flecs_strfree(&a_2, str);
+
+    int32_t *v = flecs_alloc_n(&a_1, int32_t, 100);
+    test_assert(v != NULL);
+    v[99] = 10;
+    flecs_free_n(&a_2, int32_t, 100, v);
+
+    flecs_allocator_fini(&a_1);
+    flecs_allocator_fini(&a_2);
+    flecs_ballocator_depot_free(depot);
+}
+
+#define THREAD_COUNT (4)
+#define THREAD_ALLOC_COUNT (10000)
+
+typedef struct {
+    ecs_block_allocator_depot_t *depot;
+    int64_t **ptrs;     /* Chunks allocated by this thread */
+    int64_t **other;    /* Chunks allocated by other thread, freed by this */
+    int32_t id;
+    bool failed;
+} thread_ctx_t;
+
+static
+void* depot_thread(void *arg) {
+    thread_ctx_t *ctx = arg;
+    ecs_block_allocator_t ba;
+    flecs_ballocator_init_w_depot(&ba, ECS_SIZEOF(int64_t) * 2, ctx->depot);
+
+    int32_t i, r;
+    for (r = 0; r < 10; r ++) {
+        for (i = 0; i < THREAD_ALLOC_COUNT; i ++) {
+            ctx->ptrs[i] = flecs_balloc(&ba);
+            ctx->ptrs[i][0] = ctx->id;
+            ctx->ptrs[i][1] = i;
+        }
+        for (i = 0; i < THREAD_ALLOC_COUNT; i ++) {
+            if (ctx->ptrs[i][0] != ctx->id || ctx->ptrs[i][1] != i) {
+                ctx->failed = true;
+            }
+            flecs_bfree(&ba, ctx->ptrs[i]);
+        }
+    }
+
+    /* Free chunks allocated by other thread */
+    for (i = 0; i < THREAD_ALLOC_COUNT; i ++) {
+        flecs_bfree(&ba, ctx->other[i]);
+    }
+
+    flecs_ballocator_fini(&ba);
+    return NULL;
+}
+
+void BlockAllocator_depot_multithreaded(void) {
+    if (!ecs_os_has_threading()) {
+        test_quarantine("threading is not available");
+        return;
+    }
+
+    ecs_block_allocator_depot_t *depot = flecs_ballocator_depot_new();
+    ecs_block_allocator_t ba;
+    flecs_ballocator_init_w_depot(&ba, ECS_SIZEOF(int64_t) * 2, depot);
+
+    thread_ctx_t ctx[THREAD_COUNT];
+    ecs_os_thread_t threads[THREAD_COUNT];
+    int32_t t, i;
+    for (t = 0; t < THREAD_COUNT; t ++) {
+        ctx[t].depot = depot;
+        ctx[t].id = t;
+        ctx[t].failed = false;
+        ctx[t].ptrs = ecs_os_malloc_n(int64_t*, THREAD_ALLOC_COUNT);
+        ctx[t].other = ecs_os_malloc_n(int64_t*, THREAD_ALLOC_COUNT);
+        for (i = 0; i < THREAD_ALLOC_COUNT; i ++) {
+            ctx[t].other[i] = flecs_balloc(&ba);
+        }
+    }
+
+    for (t = 0; t < THREAD_COUNT; t ++) {
+        threads[t] = ecs_os_thread_new(depot_thread, &ctx[t]);
+    }
+
+    for (t = 0; t < THREAD_COUNT; t ++) {
+        ecs_os_thread_join(threads[t]);
+        test_bool(ctx[t].failed, false);
+        ecs_os_free(ctx[t].ptrs);
+        ecs_os_free(ctx[t].other);
+    }
+
+    flecs_ballocator_fini(&ba);
+    flecs_ballocator_depot_free(depot);
+}
+
+void BlockAllocator_alloc_free_large(void) {
+    ecs_block_allocator_t ba;
+    flecs_ballocator_init(&ba, FLECS_PAGE_ALLOC_SIZE);
+    test_int(ba.chunks_per_block, 1);
+
+    char *v1 = flecs_balloc(&ba);
+    char *v2 = flecs_balloc(&ba);
+    test_assert(v1 != NULL);
+    test_assert(v2 != NULL);
+    test_assert(v1 != v2);
+#ifndef FLECS_SANITIZE
+    test_int((uintptr_t)v1 & 4095, 0);
+    test_int((uintptr_t)v2 & 4095, 0);
+#endif
+    ecs_os_memset(v1, 1, FLECS_PAGE_ALLOC_SIZE);
+    ecs_os_memset(v2, 2, FLECS_PAGE_ALLOC_SIZE);
+    test_int(v1[FLECS_PAGE_ALLOC_SIZE - 1], 1);
+    test_int(v2[0], 2);
+
+    flecs_bfree(&ba, v1);
+    test_assert(flecs_balloc(&ba) == v1);
+
+    flecs_bfree(&ba, v1);
+    flecs_bfree(&ba, v2);
+    flecs_ballocator_fini(&ba);
+}
+
+void BlockAllocator_alloc_free_huge(void) {
+    ecs_size_t size = FLECS_HUGE_PAGE_ALLOC_SIZE * 2;
+    ecs_block_allocator_t ba;
+    flecs_ballocator_init(&ba, size);
+
+    char *v = flecs_balloc(&ba);
+    test_assert(v != NULL);
+    ecs_os_memset(v, 1, size);
+    test_int(v[0], 1);
+    test_int(v[size - 1], 1);
+
+    flecs_bfree(&ba, v);
+    flecs_ballocator_fini(&ba);
+}
+
+void BlockAllocator_alloc_free_large_w_arena(void) {
+    ecs_block_allocator_arena_t arena;
+    flecs_ballocator_arena_init(&arena);
+
+    ecs_block_allocator_t ba;
+    flecs_ballocator_init_w_arena(&ba, FLECS_PAGE_ALLOC_SIZE, &arena);
+
+    /* Large blocks don't use the arena */
+    char *v = flecs_balloc(&ba);
+    test_assert(v != NULL);
+    test_int(arena.page_count, 0);
+    ecs_os_memset(v, 1, FLECS_PAGE_ALLOC_SIZE);
+
+    flecs_bfree(&ba, v);
+    flecs_ballocator_fini(&ba);
+    flecs_ballocator_arena_fini(&arena);
+}
+
+void BlockAllocator_os_aligned_alloc(void) {
+    ecs_size_t alignments[] = { 1, 8, 64, 4096 };
+    int i;
+    for (i = 0; i < 4; i ++) {
+        char *v = ecs_os_aligned_alloc(100, alignments[i]);
+        test_assert(v != NULL);
+        test_int((uintptr_t)v & (uintptr_t)(alignments[i] - 1), 0);
+        ecs_os_memset(v, 1, 100);
+        ecs_os_aligned_free(v);
+    }
+
+    ecs_os_aligned_free(NULL);
+}
+
+void BlockAllocator_os_page_alloc(void) {
+    char *v = ecs_os_page_alloc(10000, -1, 0);
+    test_assert(v != NULL);
+    test_int((uintptr_t)v & 4095, 0);
+    ecs_os_memset(v, 1, 10000);
+    test_int(v[9999], 1);
+    ecs_os_page_free(v, 10000);
+}
+
+void BlockAllocator_os_page_alloc_huge_w_node(void) {
+    ecs_size_t size = 3 * 1024 * 1024;
+    char *v = ecs_os_page_alloc(size, 0, EcsOsPageHuge);
+    test_assert(v != NULL);
+    test_int((uintptr_t)v & 4095, 0);
+    ecs_os_memset(v, 1, size);
+    test_int(v[0], 1);
+    test_int(v[size - 1], 1);
+    ecs_os_page_free(v, size);
+}
+
+void BlockAllocator_trim(void) {
+    ecs_block_allocator_t ba;
+    flecs_ballocator_init(&ba, 64);
+    test_assert(ba.chunks_per_block > 1);
+
+    int32_t i, count = ba.chunks_per_block * 3;
+    void **ptrs = ecs_os_malloc_n(void*, count);
+    for (i = 0; i < count; i ++) {
+        ptrs[i] = flecs_balloc(&ba);
+    }
+
+    /* No free chunks */
+    test_int(flecs_ballocator_trim(&ba), 0);
+
+    /* Free all chunks of first block, one chunk of second block */
+    for (i = 0; i <= ba.chunks_per_block; i ++) {
+        flecs_bfree(&ba, ptrs[i]);
+    }
+
+    test_int(flecs_ballocator_trim(&ba), ba.block_size);
+    test_int(flecs_ballocator_trim(&ba), 0);
+
+    /* Remaining free chunk can be reused */
+    void *ptr = flecs_balloc(&ba);
+    test_assert(ptr == ptrs[ba.chunks_per_block]);
+    ptrs[ba.chunks_per_block] = ptr;
+
+    for (i = ba.chunks_per_block; i < count; i ++) {
+        flecs_bfree(&ba, ptrs[i]);
+    }
+
+    test_int(flecs_ballocator_trim(&ba), 2 * ba.block_size);
+    test_assert(ba.block_head == NULL);
+    test_assert(ba.block_tail == NULL);
+    test_assert(ba.head == NULL);
+
+    /* Allocator can be used after all blocks were freed */
+    ptr = flecs_balloc(&ba);
+    test_assert(ptr != NULL);
+    flecs_bfree(&ba, ptr);
+
+    ecs_os_free(ptrs);
+    flecs_ballocator_fini(&ba);
+}
+
+void BlockAllocator_trim_w_arena(void) {
+    ecs_block_allocator_arena_t arena;
+    flecs_ballocator_arena_init(&arena);
+
+    ecs_block_allocator_t ba;
+    flecs_ballocator_init_w_arena(&ba, 64, &arena);
+
+    void *ptr = flecs_balloc(&ba);
+    flecs_bfree(&ba, ptr);
+
+    /* Blocks of an arena are freed with the arena */
+    test_int(flecs_ballocator_trim(&ba), 0);
+
+    flecs_ballocator_fini(&ba);
+    flecs_ballocator_arena_fini(&arena);
+}
+
+void BlockAllocator_os_vm_reserve_commit(void) {
+    test_assert(ecs_os_has_vm());
+
+    ecs_size_t size = 4 * 1024 * 1024;
+    char *v = ecs_os_vm_reserve(size);
+    test_assert(v != NULL);
+    test_int(ecs_os_vm_commit(v, 10000), 0);
+    v[0] = 1; v[9999] = 2;
+    test_int(ecs_os_vm_commit(v, size), 0);
+    test_int(v[0], 1);
+    test_int(v[9999], 2);
+    v[size - 1] = 3;
+    ecs_os_vm_release(v, size);
+}
+
+void BlockAllocator_allocator_vm_realloc(void) {
+    ecs_allocator_t a;
+    flecs_allocator_init(&a);
+    test_bool(flecs_allocator_set_vm_reserve(&a, 64 * 1024 * 1024), true);
+
+    ecs_size_t size = FLECS_VM_ALLOC_SIZE;
+    int32_t *ptr = flecs_alloc(&a, size);
+    test_assert(ptr != NULL);
+    test_int(ecs_map_count(&a.vm.regions), 1);
+    int32_t i, count = size / ECS_SIZEOF(int32_t);
+    for (i = 0; i < count; i ++) {
+        ptr[i] = i;
+    }
+
+    /* Growing commits more of the region, which doesn't move the data */
+    int32_t *grown = flecs_realloc(&a, size * 4, size, ptr);
+    test_assert(grown == ptr);
+    test_int(a.vm.committed, size * 4);
+    for (i = 0; i < count; i ++) {
+        test_int(grown[i], i);
+    }
+    grown[count * 4 - 1] = 10;
+
+    /* Shrinking moves data out of the region */
+    int32_t *shrunk = flecs_realloc(&a, 1024, size * 4, grown);
+    test_assert(shrunk != grown);
+    test_int(ecs_map_count(&a.vm.regions), 0);
+    test_int(a.vm.committed, 0);
+    test_int(shrunk[255], 255);
+
+    flecs_free(&a, 1024, shrunk);
+    flecs_allocator_fini(&a);
+}
+
+void BlockAllocator_allocator_vm_exceed_reserve(void) {
+    ecs_allocator_t a;
+    flecs_allocator_init(&a);
+    test_bool(flecs_allocator_set_vm_reserve(&a, 2 * FLECS_VM_ALLOC_SIZE),
+        true);
+
+    ecs_size_t size = FLECS_VM_ALLOC_SIZE;
+    char *ptr = flecs_alloc(&a, size);
+    ptr[size - 1] = 1;
+
+    /* Grows in place while within the reservation */
+    char *grown = flecs_realloc(&a, size * 2, size, ptr);
+    test_assert(grown == ptr);
+
+    /* Copies when it no longer fits */
+    char *moved = flecs_realloc(&a, size * 4, size * 2, grown);
+    test_int(moved[size - 1], 1);
+    test_int(ecs_map_count(&a.vm.regions), 0);
+
+    flecs_free(&a, size * 4, moved);
+
+    /* Disabling the reserve uses regular blocks */
+    test_bool(flecs_allocator_set_vm_reserve(&a, 0), true);
+    ptr = flecs_alloc(&a, size);
+    test_int(ecs_map_count(&a.vm.regions), 0);
+    flecs_free(&a, size, ptr);
+
+    flecs_allocator_fini(&a);
+}
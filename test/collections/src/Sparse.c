@@ -392,3 +392,150 @@ void Sparse_remove_low_after_ensure_high(void) {
 
     flecs_sparse_free(sp);
 }
+
+void Sparse_new_ids(void) {
+    ecs_sparse_t *sp = flecs_sparse_new(NULL, NULL, int);
+
+    const uint64_t *ids = flecs_sparse_new_ids(sp, 10000);
+    test_assert(ids != NULL);
+    test_int(flecs_sparse_count(sp), 10000);
+
+    uint64_t copy[10000];
+    ecs_os_memcpy_n(copy, ids, uint64_t, 10000);
+
+    int i;
+    for (i = 0; i < 10000; i ++) {
+        test_assert(flecs_sparse_is_alive(sp, copy[i]));
+        int *ptr = flecs_sparse_get_t(sp, int, copy[i]);
+        test_assert(ptr != NULL);
+        test_int(*ptr, 0);
+        *ptr = i;
+    }
+
+    for (i = 0; i < 10000; i ++) {
+        test_int(*flecs_sparse_get_t(sp, int, copy[i]), i);
+        if (i) {
+            test_assert(copy[i] != copy[i - 1]);
+        }
+    }
+
+    flecs_sparse_free(sp);
+}
+
+void Sparse_new_ids_recycle(void) {
+    ecs_sparse_t *sp = flecs_sparse_new(NULL, NULL, int);
+
+    uint64_t first[4];
+    ecs_os_memcpy_n(first, flecs_sparse_new_ids(sp, 4), uint64_t, 4);
+    flecs_sparse_remove_t(sp, int, first[1]);
+    flecs_sparse_remove_t(sp, int, first[2]);
+    test_int(flecs_sparse_count(sp), 2);
+
+    /* Two ids are recycled, one is new */
+    const uint64_t *ids = flecs_sparse_new_ids(sp, 3);
+    test_int(flecs_sparse_count(sp), 5);
+    test_assert(flecs_sparse_is_alive_n(sp, ids, 3));
+    test_assert(flecs_sparse_is_alive_n(sp, first, 1));
+    test_assert(!flecs_sparse_is_alive(sp, first[1]));
+    test_assert(!flecs_sparse_is_alive(sp, first[2]));
+
+    int i, recycled = 0;
+    for (i = 0; i < 3; i ++) {
+        if ((uint32_t)ids[i] == (uint32_t)first[1] ||
+            (uint32_t)ids[i] == (uint32_t)first[2])
+        {
+            test_assert(ECS_GENERATION(ids[i]) == 1);
+            recycled ++;
+        }
+    }
+    test_int(recycled, 2);
+
+    flecs_sparse_free(sp);
+}
+
+void Sparse_remove_n(void) {
+    ecs_sparse_t *sp = flecs_sparse_new(NULL, NULL, int);
+
+    uint64_t ids[6000];
+    ecs_os_memcpy_n(ids, flecs_sparse_new_ids(sp, 6000), uint64_t, 6000);
+    test_assert(flecs_sparse_is_alive_n(sp, ids, 6000));
+
+    /* Remove every other id, spanning multiple pages */
+    uint64_t removed[3000];
+    int i;
+    for (i = 0; i < 3000; i ++) {
+        removed[i] = ids[i * 2];
+    }
+
+    flecs_sparse_remove_n_t(sp, int, removed, 3000);
+    test_int(flecs_sparse_count(sp), 3000);
+
+    for (i = 0; i < 6000; i ++) {
+        test_bool(flecs_sparse_is_alive(sp, ids[i]), (i % 2) != 0);
+    }
+
+    /* Removing ids that are no longer alive is a no-op */
+    flecs_sparse_remove_n_t(sp, int, removed, 3000);
+    test_int(flecs_sparse_count(sp), 3000);
+
+    flecs_sparse_free(sp);
+}
+
+void Sparse_is_alive_n(void) {
+    ecs_sparse_t *sp = flecs_sparse_new(NULL, NULL, int);
+
+    uint64_t ids[5];
+    ecs_os_memcpy_n(ids, flecs_sparse_new_ids(sp, 5), uint64_t, 5);
+    test_assert(flecs_sparse_is_alive_n(sp, ids, 5));
+    test_assert(flecs_sparse_is_alive_n(sp, ids, 0));
+
+    flecs_sparse_remove_t(sp, int, ids[3]);
+    test_assert(flecs_sparse_is_alive_n(sp, ids, 3));
+    test_assert(!flecs_sparse_is_alive_n(sp, ids, 5));
+
+    /* Recycled id has a different generation */
+    uint64_t old = ids[3];
+    ids[3] = flecs_sparse_new_id(sp);
+    test_assert(flecs_sparse_is_alive_n(sp, ids, 5));
+    test_assert(!flecs_sparse_is_alive_n(sp, &old, 1));
+
+    /* Id in page that doesn't exist */
+    uint64_t high = 100000;
+    test_assert(!flecs_sparse_is_alive_n(sp, &high, 1));
+
+    flecs_sparse_free(sp);
+}
+
+void Sparse_iter(void) {
+    ecs_sparse_t *sp = flecs_sparse_new(NULL, NULL, int);
+    populate(sp, 5000);
+    flecs_sparse_remove_t(sp, int, flecs_sparse_ids(sp)[10]);
+
+    int32_t count = flecs_sparse_count(sp);
+    test_int(count, 4999);
+
+    ecs_sparse_iter_t it = flecs_sparse_iter(sp);
+    int i = 0, *ptr;
+    uint64_t id;
+    while ((ptr = flecs_sparse_next_t(&it, int, &id))) {
+        test_assert(i < count);
+        test_assert(ptr == flecs_sparse_get_dense_t(sp, int, i));
+        test_assert(ptr == flecs_sparse_get_t(sp, int, id));
+        test_assert(id == flecs_sparse_ids(sp)[i]);
+        i ++;
+    }
+
+    test_int(i, count);
+    test_assert(flecs_sparse_next_t(&it, int, NULL) == NULL);
+
+    flecs_sparse_free(sp);
+}
+
+void Sparse_iter_empty(void) {
+    ecs_sparse_t *sp = flecs_sparse_new(NULL, NULL, int);
+
+    ecs_sparse_iter_t it = flecs_sparse_iter(sp);
+    test_assert(flecs_sparse_next_t(&it, int, NULL) == NULL);
+
+    flecs_sparse_free(sp);
+}
@@ -529,3 +529,127 @@ void Strbuf_append_inf_delim(void) {
         ecs_os_free(str);
     }
 }
+
+void Strbuf_append_int(void) {
+    ecs_strbuf_t b = ECS_STRBUF_INIT;
+    ecs_strbuf_appendint(&b, 0);
+    ecs_strbuf_appendch(&b, ' ');
+    ecs_strbuf_appendint(&b, 7);
+    ecs_strbuf_appendch(&b, ' ');
+    ecs_strbuf_appendint(&b, -10);
+    ecs_strbuf_appendch(&b, ' ');
+    ecs_strbuf_appendint(&b, 1234567);
+    ecs_strbuf_appendch(&b, ' ');
+    ecs_strbuf_appendint(&b, INT64_MAX);
+    ecs_strbuf_appendch(&b, ' ');
+    ecs_strbuf_appendint(&b, INT64_MIN);
+
+    char *str = ecs_strbuf_get(&b);
+    test_assert(str != NULL);
+    test_str(str, "0 7 -10 1234567 9223372036854775807 -9223372036854775808");
+    ecs_os_free(str);
+}
+
+void Strbuf_append_flt_integral(void) {
+    ecs_strbuf_t b = ECS_STRBUF_INIT;
+    ecs_strbuf_appendflt(&b, 0, 0);
+    ecs_strbuf_appendch(&b, ' ');
+    ecs_strbuf_appendflt(&b, -25, 0);
+    ecs_strbuf_appendch(&b, ' ');
+    ecs_strbuf_appendflt(&b, 1000, 0);
+    ecs_strbuf_appendch(&b, ' ');
+    ecs_strbuf_appendflt(&b, 10000, 0);
+
+    char *str = ecs_strbuf_get(&b);
+    test_assert(str != NULL);
+    test_str(str, "0 -25 1000 1e4");
+    ecs_os_free(str);
+}
+
+void Strbuf_append_esc(void) {
+    ecs_strbuf_t b = ECS_STRBUF_INIT;
+    ecs_strbuf_appendesc(&b, "Hello \"World\"\n", '"');
+
+    char *str = ecs_strbuf_get(&b);
+    test_assert(str != NULL);
+    test_str(str, "Hello \\\"World\\\"\\n");
+    ecs_os_free(str);
+}
+
+void Strbuf_append_esc_long(void) {
+    ecs_strbuf_t b = ECS_STRBUF_INIT;
+    ecs_strbuf_appendesc(&b, 
+        "The quick brown fox jumps over the lazy dog, "
+        "then\tescapes to C:\\path\\to\\\"file\"", '"');
+
+    char *str = ecs_strbuf_get(&b);
+    test_assert(str != NULL);
+    test_str(str, 
+        "The quick brown fox jumps over the lazy dog, "
+        "then\\tescapes to C:\\\\path\\\\to\\\\\\\"file\\\"");
+    ecs_os_free(str);
+}
+
+void Strbuf_append_esc_no_delim(void) {
+    ecs_strbuf_t b = ECS_STRBUF_INIT;
+    ecs_strbuf_appendesc(&b, "\"quoted\" and\\ 'single'", 0);
+
+    char *str = ecs_strbuf_get(&b);
+    test_assert(str != NULL);
+    test_str(str, "\"quoted\" and\\\\ 'single'");
+    ecs_os_free(str);
+}
+
+void Strbuf_reserve_commit(void) {
+    ecs_strbuf_t b = ECS_STRBUF_INIT;
+    ecs_strbuf_appendstr(&b, "Foo");
+
+    char *ptr = ecs_strbuf_reserve(&b, 3);
+    test_assert(ptr != NULL);
+    ptr[0] = 'B';
+    ptr[1] = 'a';
+    ptr[2] = 'r';
+    ecs_strbuf_commit(&b, 3);
+    test_int(ecs_strbuf_written(&b), 6);
+
+    char *str = ecs_strbuf_get(&b);
+    test_assert(str != NULL);
+    test_str(str, "FooBar");
+    ecs_os_free(str);
+}
+
+void Strbuf_reserve_large(void) {
+    ecs_strbuf_t b = ECS_STRBUF_INIT;
+    ecs_strbuf_appendstr(&b, "Foo");
+
+    char *ptr = ecs_strbuf_reserve(&b, 5000);
+    test_assert(ptr != NULL);
+    ecs_os_memset(ptr, 'a', 4000);
+    ecs_strbuf_commit(&b, 4000);
+    ecs_strbuf_appendstr(&b, "Bar");
+    test_int(ecs_strbuf_written(&b), 4006);
+
+    char *str = ecs_strbuf_get(&b);
+    test_assert(str != NULL);
+    test_int(ecs_os_strlen(str), 4006);
+    test_assert(!ecs_os_strncmp(str, "Fooaaa", 6));
+    test_str(&str[4000], "aaaBar");
+    ecs_os_free(str);
+}
+
+void Strbuf_merge_large(void) {
+    ecs_strbuf_t b1 = ECS_STRBUF_INIT;
+    ecs_strbuf_appendstr(&b1, "Foo");
+
+    ecs_strbuf_t b2 = ECS_STRBUF_INIT;
+    for (int i = 0; i < 1000; i ++) {
+        ecs_strbuf_appendstr(&b2, "Hello");
+    }
+    ecs_strbuf_mergebuff(&b1, &b2);
+    test_int(ecs_strbuf_written(&b1), 5003);
+
+    char *str = ecs_strbuf_get(&b1);
+    test_int(ecs_os_strlen(str), 5003);
+    test_str(&str[4998], "Hello");
+    ecs_os_free(str);
+}
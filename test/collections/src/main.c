@@ -63,6 +63,12 @@ void Sparse_count_of_null(void);
 void Sparse_try_low_after_ensure_high(void);
 void Sparse_is_alive_low_after_ensure_high(void);
 void Sparse_remove_low_after_ensure_high(void);
+void Sparse_new_ids(void);
+void Sparse_new_ids_recycle(void);
+void Sparse_remove_n(void);
+void Sparse_is_alive_n(void);
+void Sparse_iter(void);
+void Sparse_iter_empty(void);
 
 // Testsuite 'Strbuf'
 void Strbuf_setup(void);
@@ -101,6 +107,36 @@ void Strbuf_append_nan(void);
 void Strbuf_append_inf(void);
 void Strbuf_append_nan_delim(void);
 void Strbuf_append_inf_delim(void);
+void Strbuf_append_int(void);
+void Strbuf_append_flt_integral(void);
+void Strbuf_append_esc(void);
+void Strbuf_append_esc_long(void);
+void Strbuf_append_esc_no_delim(void);
+void Strbuf_reserve_commit(void);
+void Strbuf_reserve_large(void);
+void Strbuf_merge_large(void);
+
+// Testsuite 'BlockAllocator'
+void BlockAllocator_setup(void);
+void BlockAllocator_alloc_free(void);
+void BlockAllocator_depot_alloc_free(void);
+void BlockAllocator_depot_free_w_other_allocator(void);
+void BlockAllocator_depot_reuse_after_fini(void);
+void BlockAllocator_depot_return_magazine(void);
+void BlockAllocator_depot_different_sizes(void);
+void BlockAllocator_allocator_w_depot(void);
+void BlockAllocator_depot_multithreaded(void);
+void BlockAllocator_alloc_free_large(void);
+void BlockAllocator_alloc_free_huge(void);
+void BlockAllocator_alloc_free_large_w_arena(void);
+void BlockAllocator_os_aligned_alloc(void);
+void BlockAllocator_os_page_alloc(void);
+void BlockAllocator_os_page_alloc_huge_w_node(void);
+void BlockAllocator_trim(void);
+void BlockAllocator_trim_w_arena(void);
+void BlockAllocator_os_vm_reserve_commit(void);
+void BlockAllocator_allocator_vm_realloc(void);
+void BlockAllocator_allocator_vm_exceed_reserve(void);
 
 bake_test_case Map_testcases[] = {
     {
@@ -305,6 +341,30 @@ bake_test_case Sparse_testcases[] = {
     {
         "remove_low_after_ensure_high",
         Sparse_remove_low_after_ensure_high
+    },
+    {
+        "new_ids",
+        Sparse_new_ids
+    },
+    {
+        "new_ids_recycle",
+        Sparse_new_ids_recycle
+    },
+    {
+        "remove_n",
+        Sparse_remove_n
+    },
+    {
+        "is_alive_n",
+        Sparse_is_alive_n
+    },
+    {
+        "iter",
+        Sparse_iter
+    },
+    {
+        "iter_empty",
+        Sparse_iter_empty
     }
 };
 
@@ -448,6 +508,117 @@ bake_test_case Strbuf_testcases[] = {
     {
         "append_inf_delim",
         Strbuf_append_inf_delim
+    },
+    {
+        "append_int",
+        Strbuf_append_int
+    },
+    {
+        "append_flt_integral",
+        Strbuf_append_flt_integral
+    },
+    {
+        "append_esc",
+        Strbuf_append_esc
+    },
+    {
+        "append_esc_long",
+        Strbuf_append_esc_long
+    },
+    {
+        "append_esc_no_delim",
+        Strbuf_append_esc_no_delim
+    },
+    {
+        "reserve_commit",
+        Strbuf_reserve_commit
+    },
+    {
+        "reserve_large",
+        Strbuf_reserve_large
+    },
+    {
+        "merge_large",
+        Strbuf_merge_large
+    }
+};
+
+bake_test_case BlockAllocator_testcases[] = {
+    {
+        "alloc_free",
+        BlockAllocator_alloc_free
+    },
+    {
+        "depot_alloc_free",
+        BlockAllocator_depot_alloc_free
+    },
+    {
+        "depot_free_w_other_allocator",
+        BlockAllocator_depot_free_w_other_allocator
+    },
+    {
+        "depot_reuse_after_fini",
+        BlockAllocator_depot_reuse_after_fini
+    },
+    {
+        "depot_return_magazine",
+        BlockAllocator_depot_return_magazine
+    },
+    {
+        "depot_different_sizes",
+        BlockAllocator_depot_different_sizes
+    },
+    {
+        "allocator_w_depot",
+        BlockAllocator_allocator_w_depot
+    },
+    {
+        "depot_multithreaded",
+        BlockAllocator_depot_multithreaded
+    },
+    {
+        "alloc_free_large",
+        BlockAllocator_alloc_free_large
+    },
+    {
+        "alloc_free_huge",
+        BlockAllocator_alloc_free_huge
+    },
+    {
+        "alloc_free_large_w_arena",
+        BlockAllocator_alloc_free_large_w_arena
+    },
+    {
+        "os_aligned_alloc",
+        BlockAllocator_os_aligned_alloc
+    },
+    {
+        "os_page_alloc",
+        BlockAllocator_os_page_alloc
+    },
+    {
+        "os_page_alloc_huge_w_node",
+        BlockAllocator_os_page_alloc_huge_w_node
+    },
+    {
+        "trim",
+        BlockAllocator_trim
+    },
+    {
+        "trim_w_arena",
+        BlockAllocator_trim_w_arena
+    },
+    {
+        "os_vm_reserve_commit",
+        BlockAllocator_os_vm_reserve_commit
+    },
+    {
+        "allocator_vm_realloc",
+        BlockAllocator_allocator_vm_realloc
+    },
+    {
+        "allocator_vm_exceed_reserve",
+        BlockAllocator_allocator_vm_exceed_reserve
     }
 };
 
@@ -463,18 +634,25 @@ static bake_test_suite suites[] = {
         "Sparse",
         Sparse_setup,
         NULL,
-        21,
+        27,
         Sparse_testcases
     },
     {
         "Strbuf",
         Strbuf_setup,
         NULL,
-        35,
+        43,
         Strbuf_testcases
+    },
+    {
+        "BlockAllocator",
+        BlockAllocator_setup,
+        NULL,
+        19,
+        BlockAllocator_testcases
     }
 };
 
 int main(int argc, char *argv[]) {
-    return bake_test_run("collections", argc, argv, suites, 3);
+    return bake_test_run("collections", argc, argv, suites, 4);
 }
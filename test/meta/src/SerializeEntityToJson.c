@@ -1104,13 +1104,13 @@ void SerializeEntityToJson_serialize_w_2_alerts(void) {
         "\"path\":\"e1\", "
         "\"ids\":[[\"Position\"]], "
         "\"alerts\":[{"
-            "\"alert\":\"position_without_mass.e1_alert_2\", "
-            "\"message\":\"e1 has Position but not Mass\", "
-            "\"severity\":\"Error\""
-        "}, {"
             "\"alert\":\"position_without_velocity.e1_alert_1\", "
             "\"message\":\"e1 has Position but not Velocity\", "
             "\"severity\":\"Error\""
+        "}, {"
+            "\"alert\":\"position_without_mass.e1_alert_2\", "
+            "\"message\":\"e1 has Position but not Mass\", "
+            "\"severity\":\"Error\""
         "}]"
     "}");
     ecs_os_free(json);
@@ -3289,3 +3289,144 @@ void SerializeIterToJson_serialize_entity_w_flecs_core_parent(void) {
 
     ecs_fini(world);
 }
+
+typedef struct {
+    ecs_strbuf_t buf;
+    int32_t calls;
+    int32_t min_size;
+    int32_t last_size;
+    int32_t fail_at;
+} json_stream_t;
+
+static
+int json_stream_write(const char *data, ecs_size_t size, void *ctx) {
+    json_stream_t *s = ctx;
+    s->calls ++;
+    if (s->fail_at && s->calls == s->fail_at) {
+        return -1;
+    }
+    if (s->calls > 1 && s->last_size < s->min_size) {
+        s->min_size = s->last_size;
+    }
+    if (s->calls == 1) {
+        s->min_size = size;
+    }
+    s->last_size = size;
+    ecs_strbuf_appendstrn(&s->buf, data, size);
+    return 0;
+}
+
+void SerializeIterToJson_serialize_stream(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_i32_t)},
+            {"y", ecs_id(ecs_i32_t)}
+        }
+    });
+
+    ecs_entity_t e = ecs_new_entity(world, "e");
+    ecs_set(world, e, Position, {10, 20});
+
+    ecs_query_t *q = ecs_query(world, { .filter.terms = {{ ecs_id(Position) }}});
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    char *expect = ecs_iter_to_json(world, &it, NULL);
+    test_assert(expect != NULL);
+
+    json_stream_t s = { ECS_STRBUF_INIT };
+    it = ecs_query_iter(world, q);
+    test_int(0, ecs_iter_to_json_stream(world, &it, NULL, json_stream_write, &s));
+    test_int(s.calls, 1);
+
+    char *json = ecs_strbuf_get(&s.buf);
+    test_str(json, expect);
+    ecs_os_free(json);
+    ecs_os_free(expect);
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void SerializeIterToJson_serialize_stream_chunks(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+    ECS_TAG(world, Foo);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_i32_t)},
+            {"y", ecs_id(ecs_i32_t)}
+        }
+    });
+
+    int32_t i;
+    for (i = 0; i < 20000; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        ecs_set(world, e, Position, {i, i * 2});
+        if (!(i % 2)) {
+            ecs_add(world, e, Foo);
+        }
+    }
+
+    ecs_query_t *q = ecs_query(world, { .filter.terms = {{ ecs_id(Position) }}});
+
+    ecs_iter_t it = ecs_query_iter(world, q);
+    char *expect = ecs_iter_to_json(world, &it, NULL);
+    test_assert(expect != NULL);
+
+    json_stream_t s = { ECS_STRBUF_INIT };
+    it = ecs_query_iter(world, q);
+    test_int(0, ecs_iter_to_json_stream(world, &it, NULL, json_stream_write, &s));
+    test_assert(s.calls > 1);
+    test_assert(s.min_size >= ECS_JSON_STREAM_CHUNK_SIZE);
+
+    char *json = ecs_strbuf_get(&s.buf);
+    test_str(json, expect);
+    ecs_os_free(json);
+    ecs_os_free(expect);
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
+
+void SerializeIterToJson_serialize_stream_write_error(void) {
+    ecs_world_t *world = ecs_init();
+
+    ECS_COMPONENT(world, Position);
+
+    ecs_struct(world, {
+        .entity = ecs_id(Position),
+        .members = {
+            {"x", ecs_id(ecs_i32_t)},
+            {"y", ecs_id(ecs_i32_t)}
+        }
+    });
+
+    int32_t i;
+    for (i = 0; i < 20000; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        ecs_set(world, e, Position, {i, i * 2});
+    }
+
+    ecs_query_t *q = ecs_query(world, { .filter.terms = {{ ecs_id(Position) }}});
+
+    json_stream_t s = { ECS_STRBUF_INIT, .fail_at = 1 };
+    ecs_iter_t it = ecs_query_iter(world, q);
+    test_assert(0 != ecs_iter_to_json_stream(
+        world, &it, NULL, json_stream_write, &s));
+    test_int(s.calls, 1);
+    ecs_strbuf_reset(&s.buf);
+
+    ecs_query_fini(q);
+
+    ecs_fini(world);
+}
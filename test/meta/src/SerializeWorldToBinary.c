@@ -0,0 +1,464 @@
+#include <meta.h>
+
+typedef struct {
+    char *name;
+    ecs_entity_t target;
+} Label;
+
+typedef struct {
+    ecs_vec_t values;
+} Values;
+
+static
+void register_types(ecs_world_t *world) {
+    ecs_entity_t ecs_id(Position) = ecs_struct(world, {
+        .entity = ecs_entity(world, { .name = "Position", .symbol = "Position" }),
+        .members = {
+            { .name = "x", .type = ecs_id(ecs_i32_t) },
+            { .name = "y", .type = ecs_id(ecs_i32_t) }
+        }
+    });
+    test_assert(ecs_id(Position) != 0);
+
+    ecs_entity_t ecs_id(Label) = ecs_struct(world, {
+        .entity = ecs_entity(world, { .name = "Label", .symbol = "Label" }),
+        .members = {
+            { .name = "name", .type = ecs_id(ecs_string_t) },
+            { .name = "target", .type = ecs_id(ecs_entity_t) }
+        }
+    });
+    test_assert(ecs_id(Label) != 0);
+
+    ecs_entity_t vec = ecs_vector(world, {
+        .entity = ecs_entity(world, { .name = "IntVec" }),
+        .type = ecs_id(ecs_i32_t)
+    });
+
+    ecs_entity_t ecs_id(Values) = ecs_struct(world, {
+        .entity = ecs_entity(world, { .name = "Values", .symbol = "Values" }),
+        .members = {
+            { .name = "values", .type = vec }
+        }
+    });
+    test_assert(ecs_id(Values) != 0);
+}
+
+typedef struct {
+    const char *data;
+    ecs_size_t size;
+    ecs_size_t read;
+    ecs_size_t chunk;
+} binary_reader_t;
+
+static
+ecs_size_t binary_read(void *data, ecs_size_t size, void *ctx) {
+    binary_reader_t *r = ctx;
+    ecs_size_t n = r->size - r->read;
+    if (n > size) {
+        n = size;
+    }
+    if (n > r->chunk) {
+        n = r->chunk;
+    }
+    ecs_os_memcpy(data, r->data + r->read, n);
+    r->read += n;
+    return n;
+}
+
+typedef struct {
+    ecs_vec_t buf;
+    int32_t calls;
+} binary_writer_t;
+
+static
+int binary_write(const void *data, ecs_size_t size, void *ctx) {
+    binary_writer_t *w = ctx;
+    void *dst = ecs_vec_grow(NULL, &w->buf, 1, size);
+    ecs_os_memcpy(dst, data, size);
+    w->calls ++;
+    return 0;
+}
+
+void SerializeWorldToBinary_ser_deser_mini(void) {
+    ecs_world_t *world = ecs_mini();
+
+    ecs_size_t size = 0;
+    void *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    test_assert(size != 0);
+
+    test_int(ecs_world_from_binary(world, data, size, NULL), 0);
+    ecs_os_free(data);
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_ser_deser_init(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_size_t size = 0;
+    void *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    test_assert(size != 0);
+
+    test_int(ecs_world_from_binary(world, data, size, NULL), 0);
+    ecs_os_free(data);
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_ser_deser_entities(void) {
+    ecs_world_t *world = ecs_init();
+    register_types(world);
+    ecs_entity_t ecs_id(Position) = ecs_lookup(world, "Position");
+
+    ecs_entity_t e1 = ecs_entity(world, { .name = "e1" });
+    ecs_set(world, e1, Position, {10, 20});
+    ecs_entity_t e2 = ecs_new_id(world);
+    ecs_set(world, e2, Position, {30, 40});
+
+    ecs_size_t size = 0;
+    void *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    ecs_fini(world);
+
+    world = ecs_init();
+    register_types(world);
+    ecs_id(Position) = ecs_lookup(world, "Position");
+
+    test_int(ecs_world_from_binary(world, data, size, NULL), 0);
+    ecs_os_free(data);
+
+    e1 = ecs_lookup(world, "e1");
+    test_assert(e1 != 0);
+    const Position *p = ecs_get(world, e1, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    int32_t count = 0;
+    ecs_filter_t *f = ecs_filter(world, { .terms = {{ ecs_id(Position) }} });
+    ecs_iter_t it = ecs_filter_iter(world, f);
+    while (ecs_filter_next(&it)) {
+        Position *ptr = ecs_field(&it, Position, 1);
+        for (int i = 0; i < it.count; i ++) {
+            if (it.entities[i] != e1) {
+                test_int(ptr[i].x, 30);
+                test_int(ptr[i].y, 40);
+            }
+            count ++;
+        }
+    }
+    test_int(count, 2);
+    ecs_filter_fini(f);
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_ser_deser_hierarchy(void) {
+    ecs_world_t *world = ecs_init();
+    register_types(world);
+    ecs_entity_t ecs_id(Position) = ecs_lookup(world, "Position");
+
+    ecs_entity_t child = ecs_entity(world, { .name = "parent.child" });
+    ecs_set(world, child, Position, {10, 20});
+
+    ecs_size_t size = 0;
+    void *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    ecs_fini(world);
+
+    world = ecs_init();
+    register_types(world);
+    ecs_id(Position) = ecs_lookup(world, "Position");
+
+    test_int(ecs_world_from_binary(world, data, size, NULL), 0);
+    ecs_os_free(data);
+
+    ecs_entity_t parent = ecs_lookup(world, "parent");
+    test_assert(parent != 0);
+    child = ecs_lookup(world, "parent.child");
+    test_assert(child != 0);
+    test_assert(ecs_has_pair(world, child, EcsChildOf, parent));
+
+    const Position *p = ecs_get(world, child, Position);
+    test_assert(p != NULL);
+    test_int(p->x, 10);
+    test_int(p->y, 20);
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_ser_deser_pairs(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_entity_t likes = ecs_entity(world, { .name = "Likes" });
+    ecs_entity_t alice = ecs_entity(world, { .name = "Alice" });
+    ecs_entity_t bob = ecs_entity(world, { .name = "Bob" });
+    ecs_add_pair(world, alice, likes, bob);
+
+    ecs_size_t size = 0;
+    void *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    ecs_fini(world);
+
+    world = ecs_init();
+    test_int(ecs_world_from_binary(world, data, size, NULL), 0);
+    ecs_os_free(data);
+
+    likes = ecs_lookup(world, "Likes");
+    alice = ecs_lookup(world, "Alice");
+    bob = ecs_lookup(world, "Bob");
+    test_assert(likes != 0);
+    test_assert(alice != 0);
+    test_assert(bob != 0);
+    test_assert(ecs_has_pair(world, alice, likes, bob));
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_ser_deser_string_entity(void) {
+    ecs_world_t *world = ecs_init();
+    register_types(world);
+    ecs_entity_t ecs_id(Label) = ecs_lookup(world, "Label");
+
+    ecs_entity_t target = ecs_entity(world, { .name = "target" });
+    ecs_entity_t e = ecs_entity(world, { .name = "e" });
+    ecs_set(world, e, Label, { .name = "Hello", .target = target });
+
+    ecs_size_t size = 0;
+    void *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    ecs_fini(world);
+
+    world = ecs_init();
+    register_types(world);
+    ecs_id(Label) = ecs_lookup(world, "Label");
+
+    test_int(ecs_world_from_binary(world, data, size, NULL), 0);
+    ecs_os_free(data);
+
+    e = ecs_lookup(world, "e");
+    target = ecs_lookup(world, "target");
+    test_assert(e != 0);
+    test_assert(target != 0);
+
+    const Label *l = ecs_get(world, e, Label);
+    test_assert(l != NULL);
+    test_str(l->name, "Hello");
+    test_uint(l->target, target);
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_ser_deser_vector(void) {
+    ecs_world_t *world = ecs_init();
+    register_types(world);
+    ecs_entity_t ecs_id(Values) = ecs_lookup(world, "Values");
+
+    ecs_entity_t e = ecs_entity(world, { .name = "e" });
+    Values *v = ecs_ensure(world, e, Values);
+    ecs_vec_init_t(NULL, &v->values, int32_t, 3);
+    ecs_vec_append_t(NULL, &v->values, int32_t)[0] = 10;
+    ecs_vec_append_t(NULL, &v->values, int32_t)[0] = 20;
+    ecs_vec_append_t(NULL, &v->values, int32_t)[0] = 30;
+    ecs_modified(world, e, Values);
+
+    ecs_size_t size = 0;
+    void *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    ecs_fini(world);
+
+    world = ecs_init();
+    register_types(world);
+    ecs_id(Values) = ecs_lookup(world, "Values");
+
+    test_int(ecs_world_from_binary(world, data, size, NULL), 0);
+    ecs_os_free(data);
+
+    e = ecs_lookup(world, "e");
+    test_assert(e != 0);
+    const Values *cv = ecs_get(world, e, Values);
+    test_assert(cv != NULL);
+    test_int(ecs_vec_count(&cv->values), 3);
+    int32_t *values = ecs_vec_first(&cv->values);
+    test_int(values[0], 10);
+    test_int(values[1], 20);
+    test_int(values[2], 30);
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_ser_deser_stream(void) {
+    ecs_world_t *world = ecs_init();
+    register_types(world);
+    ecs_entity_t ecs_id(Position) = ecs_lookup(world, "Position");
+
+    /* Large enough to exceed the stream chunk size */
+    int32_t i, count = 20000;
+    for (i = 0; i < count; i ++) {
+        ecs_entity_t e = ecs_new_id(world);
+        ecs_set(world, e, Position, {(float)i, (float)(i * 2)});
+    }
+
+    binary_writer_t w = {0};
+    ecs_vec_init(NULL, &w.buf, 1, 0);
+    test_int(ecs_world_to_binary_stream(world, NULL, binary_write, &w), 0);
+    test_assert(w.calls > 1);
+    ecs_fini(world);
+
+    world = ecs_init();
+    register_types(world);
+    ecs_id(Position) = ecs_lookup(world, "Position");
+
+    binary_reader_t r = {
+        .data = ecs_vec_first(&w.buf),
+        .size = ecs_vec_count(&w.buf),
+        .chunk = 1000
+    };
+
+    test_int(ecs_world_from_binary_stream(world, binary_read, &r, NULL), 0);
+    test_int(r.read, r.size);
+    ecs_vec_fini(NULL, &w.buf, 1);
+
+    int32_t found = 0;
+    ecs_filter_t *f = ecs_filter(world, { .terms = {{ ecs_id(Position) }} });
+    ecs_iter_t it = ecs_filter_iter(world, f);
+    while (ecs_filter_next(&it)) {
+        Position *p = ecs_field(&it, Position, 1);
+        for (i = 0; i < it.count; i ++) {
+            test_int(p[i].y, p[i].x * 2);
+            found ++;
+        }
+    }
+    test_int(found, count);
+    ecs_filter_fini(f);
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_deser_layout_mismatch(void) {
+    ecs_world_t *world = ecs_init();
+    register_types(world);
+    ecs_entity_t ecs_id(Position) = ecs_lookup(world, "Position");
+
+    ecs_entity_t e = ecs_entity(world, { .name = "e" });
+    ecs_set(world, e, Position, {10, 20});
+
+    ecs_size_t size = 0;
+    void *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    ecs_fini(world);
+
+    world = ecs_init();
+    ecs_entity_t t = ecs_struct(world, {
+        .entity = ecs_entity(world, { .name = "Position" }),
+        .members = {
+            { .name = "x", .type = ecs_id(ecs_i32_t) },
+            { .name = "y", .type = ecs_id(ecs_i32_t) },
+            { .name = "z", .type = ecs_id(ecs_i32_t) }
+        }
+    });
+
+    test_int(ecs_world_from_binary(world, data, size, NULL), 0);
+    e = ecs_lookup(world, "e");
+    test_assert(e != 0);
+    test_assert(ecs_has_id(world, e, t));
+
+    ecs_log_set_level(-4);
+    ecs_from_binary_desc_t desc = { .strict = true };
+    test_assert(ecs_world_from_binary(world, data, size, &desc) != 0);
+    ecs_os_free(data);
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_deser_invalid(void) {
+    ecs_world_t *world = ecs_init();
+
+    ecs_log_set_level(-4);
+    const char data[] = "not a binary world";
+    test_assert(ecs_world_from_binary(
+        world, data, ECS_SIZEOF(data), NULL) != 0);
+
+    ecs_size_t size = 0;
+    void *buf = ecs_world_to_binary(world, NULL, &size);
+    test_assert(buf != NULL);
+    test_assert(ecs_world_from_binary(world, buf, size / 2, NULL) != 0);
+    ecs_os_free(buf);
+
+    ecs_fini(world);
+}
+
+static
+char* find_bytes(char *data, ecs_size_t size, const void *bytes, ecs_size_t len) {
+    ecs_size_t i;
+    for (i = 0; i <= (size - len); i ++) {
+        if (!ecs_os_memcmp(&data[i], bytes, len)) {
+            return &data[i];
+        }
+    }
+    return NULL;
+}
+
+void SerializeWorldToBinary_deser_invalid_vector_length(void) {
+    ecs_world_t *world = ecs_init();
+    register_types(world);
+    ecs_entity_t ecs_id(Values) = ecs_lookup(world, "Values");
+
+    ecs_entity_t e = ecs_entity(world, { .name = "e" });
+    Values *v = ecs_ensure(world, e, Values);
+    ecs_vec_init_t(NULL, &v->values, int32_t, 2);
+    ecs_vec_append_t(NULL, &v->values, int32_t)[0] = 10;
+    ecs_vec_append_t(NULL, &v->values, int32_t)[0] = 20;
+    ecs_modified(world, e, Values);
+
+    ecs_size_t size = 0;
+    char *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    ecs_fini(world);
+
+    int32_t stored[] = {2, 10, 20};
+    char *count = find_bytes(data, size, stored, ECS_SIZEOF(stored));
+    test_assert(count != NULL);
+    uint32_t invalid_count = 0x10000000;
+    ecs_os_memcpy(count, &invalid_count, ECS_SIZEOF(uint32_t));
+
+    world = ecs_init();
+    register_types(world);
+
+    ecs_log_set_level(-4);
+    test_assert(ecs_world_from_binary(world, data, size, NULL) != 0);
+    ecs_os_free(data);
+
+    ecs_fini(world);
+}
+
+void SerializeWorldToBinary_deser_invalid_string_length(void) {
+    ecs_world_t *world = ecs_init();
+    register_types(world);
+    ecs_entity_t ecs_id(Label) = ecs_lookup(world, "Label");
+
+    ecs_entity_t e = ecs_entity(world, { .name = "e" });
+    ecs_set(world, e, Label, { .name = "Hello" });
+
+    ecs_size_t size = 0;
+    char *data = ecs_world_to_binary(world, NULL, &size);
+    test_assert(data != NULL);
+    ecs_fini(world);
+
+    char stored[] = {5, 0, 0, 0, 'H', 'e', 'l', 'l', 'o'};
+    char *len = find_bytes(data, size, stored, ECS_SIZEOF(stored));
+    test_assert(len != NULL);
+    uint32_t invalid_len = UINT32_MAX - 1;
+    ecs_os_memcpy(len, &invalid_len, ECS_SIZEOF(uint32_t));
+
+    world = ecs_init();
+    register_types(world);
+
+    ecs_log_set_level(-4);
+    test_assert(ecs_world_from_binary(world, data, size, NULL) != 0);
+    ecs_os_free(data);
+
+    ecs_fini(world);
+}
@@ -820,6 +820,9 @@ void SerializeIterToJson_serialize_null_doc_name(void);
 void SerializeIterToJson_serialize_rule_w_optional(void);
 void SerializeIterToJson_serialize_rule_w_optional_component(void);
 void SerializeIterToJson_serialize_entity_w_flecs_core_parent(void);
+void SerializeIterToJson_serialize_stream(void);
+void SerializeIterToJson_serialize_stream_chunks(void);
+void SerializeIterToJson_serialize_stream_write_error(void);
 
 // Testsuite 'SerializeIterToRowJson'
 void SerializeIterToRowJson_serialize_this_w_1_tag(void);
@@ -1178,6 +1181,20 @@ void Misc_unit_from_suspend_defer(void);
 void Misc_unit_prefix_from_suspend_defer(void);
 void Misc_quantity_from_suspend_defer(void);
 
+// Testsuite 'SerializeWorldToBinary'
+void SerializeWorldToBinary_ser_deser_mini(void);
+void SerializeWorldToBinary_ser_deser_init(void);
+void SerializeWorldToBinary_ser_deser_entities(void);
+void SerializeWorldToBinary_ser_deser_hierarchy(void);
+void SerializeWorldToBinary_ser_deser_pairs(void);
+void SerializeWorldToBinary_ser_deser_string_entity(void);
+void SerializeWorldToBinary_ser_deser_vector(void);
+void SerializeWorldToBinary_ser_deser_stream(void);
+void SerializeWorldToBinary_deser_layout_mismatch(void);
+void SerializeWorldToBinary_deser_invalid(void);
+void SerializeWorldToBinary_deser_invalid_vector_length(void);
+void SerializeWorldToBinary_deser_invalid_string_length(void);
+
 bake_test_case PrimitiveTypes_testcases[] = {
     {
         "bool",
@@ -4347,6 +4364,18 @@ bake_test_case SerializeIterToJson_testcases[] = {
     {
         "serialize_entity_w_flecs_core_parent",
         SerializeIterToJson_serialize_entity_w_flecs_core_parent
+    },
+    {
+        "serialize_stream",
+        SerializeIterToJson_serialize_stream
+    },
+    {
+        "serialize_stream_chunks",
+        SerializeIterToJson_serialize_stream_chunks
+    },
+    {
+        "serialize_stream_write_error",
+        SerializeIterToJson_serialize_stream_write_error
     }
 };
 
@@ -5739,6 +5768,57 @@ bake_test_case Misc_testcases[] = {
 };
 
 
+bake_test_case SerializeWorldToBinary_testcases[] = {
+    {
+        "ser_deser_mini",
+        SerializeWorldToBinary_ser_deser_mini
+    },
+    {
+        "ser_deser_init",
+        SerializeWorldToBinary_ser_deser_init
+    },
+    {
+        "ser_deser_entities",
+        SerializeWorldToBinary_ser_deser_entities
+    },
+    {
+        "ser_deser_hierarchy",
+        SerializeWorldToBinary_ser_deser_hierarchy
+    },
+    {
+        "ser_deser_pairs",
+        SerializeWorldToBinary_ser_deser_pairs
+    },
+    {
+        "ser_deser_string_entity",
+        SerializeWorldToBinary_ser_deser_string_entity
+    },
+    {
+        "ser_deser_vector",
+        SerializeWorldToBinary_ser_deser_vector
+    },
+    {
+        "ser_deser_stream",
+        SerializeWorldToBinary_ser_deser_stream
+    },
+    {
+        "deser_layout_mismatch",
+        SerializeWorldToBinary_deser_layout_mismatch
+    },
+    {
+        "deser_invalid",
+        SerializeWorldToBinary_deser_invalid
+    },
+    {
+        "deser_invalid_vector_length",
+        SerializeWorldToBinary_deser_invalid_vector_length
+    },
+    {
+        "deser_invalid_string_length",
+        SerializeWorldToBinary_deser_invalid_string_length
+    }
+};
+
 static bake_test_suite suites[] = {
     {
         "PrimitiveTypes",
@@ -5849,7 +5929,7 @@ static bake_test_suite suites[] = {
         "SerializeIterToJson",
         NULL,
         NULL,
-        73,
+        76,
         SerializeIterToJson_testcases
     },
     {
@@ -5907,9 +5987,16 @@ static bake_test_suite suites[] = {
         NULL,
         40,
         Misc_testcases
+    },
+    {
+        "SerializeWorldToBinary",
+        NULL,
+        NULL,
+        12,
+        SerializeWorldToBinary_testcases
     }
 };
 
 int main(int argc, char *argv[]) {
-    return bake_test_run("meta", argc, argv, suites, 24);
+    return bake_test_run("meta", argc, argv, suites, 25);
 }